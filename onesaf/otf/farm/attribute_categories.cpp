@@ -48,6 +48,7 @@
 **
 *****************************************************************************/
 
+#include "farm_trace.h"
 #include "attribute_categories.h"
 
 namespace
@@ -170,6 +171,9 @@ namespace FARM
     // ------------------------------------------------------------------------
     bool AttributeCategories::initialize()
     {
+        StartupTracePhase
+            phase("AttributeCategories::initialize");
+
         if (FeatureAttributeMapping::initialized())
         {
             initialized = true;
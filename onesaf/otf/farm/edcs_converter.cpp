@@ -17,8 +17,11 @@
  *
  */
 #include <cctype>
+#include <cmath>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <set>
 #include <vector>
@@ -35,6 +38,9 @@
 #include "edcs_converter.h"
 #include "farm_data_types.h"
 #include "farm_enumerant.h"
+#include "farm_instrumentation.h"
+#include "farm_label_filter.h"
+#include "farm_trace.h"
 #include "feature_categories.h"
 
 namespace
@@ -44,11 +50,22 @@ namespace
     typedef std::map< FARM::FeatureLabel, FARM::FeatureLabel >
         EDCSFeatureMapping;
 
-    // New EDCS enumerant values are defined as a pair consisting of an
-    // attribute label and a union value.
+    // New EDCS enumerant values are defined by an attribute label and a
+    // typed value.  An enumerated value also keeps the EDCS 4.x enumerant
+    // label of the mapping file, interned in the mapping strings, so that the
+    // legacy convert_value() can return it without looking it up.
     //
-    typedef std::pair<FARM::AttributeLabel, FARM::AttributeDataValue>
-        AttributeValuePair;
+    struct AttributeValuePair
+    {
+        AttributeValuePair(void);
+
+        FARM::AttributeLabel
+            attribute_label;
+        FARM::TypedValue
+            value;
+        const std::string
+            *enumerant_label;   // 0 unless the value is an enumerant
+    };
 
     // Maps old EDCS attribute values to new EDCS attribute values
     // Attribute data types may have changed from one version of
@@ -63,6 +80,12 @@ namespace
     typedef std::map< FARM::AttributeEnumPair, FARM::AttributeLabel >
         EDCSAttributeMappingWithEnum;
 
+    // The strings of the mapping files that the typed values of the tables
+    // and plans point to.  They are released by EDCSConverter::destroy().
+    //
+    FARM::StringPool
+        mapping_strings;
+
     EDCSFeatureMapping
         edcs_feature_map;
     EDCSAttributeValueMapping
@@ -76,6 +99,593 @@ namespace
         attribute_labels_to_types;      // Stores the mapping of attribute
                                         // labels to respective data types
 
+    // Codes above this limit are not given a compiled conversion plan since
+    // the plans are indexed directly by code.
+    //
+    const CORE::Int32
+        max_plan_code = 65535;
+
+    // Maps the EDCS 3.x enumerant label to the EDCS 3.x enumerant code of a
+    // single attribute.
+    //
+    typedef std::map< FARM::EnumerantLabel, FARM::EnumerantCode >
+        EnumerantLabelsToCodes;
+
+    // The compiled conversion of a single EDCS 3.x attribute.  Enumerated
+    // attributes index their conversions by the EDCS 3.x enumerant code, all
+    // other attributes share a single conversion.  The EDCS 4.x attribute
+    // labels and the enumerant codes by label are kept for the typed
+    // convert_value(), which is given labels.
+    //
+    struct ConversionPlan
+    {
+        ConversionPlan(void);
+
+        FARM::AttributeDataType
+            old_data_type;
+        FARM::ConvertedValue
+            result;
+        FARM::AttributeLabel
+            new_label;
+        std::vector<FARM::ConvertedValue>
+            enumerants;
+        std::vector<FARM::AttributeLabel>
+            enumerant_labels;
+        EnumerantLabelsToCodes
+            enumerant_codes;
+    };
+
+    // Maps the EDCS 3.x attribute code to its compiled conversion plan.
+    //
+    typedef std::vector<ConversionPlan>
+        ConversionPlans;
+
+    // Maps the EDCS 3.x attribute label to the EDCS 3.x attribute code.
+    //
+    typedef std::map< FARM::AttributeLabel, FARM::AttributeCode >
+        OldAttributeLabelsToCodes;
+
+    // Maps the EDCS 3.x attribute and enumerant labels to the EDCS 3.x
+    // enumerant code.
+    //
+    typedef std::map< FARM::AttributeEnumPair, FARM::EnumerantCode >
+        OldEnumerantLabelsToCodes;
+
+    ConversionPlans
+        conversion_plans;
+    OldAttributeLabelsToCodes
+        old_attribute_labels_to_codes;
+    OldEnumerantLabelsToCodes
+        old_enum_labels_to_codes;
+
+    // Orders typed values by data type and then by value so that they can
+    // key a map.
+    //
+    struct TypedValueLess
+    {
+        bool operator()(
+            const FARM::TypedValue &lhs,
+            const FARM::TypedValue &rhs
+        ) const;
+    };
+
+    // Maps an EDCS 4.x value that is not an enumerant to the EDCS 3.x value.
+    //
+    typedef std::map<FARM::TypedValue, FARM::ConvertedValue, TypedValueLess>
+        ReverseValues;
+
+    // The compiled down conversion of a single EDCS 4.x attribute.  Values
+    // that came from EDCS 3.x enumerants are found by their EDCS 4.x value:
+    // enumerants are indexed by code, other values are keyed by value.  The
+    // result is used for the values of EDCS 3.x attributes that carried
+    // over.
+    //
+    struct ReversePlan
+    {
+        ReversePlan(void);
+
+        FARM::ConvertedValue
+            result;
+        std::vector<FARM::ConvertedValue>
+            enumerants;
+        ReverseValues
+            values;
+    };
+
+    // Maps the EDCS 4.x attribute code to its compiled down conversion.
+    //
+    typedef std::vector<ReversePlan>
+        ReversePlans;
+
+    // Maps the EDCS 3.x attribute and enumerant codes to the EDCS 3.x
+    // enumerant label.
+    //
+    typedef std::map<std::pair<FARM::AttributeCode, FARM::EnumerantCode>,
+        FARM::EnumerantLabel>
+        OldEnumerantCodesToLabels;
+
+    ReversePlans
+        reverse_plans;
+    std::map<FARM::AttributeCode, FARM::AttributeLabel>
+        old_attribute_codes_to_labels;
+    OldEnumerantCodesToLabels
+        old_enum_codes_to_labels;
+
+    // Reject unknown EDCS 3.x labels before the mapping tables are searched.
+    // The attribute filter covers the attribute codes and data types, and the
+    // enumerant filter covers the enumerant codes and value mappings.
+    //
+    FARM::LabelFilter
+        old_feature_filter("EDCS 3.x feature labels"),
+        old_attribute_filter("EDCS 3.x attribute labels"),
+        old_enumerant_filter("EDCS 3.x enumerant labels");
+
+    // ------------------------------------------------------------------------
+    // Return:  A conversion result that is not mapped.
+    //
+    FARM::ConvertedValue unmapped_value(void)
+    {
+        FARM::ConvertedValue
+            converted;
+
+        converted.attribute_code = -999;
+        converted.mapping_flag = FARM::not_mapped;
+
+        return converted;
+    }
+
+    // ------------------------------------------------------------------------
+    AttributeValuePair::AttributeValuePair(void) :
+        enumerant_label(0)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    ConversionPlan::ConversionPlan(void) :
+        old_data_type(FARM::no_data_type),
+        result(unmapped_value())
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    ReversePlan::ReversePlan(void) :
+        result(unmapped_value())
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    bool TypedValueLess::operator()(
+        const FARM::TypedValue &lhs,
+        const FARM::TypedValue &rhs
+    ) const
+    {
+        bool
+            less = lhs.get_data_type() < rhs.get_data_type();
+
+        if (lhs.get_data_type() == rhs.get_data_type())
+        {
+            switch (lhs.get_data_type())
+            {
+                case FARM::int32:
+                {
+                    less = lhs.get_int32() < rhs.get_int32();
+                    break;
+                }
+
+                case FARM::float64:
+                {
+                    less = lhs.get_float64() < rhs.get_float64();
+                    break;
+                }
+
+                case FARM::boolean:
+                {
+                    less = lhs.get_boolean() < rhs.get_boolean();
+                    break;
+                }
+
+                case FARM::enumeration:
+                {
+                    less = lhs.get_enumerant() < rhs.get_enumerant();
+                    break;
+                }
+
+                case FARM::string:
+                {
+                    less = lhs.get_string() < rhs.get_string();
+                    break;
+                }
+
+                default:
+                {
+                    break;
+                }
+            }
+        }
+
+        return less;
+    }
+
+    // ------------------------------------------------------------------------
+    // Converts an EDCS 4.x value that carries over to the EDCS 3.x data type
+    // that is already set in the old value.  As in convert_value(), int32
+    // and float64 values convert to each other, but a float64 value only
+    // converts to int32 when it is a whole number in range.  Booleans and
+    // strings only carry over unchanged.
+    //
+    // Return:  Was the value converted?
+    //
+    bool carry_over_value(
+        const FARM::TypedValue &new_value,
+        FARM::TypedValue &old_value
+    )
+    {
+        const FARM::AttributeDataType
+            old_data_type = old_value.get_data_type();
+
+        bool
+            status = new_value.get_data_type() == old_data_type;
+
+        if (status)
+        {
+            old_value = new_value;
+        }
+        else if (
+            old_data_type == FARM::float64 and
+            new_value.get_data_type() == FARM::int32)
+        {
+            old_value.set_float64(new_value.get_int32());
+            status = true;
+        }
+        else if (
+            old_data_type == FARM::int32 and
+            new_value.get_data_type() == FARM::float64)
+        {
+            const CORE::Float64
+                float64 = new_value.get_float64();
+
+            status =
+                CORE::ordered<CORE::Float64>(
+                    std::numeric_limits<CORE::Int32>::min(),
+                    float64,
+                    std::numeric_limits<CORE::Int32>::max()) and
+                float64 == std::floor(float64);
+
+            if (status)
+            {
+                old_value.set_int32(static_cast<CORE::Int32>(float64));
+            }
+        }
+
+        return status;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The conversion plan for the EDCS 3.x attribute code, or 0 if
+    //          the code cannot be indexed.
+    //
+    ConversionPlan *get_plan(const FARM::AttributeCode &old_attribute_code)
+    {
+        ConversionPlan
+            *plan = 0;
+
+        if (CORE::ordered<FARM::AttributeCode>(
+            0, old_attribute_code, max_plan_code))
+        {
+            if (conversion_plans.size() <=
+                static_cast<std::size_t>(old_attribute_code))
+            {
+                conversion_plans.resize(old_attribute_code + 1);
+            }
+
+            plan = &conversion_plans[old_attribute_code];
+        }
+        else
+        {
+            LOG_WITH_STREAM(
+                high,
+                "The EDCS 3.x attribute code " << old_attribute_code <<
+                    " is out of range for a conversion plan.");
+        }
+
+        return plan;
+    }
+
+    // ------------------------------------------------------------------------
+    // Compiles the conversion of an EDCS 3.x attribute that is not an
+    // enumeration.
+    //
+    void compile_attribute_plan(
+        const FARM::AttributeCode &old_attribute_code,
+        const FARM::AttributeDataType &old_data_type,
+        const FARM::AttributeCode &new_attribute_code,
+        const FARM::AttributeDataType &new_data_type,
+        const FARM::AttributeLabel &new_attribute_label
+    )
+    {
+        ConversionPlan
+            *plan = get_plan(old_attribute_code);
+
+        if (plan)
+        {
+            plan->old_data_type = old_data_type;
+
+            if (old_data_type != FARM::enumeration)
+            {
+                plan->result.attribute_code =
+                    new_data_type == FARM::deleted ? -999 : new_attribute_code;
+                plan->result.value.set_data_type(new_data_type);
+                plan->result.mapping_flag = FARM::mapped;
+                plan->new_label = new_attribute_label;
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Compiles the conversion of an EDCS 3.x enumerant.
+    //
+    void compile_enumerant_plan(
+        const FARM::AttributeCode &old_attribute_code,
+        const FARM::EnumerantCode &old_enumerant_code,
+        const FARM::EnumerantLabel &old_enumerant_label,
+        const FARM::ConvertedValue &converted,
+        const FARM::AttributeLabel &new_attribute_label
+    )
+    {
+        ConversionPlan
+            *plan = get_plan(old_attribute_code);
+
+        if (plan)
+        {
+            plan->old_data_type = FARM::enumeration;
+
+            if (CORE::ordered<FARM::EnumerantCode>(
+                0, old_enumerant_code, max_plan_code))
+            {
+                if (plan->enumerants.size() <=
+                    static_cast<std::size_t>(old_enumerant_code))
+                {
+                    plan->enumerants.resize(
+                        old_enumerant_code + 1, unmapped_value());
+                    plan->enumerant_labels.resize(old_enumerant_code + 1);
+                }
+
+                plan->enumerants[old_enumerant_code] = converted;
+                plan->enumerant_labels[old_enumerant_code] =
+                    new_attribute_label;
+                plan->enumerant_codes.insert(
+                    EnumerantLabelsToCodes::value_type(
+                        old_enumerant_label, old_enumerant_code));
+            }
+            else
+            {
+                LOG_WITH_STREAM(
+                    high,
+                    "The EDCS 3.x enumerant code " << old_enumerant_code <<
+                        " is out of range for a conversion plan.");
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The down conversion plan for the EDCS 4.x attribute code, or 0
+    //          if the code cannot be indexed.
+    //
+    ReversePlan *get_reverse_plan(
+        const FARM::AttributeCode &new_attribute_code
+    )
+    {
+        ReversePlan
+            *plan = 0;
+
+        if (CORE::ordered<FARM::AttributeCode>(
+            0, new_attribute_code, max_plan_code))
+        {
+            if (reverse_plans.size() <=
+                static_cast<std::size_t>(new_attribute_code))
+            {
+                reverse_plans.resize(new_attribute_code + 1);
+            }
+
+            plan = &reverse_plans[new_attribute_code];
+        }
+        else
+        {
+            LOG_WITH_STREAM(
+                high,
+                "The EDCS 4.x attribute code " << new_attribute_code <<
+                    " is out of range for a down conversion plan.");
+        }
+
+        return plan;
+    }
+
+    // ------------------------------------------------------------------------
+    // Several EDCS 3.x values can convert to the same EDCS 4.x value.  So
+    // that the down conversion does not depend on the order of the mapping
+    // files, the lowest EDCS 3.x attribute code, then enumerant code, wins.
+    //
+    // Return:  Should the candidate replace the current EDCS 3.x value?
+    //
+    bool preferred_old_value(
+        const FARM::ConvertedValue &candidate,
+        const FARM::ConvertedValue &current
+    )
+    {
+        bool
+            preferred = current.mapping_flag != FARM::mapped;
+
+        if (not preferred)
+        {
+            if (candidate.attribute_code != current.attribute_code)
+            {
+                preferred = candidate.attribute_code < current.attribute_code;
+            }
+            else if (
+                candidate.value.get_data_type() == FARM::enumeration and
+                current.value.get_data_type() == FARM::enumeration)
+            {
+                preferred =
+                    candidate.value.get_enumerant() <
+                        current.value.get_enumerant();
+            }
+        }
+
+        return preferred;
+    }
+
+    // ------------------------------------------------------------------------
+    // Compiles the down conversion of an EDCS 4.x attribute whose values
+    // carry over from an EDCS 3.x attribute.
+    //
+    void compile_reverse_attribute_plan(
+        const FARM::AttributeCode &old_attribute_code,
+        const FARM::AttributeDataType &old_data_type,
+        const FARM::AttributeCode &new_attribute_code,
+        const FARM::AttributeDataType &new_data_type
+    )
+    {
+        if (old_data_type != FARM::enumeration and
+            old_data_type != FARM::no_data_type and
+            new_data_type != FARM::deleted and
+            new_data_type != FARM::no_data_type)
+        {
+            ReversePlan
+                *plan = get_reverse_plan(new_attribute_code);
+            FARM::ConvertedValue
+                old_value;
+
+            old_value.attribute_code = old_attribute_code;
+            old_value.mapping_flag = FARM::mapped;
+            old_value.value.set_data_type(old_data_type);
+
+            if (plan and preferred_old_value(old_value, plan->result))
+            {
+                plan->result = old_value;
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Compiles the down conversion of the EDCS 4.x value that an EDCS 3.x
+    // enumerant converts to.  Deleted enumerants have no down conversion.
+    //
+    void compile_reverse_enumerant_plan(
+        const FARM::AttributeCode &old_attribute_code,
+        const FARM::EnumerantCode &old_enumerant_code,
+        const FARM::AttributeCode &new_attribute_code,
+        const FARM::TypedValue &new_value
+    )
+    {
+        const FARM::AttributeDataType
+            new_data_type = new_value.get_data_type();
+
+        if (new_data_type != FARM::deleted and
+            new_data_type != FARM::no_data_type)
+        {
+            ReversePlan
+                *plan = get_reverse_plan(new_attribute_code);
+            FARM::ConvertedValue
+                old_value;
+
+            old_value.attribute_code = old_attribute_code;
+            old_value.mapping_flag = FARM::mapped;
+            old_value.value.set_enumerant(old_enumerant_code);
+
+            if (not plan)
+            {
+                // The code was out of range and has already been logged.
+            }
+            else if (new_data_type == FARM::enumeration)
+            {
+                const FARM::EnumerantCode
+                    new_enumerant_code = new_value.get_enumerant();
+
+                if (CORE::ordered<FARM::EnumerantCode>(
+                    0, new_enumerant_code, max_plan_code))
+                {
+                    if (plan->enumerants.size() <=
+                        static_cast<std::size_t>(new_enumerant_code))
+                    {
+                        plan->enumerants.resize(
+                            new_enumerant_code + 1, unmapped_value());
+                    }
+
+                    if (preferred_old_value(
+                        old_value, plan->enumerants[new_enumerant_code]))
+                    {
+                        plan->enumerants[new_enumerant_code] = old_value;
+                    }
+                }
+                else
+                {
+                    LOG_WITH_STREAM(
+                        high,
+                        "The EDCS 4.x enumerant code " << new_enumerant_code <<
+                            " is out of range for a down conversion plan.");
+                }
+            }
+            else
+            {
+                std::pair<ReverseValues::iterator, bool>
+                    inserted = plan->values.insert(
+                        ReverseValues::value_type(new_value, old_value));
+
+                if (not inserted.second and
+                    preferred_old_value(old_value, inserted.first->second))
+                {
+                    inserted.first->second = old_value;
+                }
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Builds the label filters from the mapping tables.
+    //
+    void build_label_filters(void)
+    {
+        old_feature_filter.reset(edcs_feature_map.size());
+
+        for (EDCSFeatureMapping::const_iterator
+            map_itr = edcs_feature_map.begin();
+            map_itr != edcs_feature_map.end();
+            ++map_itr)
+        {
+            old_feature_filter.add(map_itr->first);
+        }
+
+        old_attribute_filter.reset(old_attribute_labels_to_types.size());
+
+        for (FARM::AttributeLabelsToDataTypes::const_iterator
+            map_itr = old_attribute_labels_to_types.begin();
+            map_itr != old_attribute_labels_to_types.end();
+            ++map_itr)
+        {
+            old_attribute_filter.add(map_itr->first);
+        }
+
+        old_enumerant_filter.reset(edcs_attribute_value_map.size());
+
+        for (EDCSAttributeValueMapping::const_iterator
+            map_itr = edcs_attribute_value_map.begin();
+            map_itr != edcs_attribute_value_map.end();
+            ++map_itr)
+        {
+            old_enumerant_filter.add(map_itr->first.first, map_itr->first.second);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Empties the label filters.
+    //
+    void clear_label_filters(void)
+    {
+        old_feature_filter.clear();
+        old_attribute_filter.clear();
+        old_enumerant_filter.clear();
+    }
+
     // Forward declaring these debug functions so we can mark them to prevent
     // GCC from throwing a warning for them.
     void dump_edcs_value_map()  __attribute__ ((unused));
@@ -137,8 +747,6 @@ namespace
 
         int
             count = 1;
-        FARM::AttributeDataType
-            new_data_type;
 
         for (EDCSAttributeValueMapping::const_iterator
             map_itr = edcs_attribute_value_map.begin();
@@ -150,41 +758,12 @@ namespace
             AttributeValuePair
                 new_attribute_value = map_itr->second;
 
-            FARM::AttributeLabelsToDataTypes::iterator
-                datatype_map_iter =
-                    attribute_labels_to_types.find(new_attribute_value.first);
-
-            if (datatype_map_iter != attribute_labels_to_types.end())
-            {
-                new_data_type = datatype_map_iter->second;
-            }
-            else
-            {
-                // Could be a deleted type, in which case the new attribute label
-                // would not be available in the edcs_attribute_value_map (above).
-                // Use the old attribute label to get the data type.
-
-                FARM::AttributeLabelsToDataTypes::iterator
-                    datatype_map_iter2 =
-                        attribute_labels_to_types.find(old_attribute_value.first);
-
-                ASSERT(
-                    datatype_map_iter2 != attribute_labels_to_types.end(),
-                    fatal,
-                    "Could not get the data type for '" +
-                        new_attribute_value.first + "'.");
-
-                if (datatype_map_iter2 != attribute_labels_to_types.end())
-                {
-                    new_data_type = datatype_map_iter2->second;
-                }
-            }
-
             std::cout << count << ") [" << old_attribute_value.first << ", " ;
             std::cout << old_attribute_value.second;
-            std::cout << "], [" << new_attribute_value.first << ", " ;
+            std::cout << "], [" << new_attribute_value.attribute_label;
+            std::cout << ", ";
 
-            switch (new_data_type)
+            switch (new_attribute_value.value.get_data_type())
             {
                 case FARM::no_data_type:
                 {
@@ -194,31 +773,31 @@ namespace
 
                 case FARM::int32:
                 {
-                    std::cout << new_attribute_value.second.int32;
+                    std::cout << new_attribute_value.value.get_int32();
                     break;
                 }
 
                 case FARM::float64:
                 {
-                    std::cout << new_attribute_value.second.float64;
+                    std::cout << new_attribute_value.value.get_float64();
                     break;
                 }
 
                 case FARM::string:
                 {
-                    std::cout << new_attribute_value.second.str;
+                    std::cout << new_attribute_value.value.get_string();
                     break;
                 }
 
                 case FARM::enumeration:
                 {
-                    std::cout << new_attribute_value.second.enumeration;
+                    std::cout << new_attribute_value.value.get_enumerant();
                     break;
                 }
 
                 case FARM::boolean:
                 {
-                    std::cout << new_attribute_value.second.boolean;
+                    std::cout << new_attribute_value.value.get_boolean();
                     break;
                 }
 
@@ -253,6 +832,9 @@ namespace FARM
         const std::string &edcs_attrib_enum_mapping_filename
     )
     {
+        StartupTracePhase
+            phase("EDCSConverter::initialize");
+
         FeatureLabel
             old_feature_label,
             new_feature_label;
@@ -266,6 +848,14 @@ namespace FARM
             edcs_attribute_value_map.clear();
             old_attribute_labels_to_types.clear();
             attribute_labels_to_types.clear();
+            conversion_plans.clear();
+            old_attribute_labels_to_codes.clear();
+            old_enum_labels_to_codes.clear();
+            reverse_plans.clear();
+            old_attribute_codes_to_labels.clear();
+            old_enum_codes_to_labels.clear();
+            clear_label_filters();
+            mapping_strings.clear();
 
             // Read in Feature Label Mapping data and set up map
 
@@ -347,6 +937,10 @@ namespace FARM
                 old_data_type,
                 new_data_type;
 
+            AttributeCode
+                old_attribute_code,
+                new_attribute_code;
+
             std::string
                 old_data_type_string,
                 new_data_type_string;
@@ -392,6 +986,8 @@ namespace FARM
                 old_attribute_label = "";
                 new_attribute_label = "";
                 old_enumerant_label = "";
+                old_attribute_code = -999;
+                new_attribute_code = -999;
 
                 old_attribute_value =
                     AttributeEnumPair(old_attribute_label, old_enumerant_label);
@@ -400,6 +996,12 @@ namespace FARM
                     high,
                     "Unable to get entry from edcs attribute mapping");
 
+                // Get the old attribute code.
+                //
+                ASSERT(edcs_config_options_ptr->value(edcs_attribute_entry, 0, old_attribute_code),
+                    high,
+                    "Unable to get old attribute code from edcs attribute mapping entry");
+
                 // Get the old attribute data type.
                 //
                 ASSERT(edcs_config_options_ptr->value(edcs_attribute_entry, 1, old_data_type_string),
@@ -414,6 +1016,12 @@ namespace FARM
 
                 old_attribute_value.first = old_attribute_label;
 
+                // Get the new attribute code.
+                //
+                ASSERT(edcs_config_options_ptr->value(edcs_attribute_entry, 3, new_attribute_code),
+                    high,
+                    "Unable to get new attribute code from edcs attribute mapping entry");
+
                 // Get the new attribute data type.
                 //
                 ASSERT(edcs_config_options_ptr->value(edcs_attribute_entry, 4, new_data_type_string),
@@ -456,6 +1064,12 @@ namespace FARM
                 old_attribute_labels_to_types.insert(
                     AttributeLabelsToDataTypes::value_type(old_attribute_label, old_data_type));
 
+                old_attribute_labels_to_codes.insert(
+                    OldAttributeLabelsToCodes::value_type(old_attribute_label, old_attribute_code));
+
+                old_attribute_codes_to_labels.insert(
+                    std::make_pair(old_attribute_code, old_attribute_label));
+
                 // Store the attribute mappings except for those of enumeration type.
 
                 if (old_data_type != enumeration)
@@ -496,6 +1110,19 @@ namespace FARM
                         AttributeLabelsToDataTypes::value_type(
                             new_attribute_label, new_data_type));
                 }
+
+                compile_attribute_plan(
+                    old_attribute_code,
+                    old_data_type,
+                    new_attribute_code,
+                    new_data_type,
+                    new_attribute_label);
+
+                compile_reverse_attribute_plan(
+                    old_attribute_code,
+                    old_data_type,
+                    new_attribute_code,
+                    new_data_type);
             }
 
             //for debug
@@ -518,8 +1145,8 @@ namespace FARM
             AttributeValuePair
                 new_attribute_value;
 
-            AttributeDataValue
-                new_data_value;
+            ConvertedValue
+                converted_value;
             std::string
                 mapping_type,
                 tmp_string;
@@ -562,21 +1189,27 @@ namespace FARM
                 new_data_type_string = "";
                 tmp_string = "";
 
+                old_attribute_code = -999;
+                new_attribute_code = -999;
                 old_enumerant_code = -999;
                 new_enumerant_code = -999;
+                converted_value = unmapped_value();
 
                 mapping_type = "";
                 old_enumerant_label = "";
-                std::strcpy(new_data_value.enumeration, "");
-
                 old_attribute_value =
                     AttributeEnumPair(old_attribute_label, old_enumerant_label);
-                new_attribute_value =
-                    AttributeValuePair(new_attribute_label, new_data_value);
+                new_attribute_value = AttributeValuePair();
 
                 ASSERT(edcs_config_options_ptr->value(edcs_enum_table, i, edcs_enum_entry),
                     high,
-                    "Unable to get entry from edcs enum mapping");
+                    "Unable to get entry from edcs enum mapping");
+
+                // Get the old attribute code.
+                //
+                ASSERT(edcs_config_options_ptr->value(edcs_enum_entry, 0, old_attribute_code),
+                    high,
+                    "Unable to get old attribute code from edcs enum mapping entry");
 
                 // Get the old enumerant code.
                 //
@@ -615,6 +1248,12 @@ namespace FARM
                     high,
                     "Unable to get new data type from edcs enum mapping entry");
 
+                // Get the new attribute code.
+                //
+                ASSERT(edcs_config_options_ptr->value(edcs_enum_entry, 6, new_attribute_code),
+                    high,
+                    "Unable to get new attribute code from edcs enum mapping entry");
+
                 // Get the new enumerant code.
                 //
                 ASSERT(edcs_config_options_ptr->value(edcs_enum_entry, 7, new_enumerant_code),
@@ -627,7 +1266,7 @@ namespace FARM
                     high,
                     "Unable to get new attribute label from edcs enum mapping entry");
 
-                new_attribute_value.first = new_attribute_label;
+                new_attribute_value.attribute_label = new_attribute_label;
 
                 // Get the new attribute value (may have changed from enumerant
                 // to something else).
@@ -636,6 +1275,8 @@ namespace FARM
                 {
                     new_data_type = deleted;
                     new_attribute_label = old_attribute_label;
+
+                    converted_value.value.set_data_type(deleted);
                 }
                 else if (new_data_type_string == "ENUM" or new_data_type_string == "ENUMERATION")
                 {
@@ -646,10 +1287,9 @@ namespace FARM
                         high,
                         "Unable to get new enum label from edcs enum mapping entry");
 
-                    // store the label
-                    //
-                    std::strcpy(
-                        new_data_value.enumeration, tmp_string.c_str());
+                    converted_value.value.set_enumerant(new_enumerant_code);
+                    new_attribute_value.enumerant_label =
+                        mapping_strings.intern(tmp_string);
                 }
                 else if (new_data_type_string == "BOOLEAN" or new_data_type_string == "BOOL")
                 {
@@ -659,7 +1299,8 @@ namespace FARM
                         "Unable to get new enum label from edcs enum mapping entry");
 
                     new_data_type = boolean;
-                    new_data_value.boolean = (tmp_string == "TRUE" ? true : false);
+
+                    converted_value.value.set_boolean(tmp_string == "TRUE");
                 }
                 else if (new_data_type_string == "STRING" or new_data_type_string == "CONSTRAINED_STRING")
                 {
@@ -670,31 +1311,42 @@ namespace FARM
                         high,
                         "Unable to get new enum label from edcs enum mapping entry");
 
-                    std::strcpy(new_data_value.str, tmp_string.c_str());
+                    converted_value.value.set_string(
+                        mapping_strings.intern(tmp_string));
                 }
 
                 else if (new_data_type_string == "INTEGER")
                 {
+                    CORE::Int32
+                        new_int32 = 0;
+
                     new_data_type = int32;
 
                     ASSERT(
-                        edcs_config_options_ptr->value(edcs_enum_entry, 9, new_data_value.int32),
+                        edcs_config_options_ptr->value(edcs_enum_entry, 9, new_int32),
                         high,
                         "Unable to get new enum label from edcs enum mapping entry");
+
+                    converted_value.value.set_int32(new_int32);
                 }
                 else if (new_data_type_string == "REAL")
                 {
+                    CORE::Float64
+                        new_float64 = 0.0;
+
                     new_data_type = float64;
 
                     ASSERT_WITH_STREAM(
                         edcs_config_options_ptr->value(
-                            edcs_enum_entry, 9, new_data_value.float64),
+                            edcs_enum_entry, 9, new_float64),
                         high,
                         "Unable to get new enum label from edcs enum mapping "
                             "entry at row " << i << ".");
+
+                    converted_value.value.set_float64(new_float64);
                 }
 
-                new_attribute_value.second = new_data_value;
+                new_attribute_value.value = converted_value.value;
 
                 edcs_attribute_value_map.insert(
                     EDCSAttributeValueMapping::value_type(old_attribute_value, new_attribute_value));
@@ -706,6 +1358,33 @@ namespace FARM
 
                 attribute_labels_to_types.insert(
                     AttributeLabelsToDataTypes::value_type(new_attribute_label, new_data_type));
+
+                old_enum_labels_to_codes.insert(
+                    OldEnumerantLabelsToCodes::value_type(old_attribute_value, old_enumerant_code));
+
+                // Compile the conversion of the enumerant.
+                //
+                converted_value.attribute_code =
+                    new_data_type == deleted ? -999 : new_attribute_code;
+                converted_value.mapping_flag = mapped;
+
+                compile_enumerant_plan(
+                    old_attribute_code,
+                    old_enumerant_code,
+                    old_enumerant_label,
+                    converted_value,
+                    new_attribute_label);
+
+                compile_reverse_enumerant_plan(
+                    old_attribute_code,
+                    old_enumerant_code,
+                    new_attribute_code,
+                    converted_value.value);
+
+                old_enum_codes_to_labels.insert(
+                    OldEnumerantCodesToLabels::value_type(
+                        std::make_pair(old_attribute_code, old_enumerant_code),
+                        old_enumerant_label));
             }
 
             //for debug
@@ -720,6 +1399,8 @@ namespace FARM
             }
         }
 
+        build_label_filters();
+
         converter_initialized =
             edcs_feature_map.size() and
             edcs_attrib_with_enum_map.size() and
@@ -749,6 +1430,14 @@ namespace FARM
             edcs_attribute_value_map.clear();
             old_attribute_labels_to_types.clear();
             attribute_labels_to_types.clear();
+            conversion_plans.clear();
+            old_attribute_labels_to_codes.clear();
+            old_enum_labels_to_codes.clear();
+            reverse_plans.clear();
+            old_attribute_codes_to_labels.clear();
+            old_enum_codes_to_labels.clear();
+            clear_label_filters();
+            mapping_strings.clear();
 
             converter_initialized = false;
         }
@@ -760,19 +1449,23 @@ namespace FARM
         FeatureLabel &new_label
     )
     {
+        FARM_INSTRUMENT_CALL(convert_feature);
+
         bool
             status = false;
 
         // Get the new label from map
 
-        EDCSFeatureMapping::iterator
-            feature_map_iter = edcs_feature_map.find(old_label);
+        EDCSFeatureMapping::const_iterator
+            feature_map_iter = find_label(
+                old_feature_filter, edcs_feature_map, old_label);
 
         status = feature_map_iter != edcs_feature_map.end();
 
-        ASSERT(status,
+        ASSERT_WITH_STREAM(status,
             fatal,
-            "Could not get the new edcs feature label for '" + old_label + "'.");
+            "Could not get the new edcs feature label for '" << old_label <<
+                "'.");
 
         if (status)
         {
@@ -792,6 +1485,8 @@ namespace FARM
         AttributeDataValue &new_data_value
     )
     {
+        FARM_INSTRUMENT_CALL(convert_value);
+
         bool
             status = false;
 
@@ -811,11 +1506,11 @@ namespace FARM
 
         status = attrib_map_iter != edcs_attrib_with_enum_map.end();
 
-        ASSERT(status,
+        ASSERT_WITH_STREAM(status,
             fatal,
-            "Could not get the new edcs attribute label for [" +
-            old_attribute_value.first + ", " +
-            old_attribute_value.second + "].");
+            "Could not get the new edcs attribute label for [" <<
+            old_attribute_value.first << ", " <<
+            old_attribute_value.second << "].");
 
         if (status)
         {
@@ -828,9 +1523,10 @@ namespace FARM
 
             status = datatype_map_iter != attribute_labels_to_types.end();
 
-            ASSERT(status,
+            ASSERT_WITH_STREAM(status,
                 fatal,
-                "Could not get the new edcs datatype for '" + new_label + "'.");
+                "Could not get the new edcs datatype for '" << new_label <<
+                    "'.");
 
             if (status)
             {
@@ -844,19 +1540,38 @@ namespace FARM
                 {
                     // Lastly get the new data value from map
 
-                    EDCSAttributeValueMapping::iterator
-                        map_itr = edcs_attribute_value_map.find(old_attribute_value);
+                    EDCSAttributeValueMapping::const_iterator
+                        map_itr = find_label(
+                            old_enumerant_filter,
+                            edcs_attribute_value_map,
+                            old_attribute_value);
 
                     status = map_itr != edcs_attribute_value_map.end();
 
-                    ASSERT(status,
+                    ASSERT_WITH_STREAM(status,
                         fatal,
-                        "Could not get the new edcs attribute value for '[" +
-                            old_label + ", " + old_data_value + "]'.");
+                        "Could not get the new edcs attribute value for '[" <<
+                            old_label << ", " << old_data_value << "]'.");
 
-                    if (status)
+                    if (status and map_itr->second.enumerant_label)
                     {
-                        new_data_value = map_itr->second.second;
+                        // The label of the mapping file is returned as is.
+                        //
+                        const std::string
+                            &enumerant_label =
+                                *map_itr->second.enumerant_label;
+
+                        std::strncpy(
+                            new_data_value.enumeration,
+                            enumerant_label.c_str(),
+                            sizeof(new_data_value.enumeration) - 1);
+                        new_data_value.enumeration[
+                            sizeof(new_data_value.enumeration) - 1] = '\0';
+                    }
+                    else if (status)
+                    {
+                        status = to_legacy_value(
+                            new_label, map_itr->second.value, new_data_value);
                     }
                     else
                     {
@@ -869,14 +1584,486 @@ namespace FARM
         return status;
     }
 
+    // ------------------------------------------------------------------------
+    bool EDCSConverter::convert_value(
+        const AttributeLabel &old_label,
+        const EnumerantLabel &old_data_value,
+        MappingType &mapping_flag,
+        AttributeLabel &new_label,
+        TypedValue &new_value,
+        StringPool &strings
+    )
+    {
+        FARM_INSTRUMENT_CALL(convert_value);
+
+        const ConversionPlan
+            *plan = 0;
+        const AttributeLabel
+            *converted_label = 0;
+        AttributeCode
+            old_attribute_code = -999;
+        ConvertedValue
+            converted = unmapped_value();
+
+        verify_edcs_converter_initialization();
+
+        // The label is resolved to its code once, and the compiled plan of
+        // convert_values() is used from there.
+        //
+        if (get_3p1_attribute_code(old_label, old_attribute_code) and
+            static_cast<ConversionPlans::size_type>(old_attribute_code) <
+                conversion_plans.size())
+        {
+            plan = &conversion_plans[old_attribute_code];
+
+            if (plan->old_data_type != enumeration)
+            {
+                converted = plan->result;
+                converted_label = &plan->new_label;
+            }
+            else
+            {
+                const EnumerantLabelsToCodes::const_iterator
+                    code_itr = plan->enumerant_codes.find(old_data_value);
+
+                if (code_itr != plan->enumerant_codes.end())
+                {
+                    converted = plan->enumerants[code_itr->second];
+                    converted_label =
+                        &plan->enumerant_labels[code_itr->second];
+                }
+            }
+        }
+
+        mapping_flag = converted.mapping_flag;
+        new_value = converted.value;
+
+        bool
+            status = mapping_flag == mapped;
+
+        if (status)
+        {
+            new_label = *converted_label;
+
+            if (plan->old_data_type != enumeration)
+            {
+                // The value carries over, so it is read from the text in the
+                // new data type.
+                //
+                switch (new_value.get_data_type())
+                {
+                    case int32:
+                    {
+                        CORE::Int32
+                            int_value = 0;
+
+                        status = CORE::from_string(old_data_value, int_value);
+                        new_value.set_int32(int_value);
+                        break;
+                    }
+
+                    case float64:
+                    {
+                        CORE::Float64
+                            double_value = 0.0;
+
+                        status =
+                            CORE::from_string(old_data_value, double_value);
+                        new_value.set_float64(double_value);
+                        break;
+                    }
+
+                    case boolean:
+                    {
+                        status =
+                            old_data_value == "TRUE" or
+                            old_data_value == "FALSE";
+                        new_value.set_boolean(old_data_value == "TRUE");
+                        break;
+                    }
+
+                    case string:
+                    {
+                        new_value.set_string(strings.intern(old_data_value));
+                        break;
+                    }
+
+                    case enumeration:
+                    {
+                        EnumerantCode
+                            enumerant_code = -999;
+
+                        status = FeatureAttributeMapping::get_enumerant_code(
+                            new_label, old_data_value, enumerant_code);
+                        new_value.set_enumerant(enumerant_code);
+                        break;
+                    }
+
+                    default:
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+
+        return status;
+    }
+
+    // ------------------------------------------------------------------------
+    bool EDCSConverter::convert_values(
+        const OldAttributeValue *old_values,
+        int count,
+        ConvertedValue *new_values
+    )
+    {
+        FARM_INSTRUMENT_CALL(convert_values);
+
+        bool
+            all_mapped = true;
+
+        verify_edcs_converter_initialization();
+
+        const ConversionPlans::size_type
+            plan_count = conversion_plans.size();
+
+        for (int i = 0; i < count; ++i)
+        {
+            const OldAttributeValue
+                &old_value = old_values[i];
+            ConvertedValue
+                &new_value = new_values[i];
+
+            new_value = unmapped_value();
+
+            if (static_cast<ConversionPlans::size_type>(
+                old_value.attribute_code) < plan_count)
+            {
+                const ConversionPlan
+                    &plan = conversion_plans[old_value.attribute_code];
+
+                if (plan.old_data_type != enumeration)
+                {
+                    new_value = plan.result;
+                }
+                else if (
+                    static_cast<std::size_t>(old_value.enumerant_code) <
+                        plan.enumerants.size())
+                {
+                    new_value = plan.enumerants[old_value.enumerant_code];
+                }
+            }
+
+            all_mapped = all_mapped and new_value.mapping_flag == mapped;
+        }
+
+        return all_mapped;
+    }
+
+    // ------------------------------------------------------------------------
+    bool EDCSConverter::down_convert_values(
+        const NewAttributeValue *new_values,
+        int count,
+        ConvertedValue *old_values
+    )
+    {
+        FARM_INSTRUMENT_CALL(down_convert_values);
+
+        bool
+            all_mapped = true;
+
+        verify_edcs_converter_initialization();
+
+        const ReversePlans::size_type
+            plan_count = reverse_plans.size();
+
+        for (int i = 0; i < count; ++i)
+        {
+            const NewAttributeValue
+                &new_value = new_values[i];
+            ConvertedValue
+                &old_value = old_values[i];
+
+            old_value = unmapped_value();
+
+            if (static_cast<ReversePlans::size_type>(
+                new_value.attribute_code) < plan_count)
+            {
+                const ReversePlan
+                    &plan = reverse_plans[new_value.attribute_code];
+                const AttributeDataType
+                    new_data_type = new_value.value.get_data_type();
+
+                // Look for an EDCS 3.x enumerant first.
+                //
+                if (new_data_type == enumeration)
+                {
+                    const EnumerantCode
+                        new_enumerant_code = new_value.value.get_enumerant();
+
+                    if (static_cast<std::size_t>(new_enumerant_code) <
+                        plan.enumerants.size())
+                    {
+                        old_value = plan.enumerants[new_enumerant_code];
+                    }
+                }
+                else
+                {
+                    const ReverseValues::const_iterator
+                        value_itr = plan.values.find(new_value.value);
+
+                    if (value_itr != plan.values.end())
+                    {
+                        old_value = value_itr->second;
+                    }
+                }
+
+                // Otherwise the value carries over to the EDCS 3.x attribute
+                // if it can be converted to the EDCS 3.x data type.
+                //
+                if (old_value.mapping_flag != mapped and
+                    plan.result.mapping_flag == mapped)
+                {
+                    old_value = plan.result;
+
+                    if (not carry_over_value(
+                        new_value.value, old_value.value))
+                    {
+                        old_value = unmapped_value();
+                    }
+                }
+            }
+
+            all_mapped = all_mapped and old_value.mapping_flag == mapped;
+        }
+
+        return all_mapped;
+    }
+
+    // ------------------------------------------------------------------------
+    bool EDCSConverter::get_3p1_attribute_label(
+        const AttributeCode &old_code,
+        AttributeLabel &old_label
+    )
+    {
+        std::map<AttributeCode, AttributeLabel>::const_iterator
+            label_itr = old_attribute_codes_to_labels.find(old_code);
+
+        bool
+            status = label_itr != old_attribute_codes_to_labels.end();
+
+        if (status)
+        {
+            old_label = label_itr->second;
+        }
+
+        return status;
+    }
+
+    // ------------------------------------------------------------------------
+    bool EDCSConverter::get_3p1_enumerant_label(
+        const AttributeCode &old_attribute_code,
+        const EnumerantCode &old_enumerant_code,
+        EnumerantLabel &old_label
+    )
+    {
+        OldEnumerantCodesToLabels::const_iterator
+            label_itr = old_enum_codes_to_labels.find(
+                std::make_pair(old_attribute_code, old_enumerant_code));
+
+        bool
+            status = label_itr != old_enum_codes_to_labels.end();
+
+        if (status)
+        {
+            old_label = label_itr->second;
+        }
+
+        return status;
+    }
+
+    // ------------------------------------------------------------------------
+    bool EDCSConverter::to_legacy_value(
+        const AttributeLabel &attribute_label,
+        const TypedValue &value,
+        AttributeDataValue &legacy_value
+    )
+    {
+        bool
+            status = true;
+
+        switch (value.get_data_type())
+        {
+            case int32:
+            {
+                legacy_value.int32 = value.get_int32();
+                break;
+            }
+
+            case float64:
+            {
+                legacy_value.float64 = value.get_float64();
+                break;
+            }
+
+            case boolean:
+            {
+                legacy_value.boolean = value.get_boolean();
+                break;
+            }
+
+            case string:
+            {
+                std::strncpy(
+                    legacy_value.str,
+                    value.get_string().c_str(),
+                    sizeof(legacy_value.str) - 1);
+                legacy_value.str[sizeof(legacy_value.str) - 1] = '\0';
+                break;
+            }
+
+            case enumeration:
+            {
+                EnumerantLabel
+                    enumerant_label;
+
+                status = FeatureAttributeMapping::get_enumerant_label(
+                    attribute_label, value.get_enumerant(), enumerant_label);
+
+                std::strncpy(
+                    legacy_value.enumeration,
+                    enumerant_label.c_str(),
+                    sizeof(legacy_value.enumeration) - 1);
+                legacy_value.enumeration[
+                    sizeof(legacy_value.enumeration) - 1] = '\0';
+                break;
+            }
+
+            default:
+            {
+                status = false;
+                break;
+            }
+        }
+
+        return status;
+    }
+
+    // ------------------------------------------------------------------------
+    bool EDCSConverter::from_legacy_value(
+        const AttributeLabel &attribute_label,
+        const AttributeDataType &data_type,
+        const AttributeDataValue &legacy_value,
+        TypedValue &value,
+        StringPool &strings
+    )
+    {
+        bool
+            status = true;
+
+        switch (data_type)
+        {
+            case int32:
+            {
+                value.set_int32(legacy_value.int32);
+                break;
+            }
+
+            case float64:
+            {
+                value.set_float64(legacy_value.float64);
+                break;
+            }
+
+            case boolean:
+            {
+                value.set_boolean(legacy_value.boolean);
+                break;
+            }
+
+            case string:
+            {
+                value.set_string(strings.intern(legacy_value.str));
+                break;
+            }
+
+            case enumeration:
+            {
+                EnumerantCode
+                    enumerant_code = -999;
+
+                status = FeatureAttributeMapping::get_enumerant_code(
+                    attribute_label, legacy_value.enumeration, enumerant_code);
+
+                value.set_enumerant(enumerant_code);
+                break;
+            }
+
+            default:
+            {
+                value.set_data_type(data_type);
+                status = false;
+                break;
+            }
+        }
+
+        return status;
+    }
+
+    // ------------------------------------------------------------------------
+    bool EDCSConverter::get_3p1_attribute_code(
+        const AttributeLabel &old_label,
+        AttributeCode &old_code
+    )
+    {
+        OldAttributeLabelsToCodes::const_iterator
+            code_itr = find_label(
+                old_attribute_filter, old_attribute_labels_to_codes, old_label);
+
+        bool
+            status = code_itr != old_attribute_labels_to_codes.end();
+
+        if (status)
+        {
+            old_code = code_itr->second;
+        }
+
+        return status;
+    }
+
+    // ------------------------------------------------------------------------
+    bool EDCSConverter::get_3p1_enumerant_code(
+        const AttributeLabel &old_attribute_label,
+        const EnumerantLabel &old_enumerant_label,
+        EnumerantCode &old_code
+    )
+    {
+        OldEnumerantLabelsToCodes::const_iterator
+            code_itr = find_label(
+                old_enumerant_filter,
+                old_enum_labels_to_codes,
+                AttributeEnumPair(old_attribute_label, old_enumerant_label));
+
+        bool
+            status = code_itr != old_enum_labels_to_codes.end();
+
+        if (status)
+        {
+            old_code = code_itr->second;
+        }
+
+        return status;
+    }
+
     // ------------------------------------------------------------------------
     bool EDCSConverter::get_3p1_attribute_datatype(
         const AttributeLabel &old_label,
         AttributeDataType &old_datatype
     )
     {
-        AttributeLabelsToDataTypes::iterator
-            datatype_map_iter = old_attribute_labels_to_types.find(old_label);
+        AttributeLabelsToDataTypes::const_iterator
+            datatype_map_iter = find_label(
+                old_attribute_filter, old_attribute_labels_to_types, old_label);
 
         bool
             status = datatype_map_iter != old_attribute_labels_to_types.end();
@@ -889,6 +2076,16 @@ namespace FARM
         return status;
     }
 
+    // ------------------------------------------------------------------------
+    bool EDCSConverter::valid_old_feature(
+        const FeatureLabel &old_feature_label
+    )
+    {
+        return
+            find_label(old_feature_filter, edcs_feature_map, old_feature_label) !=
+                edcs_feature_map.end();
+    }
+
     // ------------------------------------------------------------------------
     bool EDCSConverter::valid_old_enum(
         const AttributeLabel &old_attribute_label,
@@ -898,12 +2095,26 @@ namespace FARM
         AttributeEnumPair
             old_attribute_value(old_attribute_label, old_enumerant_value);
 
-        EDCSAttributeValueMapping::iterator
-            map_itr = edcs_attribute_value_map.find(old_attribute_value);
+        EDCSAttributeValueMapping::const_iterator
+            map_itr = find_label(
+                old_enumerant_filter,
+                edcs_attribute_value_map,
+                old_attribute_value);
 
         return map_itr != edcs_attribute_value_map.end();
     }
 
+    // ------------------------------------------------------------------------
+    void EDCSConverter::get_label_filter_statistics(
+        std::vector<LabelFilterStatistics> &statistics
+    )
+    {
+        statistics.clear();
+        statistics.push_back(old_feature_filter.get_statistics());
+        statistics.push_back(old_attribute_filter.get_statistics());
+        statistics.push_back(old_enumerant_filter.get_statistics());
+    }
+
     // ------------------------------------------------------------------------
     void EDCSConverter::dump_attribute_labels_to_types(
         const AttributeLabelsToDataTypes &label_to_type_map
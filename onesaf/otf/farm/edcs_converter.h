@@ -21,6 +21,7 @@
 #include <fstream>
 #include <iostream>
 #include <list>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -28,11 +29,14 @@
 #include "farm_attribute.h"
 #include "farm_feature.h"
 #include "farm_enumerant.h"
+#include "farm_typed_value.h"
 #include "farm.h"
 
 namespace FARM
 {
-    // Stores the data value for an attribute.
+    // Stores the data value for an attribute.  Kept for the legacy
+    // convert_value(); new code should use the 16 byte TypedValue, which
+    // EDCSConverter::to_legacy_value() and from_legacy_value() convert.
     //
     union AttributeDataValue
     {
@@ -56,6 +60,44 @@ namespace FARM
     typedef std::map< FARM::AttributeLabel, FARM::AttributeDataType >
         AttributeLabelsToDataTypes;
 
+    // An EDCS 3.x attribute value to be converted in a batch.  The enumerant
+    // code is only used for EDCS 3.x enumerated attributes; the values of all
+    // other attributes carry over unchanged.
+    //
+    struct OldAttributeValue
+    {
+        AttributeCode
+            attribute_code;     // EDCS 3.x attribute code
+        EnumerantCode
+            enumerant_code;     // EDCS 3.x enumerant code (enumerations only)
+    };
+
+    // The compact result of converting an EDCS 3.x attribute value.  The
+    // data type of the value is the EDCS 4.x data type, which is deleted if
+    // the attribute was removed.  The value itself is only set when an EDCS
+    // 3.x enumerant is converted.
+    //
+    struct ConvertedValue
+    {
+        AttributeCode
+            attribute_code;     // EDCS 4.x attribute code (-999 if deleted)
+        MappingType
+            mapping_flag;       // Was a conversion found?
+        TypedValue
+            value;
+    };
+
+    // An EDCS 4.x attribute value to be down converted to EDCS 3.x in a
+    // batch.
+    //
+    struct NewAttributeValue
+    {
+        AttributeCode
+            attribute_code;     // EDCS 4.x attribute code
+        TypedValue
+            value;              // In the EDCS 4.x data type
+    };
+
     class EDCSConverter
     {
       public:
@@ -70,7 +112,8 @@ namespace FARM
             const std::string &edcs_attribute_mapping_filename,
             const std::string &edcs_attrib_enum_mapping_filename);
 
-        // Releases any memory that was allocated for the edcs converter .
+        // Releases any memory that was allocated for the edcs converter ,
+        // including the strings that converted values point to.
         //
         static void destroy(void);
 
@@ -99,6 +142,116 @@ namespace FARM
             AttributeDataValue &new_data_value
         );
 
+        // Convert EDCS 3.x farm attribute value to a typed EDCS 4.x farm
+        // attribute value.  Unlike the legacy convert_value(), nothing is
+        // asserted; values of attributes that are not enumerations are read
+        // from the text in the EDCS 4.x data type.  The labels are resolved
+        // to codes and converted with the plans of convert_values().  A
+        // string that carries over is interned in the given pool; a string
+        // that an enumerant converts to stays valid until destroy().
+        //
+        // Return:  Was the value converted?
+        //
+        static bool convert_value(
+            const AttributeLabel &old_label,
+            const EnumerantLabel &old_data_value,
+            MappingType &mapping_flag,
+            AttributeLabel &new_label,
+            TypedValue &new_value,
+            StringPool &strings
+        );
+
+        // Converts a batch of EDCS 3.x attribute values using the conversion
+        // plans that were compiled by initialize().  Values without a
+        // conversion are flagged not_mapped instead of being reported one at
+        // a time.  String values point into the strings of the mapping
+        // files, which stay valid until destroy().
+        //
+        // Return:  Were all of the values mapped?
+        //
+        static bool convert_values(
+            const OldAttributeValue *old_values,
+            int count,
+            ConvertedValue *new_values
+        );
+
+        // Converts a batch of EDCS 4.x attribute values back to EDCS 3.x for
+        // federates that still use EDCS 3.x.  The results use the EDCS 3.x
+        // attribute codes and data types, and EDCS 3.x enumerants are
+        // returned as enumerant codes.  When several EDCS 3.x values convert
+        // to the same EDCS 4.x value, the lowest EDCS 3.x attribute code and
+        // then enumerant code is returned.  Values that carry over are
+        // converted to the EDCS 3.x data type.  Values that only came from
+        // deleted mappings, or that cannot be converted to the EDCS 3.x data
+        // type, are flagged not_mapped.
+        //
+        // Return:  Were all of the values mapped?
+        //
+        static bool down_convert_values(
+            const NewAttributeValue *new_values,
+            int count,
+            ConvertedValue *old_values
+        );
+
+        // Converts a typed value of an EDCS 4.x attribute to the legacy
+        // union, looking up the label of an enumerant.
+        //
+        // Return:  Was the value converted?
+        //
+        static bool to_legacy_value(
+            const AttributeLabel &attribute_label,
+            const TypedValue &value,
+            AttributeDataValue &legacy_value
+        );
+
+        // Converts the legacy union of an EDCS 4.x attribute to a typed
+        // value, looking up the code of an enumerant.  A string is interned
+        // in the given pool.
+        //
+        // Return:  Was the value converted?
+        //
+        static bool from_legacy_value(
+            const AttributeLabel &attribute_label,
+            const AttributeDataType &data_type,
+            const AttributeDataValue &legacy_value,
+            TypedValue &value,
+            StringPool &strings
+        );
+
+        // Returns the EDCS 3.x attribute code for the given EDCS 3.x
+        // attribute label.
+        //
+        static bool get_3p1_attribute_code(
+            const AttributeLabel &old_label,
+            AttributeCode &old_code
+        );
+
+        // Returns the EDCS 3.x attribute label for the given EDCS 3.x
+        // attribute code.
+        //
+        static bool get_3p1_attribute_label(
+            const AttributeCode &old_code,
+            AttributeLabel &old_label
+        );
+
+        // Returns the EDCS 3.x enumerant label for the given EDCS 3.x
+        // attribute and enumerant codes.
+        //
+        static bool get_3p1_enumerant_label(
+            const AttributeCode &old_attribute_code,
+            const EnumerantCode &old_enumerant_code,
+            EnumerantLabel &old_label
+        );
+
+        // Returns the EDCS 3.x enumerant code for the given EDCS 3.x
+        // attribute and enumerant labels.
+        //
+        static bool get_3p1_enumerant_code(
+            const AttributeLabel &old_attribute_label,
+            const EnumerantLabel &old_enumerant_label,
+            EnumerantCode &old_code
+        );
+
         // Returns the respective EDCS 3.x attribute datatype for the given
         // EDCS 3.x attribute label.
         //
@@ -107,6 +260,12 @@ namespace FARM
             AttributeDataType &old_datatype
         );
 
+        // Checks to see if a mapping exists for an EDCS 3.x farm feature.
+        //
+        static bool valid_old_feature(
+            const FeatureLabel &old_feature_label
+        );
+
         // Checks to see if a mapping exists for an EDCS 3.x farm attribute,
         // enum pair
         //
@@ -115,6 +274,14 @@ namespace FARM
             const EnumerantLabel &old_enumerant_value
         );
 
+        // Returns the counters of the filters that reject unknown EDCS 3.x
+        // feature, attribute, and enumerant labels before the mapping tables
+        // are searched.
+        //
+        static void get_label_filter_statistics(
+            std::vector<LabelFilterStatistics> &statistics
+        );
+
         // Dumps attribute label to attribute data type mappings
         //
         static void dump_attribute_labels_to_types(
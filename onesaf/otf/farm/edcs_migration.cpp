@@ -0,0 +1,1392 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "core/core_string.h"
+#include "core/directory_parser.h"
+#include "core/logger.h"
+#include "edcs_converter.h"
+#include "edcs_migration.h"
+#include "farm.h"
+
+namespace
+{
+    typedef std::chrono::steady_clock
+        Clock;
+
+    // A single attribute value of an EDCS 3.x record.
+    //
+    struct RecordValue
+    {
+        FARM::AttributeLabel
+            old_label;
+        std::string
+            text;               // The value as it was read
+        bool
+            from_enumerant;     // Was the value an EDCS 3.x enumerant?
+        FARM::ConvertedValue
+            converted;
+    };
+
+    // A feature record as it flows through the pipeline.
+    //
+    struct MigrationRecord
+    {
+        CORE::Int64
+            line;
+        std::string
+            text;               // The original line for the reject log
+        FARM::FeatureLabel
+            feature_label;      // EDCS 3.x label until it is converted
+        FARM::FeatureGeometry
+            geometry;
+        std::vector<RecordValue>
+            values;
+        bool
+            rejected;
+        FARM::FeatureCategory
+            feature_category;
+        std::vector<char>
+            overlay;
+        std::vector<std::pair<FARM::AttributeOffset, std::string> >
+            strings;
+    };
+
+    // A batch of records from one input file.  The batches of a file are
+    // numbered so that the writer can restore their order.
+    //
+    struct RecordBatch
+    {
+        RecordBatch(void) :
+            chunk(0),
+            sequence(0),
+            last(false),
+            values_converted(0),
+            values_deleted(0),
+            values_rejected(0)
+        {
+        }
+
+        int
+            chunk;              // Index of the input file
+        CORE::Int64
+            sequence;
+        bool
+            last;               // Is this the last batch of the input file?
+        std::vector<MigrationRecord>
+            records;
+        std::vector<std::string>
+            rejects;            // Lines for the reject log
+        CORE::Int64
+            values_converted,
+            values_deleted,
+            values_rejected;
+    };
+
+    // ------------------------------------------------------------------------
+    // A queue between two pipeline stages.  push() blocks while the queue is
+    // full, which holds back the producing stage.  pop() fails once every
+    // producer is done and the queue has been drained.
+    //
+    template <class T>
+    class BoundedQueue
+    {
+      public:
+        BoundedQueue(std::size_t capacity, int producers) :
+            capacity(std::max<std::size_t>(1, capacity)),
+            producers(producers)
+        {
+        }
+
+        void push(const T &item)
+        {
+            std::unique_lock<std::mutex>
+                lock(mutex);
+
+            while (items.size() >= capacity)
+            {
+                not_full.wait(lock);
+            }
+
+            items.push_back(item);
+            not_empty.notify_one();
+        }
+
+        bool pop(T &item)
+        {
+            std::unique_lock<std::mutex>
+                lock(mutex);
+
+            while (items.empty() and 0 < producers)
+            {
+                not_empty.wait(lock);
+            }
+
+            bool
+                successful = not items.empty();
+
+            if (successful)
+            {
+                item = items.front();
+                items.pop_front();
+                not_full.notify_one();
+            }
+
+            return successful;
+        }
+
+        void producer_done(void)
+        {
+            std::lock_guard<std::mutex>
+                lock(mutex);
+
+            --producers;
+            not_empty.notify_all();
+        }
+
+      private:
+        std::mutex
+            mutex;
+        std::condition_variable
+            not_empty,
+            not_full;
+        std::deque<T>
+            items;
+        std::size_t
+            capacity;
+        int
+            producers;
+    };
+
+    typedef BoundedQueue<RecordBatch *>
+        BatchQueue;
+
+    // Throughput counters of a pipeline stage.
+    //
+    struct StageCounter
+    {
+        StageCounter(void) : records(0), busy_nanoseconds(0) {}
+
+        std::atomic<CORE::Int64>
+            records,
+            busy_nanoseconds;
+    };
+
+    // ------------------------------------------------------------------------
+    // Adds the time since the start to the stage counter.
+    //
+    void add_busy_time(StageCounter &counter, const Clock::time_point &start)
+    {
+        counter.busy_nanoseconds +=
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now() - start).count();
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The reject log line for a record.
+    //
+    std::string reject_line(
+        const std::string &input_file,
+        const MigrationRecord &record,
+        const std::string &reason
+    )
+    {
+        std::ostringstream
+            stream;
+
+        stream << input_file << ":" << record.line << "\t" << reason << "\t" <<
+            record.text;
+
+        return stream.str();
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The file name without its directory.
+    //
+    std::string base_name(const std::string &file_name)
+    {
+        const std::string::size_type
+            slash = file_name.find_last_of("/\\");
+
+        return slash == std::string::npos ?
+            file_name :
+            file_name.substr(slash + 1);
+    }
+
+    // ------------------------------------------------------------------------
+    // Splits a line into its tab separated fields.
+    //
+    void split_fields(const std::string &line, std::vector<std::string> &fields)
+    {
+        std::string::size_type
+            start = 0,
+            tab;
+
+        fields.clear();
+
+        do
+        {
+            tab = line.find('\t', start);
+
+            fields.push_back(line.substr(
+                start,
+                tab == std::string::npos ? std::string::npos : tab - start));
+
+            start = tab + 1;
+        }
+        while (tab != std::string::npos);
+    }
+
+    // ------------------------------------------------------------------------
+    // Parses a record from a line of an input file.
+    //
+    // Return:  The reason the record could not be parsed, or an empty string.
+    //
+    std::string parse_record(MigrationRecord &record)
+    {
+        std::vector<std::string>
+            fields;
+        std::string
+            reason;
+
+        split_fields(record.text, fields);
+
+        if (fields.size() < 2 or fields[0].empty())
+        {
+            reason = "missing the feature label or geometry";
+        }
+        else
+        {
+            record.feature_label = fields[0];
+
+            if (fields[1] == "POINT")
+            {
+                record.geometry = FARM::point;
+            }
+            else if (fields[1] == "LINE")
+            {
+                record.geometry = FARM::linear;
+            }
+            else if (fields[1] == "AREA")
+            {
+                record.geometry = FARM::areal;
+            }
+            else
+            {
+                reason = "unknown geometry '" + fields[1] + "'";
+            }
+
+            for (std::vector<std::string>::size_type i = 2;
+                reason.empty() and i < fields.size();
+                ++i)
+            {
+                const std::string::size_type
+                    equals = fields[i].find('=');
+
+                if (equals == std::string::npos or equals == 0)
+                {
+                    reason = "malformed attribute value '" + fields[i] + "'";
+                }
+                else
+                {
+                    RecordValue
+                        value;
+
+                    value.old_label = fields[i].substr(0, equals);
+                    value.text = fields[i].substr(equals + 1);
+                    value.from_enumerant = false;
+
+                    record.values.push_back(value);
+                }
+            }
+        }
+
+        return reason;
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes a value into the overlay.
+    //
+    template <class T>
+    void put_value(
+        std::vector<char> &overlay,
+        const FARM::AttributeOffset &offset,
+        const T &value
+    )
+    {
+        if (0 <= offset and
+            offset + sizeof(T) <= overlay.size())
+        {
+            std::memcpy(&overlay[offset], &value, sizeof(T));
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Builds the overlay of a feature category that holds the FARM default
+    // for every attribute.
+    //
+    void build_default_overlay(
+        const FARM::FeatureCategory &feature_category,
+        std::vector<char> &overlay
+    )
+    {
+        int
+            overlay_size = 0;
+        std::list<FARM::AttributeCategory>
+            attribute_categories;
+
+        FARM::FeatureAttributeMapping::get_attributes_overlay_size(
+            feature_category, overlay_size);
+
+        overlay.assign(std::max(0, overlay_size), 0);
+
+        FARM::FeatureAttributeMapping::get_attribute_categories(
+            feature_category, attribute_categories);
+
+        for (std::list<FARM::AttributeCategory>::const_iterator
+            attr_itr = attribute_categories.begin();
+            attr_itr != attribute_categories.end();
+            ++attr_itr)
+        {
+            FARM::AttributeDataType
+                data_type = FARM::no_data_type;
+            FARM::AttributeOffset
+                offset = 0;
+
+            if (not FARM::FeatureAttributeMapping::get_data_type(
+                    *attr_itr, data_type) or
+                not FARM::FeatureAttributeMapping::get_attribute_offset(
+                    feature_category, *attr_itr, offset))
+            {
+                continue;
+            }
+
+            switch (data_type)
+            {
+                case FARM::int32:
+                {
+                    int
+                        value = 0;
+
+                    FARM::FeatureAttributeMapping::get_default(
+                        feature_category, *attr_itr, value);
+                    put_value(overlay, offset, static_cast<CORE::Int32>(value));
+                    break;
+                }
+
+                case FARM::float64:
+                {
+                    double
+                        value = 0.0;
+
+                    FARM::FeatureAttributeMapping::get_default(
+                        feature_category, *attr_itr, value);
+                    put_value(overlay, offset, static_cast<CORE::Float64>(value));
+                    break;
+                }
+
+                case FARM::boolean:
+                {
+                    bool
+                        value = false;
+
+                    FARM::FeatureAttributeMapping::get_default(
+                        feature_category, *attr_itr, value);
+                    put_value(overlay, offset, static_cast<CORE::Int32>(value));
+                    break;
+                }
+
+                case FARM::enumeration:
+                {
+                    FARM::Enumerant
+                        value;
+
+                    if (FARM::FeatureAttributeMapping::get_default(
+                        feature_category, *attr_itr, value))
+                    {
+                        put_value(
+                            overlay,
+                            offset,
+                            static_cast<CORE::Int32>(value.get_ea_code()));
+                        put_value(
+                            overlay,
+                            offset + static_cast<FARM::AttributeOffset>(
+                                sizeof(CORE::Int32)),
+                            static_cast<CORE::Int32>(value.get_ee_code()));
+                    }
+                    break;
+                }
+
+                case FARM::string:
+                {
+                    put_value(overlay, offset, static_cast<CORE::Int32>(-1));
+                    break;
+                }
+
+                default:
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // The state that is shared by the stages of a migration.
+    //
+    class Pipeline
+    {
+      public:
+        Pipeline(const FARM::MigrationOptions &options) :
+            options(options),
+            batch_size(std::max(1, options.batch_size)),
+            next_input_file(0),
+            successful(true)
+        {
+        }
+
+        void parse_stage(BatchQueue &output);
+        void convert_stage(BatchQueue &input, BatchQueue &output);
+        void validate_stage(BatchQueue &input, BatchQueue &output);
+        void write_stage(BatchQueue &input, FARM::MigrationReport &report);
+
+        const FARM::MigrationOptions
+            &options;
+        const int
+            batch_size;
+        std::atomic<int>
+            next_input_file;
+        std::atomic<bool>
+            successful;
+        StageCounter
+            parse_counter,
+            convert_counter,
+            validate_counter,
+            write_counter;
+
+      private:
+        void reject_value(
+            RecordBatch &batch,
+            const MigrationRecord &record,
+            const RecordValue &value,
+            const std::string &reason);
+
+        bool set_value(
+            const MigrationRecord &record,
+            const RecordValue &value,
+            const FARM::AttributeOffset &offset,
+            std::vector<char> &overlay,
+            std::vector<std::pair<FARM::AttributeOffset, std::string> >
+                &strings,
+            std::string &reason);
+    };
+
+    // ------------------------------------------------------------------------
+    void Pipeline::reject_value(
+        RecordBatch &batch,
+        const MigrationRecord &record,
+        const RecordValue &value,
+        const std::string &reason
+    )
+    {
+        ++batch.values_rejected;
+
+        batch.rejects.push_back(reject_line(
+            options.input_files[batch.chunk],
+            record,
+            reason + " for " + value.old_label + "=" + value.text));
+    }
+
+    // ------------------------------------------------------------------------
+    // Reads the input files and splits them into batches of records.
+    //
+    void Pipeline::parse_stage(BatchQueue &output)
+    {
+        int
+            chunk;
+
+        while ((chunk = next_input_file++) <
+            static_cast<int>(options.input_files.size()))
+        {
+            Clock::time_point
+                start = Clock::now();
+            std::ifstream
+                input(options.input_files[chunk].c_str());
+            std::string
+                line;
+            CORE::Int64
+                line_number = 0,
+                sequence = 0;
+            RecordBatch
+                *batch = new RecordBatch();
+
+            batch->chunk = chunk;
+
+            if (not input.is_open())
+            {
+                successful = false;
+
+                batch->rejects.push_back(
+                    options.input_files[chunk] + "\tcould not be opened");
+            }
+
+            while (std::getline(input, line))
+            {
+                ++line_number;
+
+                if (not line.empty() and line[line.size() - 1] == '\r')
+                {
+                    line.erase(line.size() - 1);
+                }
+
+                if (line.empty() or line[0] == '#')
+                {
+                    continue;
+                }
+
+                batch->records.push_back(MigrationRecord());
+
+                MigrationRecord
+                    &record = batch->records.back();
+
+                record.line = line_number;
+                record.text = line;
+                record.rejected = false;
+                record.feature_category = -1;
+
+                const std::string
+                    reason = parse_record(record);
+
+                if (not reason.empty())
+                {
+                    record.rejected = true;
+                    batch->rejects.push_back(reject_line(
+                        options.input_files[chunk], record, reason));
+                }
+
+                ++parse_counter.records;
+
+                if (static_cast<int>(batch->records.size()) == batch_size)
+                {
+                    batch->sequence = sequence++;
+
+                    add_busy_time(parse_counter, start);
+                    output.push(batch);
+                    start = Clock::now();
+
+                    batch = new RecordBatch();
+                    batch->chunk = chunk;
+                }
+            }
+
+            // The last batch is always sent, even if it is empty, so that the
+            // writer knows the input file is complete.
+            //
+            batch->sequence = sequence;
+            batch->last = true;
+
+            add_busy_time(parse_counter, start);
+            output.push(batch);
+        }
+
+        output.producer_done();
+    }
+
+    // ------------------------------------------------------------------------
+    // Converts the features and attribute values of the records to EDCS 4.x.
+    // The values of a whole batch are converted with a single call to
+    // EDCSConverter::convert_values().
+    //
+    void Pipeline::convert_stage(BatchQueue &input, BatchQueue &output)
+    {
+        RecordBatch
+            *batch = 0;
+        std::vector<FARM::OldAttributeValue>
+            old_values;
+        std::vector<FARM::ConvertedValue>
+            new_values;
+
+        while (input.pop(batch))
+        {
+            const Clock::time_point
+                start = Clock::now();
+
+            old_values.clear();
+
+            for (std::vector<MigrationRecord>::iterator
+                record_itr = batch->records.begin();
+                record_itr != batch->records.end();
+                ++record_itr)
+            {
+                if (record_itr->rejected)
+                {
+                    continue;
+                }
+
+                if (not FARM::EDCSConverter::valid_old_feature(
+                    record_itr->feature_label))
+                {
+                    record_itr->rejected = true;
+                    batch->rejects.push_back(reject_line(
+                        options.input_files[batch->chunk],
+                        *record_itr,
+                        "unmapped feature " + record_itr->feature_label));
+                    continue;
+                }
+
+                FARM::EDCSConverter::convert_feature(
+                    record_itr->feature_label, record_itr->feature_label);
+
+                for (std::vector<RecordValue>::iterator
+                    value_itr = record_itr->values.begin();
+                    value_itr != record_itr->values.end();
+                    ++value_itr)
+                {
+                    FARM::OldAttributeValue
+                        old_value;
+                    FARM::AttributeDataType
+                        old_data_type = FARM::no_data_type;
+
+                    old_value.attribute_code = -999;
+                    old_value.enumerant_code = -999;
+
+                    if (FARM::EDCSConverter::get_3p1_attribute_code(
+                            value_itr->old_label, old_value.attribute_code) and
+                        FARM::EDCSConverter::get_3p1_attribute_datatype(
+                            value_itr->old_label, old_data_type) and
+                        old_data_type == FARM::enumeration)
+                    {
+                        value_itr->from_enumerant = true;
+
+                        FARM::EDCSConverter::get_3p1_enumerant_code(
+                            value_itr->old_label,
+                            value_itr->text,
+                            old_value.enumerant_code);
+                    }
+
+                    old_values.push_back(old_value);
+                }
+            }
+
+            new_values.resize(old_values.size());
+
+            if (not old_values.empty())
+            {
+                FARM::EDCSConverter::convert_values(
+                    &old_values[0],
+                    static_cast<int>(old_values.size()),
+                    &new_values[0]);
+            }
+
+            // Hand the converted values back to their records.  Values of
+            // deleted attributes are dropped and unmapped values rejected.
+            //
+            std::vector<FARM::ConvertedValue>::const_iterator
+                new_value_itr = new_values.begin();
+
+            for (std::vector<MigrationRecord>::iterator
+                record_itr = batch->records.begin();
+                record_itr != batch->records.end();
+                ++record_itr)
+            {
+                if (record_itr->rejected)
+                {
+                    continue;
+                }
+
+                std::vector<RecordValue>
+                    converted_values;
+
+                for (std::vector<RecordValue>::iterator
+                    value_itr = record_itr->values.begin();
+                    value_itr != record_itr->values.end();
+                    ++value_itr, ++new_value_itr)
+                {
+                    if (new_value_itr->mapping_flag != FARM::mapped)
+                    {
+                        reject_value(
+                            *batch, *record_itr, *value_itr, "unmapped value");
+                    }
+                    else if (new_value_itr->value.get_data_type() == FARM::deleted)
+                    {
+                        ++batch->values_deleted;
+                    }
+                    else
+                    {
+                        value_itr->converted = *new_value_itr;
+                        converted_values.push_back(*value_itr);
+                    }
+                }
+
+                record_itr->values.swap(converted_values);
+            }
+
+            convert_counter.records +=
+                static_cast<CORE::Int64>(batch->records.size());
+            add_busy_time(convert_counter, start);
+
+            output.push(batch);
+        }
+
+        output.producer_done();
+    }
+
+    // ------------------------------------------------------------------------
+    // Sets a converted value in the overlay of a record.
+    //
+    // Return:  Was the value valid for the feature?
+    //
+    bool Pipeline::set_value(
+        const MigrationRecord &record,
+        const RecordValue &value,
+        const FARM::AttributeOffset &offset,
+        std::vector<char> &overlay,
+        std::vector<std::pair<FARM::AttributeOffset, std::string> > &strings,
+        std::string &reason
+    )
+    {
+        const FARM::FeatureCategory
+            &feature_category = record.feature_category;
+        const FARM::AttributeCategory
+            &attribute_category = value.converted.attribute_code;
+        bool
+            successful = true;
+
+        switch (value.converted.value.get_data_type())
+        {
+            case FARM::int32:
+            {
+                int
+                    int_value =
+                        value.from_enumerant ?
+                            value.converted.value.get_int32() :
+                            0;
+
+                successful =
+                    (value.from_enumerant or
+                        CORE::from_string(value.text, int_value)) and
+                    FARM::FeatureAttributeMapping::valid_attribute(
+                        feature_category, attribute_category, int_value);
+
+                if (successful)
+                {
+                    put_value(
+                        overlay, offset, static_cast<CORE::Int32>(int_value));
+                }
+                break;
+            }
+
+            case FARM::float64:
+            {
+                double
+                    double_value =
+                        value.from_enumerant ?
+                            value.converted.value.get_float64() :
+                            0.0;
+
+                successful =
+                    (value.from_enumerant or
+                        CORE::from_string(value.text, double_value)) and
+                    FARM::FeatureAttributeMapping::valid_attribute(
+                        feature_category, attribute_category, double_value);
+
+                if (successful)
+                {
+                    put_value(
+                        overlay,
+                        offset,
+                        static_cast<CORE::Float64>(double_value));
+                }
+                break;
+            }
+
+            case FARM::boolean:
+            {
+                bool
+                    bool_value =
+                        value.from_enumerant and
+                        value.converted.value.get_boolean();
+
+                if (not value.from_enumerant)
+                {
+                    successful =
+                        value.text == "TRUE" or value.text == "FALSE" or
+                        value.text == "1" or value.text == "0";
+                    bool_value = value.text == "TRUE" or value.text == "1";
+                }
+
+                successful =
+                    successful and
+                    FARM::FeatureAttributeMapping::valid_attribute(
+                        feature_category, attribute_category, bool_value);
+
+                if (successful)
+                {
+                    put_value(
+                        overlay, offset, static_cast<CORE::Int32>(bool_value));
+                }
+                break;
+            }
+
+            case FARM::enumeration:
+            {
+                FARM::EnumerantCode
+                    enumerant_code =
+                        value.from_enumerant ?
+                            value.converted.value.get_enumerant() :
+                            -999;
+
+                if (not value.from_enumerant)
+                {
+                    // The EDCS 4.x attribute became an enumeration, so the
+                    // text has to be an EDCS 4.x enumerant label.
+                    //
+                    FARM::AttributeLabel
+                        attribute_label;
+
+                    successful =
+                        FARM::FeatureAttributeMapping::get_attribute_label(
+                            attribute_category, attribute_label) and
+                        FARM::FeatureAttributeMapping::get_enumerant_code(
+                            attribute_label, value.text, enumerant_code);
+                }
+
+                successful =
+                    successful and
+                    FARM::FeatureAttributeMapping::valid_enumerant(
+                        feature_category, attribute_category, enumerant_code);
+
+                if (successful)
+                {
+                    put_value(
+                        overlay,
+                        offset,
+                        static_cast<CORE::Int32>(attribute_category));
+                    put_value(
+                        overlay,
+                        offset + static_cast<FARM::AttributeOffset>(
+                            sizeof(CORE::Int32)),
+                        static_cast<CORE::Int32>(enumerant_code));
+                }
+                break;
+            }
+
+            case FARM::string:
+            {
+                put_value(
+                    overlay, offset, static_cast<CORE::Int32>(strings.size()));
+
+                strings.push_back(std::make_pair(
+                    offset,
+                    value.from_enumerant ?
+                        value.converted.value.get_string() :
+                        value.text));
+                break;
+            }
+
+            default:
+            {
+                successful = false;
+                break;
+            }
+        }
+
+        if (not successful)
+        {
+            reason = "value is not valid for the feature";
+        }
+
+        return successful;
+    }
+
+    // ------------------------------------------------------------------------
+    // Validates the records against the FARM and builds their overlays.
+    //
+    void Pipeline::validate_stage(BatchQueue &input, BatchQueue &output)
+    {
+        RecordBatch
+            *batch = 0;
+        std::map<FARM::FeatureCategory, std::vector<char> >
+            default_overlays;   // Built the first time a category is seen
+
+        while (input.pop(batch))
+        {
+            const Clock::time_point
+                start = Clock::now();
+
+            for (std::vector<MigrationRecord>::iterator
+                record_itr = batch->records.begin();
+                record_itr != batch->records.end();
+                ++record_itr)
+            {
+                if (record_itr->rejected)
+                {
+                    continue;
+                }
+
+                if (not FARM::FeatureAttributeMapping::get_feature_category(
+                    record_itr->feature_label,
+                    record_itr->geometry,
+                    record_itr->feature_category))
+                {
+                    record_itr->rejected = true;
+                    batch->rejects.push_back(reject_line(
+                        options.input_files[batch->chunk],
+                        *record_itr,
+                        "feature " + record_itr->feature_label +
+                            " is not in the FARM"));
+                    continue;
+                }
+
+                std::map<FARM::FeatureCategory, std::vector<char> >::iterator
+                    default_itr =
+                        default_overlays.find(record_itr->feature_category);
+
+                if (default_itr == default_overlays.end())
+                {
+                    default_itr = default_overlays.insert(std::make_pair(
+                        record_itr->feature_category,
+                        std::vector<char>())).first;
+
+                    build_default_overlay(
+                        record_itr->feature_category, default_itr->second);
+                }
+
+                record_itr->overlay = default_itr->second;
+
+                for (std::vector<RecordValue>::const_iterator
+                    value_itr = record_itr->values.begin();
+                    value_itr != record_itr->values.end();
+                    ++value_itr)
+                {
+                    const FARM::AttributeCategory
+                        &attribute_category = value_itr->converted.attribute_code;
+                    FARM::AttributeDataType
+                        data_type;
+                    FARM::AttributeOffset
+                        offset;
+                    std::string
+                        reason;
+
+                    if (not FARM::FeatureAttributeMapping::get_attribute_offset(
+                        record_itr->feature_category,
+                        attribute_category,
+                        offset))
+                    {
+                        reject_value(
+                            *batch,
+                            *record_itr,
+                            *value_itr,
+                            "attribute is not in the feature");
+                    }
+                    else if (
+                        FARM::FeatureAttributeMapping::get_data_type(
+                            attribute_category, data_type) and
+                        data_type != value_itr->converted.value.get_data_type())
+                    {
+                        reject_value(
+                            *batch,
+                            *record_itr,
+                            *value_itr,
+                            "data type does not match the FARM");
+                    }
+                    else if (not set_value(
+                        *record_itr,
+                        *value_itr,
+                        offset,
+                        record_itr->overlay,
+                        record_itr->strings,
+                        reason))
+                    {
+                        reject_value(*batch, *record_itr, *value_itr, reason);
+                    }
+                    else
+                    {
+                        ++batch->values_converted;
+                    }
+                }
+            }
+
+            validate_counter.records +=
+                static_cast<CORE::Int64>(batch->records.size());
+            add_busy_time(validate_counter, start);
+
+            output.push(batch);
+        }
+
+        output.producer_done();
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes the overlays and the reject log.  The batches of each input file
+    // are written in the order they were read.
+    //
+    void Pipeline::write_stage(
+        BatchQueue &input,
+        FARM::MigrationReport &report
+    )
+    {
+        RecordBatch
+            *batch = 0;
+        std::vector<std::ofstream *>
+            outputs(options.input_files.size(), 0);
+        std::vector<CORE::Int64>
+            next_sequence(options.input_files.size(), 0);
+        std::vector<std::map<CORE::Int64, RecordBatch *> >
+            pending(options.input_files.size());
+        std::ofstream
+            reject_log;
+
+        if (not options.reject_log_file.empty())
+        {
+            reject_log.open(options.reject_log_file.c_str());
+
+            if (not reject_log.is_open())
+            {
+                successful = false;
+
+                LOG(high,
+                    "Could not open the EDCS migration reject log '" +
+                        options.reject_log_file + "'.");
+            }
+        }
+
+        while (input.pop(batch))
+        {
+            const Clock::time_point
+                start = Clock::now();
+            const int
+                chunk = batch->chunk;
+
+            pending[chunk].insert(std::make_pair(batch->sequence, batch));
+
+            while (not pending[chunk].empty() and
+                pending[chunk].begin()->first == next_sequence[chunk])
+            {
+                batch = pending[chunk].begin()->second;
+                pending[chunk].erase(pending[chunk].begin());
+                ++next_sequence[chunk];
+
+                if (not outputs[chunk])
+                {
+                    const std::string
+                        output_file =
+                            options.output_dir + "/" +
+                            base_name(options.input_files[chunk]) + ".ovl";
+
+                    outputs[chunk] = new std::ofstream(
+                        output_file.c_str(), std::ios::out | std::ios::binary);
+
+                    if (not outputs[chunk]->is_open())
+                    {
+                        successful = false;
+
+                        LOG(high,
+                            "Could not open the EDCS migration output file '" +
+                                output_file + "'.");
+                    }
+                }
+
+                std::ofstream
+                    &output = *outputs[chunk];
+
+                for (std::vector<MigrationRecord>::const_iterator
+                    record_itr = batch->records.begin();
+                    record_itr != batch->records.end();
+                    ++record_itr)
+                {
+                    ++report.records_read;
+
+                    if (record_itr->rejected)
+                    {
+                        ++report.records_rejected;
+                        continue;
+                    }
+
+                    const CORE::Int32
+                        feature_category = record_itr->feature_category,
+                        overlay_size =
+                            static_cast<CORE::Int32>(record_itr->overlay.size()),
+                        string_count =
+                            static_cast<CORE::Int32>(record_itr->strings.size());
+
+                    output.write(
+                        reinterpret_cast<const char *>(&feature_category),
+                        sizeof(feature_category));
+                    output.write(
+                        reinterpret_cast<const char *>(&overlay_size),
+                        sizeof(overlay_size));
+
+                    if (overlay_size)
+                    {
+                        output.write(&record_itr->overlay[0], overlay_size);
+                    }
+
+                    output.write(
+                        reinterpret_cast<const char *>(&string_count),
+                        sizeof(string_count));
+
+                    for (int i = 0; i < string_count; ++i)
+                    {
+                        const CORE::Int32
+                            offset = record_itr->strings[i].first;
+
+                        output.write(
+                            reinterpret_cast<const char *>(&offset),
+                            sizeof(offset));
+                        CORE::dump_string(output, record_itr->strings[i].second);
+                    }
+
+                    ++report.records_written;
+                }
+
+                for (std::vector<std::string>::const_iterator
+                    reject_itr = batch->rejects.begin();
+                    reject_itr != batch->rejects.end();
+                    ++reject_itr)
+                {
+                    if (reject_log.is_open())
+                    {
+                        reject_log << *reject_itr << "\n";
+                    }
+                }
+
+                report.values_converted += batch->values_converted;
+                report.values_deleted += batch->values_deleted;
+                report.values_rejected += batch->values_rejected;
+
+                write_counter.records +=
+                    static_cast<CORE::Int64>(batch->records.size());
+
+                if (batch->last)
+                {
+                    if (not output.good())
+                    {
+                        successful = false;
+                    }
+
+                    output.close();
+                }
+
+                delete batch;
+            }
+
+            add_busy_time(write_counter, start);
+        }
+
+        for (std::vector<std::ofstream *>::iterator
+            output_itr = outputs.begin();
+            output_itr != outputs.end();
+            ++output_itr)
+        {
+            delete *output_itr;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The report for a pipeline stage.
+    //
+    FARM::MigrationStageReport stage_report(
+        const std::string &stage,
+        int workers,
+        const StageCounter &counter
+    )
+    {
+        FARM::MigrationStageReport
+            report;
+
+        report.stage = stage;
+        report.workers = workers;
+        report.records = counter.records;
+        report.busy_seconds = counter.busy_nanoseconds * 1.0e-9;
+
+        return report;
+    }
+}
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    MigrationOptions::MigrationOptions(void) :
+        output_dir("."),
+        thread_count(0),
+        batch_size(512),
+        queue_capacity(8)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    MigrationReport::MigrationReport(void) :
+        records_read(0),
+        records_written(0),
+        records_rejected(0),
+        values_converted(0),
+        values_deleted(0),
+        values_rejected(0),
+        elapsed_seconds(0.0)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    void MigrationReport::display(std::ostream &stream) const
+    {
+        stream << "EDCS migration: " << records_read << " records read, " <<
+            records_written << " written, " << records_rejected <<
+            " rejected in " << elapsed_seconds << " s";
+
+        if (0.0 < elapsed_seconds)
+        {
+            stream << " (" << records_read / elapsed_seconds << " records/s)";
+        }
+
+        stream << std::endl << "  values: " << values_converted <<
+            " converted, " << values_deleted << " deleted, " <<
+            values_rejected << " rejected" << std::endl;
+
+        for (std::vector<MigrationStageReport>::const_iterator
+            stage_itr = stages.begin();
+            stage_itr != stages.end();
+            ++stage_itr)
+        {
+            stream << "  " << stage_itr->stage << " (" << stage_itr->workers <<
+                " workers): " << stage_itr->records << " records, " <<
+                stage_itr->busy_seconds << " busy s";
+
+            if (0.0 < stage_itr->busy_seconds)
+            {
+                stream << ", " <<
+                    stage_itr->records * stage_itr->workers /
+                        stage_itr->busy_seconds <<
+                    " records/s";
+            }
+
+            stream << std::endl;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    bool EDCSMigration::migrate(
+        const MigrationOptions &options,
+        MigrationReport &report
+    )
+    {
+        EDCSConverter::verify_edcs_converter_initialization();
+        FeatureAttributeMapping::verify_farm_initialization();
+
+        report = MigrationReport();
+
+        const Clock::time_point
+            start = Clock::now();
+        const int
+            input_count = static_cast<int>(options.input_files.size()),
+            thread_count =
+                0 < options.thread_count ?
+                    options.thread_count :
+                    std::max(1u, std::thread::hardware_concurrency()),
+            parse_workers =
+                std::max(1, std::min(input_count, thread_count / 4)),
+            convert_workers = std::max(1, thread_count / 2),
+            validate_workers = std::max(1, thread_count / 4);
+
+        Pipeline
+            pipeline(options);
+
+        if (not CORE::DirectoryParser::verify_dir(options.output_dir))
+        {
+            LOG(high,
+                "Could not create the EDCS migration output directory '" +
+                    options.output_dir + "'.");
+
+            pipeline.successful = false;
+        }
+        else
+        {
+            BatchQueue
+                parsed(options.queue_capacity, parse_workers),
+                converted(options.queue_capacity, convert_workers),
+                validated(options.queue_capacity, validate_workers);
+            std::vector<std::thread>
+                workers;
+
+            for (int i = 0; i < parse_workers; ++i)
+            {
+                workers.push_back(std::thread(
+                    &Pipeline::parse_stage, &pipeline, std::ref(parsed)));
+            }
+
+            for (int i = 0; i < convert_workers; ++i)
+            {
+                workers.push_back(std::thread(
+                    &Pipeline::convert_stage,
+                    &pipeline,
+                    std::ref(parsed),
+                    std::ref(converted)));
+            }
+
+            for (int i = 0; i < validate_workers; ++i)
+            {
+                workers.push_back(std::thread(
+                    &Pipeline::validate_stage,
+                    &pipeline,
+                    std::ref(converted),
+                    std::ref(validated)));
+            }
+
+            // The writer runs on this thread.
+            //
+            pipeline.write_stage(validated, report);
+
+            for (std::vector<std::thread>::iterator
+                worker_itr = workers.begin();
+                worker_itr != workers.end();
+                ++worker_itr)
+            {
+                worker_itr->join();
+            }
+        }
+
+        report.elapsed_seconds =
+            std::chrono::duration_cast<std::chrono::duration<double> >(
+                Clock::now() - start).count();
+
+        report.stages.push_back(
+            stage_report("parse", parse_workers, pipeline.parse_counter));
+        report.stages.push_back(
+            stage_report("convert", convert_workers, pipeline.convert_counter));
+        report.stages.push_back(
+            stage_report(
+                "validate", validate_workers, pipeline.validate_counter));
+        report.stages.push_back(
+            stage_report("write", 1, pipeline.write_counter));
+
+        return pipeline.successful;
+    }
+}
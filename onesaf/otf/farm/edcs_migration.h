@@ -0,0 +1,131 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef EDCS_MIGRATION_H
+#define EDCS_MIGRATION_H
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "core/sys_types.h"
+
+namespace FARM
+{
+    // Options for migrating EDCS 3.x terrain feature dumps.
+    //
+    // Each input file is a chunk of a terrain feature dump with one feature
+    // record per line.  The fields of a record are separated by tabs:
+    //
+    //     <feature label> <geometry> <attribute label>=<value> ...
+    //
+    // The geometry is POINT, LINE, or AREA.  Enumerated attribute values are
+    // EDCS 3.x enumerant labels, all other values are written as text.  Blank
+    // lines and lines starting with '#' are ignored.
+    //
+    struct MigrationOptions
+    {
+        MigrationOptions(void);
+
+        std::vector<std::string>
+            input_files;        // EDCS 3.x terrain feature dump chunks
+        std::string
+            output_dir,         // EDCS 4.x overlays are written here
+            reject_log_file;    // Unmapped records and values are logged here
+        int
+            thread_count,       // Worker threads, 0 for the hardware count
+            batch_size,         // Records passed between stages at a time
+            queue_capacity;     // Batches buffered between two stages
+    };
+
+    // The throughput of a single pipeline stage.
+    //
+    struct MigrationStageReport
+    {
+        std::string
+            stage;
+        int
+            workers;
+        CORE::Int64
+            records;
+        double
+            busy_seconds;       // Summed over all of the stage's workers
+    };
+
+    // The results of a migration.
+    //
+    struct MigrationReport
+    {
+        MigrationReport(void);
+
+        // Writes the counts and the records per second of each stage.
+        //
+        void display(std::ostream &stream) const;
+
+        CORE::Int64
+            records_read,
+            records_written,
+            records_rejected,
+            values_converted,
+            values_deleted,     // Values of attributes deleted from EDCS 4.x
+            values_rejected;
+        double
+            elapsed_seconds;
+        std::vector<MigrationStageReport>
+            stages;
+    };
+
+    // ------------------------------------------------------------------------
+    // Migrates EDCS 3.x terrain feature dumps to EDCS 4.x attribute overlays.
+    // The records flow through four stages that are connected by bounded
+    // queues so that a slow stage holds back the stages in front of it:
+    //
+    //     parse -> convert (EDCSConverter) -> validate (FARM) -> write
+    //
+    // Unmapped features and values are written to the reject log instead of
+    // stopping the migration.  For every input file an overlay file named
+    // <input file name>.ovl is written to the output directory.  Each record
+    // in the overlay file holds:
+    //
+    //     Int32 feature category
+    //     Int32 overlay size, followed by the overlay bytes
+    //     Int32 string count, followed by an Int32 overlay offset and the
+    //           CORE::dump_string() text for each string attribute
+    //
+    // Integer and boolean attributes are stored as a native Int32, real
+    // attributes as a native Float64, and enumerated attributes as the
+    // native Int32 attribute and enumerant codes.  A string attribute stores
+    // the Int32 index of its text in the record's strings.  Attributes that
+    // are not in a record keep the FARM default.
+    // ------------------------------------------------------------------------
+    class EDCSMigration
+    {
+      public:
+
+        // Migrates the input files.  Both the EDCSConverter and the FARM
+        // must have been initialized.
+        //
+        // Return:  Were all of the input files read and written?
+        //
+        static bool migrate(
+            const MigrationOptions &options,
+            MigrationReport &report
+        );
+    };
+}
+
+#endif
@@ -18,6 +18,7 @@
  */
 #include "attribute_categories.h"
 #include "enum_values.h"
+#include "farm_trace.h"
 #include "feature_categories.h"
 
 namespace
@@ -55,6 +56,9 @@ namespace FARM
     // ------------------------------------------------------------------------
     bool EnumValues::initialize()
     {
+        StartupTracePhase
+            phase("EnumValues::initialize");
+
         if (FeatureAttributeMapping::initialized())
         {
             initialized = true;
@@ -20,11 +20,22 @@
  *               All rights reserved.
  */
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <set>
+#include <sstream>
+#include <thread>
+#include <typeinfo>
 #include <vector>
 
 #include "attribute_categories.h"
@@ -40,8 +51,15 @@
 #include "enum_values.h"
 #include "farm.h"
 #include "farm_attribute.h"
+#include "farm_code_index.h"
 #include "farm_data_types.h"
 #include "farm_enumerant.h"
+#include "farm_flat_image.h"
+#include "farm_instrumentation.h"
+#include "farm_label_filter.h"
+#include "farm_overlay_migration.h"
+#include "farm_trace.h"
+#include "farm_trim_manifest.h"
 #include "feature_categories.h"
 
 #define EDM_DEBUG 0
@@ -58,7 +76,17 @@ namespace
         // format and is used to recompile a FARM OTF file from an older OTF
         // version to a newer OTF version.
         //
-        farm_binary_input_file = "FARM.bin";
+        farm_binary_input_file = "FARM.bin",
+        // Compressed form of the binary file, which is read in place of it
+        // when it is present.
+        //
+        farm_compressed_input_file = "FARM.binz";
+
+    // The FARM table is split into compressed sections of about this many
+    // bytes, so that its rows can be decoded in parallel.
+    //
+    const std::size_t
+        compressed_table_section_bytes = 64 * 1024;
 
     // Constants for reading the FARM configuration files.
     //
@@ -154,6 +182,95 @@ namespace
     EnumerantCodesToLabels
         enum_codes_to_labels;       // Stores the mapping of enum codes
 
+    // Reject unknown labels before the label tables above are searched.
+    // They are built with the tables by initialize_edcs_maps().
+    //
+    FARM::LabelFilter
+        feature_label_filter("FARM feature labels"),
+        attribute_label_filter("FARM attribute labels");
+
+    // Index the labels of the code to label maps above by code, so that the
+    // Feature, Attribute, and Enumerant setters do not search a map.  The
+    // labels are those in the maps, and are indexed when the maps are built
+    // by initialize_edcs_maps().
+    //
+    FARM::CodeIndex<const FARM::FeatureLabel *>
+        feature_code_labels(0);
+    FARM::CodeIndex<const FARM::AttributeLabel *>
+        attribute_code_labels(0);
+
+    // Indexes the labels of enum_codes_to_labels by attribute code and
+    // enumerant code, as attribute code * enum_code_stride + enumerant code.
+    // The stride is one more than the largest enumerant code, so that the
+    // enumerants of an attribute are adjacent.
+    //
+    FARM::CodeIndex<const FARM::EnumerantLabel *>
+        enum_code_labels(0);
+    CORE::Int64
+        enum_code_stride = 0;
+
+    // Index the label to code maps above by hash, for looking up labels in
+    // batches.  They are built with the code indexes.
+    //
+    FARM::LabelIndex
+        feature_label_index,
+        attribute_label_index,
+        enum_label_index;
+
+    // Batches of fewer labels than this per thread are not split between
+    // threads, since starting a thread costs as much as the lookups.
+    //
+    const std::size_t
+        labels_per_thread = 32768;
+
+    // Indexes the feature categories by feature code and geometry, as
+    // code * 4 + geometry.  It is built when the FARM tables are loaded.
+    //
+    FARM::CodeIndex<FARM::FeatureCategory>
+        feature_code_categories(-1);
+
+    // Holds the FeatureTraits of every feature category, which start at the
+    // first cache line boundary of the storage.
+    //
+    const std::size_t
+        cache_line_bytes = 64;
+    std::vector<char>
+        feature_traits_storage;
+
+    // The FARM table rows that are still in the compressed image when rows
+    // are decoded on demand.
+    //
+    struct RowsOnDemand
+    {
+        FARM::CompressedImageReader
+            image;
+        std::vector<int>
+            row_sections;       // The section of each row
+        std::vector<CORE::Int32>
+            row_offsets;        // Where each row starts in its section
+        std::unique_ptr<std::atomic<bool>[]>
+            rows_decoded;
+        std::unique_ptr<std::mutex[]>
+            section_mutexes;
+        std::vector< std::vector<char> >
+            sections;           // Decompressed sections with rows left
+        std::vector<int>
+            rows_left;          // The rows of each section left to decode
+        std::atomic<int>
+            decoded_row_count;
+    };
+
+    // Null unless the rows of the loaded FARM are decoded on demand.
+    //
+    RowsOnDemand
+        *rows_on_demand_table = 0;
+
+    // Set by FeatureAttributeMapping::set_rows_on_demand().
+    //
+    bool
+        rows_on_demand_set = false,
+        rows_on_demand_on = false;
+
     // Forward declaring these debug functions so we can mark them in order to prevent
     // GCC from throwing a warning for em.
     void dump_enum_labels_to_codes() __attribute__ ((unused));
@@ -162,8 +279,8 @@ namespace
     void dump_attribute_labels_to_codes() __attribute__ ((unused));
     void dump_feature_codes_to_labels() __attribute__ ((unused));
     void dump_feature_labels_to_codes() __attribute__ ((unused));
-    void local_read( std::istream&,FARM::Enumerant&) __attribute__ ((unused));
-    void local_write(std::ostream&,const FARM::Enumerant&) __attribute__ ((unused));
+    void local_read( FARM::BinaryReader&,FARM::Enumerant&) __attribute__ ((unused));
+    void local_write(FARM::BinaryWriter&,const FARM::Enumerant&) __attribute__ ((unused));
     
 
     // ------------------------------------------------------------------------
@@ -434,29 +551,29 @@ namespace
     // Reads a UInt16 from the binary stream.
     //
     void local_read(
-        std::istream &stream,
+        FARM::BinaryReader &reader,
         CORE::UInt16 &uint16
     )
     {
-        stream.read(reinterpret_cast<char *>(&uint16), sizeof(uint16));
+        reader.read(uint16);
     }
 
     // ------------------------------------------------------------------------
     // Writes a UInt16 to the binary stream.
     //
     void local_write(
-        std::ostream &stream,
+        FARM::BinaryWriter &writer,
         CORE::UInt16 uint16
     )
     {
-        stream.write(reinterpret_cast<char *>(&uint16), sizeof(uint16));
+        writer.write(uint16);
     }
 
     // ------------------------------------------------------------------------
     // Reads a string from the binary stream.
     //
     void local_read(
-        std::istream &stream,
+        FARM::BinaryReader &reader,
         std::string &string
     )
     {
@@ -467,17 +584,17 @@ namespace
 
         // Read the size of the string.
         //
-        local_read(stream, string_size);
+        local_read(reader, string_size);
 
         string.resize(string_size);
 
         // Read the characters in the string.
         //
-        stream.read(&(string[0]), string.size());
+        reader.read_bytes(&(string[0]), string.size());
 
         if (CORE::odd(string.size()))
         {
-            stream.read(&padding, sizeof(padding));
+            reader.read(padding);
         }
     }
 
@@ -485,7 +602,7 @@ namespace
     // Writes a string to the binary stream.
     //
     void local_write(
-        std::ostream &stream,
+        FARM::BinaryWriter &writer,
         const std::string &string
     )
     {
@@ -494,15 +611,15 @@ namespace
 
         // Write the size of the string.
         //
-        local_write(stream, static_cast<CORE::UInt16>(string.size()));
+        local_write(writer, static_cast<CORE::UInt16>(string.size()));
 
         // Write the characters in the string.
         //
-        stream.write(&(string[0]), string.size());
+        writer.write_bytes(string.data(), string.size());
 
         if (CORE::odd(string.size()))
         {
-            stream.write(&padding, sizeof(padding));
+            writer.write(padding);
         }
     }
 
@@ -510,7 +627,7 @@ namespace
     // Reads a feature label and geometry from the binary stream.
     //
     void local_read(
-        std::istream &stream,
+        FARM::BinaryReader &reader,
         FARM::FeatureLabelAndGeometry &label_and_geometry
     )
     {
@@ -519,11 +636,11 @@ namespace
 
         // Read the feature's label.
         //
-        local_read(stream, label_and_geometry.first);
+        local_read(reader, label_and_geometry.first);
 
         // Read the feature's geometry.
         //
-        local_read(stream, geometry);
+        local_read(reader, geometry);
         label_and_geometry.second =
             static_cast<FARM::FeatureGeometry>(geometry);
     }
@@ -532,96 +649,96 @@ namespace
     // Writes a feature label and geometry to the binary stream.
     //
     void local_write(
-        std::ostream &stream,
+        FARM::BinaryWriter &writer,
         const FARM::FeatureLabelAndGeometry &label_and_geometry
     )
     {
         // Write the feature's label.
         //
-        local_write(stream, label_and_geometry.first);
+        local_write(writer, label_and_geometry.first);
 
         // Write the feature's geometry.
         //
         local_write(
-            stream, static_cast<CORE::UInt16>(label_and_geometry.second));
+            writer, static_cast<CORE::UInt16>(label_and_geometry.second));
     }
 
     // ------------------------------------------------------------------------
     // Writes a attribute to the binary stream.
     //
     void local_write(
-        std::ostream &stream,
+        FARM::BinaryWriter &writer,
         const FARM::Attribute &attribute
     )
     {
         // Write the attribute
         //
-        attribute.write(stream);
+        attribute.write(writer);
     }
 
     // ------------------------------------------------------------------------
     // Reads a attribute from the binary stream.
     //
     void local_read(
-        std::istream &stream,
+        FARM::BinaryReader &reader,
         FARM::Attribute &attribute
     )
     {
         // Write the attribute
         //
-        attribute.read(stream);
+        attribute.read(reader);
     }
 
     // ------------------------------------------------------------------------
     // Writes a feature to the binary stream.
     //
     void local_write(
-        std::ostream &stream,
+        FARM::BinaryWriter &writer,
         const FARM::Feature &feature
     )
     {
         // Write the feature
         //
-        feature.write(stream);
+        feature.write(writer);
     }
 
     // ------------------------------------------------------------------------
     // Reads a feature from the binary stream.
     //
     void local_read(
-        std::istream &stream,
+        FARM::BinaryReader &reader,
         FARM::Feature &feature
     )
     {
         // Write the feature
         //
-        feature.read(stream);
+        feature.read(reader);
     }
 
     // ------------------------------------------------------------------------
     // Writes a enumerant to the binary stream.
     //
     void local_write(
-        std::ostream &stream,
+        FARM::BinaryWriter &writer,
         const FARM::Enumerant &enumerant
     )
     {
         // Write the enumerant
         //
-        enumerant.write(stream);
+        enumerant.write(writer);
     }
 
     // ------------------------------------------------------------------------
     // Reads a feature from the binary stream.
     //
     void local_read(
-        std::istream &stream,
+        FARM::BinaryReader &reader,
         FARM::Enumerant &enumerant
     )
     {
         // Write the enumerant
         //
-        enumerant.read(stream);
+        enumerant.read(reader);
     }
 
     // ------------------------------------------------------------------------
@@ -634,7 +751,7 @@ namespace
         class FileDataType> // Data type to store the array elements in the
                             // stream as.
     void read_array(
-        std::istream &stream,
+        FARM::BinaryReader &reader,
         std::vector<DataType> &array
     )
     {
@@ -645,7 +762,7 @@ namespace
 
         // Read the number of items in the array.
         //
-        local_read(stream, array_size);
+        local_read(reader, array_size);
 
         array.resize(array_size);
 
@@ -653,7 +770,7 @@ namespace
         //
         for (int index = 0; index < array.size(); ++index)
         {
-            local_read(stream, element);
+            local_read(reader, element);
 
             array[index] = static_cast<DataType>(element);
         }
@@ -669,13 +786,13 @@ namespace
         class FileDataType> // Data type to store the array elements in the
                     // stream as.
     void write_array(
-        std::ostream &stream,
+        FARM::BinaryWriter &writer,
         const std::vector<DataType> &array
     )
     {
         // Write the number of items in the array.
         //
-        local_write(stream, static_cast<CORE::UInt16>(array.size()));
+        local_write(writer, static_cast<CORE::UInt16>(array.size()));
 
         // Write the elements in the array.
         //
@@ -684,7 +801,7 @@ namespace
             // Sun Forte has a problem with parameters that are passed by const
             // reference and are then passed by value to another function.
             //
-            local_write(stream, static_cast<FileDataType>(array[index]));
+            local_write(writer, static_cast<FileDataType>(array[index]));
         }
     }
 
@@ -700,7 +817,7 @@ namespace
         class ValueFileDataType> // Data type to store the map values in the
                                  // stream as.
     void read_map(
-        std::istream &stream,
+        FARM::BinaryReader &reader,
         std::map<KeyDataType, ValueDataType> &map
     )
     {
@@ -714,15 +831,15 @@ namespace
 
         // Read the number of items in the map.
         //
-        local_read(stream, map_size);
+        local_read(reader, map_size);
 
         // Read the keys and values in the map.
         //
 
         for (int index = 0; index < map_size; ++index)
         {
-            local_read(stream, key);
-            local_read(stream, value);
+            local_read(reader, key);
+            local_read(reader, value);
 
             std::pair<typename std::map<KeyDataType, ValueDataType>::iterator,
             bool> insert_result =
@@ -752,7 +869,7 @@ namespace
         class ValueFileDataType> // Data type to store the map values in the
                                  // stream as.
     void write_map(
-        std::ostream &stream,
+        FARM::BinaryWriter &writer,
         const std::map<KeyDataType, ValueDataType> &map
     )
     {
@@ -762,15 +879,15 @@ namespace
         // Write the number of items in the map.
         //
         local_write(
-            stream, static_cast<CORE::UInt16>(map.size()));
+            writer, static_cast<CORE::UInt16>(map.size()));
 
         // Write the keys and values in the map.
         //
         while (iterator != map.end())
         {
-            local_write(stream, static_cast<KeyFileDataType>(iterator->first));
+            local_write(writer, static_cast<KeyFileDataType>(iterator->first));
             local_write(
-                stream, static_cast<ValueFileDataType>(iterator->second));
+                writer, static_cast<ValueFileDataType>(iterator->second));
 
             ++iterator;
         }
@@ -891,228 +1008,685 @@ namespace
             ++count;
         }
     }
-}
 
-namespace FARM
-{
-    bool
-        FeatureAttributeMapping::farm_initialized = false;
-    FeatureAttributeMapping::AttributeCodesToAttributes
-        FeatureAttributeMapping::attribute_codes_to_attributes;
-    std::vector<FeatureAttributeMapping::FarmAttributeCodeToDataType>
-        FeatureAttributeMapping::farm;
+    // ------------------------------------------------------------------------
+    // Builds the label filters from the label tables.
+    //
+    void build_label_filters(void)
+    {
+        feature_label_filter.reset(feature_labels_to_codes.size());
+
+        for (FeatureLabelsToCodes::const_iterator
+            map_itr = feature_labels_to_codes.begin();
+            map_itr != feature_labels_to_codes.end();
+            ++map_itr)
+        {
+            feature_label_filter.add(map_itr->first);
+        }
+
+        attribute_label_filter.reset(attribute_labels_to_codes.size());
+
+        for (AttributeLabelsToCodes::const_iterator
+            map_itr = attribute_labels_to_codes.begin();
+            map_itr != attribute_labels_to_codes.end();
+            ++map_itr)
+        {
+            attribute_label_filter.add(map_itr->first);
+        }
+    }
 
     // ------------------------------------------------------------------------
-    // Initializes the EDCS-related maps; labels-to-codes and codes-to-labels
-    // for features, attributes, and enums.
+    // Empties the label filters.
     //
-    // Return:  Were the maps created?
+    void clear_label_filters(void)
+    {
+        feature_label_filter.clear();
+        attribute_label_filter.clear();
+    }
+
+    // ------------------------------------------------------------------------
+    // Indexes the labels of a code to label map by code.
     //
-    bool FeatureAttributeMapping::initialize_edcs_maps(
-        const std::string &edcs_feature_mapping_filename,
-        const std::string &edcs_attribute_mapping_filename,
-        const std::string &edcs_attrib_enum_mapping_filename
+    template <class CodesToLabels>
+    void build_code_labels(
+        const CodesToLabels &codes_to_labels,
+        FARM::CodeIndex<const typename CodesToLabels::mapped_type *> &index
     )
     {
-        if (not edcs_maps_initialized)
-        {
-            FeatureLabel
-                new_feature_label;
-
-            CORE::Int32
-                new_feature_code;
+        typename FARM::CodeIndex<
+            const typename CodesToLabels::mapped_type *>::Entries
+                entries;
 
-            // Initialize the EDCS mapping tables.
+        entries.reserve(codes_to_labels.size());
 
-            feature_labels_to_codes.clear();
-            feature_codes_to_labels.clear();
-            attribute_labels_to_codes.clear();
-            attribute_codes_to_labels.clear();
-            enum_labels_to_codes.clear();
-            enum_codes_to_labels.clear();
+        for (typename CodesToLabels::const_iterator
+            map_itr = codes_to_labels.begin();
+            map_itr != codes_to_labels.end();
+            ++map_itr)
+        {
+            entries.push_back(
+                std::make_pair(map_itr->first, &map_itr->second));
+        }
 
-            // Read in Feature Label Mapping data and set up map
+        index.build(entries);
+    }
 
-            CORE::ConfigurationOptions
-                *edcs_config_options_ptr = 0;
-            edcs_config_options_ptr =
-                new CORE::ConfigurationOptions(edcs_feature_mapping_filename);
+    // ------------------------------------------------------------------------
+    // Indexes the codes of a label to code map by hash.
+    //
+    template <class LabelsToCodes>
+    void build_label_index(
+        const LabelsToCodes &labels_to_codes,
+        FARM::LabelIndex &index
+    )
+    {
+        index.reset(labels_to_codes.size());
 
-            ASSERT(
-                edcs_config_options_ptr,
-                fatal,
-                "Could not allocate the memory for the ConfigurationOptions "
-                    "class!");
+        for (typename LabelsToCodes::const_iterator
+            map_itr = labels_to_codes.begin();
+            map_itr != labels_to_codes.end();
+            ++map_itr)
+        {
+            index.add(map_itr->first, map_itr->second);
+        }
+    }
 
-            ASSERT(
-                edcs_config_options_ptr->is_ready(),
-                fatal,
-                "Could not parse the edcs feature mapping configuration "
-                    "file " + edcs_feature_mapping_filename);
+    // ------------------------------------------------------------------------
+    // Indexes the enumerant labels by attribute code and enumerant code.
+    // The attribute of an enumerant code is that of the attribute label that
+    // the code of the enumerant is paired with.
+    //
+    void build_enum_code_labels(void)
+    {
+        FARM::CodeIndex<const FARM::EnumerantLabel *>::Entries
+            entries;
 
-            CORE::VecofCells
-                edcs_feature_table,
-                edcs_feature_entry;
+        enum_code_stride = 1;
 
-            // Get the feature mapping table.
-            //
-            ASSERT(
-                edcs_config_options_ptr->value(
-                    "FeatureMapping", edcs_feature_table),
-                high,
-                "Unable to get edcs feature mapping.");
+        for (EnumerantCodesToLabels::const_iterator
+            map_itr = enum_codes_to_labels.begin();
+            map_itr != enum_codes_to_labels.end();
+            ++map_itr)
+        {
+            enum_code_stride =
+                std::max<CORE::Int64>(
+                    enum_code_stride, map_itr->first.second + 1);
+        }
 
-            // Iterate through the entries.
+        entries.reserve(enum_codes_to_labels.size());
 
-            for (int i = 0; i < edcs_feature_table.size(); ++i)
+        // The attribute codes and the enumerant codes of each attribute are
+        // in order, so the entries are sorted as they are added.
+        //
+        for (AttributeCodesToLabels::const_iterator
+            attr_itr = attribute_codes_to_labels.begin();
+            attr_itr != attribute_codes_to_labels.end();
+            ++attr_itr)
+        {
+            for (EnumerantCodesToLabels::const_iterator
+                map_itr = enum_codes_to_labels.lower_bound(
+                    AttributeEnumCodePair(attr_itr->second, 0));
+                map_itr != enum_codes_to_labels.end() and
+                    map_itr->first.first == attr_itr->second;
+                ++map_itr)
             {
-                new_feature_code = -999;
-
-                ASSERT(edcs_config_options_ptr->value(edcs_feature_table, i, edcs_feature_entry),
-                    high,
-                    "Unable to get entry from edcs feature mapping");
+                entries.push_back(
+                    std::make_pair(
+                        CORE::Int64(attr_itr->first) * enum_code_stride +
+                            map_itr->first.second,
+                        &map_itr->second));
+            }
+        }
 
-                // Get the new feature label.
-                //
-                ASSERT(edcs_config_options_ptr->value(edcs_feature_entry, 1, new_feature_label),
-                    high,
-                    "Unable to get new feature label from edcs feature mapping entry");
+        enum_code_labels.build(entries);
+    }
 
-                // Get the new feature code.
-                //
-                ASSERT(edcs_config_options_ptr->value(edcs_feature_entry, 2, new_feature_code),
-                    high,
-                    "Unable to get new feature code from edcs feature mapping entry");
+    // ------------------------------------------------------------------------
+    // Return:  The label of the enumerant of the attribute code and
+    // enumerant code, or null.
+    //
+    const FARM::EnumerantLabel *find_enum_code_label(
+        FARM::AttributeCode attribute_code,
+        FARM::EnumerantCode enumerant_code)
+    {
+        if (enumerant_code < 0 or enumerant_code >= enum_code_stride)
+        {
+            return 0;
+        }
 
-                feature_labels_to_codes.insert(
-                    FeatureLabelsToCodes::value_type(new_feature_label, new_feature_code));
-                feature_codes_to_labels.insert(
-                    FeatureCodesToLabels::value_type(new_feature_code, new_feature_label));
-            }
+        return enum_code_labels.find(
+            CORE::Int64(attribute_code) * enum_code_stride + enumerant_code);
+    }
 
-            //for debug
-            //dump_feature_labels_to_codes();
-            //dump_feature_codes_to_labels();
+    // ------------------------------------------------------------------------
+    // Builds the code and label indexes from the label tables.
+    //
+    void build_code_indexes(void)
+    {
+        build_code_labels(feature_codes_to_labels, feature_code_labels);
+        build_code_labels(attribute_codes_to_labels, attribute_code_labels);
+        build_enum_code_labels();
 
-            if (edcs_config_options_ptr)
-            {
-                delete edcs_config_options_ptr;
-                edcs_config_options_ptr = 0;
-            }
+        build_label_index(feature_labels_to_codes, feature_label_index);
+        build_label_index(attribute_labels_to_codes, attribute_label_index);
 
-            // Read in Attribute Mapping data and set up maps
+        enum_label_index.reset(enum_labels_to_codes.size());
 
-            AttributeLabel
-                new_attribute_label;
+        for (EnumerantLabelsToCodes::const_iterator
+            map_itr = enum_labels_to_codes.begin();
+            map_itr != enum_labels_to_codes.end();
+            ++map_itr)
+        {
+            enum_label_index.add(
+                map_itr->first.first, map_itr->first.second, map_itr->second);
+        }
+    }
 
-            CORE::Int32
-                new_attribute_code;
+    // ------------------------------------------------------------------------
+    // Empties the code and label indexes.
+    //
+    void clear_code_indexes(void)
+    {
+        feature_code_labels.clear();
+        attribute_code_labels.clear();
+        enum_code_labels.clear();
+        enum_code_stride = 0;
+        feature_label_index.clear();
+        attribute_label_index.clear();
+        enum_label_index.clear();
+    }
 
-            std::string
-                new_data_type_string;
+    // ------------------------------------------------------------------------
+    // Finds the codes of the chunks of a batch of labels, or of label pairs
+    // if there are second labels, until no chunks are left.  Threads that
+    // share a batch take the chunks in turn.
+    //
+    void find_label_chunks(
+        const FARM::LabelIndex &index,
+        const FARM::LabelView *first_labels,
+        const FARM::LabelView *second_labels,
+        std::size_t count,
+        CORE::Int32 *codes,
+        CORE::UInt8 *misses,
+        std::atomic<std::size_t> &next_chunk,
+        std::atomic<std::size_t> &miss_count
+    )
+    {
+        std::size_t
+            misses_found = 0;
 
-            edcs_config_options_ptr =
-                new CORE::ConfigurationOptions(edcs_attribute_mapping_filename);
+        for (std::size_t first = next_chunk.fetch_add(labels_per_thread);
+             first < count;
+             first = next_chunk.fetch_add(labels_per_thread))
+        {
+            const std::size_t
+                chunk = std::min(labels_per_thread, count - first);
+
+            misses_found +=
+                second_labels ?
+                    index.find(
+                        first_labels + first,
+                        second_labels + first,
+                        chunk,
+                        -999,
+                        codes + first,
+                        misses + first) :
+                    index.find(
+                        first_labels + first,
+                        chunk,
+                        -999,
+                        codes + first,
+                        misses + first);
+        }
 
-            ASSERT(
-                edcs_config_options_ptr,
-                fatal,
-                "Could not allocate the memory for the ConfigurationOptions "
-                    "class!");
+        miss_count += misses_found;
+    }
 
-            ASSERT(
-                edcs_config_options_ptr->is_ready(),
-                fatal,
-                "Could not parse the edcs attribute mapping configuration file " +
-                edcs_attribute_mapping_filename);
+    // ------------------------------------------------------------------------
+    // Finds the codes of a batch of labels, or of label pairs, on as many
+    // threads as the batch is worth.
+    //
+    // Return:  The number of labels that were not found.
+    //
+    std::size_t find_labels(
+        const FARM::LabelIndex &index,
+        const FARM::LabelView *first_labels,
+        const FARM::LabelView *second_labels,
+        std::size_t count,
+        CORE::Int32 *codes,
+        CORE::UInt8 *misses
+    )
+    {
+        const std::size_t
+            thread_count =
+                std::max<std::size_t>(
+                    1,
+                    std::min<std::size_t>(
+                        count / labels_per_thread,
+                        std::thread::hardware_concurrency()));
+        std::atomic<std::size_t>
+            next_chunk(0),
+            miss_count(0);
+        std::vector<std::thread>
+            workers;
+
+        for (std::size_t i = 1; i < thread_count; ++i)
+        {
+            workers.push_back(std::thread(
+                find_label_chunks,
+                std::cref(index),
+                first_labels,
+                second_labels,
+                count,
+                codes,
+                misses,
+                std::ref(next_chunk),
+                std::ref(miss_count)));
+        }
 
-            CORE::VecofCells
-                edcs_attribute_table,
-                edcs_attribute_entry;
+        // This thread works through the chunks too.
+        //
+        find_label_chunks(
+            index,
+            first_labels,
+            second_labels,
+            count,
+            codes,
+            misses,
+            next_chunk,
+            miss_count);
+
+        for (std::vector<std::thread>::iterator
+            worker_itr = workers.begin();
+            worker_itr != workers.end();
+            ++worker_itr)
+        {
+            worker_itr->join();
+        }
 
-            // Get the attribute mapping table.
-            //
-            ASSERT(
-                edcs_config_options_ptr->value(
-                    "AttributeMapping", edcs_attribute_table),
-                high,
-                "Unable to get edcs attribute mapping.");
+        return miss_count;
+    }
 
-            // Iterate through the entries.
-            //
-            //  ( old_attr_code,  old_data_type,  old_attr_label,
-            //    new_attr_code,  new_data_type,  new_attr_label)
+    // ------------------------------------------------------------------------
+    // Indexes the feature categories by feature code and geometry.
+    //
+    void build_feature_code_categories(void)
+    {
+        FARM::CodeIndex<FARM::FeatureCategory>::Entries
+            entries;
+
+        for (FARM::FeatureCategory category = 0;
+             category <
+                static_cast<FARM::FeatureCategory>(
+                    feature_categories_to_features.size());
+             ++category)
+        {
+            const FARM::Feature
+                &feature = feature_categories_to_features[category];
 
-            for (int i = 0; i < edcs_attribute_table.size(); ++i)
+            if (feature.valid())
             {
-                new_data_type_string = "";
-                new_attribute_label = "";
-                new_attribute_code = -999;
+                entries.push_back(
+                    std::make_pair(
+                        CORE::Int64(feature.get_code()) * 4 +
+                            feature.get_geometry(),
+                        category));
+            }
+        }
 
-                ASSERT(edcs_config_options_ptr->value(edcs_attribute_table, i, edcs_attribute_entry),
-                    high,
-                    "Unable to get entry from edcs attribute mapping");
+        std::sort(entries.begin(), entries.end());
 
-                // Get the new attribute code.
-                //
-                ASSERT(edcs_config_options_ptr->value(edcs_attribute_entry, 3, new_attribute_code),
-                    high,
-                    "Unable to get new attribute code from edcs attribute mapping entry");
+        feature_code_categories.build(entries);
+    }
 
-                // Get the new attribute data type.
-                //
-                ASSERT(edcs_config_options_ptr->value(edcs_attribute_entry, 4, new_data_type_string),
-                    high,
-                    "Unable to get new data type from edcs attribute mapping entry");
+    // ------------------------------------------------------------------------
+    // Finds the feature category of a feature label and geometry by the code
+    // of the label, which unlike a search of
+    // feature_labels_and_geometries_to_categories does not copy the label
+    // into a key.  The map is only searched for labels that are not found
+    // by code.
+    //
+    // Return:  The feature category, or -1 if the FARM does not have it.
+    //
+    FARM::FeatureCategory find_feature_category(
+        const FARM::FeatureLabel &feature_label,
+        const FARM::FeatureGeometry &feature_geometry)
+    {
+        const FARM::LabelView
+            label_view = FARM::make_label_view(feature_label);
+        FARM::FeatureCode
+            code;
+        CORE::UInt8
+            miss;
+
+        if (feature_label_index.find(&label_view, 1, -999, &code, &miss) == 0)
+        {
+            const FARM::FeatureCategory
+                category = feature_code_categories.find(
+                    CORE::Int64(code) * 4 + feature_geometry);
+
+            if (category >= 0 and
+                feature_categories_to_features[category].get_geometry() ==
+                    feature_geometry and
+                feature_categories_to_features[category].get_label() ==
+                    feature_label)
+            {
+                return category;
+            }
+        }
 
-                // Get the new attribute label.
-                //
-                ASSERT(edcs_config_options_ptr->value(edcs_attribute_entry, 5, new_attribute_label),
-                    high,
-                    "Unable to get new attribute label from edcs attribute mapping entry");
+        FeatureLabelsGeometriesToCategories::const_iterator
+            category_itr = feature_labels_and_geometries_to_categories.find(
+                FARM::FeatureLabelAndGeometry(
+                    feature_label, feature_geometry));
 
-//should we ignore attribute mappings for enumeration types here? MMR
-                // Store the attribute mappings.
-                //
-                if (new_data_type_string != "DELETED" and
-                    new_data_type_string != "REMOVED" and
-                    new_attribute_label != "" and
-                    new_attribute_code != 0)
-                {
-                    attribute_labels_to_codes.insert(
-                        AttributeLabelsToCodes::value_type(
-                            new_attribute_label, new_attribute_code));
+        return
+            category_itr == feature_labels_and_geometries_to_categories.end() ?
+                -1 : category_itr->second;
+    }
 
-                    attribute_codes_to_labels.insert(
-                        AttributeCodesToLabels::value_type(
-                            new_attribute_code, new_attribute_label));
-                }
+    // ------------------------------------------------------------------------
+    // Adds the heap blocks of the strings in a value.  Values without
+    // strings, such as codes, own no heap blocks.
+    //
+    template<class Value>
+    void add_strings(FARM::FootprintAccumulator &, const Value &)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    void add_strings(
+        FARM::FootprintAccumulator &accumulator,
+        const std::string &string)
+    {
+        accumulator.add_string(string);
+    }
+
+    // ------------------------------------------------------------------------
+    void add_strings(
+        FARM::FootprintAccumulator &accumulator,
+        const FARM::Attribute &attribute)
+    {
+        accumulator.add_string(attribute.get_label());
+    }
+
+    // ------------------------------------------------------------------------
+    void add_strings(
+        FARM::FootprintAccumulator &accumulator,
+        const FARM::Enumerant &enumerant)
+    {
+        accumulator.add_string(enumerant.get_ea_label());
+        accumulator.add_string(enumerant.get_ee_label());
+    }
+
+    // ------------------------------------------------------------------------
+    template<class First, class Second>
+    void add_strings(
+        FARM::FootprintAccumulator &accumulator,
+        const std::pair<First, Second> &pair)
+    {
+        add_strings(accumulator, pair.first);
+        add_strings(accumulator, pair.second);
+    }
+
+    // ------------------------------------------------------------------------
+    // Adds a map whose entries are all distinct.
+    //
+    template<class Map>
+    void add_map(
+        FARM::FootprintAccumulator &accumulator,
+        const std::string &name,
+        const Map &map)
+    {
+        accumulator.begin_structure(name);
+        accumulator.add_bytes(sizeof(map));
+        accumulator.add_tree(map);
+        accumulator.add_distinct_elements(map.size());
+
+        for (typename Map::const_iterator entry = map.begin();
+             entry != map.end(); ++entry)
+        {
+            add_strings(accumulator, *entry);
+        }
+
+        accumulator.end_structure();
+    }
+
+    // ------------------------------------------------------------------------
+    // Adds a FARM table cell.  Cells with the same binary dump are
+    // duplicates.
+    //
+    // Return:  The number of valid enumerants of the cell.
+    //
+    CORE::Int64 add_data_type(
+        FARM::FootprintAccumulator &accumulator,
+        const FARM::DataType &data_type)
+    {
+        const FARM::EnumerantDataType
+            *enumerant_data_type =
+                dynamic_cast<const FARM::EnumerantDataType *>(&data_type);
+        std::ostringstream
+            key;
+        CORE::Int64
+            enumerants = 0;
+
+        key << typeid(data_type).name() << ':';
+        data_type.dump(key);
+        accumulator.add_element(key.str());
+
+        if (enumerant_data_type)
+        {
+            const FARM::Enumerants
+                &valid_enums = enumerant_data_type->enumerants();
+
+            accumulator.add_allocation(sizeof(FARM::EnumerantDataType));
+            add_strings(
+                accumulator, enumerant_data_type->get_default_enumerant());
+            accumulator.add_tree(valid_enums);
+
+            for (FARM::Enumerants::const_iterator enumerant =
+                     valid_enums.begin();
+                 enumerant != valid_enums.end(); ++enumerant)
+            {
+                add_strings(accumulator, *enumerant);
             }
 
-            //for debug
-            //dump_attribute_labels_to_codes();
-            //dump_attribute_codes_to_labels();
+            enumerants = valid_enums.size();
+        }
+        else if (dynamic_cast<const FARM::InstantiatedDataType<CORE::Int32> *>(
+                     &data_type))
+        {
+            accumulator.add_allocation(
+                sizeof(FARM::InstantiatedDataType<CORE::Int32>));
+        }
+        else if (
+            dynamic_cast<const FARM::InstantiatedDataType<CORE::Float64> *>(
+                &data_type))
+        {
+            accumulator.add_allocation(
+                sizeof(FARM::InstantiatedDataType<CORE::Float64>));
+        }
+        else if (dynamic_cast<const FARM::BooleanDataType *>(&data_type))
+        {
+            accumulator.add_allocation(sizeof(FARM::BooleanDataType));
+        }
+        else
+        {
+            // The string and UUID data types only hold the offset.
+            //
+            accumulator.add_allocation(sizeof(FARM::DataType));
+        }
 
-            if (edcs_config_options_ptr)
+        return enumerants;
+    }
+
+    // ------------------------------------------------------------------------
+    // Adds an enumerant to a fingerprint.
+    //
+    void add_enumerant(
+        FARM::FingerprintHasher &hasher,
+        const FARM::Enumerant &enumerant)
+    {
+        hasher.add(enumerant.get_ea_code());
+        hasher.add(enumerant.get_ee_code());
+        hasher.add_string(enumerant.get_ee_label());
+    }
+
+    // ------------------------------------------------------------------------
+    // Adds the offset, the default, the range, and the enumerant domain of a
+    // FARM table cell to a fingerprint.
+    //
+    void add_data_type(
+        FARM::FingerprintHasher &hasher,
+        FARM::DataType &data_type)
+    {
+        const FARM::InstantiatedDataType<CORE::Int32>
+            *int32_data_type =
+                dynamic_cast<const FARM::InstantiatedDataType<CORE::Int32> *>(
+                    &data_type);
+        const FARM::InstantiatedDataType<CORE::Float64>
+            *float64_data_type =
+                dynamic_cast<
+                    const FARM::InstantiatedDataType<CORE::Float64> *>(
+                        &data_type);
+        const FARM::BooleanDataType
+            *boolean_data_type =
+                dynamic_cast<const FARM::BooleanDataType *>(&data_type);
+        const FARM::EnumerantDataType
+            *enumerant_data_type =
+                dynamic_cast<const FARM::EnumerantDataType *>(&data_type);
+
+        hasher.add(data_type.get_offset());
+
+        if (int32_data_type)
+        {
+            hasher.add(int32_data_type->get_default());
+            hasher.add(int32_data_type->get_minimum());
+            hasher.add(int32_data_type->get_maximum());
+        }
+        else if (float64_data_type)
+        {
+            hasher.add_double(float64_data_type->get_default());
+            hasher.add_double(float64_data_type->get_minimum());
+            hasher.add_double(float64_data_type->get_maximum());
+        }
+        else if (boolean_data_type)
+        {
+            hasher.add(boolean_data_type->get_default());
+        }
+        else if (enumerant_data_type)
+        {
+            const FARM::Enumerants
+                &valid_enums = enumerant_data_type->enumerants();
+
+            hasher.add(enumerant_data_type->get_default());
+            hasher.add(static_cast<CORE::Int64>(valid_enums.size()));
+
+            for (FARM::Enumerants::const_iterator enumerant =
+                     valid_enums.begin();
+                 enumerant != valid_enums.end(); ++enumerant)
             {
-                delete edcs_config_options_ptr;
-                edcs_config_options_ptr = 0;
+                add_enumerant(hasher, *enumerant);
             }
+        }
+    }
 
-            // Read in Enumerant Mapping data and set up maps
+    // ------------------------------------------------------------------------
+    // CORE writes and reads the version of farm.dat, so the FARM can only
+    // swap the bytes of the version if it knows how the version is laid out.
+    // A FARM of the other byte order is written and read only when the
+    // version is serialized as its version, format, and update Int32's in
+    // that order, which is checked against the accessors of the version.
+    //
+    // Return:  Is the version serialized as its three Int32 fields?
+    //
+    bool version_is_three_int32s(const CORE::Version &version)
+    {
+        std::ostringstream
+            version_stream;
+        CORE::Int32
+            fields[3];
+
+        version.write(version_stream);
+
+        const std::string
+            serialized = version_stream.str();
+        bool
+            known = serialized.size() == sizeof(fields);
+
+        if (known)
+        {
+            std::memcpy(fields, serialized.data(), sizeof(fields));
+
+            known =
+                fields[0] == version.get_version() and
+                fields[1] == version.get_format() and
+                fields[2] == version.get_update();
+        }
+
+        return known;
+    }
+}
+
+namespace FARM
+{
+    bool
+        FeatureAttributeMapping::farm_initialized = false;
+    std::atomic<CORE::UInt32>
+        FeatureAttributeMapping::generation(1);
+    FeatureAttributeMapping::AttributeCodesToAttributes
+        FeatureAttributeMapping::attribute_codes_to_attributes;
+    std::vector<FeatureAttributeMapping::FarmAttributeCodeToDataType>
+        FeatureAttributeMapping::farm;
+    const std::atomic<bool>
+        *FeatureAttributeMapping::rows_decoded = 0;
+    const FeatureTraits
+        *FeatureAttributeMapping::feature_traits = 0;
+    FeatureCategory
+        FeatureAttributeMapping::feature_traits_count = 0;
+    const FeatureTraits
+        FeatureAttributeMapping::no_feature_traits;
+
+    // ------------------------------------------------------------------------
+    // Initializes the EDCS-related maps; labels-to-codes and codes-to-labels
+    // for features, attributes, and enums.
+    //
+    // Return:  Were the maps created?
+    //
+    bool FeatureAttributeMapping::initialize_edcs_maps(
+        const std::string &edcs_feature_mapping_filename,
+        const std::string &edcs_attribute_mapping_filename,
+        const std::string &edcs_attrib_enum_mapping_filename
+    )
+    {
+        StartupTracePhase
+            phase("FeatureAttributeMapping::initialize_edcs_maps");
+
+        if (not edcs_maps_initialized)
+        {
+            FeatureLabel
+                new_feature_label;
 
             CORE::Int32
-                new_enumerant_code;
+                new_feature_code;
 
-            AttributeEnumCodePair
-                attribute_enum_code;
+            // Initialize the EDCS mapping tables.
 
-            std::string
-                mapping_type,
-                new_enumerant_label_string;
+            feature_labels_to_codes.clear();
+            feature_codes_to_labels.clear();
+            attribute_labels_to_codes.clear();
+            attribute_codes_to_labels.clear();
+            enum_labels_to_codes.clear();
+            enum_codes_to_labels.clear();
+            clear_label_filters();
+            clear_code_indexes();
 
+            // Read in Feature Label Mapping data and set up map
+
+            CORE::ConfigurationOptions
+                *edcs_config_options_ptr = 0;
             edcs_config_options_ptr =
-                new CORE::ConfigurationOptions(edcs_attrib_enum_mapping_filename);
+                new CORE::ConfigurationOptions(edcs_feature_mapping_filename);
 
             ASSERT(
                 edcs_config_options_ptr,
@@ -1123,77 +1697,253 @@ namespace FARM
             ASSERT(
                 edcs_config_options_ptr->is_ready(),
                 fatal,
-                "Could not parse the edcs enumerant mapping configuration file " +
-                edcs_attrib_enum_mapping_filename);
+                "Could not parse the edcs feature mapping configuration "
+                    "file " + edcs_feature_mapping_filename);
 
             CORE::VecofCells
-                edcs_enum_table,
-                edcs_enum_entry;
+                edcs_feature_table,
+                edcs_feature_entry;
 
-            // Get the enumerant mapping table.
+            // Get the feature mapping table.
             //
-            ASSERT(edcs_config_options_ptr->value("EnumerantMapping", edcs_enum_table),
-                high, "Unable to get edcs enumerant mapping");
+            ASSERT(
+                edcs_config_options_ptr->value(
+                    "FeatureMapping", edcs_feature_table),
+                high,
+                "Unable to get edcs feature mapping.");
 
             // Iterate through the entries.
-            //
-            // 0 old_attr_code, 1 old_enum_code, 2 old_attr_label, 3 old_enum_label,
-            // 4 mapping_type,  5 data_type,
-            // 6 new_attr_code, 7 new_enum_code, 8 new_attr_label, 9 new_enum_label
 
-            for (int i = 0; i < edcs_enum_table.size(); ++i)
+            for (int i = 0; i < edcs_feature_table.size(); ++i)
             {
-                ASSERT(
-                    edcs_config_options_ptr->value(
-                        edcs_enum_table, i, edcs_enum_entry),
-                    high,
-                    "Unable to get entry from edcs enum mapping");
-
-                // Get the mapping type.
-                //
-                ASSERT(
-                    edcs_config_options_ptr->value(
-                        edcs_enum_entry, 4, mapping_type),
-                    high,
-                    "Unable to get mapping type from edcs enum mapping entry");
+                new_feature_code = -999;
 
-                // Get the new attribute data type.
-                //
-                ASSERT(
-                    edcs_config_options_ptr->value(
-                        edcs_enum_entry, 5, new_data_type_string),
+                ASSERT(edcs_config_options_ptr->value(edcs_feature_table, i, edcs_feature_entry),
                     high,
-                    "Unable to get new data type from edcs enum mapping "
-                        "entry");
+                    "Unable to get entry from edcs feature mapping");
 
-                // Get the new attribute code.
+                // Get the new feature label.
                 //
-                ASSERT(
-                    edcs_config_options_ptr->value(
-                        edcs_enum_entry, 6, new_attribute_code),
+                ASSERT(edcs_config_options_ptr->value(edcs_feature_entry, 1, new_feature_label),
                     high,
-                    "Unable to get new attribute code from edcs enum mapping "
-                        "entry");
+                    "Unable to get new feature label from edcs feature mapping entry");
 
-                // Get the new enumerant code.
+                // Get the new feature code.
                 //
-                ASSERT(
-                    edcs_config_options_ptr->value(
-                        edcs_enum_entry, 7, new_enumerant_code),
+                ASSERT(edcs_config_options_ptr->value(edcs_feature_entry, 2, new_feature_code),
                     high,
-                    "Unable to get new enum code from edcs enum mapping "
-                        "entry");
+                    "Unable to get new feature code from edcs feature mapping entry");
 
-                // Get the new attribute label.
-                //
-                ASSERT(
-                    edcs_config_options_ptr->value(
-                        edcs_enum_entry, 8, new_attribute_label),
-                    high,
-                    "Unable to get new attribute label from edcs enum mapping "
-                        "entry");
+                feature_labels_to_codes.insert(
+                    FeatureLabelsToCodes::value_type(new_feature_label, new_feature_code));
+                feature_codes_to_labels.insert(
+                    FeatureCodesToLabels::value_type(new_feature_code, new_feature_label));
+            }
 
-                // Add the attribute mappings that come out of the enumeration
+            //for debug
+            //dump_feature_labels_to_codes();
+            //dump_feature_codes_to_labels();
+
+            if (edcs_config_options_ptr)
+            {
+                delete edcs_config_options_ptr;
+                edcs_config_options_ptr = 0;
+            }
+
+            // Read in Attribute Mapping data and set up maps
+
+            AttributeLabel
+                new_attribute_label;
+
+            CORE::Int32
+                new_attribute_code;
+
+            std::string
+                new_data_type_string;
+
+            edcs_config_options_ptr =
+                new CORE::ConfigurationOptions(edcs_attribute_mapping_filename);
+
+            ASSERT(
+                edcs_config_options_ptr,
+                fatal,
+                "Could not allocate the memory for the ConfigurationOptions "
+                    "class!");
+
+            ASSERT(
+                edcs_config_options_ptr->is_ready(),
+                fatal,
+                "Could not parse the edcs attribute mapping configuration file " +
+                edcs_attribute_mapping_filename);
+
+            CORE::VecofCells
+                edcs_attribute_table,
+                edcs_attribute_entry;
+
+            // Get the attribute mapping table.
+            //
+            ASSERT(
+                edcs_config_options_ptr->value(
+                    "AttributeMapping", edcs_attribute_table),
+                high,
+                "Unable to get edcs attribute mapping.");
+
+            // Iterate through the entries.
+            //
+            //  ( old_attr_code,  old_data_type,  old_attr_label,
+            //    new_attr_code,  new_data_type,  new_attr_label)
+
+            for (int i = 0; i < edcs_attribute_table.size(); ++i)
+            {
+                new_data_type_string = "";
+                new_attribute_label = "";
+                new_attribute_code = -999;
+
+                ASSERT(edcs_config_options_ptr->value(edcs_attribute_table, i, edcs_attribute_entry),
+                    high,
+                    "Unable to get entry from edcs attribute mapping");
+
+                // Get the new attribute code.
+                //
+                ASSERT(edcs_config_options_ptr->value(edcs_attribute_entry, 3, new_attribute_code),
+                    high,
+                    "Unable to get new attribute code from edcs attribute mapping entry");
+
+                // Get the new attribute data type.
+                //
+                ASSERT(edcs_config_options_ptr->value(edcs_attribute_entry, 4, new_data_type_string),
+                    high,
+                    "Unable to get new data type from edcs attribute mapping entry");
+
+                // Get the new attribute label.
+                //
+                ASSERT(edcs_config_options_ptr->value(edcs_attribute_entry, 5, new_attribute_label),
+                    high,
+                    "Unable to get new attribute label from edcs attribute mapping entry");
+
+//should we ignore attribute mappings for enumeration types here? MMR
+                // Store the attribute mappings.
+                //
+                if (new_data_type_string != "DELETED" and
+                    new_data_type_string != "REMOVED" and
+                    new_attribute_label != "" and
+                    new_attribute_code != 0)
+                {
+                    attribute_labels_to_codes.insert(
+                        AttributeLabelsToCodes::value_type(
+                            new_attribute_label, new_attribute_code));
+
+                    attribute_codes_to_labels.insert(
+                        AttributeCodesToLabels::value_type(
+                            new_attribute_code, new_attribute_label));
+                }
+            }
+
+            //for debug
+            //dump_attribute_labels_to_codes();
+            //dump_attribute_codes_to_labels();
+
+            if (edcs_config_options_ptr)
+            {
+                delete edcs_config_options_ptr;
+                edcs_config_options_ptr = 0;
+            }
+
+            // Read in Enumerant Mapping data and set up maps
+
+            CORE::Int32
+                new_enumerant_code;
+
+            AttributeEnumCodePair
+                attribute_enum_code;
+
+            std::string
+                mapping_type,
+                new_enumerant_label_string;
+
+            edcs_config_options_ptr =
+                new CORE::ConfigurationOptions(edcs_attrib_enum_mapping_filename);
+
+            ASSERT(
+                edcs_config_options_ptr,
+                fatal,
+                "Could not allocate the memory for the ConfigurationOptions "
+                    "class!");
+
+            ASSERT(
+                edcs_config_options_ptr->is_ready(),
+                fatal,
+                "Could not parse the edcs enumerant mapping configuration file " +
+                edcs_attrib_enum_mapping_filename);
+
+            CORE::VecofCells
+                edcs_enum_table,
+                edcs_enum_entry;
+
+            // Get the enumerant mapping table.
+            //
+            ASSERT(edcs_config_options_ptr->value("EnumerantMapping", edcs_enum_table),
+                high, "Unable to get edcs enumerant mapping");
+
+            // Iterate through the entries.
+            //
+            // 0 old_attr_code, 1 old_enum_code, 2 old_attr_label, 3 old_enum_label,
+            // 4 mapping_type,  5 data_type,
+            // 6 new_attr_code, 7 new_enum_code, 8 new_attr_label, 9 new_enum_label
+
+            for (int i = 0; i < edcs_enum_table.size(); ++i)
+            {
+                ASSERT(
+                    edcs_config_options_ptr->value(
+                        edcs_enum_table, i, edcs_enum_entry),
+                    high,
+                    "Unable to get entry from edcs enum mapping");
+
+                // Get the mapping type.
+                //
+                ASSERT(
+                    edcs_config_options_ptr->value(
+                        edcs_enum_entry, 4, mapping_type),
+                    high,
+                    "Unable to get mapping type from edcs enum mapping entry");
+
+                // Get the new attribute data type.
+                //
+                ASSERT(
+                    edcs_config_options_ptr->value(
+                        edcs_enum_entry, 5, new_data_type_string),
+                    high,
+                    "Unable to get new data type from edcs enum mapping "
+                        "entry");
+
+                // Get the new attribute code.
+                //
+                ASSERT(
+                    edcs_config_options_ptr->value(
+                        edcs_enum_entry, 6, new_attribute_code),
+                    high,
+                    "Unable to get new attribute code from edcs enum mapping "
+                        "entry");
+
+                // Get the new enumerant code.
+                //
+                ASSERT(
+                    edcs_config_options_ptr->value(
+                        edcs_enum_entry, 7, new_enumerant_code),
+                    high,
+                    "Unable to get new enum code from edcs enum mapping "
+                        "entry");
+
+                // Get the new attribute label.
+                //
+                ASSERT(
+                    edcs_config_options_ptr->value(
+                        edcs_enum_entry, 8, new_attribute_label),
+                    high,
+                    "Unable to get new attribute label from edcs enum mapping "
+                        "entry");
+
+                // Add the attribute mappings that come out of the enumeration
                 // mapping file.
                 //
                 if (mapping_type != "DELETED" and mapping_type != "REMOVED")
@@ -1204,7 +1954,8 @@ namespace FARM
                     attribute_codes_to_labels.insert(AttributeCodesToLabels::
                         value_type(new_attribute_code, new_attribute_label));
 
-                    if (new_data_type_string == "ENUM")
+                    if (new_data_type_string == "ENUM" or
+                        new_data_type_string == "ENUMERATION")
                     {
                         // If the new data is an enumeration, populate these
                         // maps for cross-referencing.
@@ -1257,6 +2008,9 @@ namespace FARM
                 attribute_codes_to_labels.size() and
                 enum_labels_to_codes.size() and
                 enum_codes_to_labels.size();
+
+            build_label_filters();
+            build_code_indexes();
         }
 
         return edcs_maps_initialized;
@@ -1270,6 +2024,9 @@ namespace FARM
     //
     void FeatureAttributeMapping::read_fdf(const std::string &fdf_file_label)
     {
+        StartupTracePhase
+            phase("FeatureAttributeMapping::read_fdf");
+
         FeatureLabel
             label;
         FeatureGeometry
@@ -1401,6 +2158,9 @@ namespace FARM
     //
     void FeatureAttributeMapping::read_adf(const std::string &adf_file_label)
     {
+        StartupTracePhase
+            phase("FeatureAttributeMapping::read_adf");
+
         AttributeLabel
             attribute_label;
         std::string
@@ -2031,1150 +2791,2233 @@ namespace FARM
     // feature types contain and also what the different feature types are used
     // for.
     //
-    void FeatureAttributeMapping::read_faa(const std::string &faa_file_label)
+    void FeatureAttributeMapping::read_faa(const std::string &faa_file_label)
+    {
+        StartupTracePhase
+            phase("FeatureAttributeMapping::read_faa");
+
+        FeatureLabel
+            feature_label;
+        std::string
+            token;
+        FeatureGeometry
+            feature_geometry = null;
+        FeatureLabelsGeometriesToCategories::const_iterator
+            iterator;
+        bool
+            found_next_feature;
+        std::ifstream
+            faa_file(faa_file_label.c_str());
+
+        ASSERT(
+            faa_file.is_open(),
+            fatal,
+            "Could not open the FAA file '" + faa_file_label + "'!");
+
+        // Initialize the FARM to the correct size and initialize all of the
+        // pointers in it to null.
+        //
+        farm.resize(feature_categories_to_features.size());
+
+        for (int row = 0; row < farm.size(); ++ row)
+        {
+            farm[row].resize(attribute_codes_to_attributes.size());
+            for (int attr=0; attr < attribute_codes_to_attributes.size(); attr++)
+            {
+                farm[row][attr]=0;
+            }
+
+        }
+
+        // Read the feature label, FACC, geometry, usages, attributes, and
+        // attribute ranges for all of the possible features in the terrain
+        // database.
+        //
+        ASSERT(
+            get_next_string(faa_file, feature_label),
+            fatal,
+            "Could not get the label for a feature in the FAA file!");
+
+        std::string
+            next_geometry = "";
+
+        do
+        {
+            // Read the geometry.
+            //
+            if (next_geometry == "")
+            {
+                bool success = get_next_string(faa_file, token);
+                if (not success)
+                {
+                    std::cout << "Failed to get geometry for " <<
+                        feature_label << std::endl;
+                }
+
+                ASSERT(
+                    success,
+                    fatal,
+                    "Could not get the geometry for a feature in the FAA file!");
+            }
+            else
+            {
+                token = next_geometry;
+            }
+
+            // Convert the string to a geometry.
+            //
+            if (token == farm_point)
+            {
+                feature_geometry = point;
+            }
+            else if (token == farm_linear)
+            {
+                feature_geometry = linear;
+            }
+            else if (token == farm_areal)
+            {
+                feature_geometry = areal;
+            }
+            else
+            {
+                LOG_WITH_STREAM(
+                    fatal,
+                    "Found an unknown feature geometry in the FAA file for label:" <<
+                    feature_label << ".  The geometry was '" << token << "'.");
+            }
+
+            // Calculate the feature category.
+            //
+            iterator = feature_labels_and_geometries_to_categories.find(
+                FeatureLabelAndGeometry(feature_label, feature_geometry));
+
+            ASSERT(
+                iterator != feature_labels_and_geometries_to_categories.end(),
+                fatal,
+                "Found an invalid feature label in the FAA file: EC_Label: " +
+                    feature_label + "; Geometry: " + token);
+
+            // Read the usages and attributes in the feature.
+
+            found_next_feature = false;
+
+            bool
+                got_next_string = get_next_string(faa_file, token);
+            std::string
+                next_token = token;
+
+        #if EDM_DEBUG
+            std::cout <<
+                "Parsing attributes for: " << feature_geometry << ":" <<
+                feature_label << "\n" << std::flush;
+        #endif
+
+            while (not found_next_feature and got_next_string)
+            {
+                  if (not updated_usage_bitmask(token,
+                      feature_categories_to_features[iterator->second]))
+                {
+                    next_token = token;
+
+                #if EDM_DEBUG
+                    std::cout <<
+                        "\tnext_token: " << next_token << "\n" << std::flush;
+                #endif
+
+                    found_next_feature = not (
+                        read_attribute_ranges(
+                            faa_file,
+                            next_token,
+                            next_geometry,
+                            iterator->second));
+
+                    if (next_geometry != "")
+                    {
+                        found_next_feature = true;
+                    }
+
+                    if (found_next_feature)
+                    {
+                        // Calculate the offsets and overlay size for the
+                        // attributes in the feature.
+                        //
+                        calculate_offsets_overlay_size(iterator->second);
+
+                        // The token was a feature label.
+                        //
+                        feature_label = next_token;
+                    }
+                    else if (not faa_file.eof() and next_token == "")
+                    {
+                        got_next_string = get_next_string(faa_file, next_token);
+                    }
+                    else
+                    {
+                        got_next_string = true;
+                    }
+                    token = next_token;
+                }
+                else
+                {
+                    ASSERT(
+                        get_next_string(faa_file, token),
+                        fatal,
+                        "Failed to get next token!!");
+                }
+            }
+        }
+        while (found_next_feature);
+
+        // Calculate the offsets and overlay size for the attributes in the
+        // last feature in the FAA file.
+        //
+        calculate_offsets_overlay_size(iterator->second);
+
+        ASSERT(
+            faa_file.eof(),
+            fatal,
+            "Did not read the entire FAA file!");
+
+        // Ensure that all of the features contains at least one attribute and
+        // usage.
+        //
+        for (int i = 0;
+            i < feature_categories_to_features.size();
+            ++i)
+        {
+            if (feature_categories_to_features[i].valid()
+                and
+                0 >= feature_categories_to_features[i].get_attributes_overlay_size())
+            {
+                std::cout << "Feature does not contain an attribute:  " <<
+                    feature_categories_to_features[i] << std::endl;
+
+                ASSERT(
+                0 < feature_categories_to_features[i].get_attributes_overlay_size(),
+                    info,
+                    "A feature did not contain at least one attribute!");
+
+                if ( ! feature_categories_to_features[i].get_usage_bitmask() )
+                {
+                    std::cout << "Feature does not contain a usage:  " <<
+                        feature_categories_to_features[i] << std::endl;
+                }
+
+                ASSERT(
+                    feature_categories_to_features[i].get_usage_bitmask(),
+                    info,
+                    "A feature did not contain at least one usage!");
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Reads the FARM table (2-dimensional array that maps features to
+    // attributes) from a binary stream.
+    //
+    void FeatureAttributeMapping::read_farm_table(BinaryReader &reader)
+    {
+        StartupTracePhase
+            phase("FeatureAttributeMapping::read_farm_table");
+
+        CORE::UInt16
+            num_rows,
+            num_columns,
+            code_max=0,
+            data_type;
+        std::vector<CORE::UInt16>
+            file_codes;
+        std::vector<AttributeCode>
+            codes;
+
+        // Read the dimensions of the FARM table.
+        //
+        local_read(reader, num_rows);
+        local_read(reader, num_columns);
+
+        // The column codes are read as one block.
+        //
+        file_codes.resize(num_columns);
+        reader.read_array(file_codes.data(), num_columns);
+
+        codes.reserve(num_columns);
+
+        for( int column = 0; column < num_columns; ++column )
+        {
+            if (file_codes[column] > code_max)
+              code_max=file_codes[column];
+
+            codes.push_back(static_cast<AttributeCode>(file_codes[column]));
+        }
+
+        farm.resize(num_rows);
+
+        // Read the entries in the FARM table.
+        //
+        for (int row = 0; row < farm.size();  ++row)
+        {
+            // resize to the possible number of attributes for each category
+            //
+            farm[row].resize(code_max+1);
+
+            for (int column = 0; column < num_columns; ++column)
+            {
+                // Read the data type for the table entry.  Allocate memory for
+                // and read the table entry if need be.
+                //
+                local_read(reader, data_type);
+
+                switch (data_type)
+                {
+                    case no_data_type:
+                    {
+                        // The feature does not contain the attribute.
+                        //
+                        farm[row][codes[column]]=0;
+                        break;
+                    }
+
+                    case int32:
+                    {
+                        farm[row][codes[column]]=
+                             new InstantiatedDataType<CORE::Int32>();
+
+                        ASSERT(
+                            farm[row][codes[column]],
+                            fatal,
+                            "Could not allocate memory for an entry in the "
+                                "FARM table!");
+                        break;
+                    }
+
+                    case float64:
+                    {
+                        farm[row][codes[column]]=
+                             new InstantiatedDataType<CORE::Float64>();
+
+                        ASSERT(
+                            farm[row][codes[column]],
+                            fatal,
+                            "Could not allocate memory for an entry in the "
+                                "FARM table!");
+                        break;
+                    }
+
+                    case string:
+                    {
+                        farm[row][codes[column]]= new StringDataType();
+
+                        ASSERT(
+                            farm[row][codes[column]],
+                            fatal,
+                            "Could not allocate memory for an entry in the "
+                                "FARM table!");
+                        break;
+                    }
+
+                    case enumeration:
+                    {
+                        farm[row][codes[column]]= new EnumerantDataType();
+
+                        ASSERT(
+                            farm[row][codes[column]],
+                            fatal,
+                            "Could not allocate memory for an entry in the "
+                                "FARM table!");
+                        break;
+                    }
+
+                    case boolean:
+                    {
+                        farm[row][codes[column]]= new BooleanDataType();
+
+                        ASSERT(
+                            farm[row][codes[column]],
+                            fatal,
+                            "Could not allocate memory for an entry in the "
+                                "FARM table!");
+                        break;
+                    }
+
+                    case uuid:
+                    {
+                        farm[row][codes[column]]= new UUIDDataType();
+
+                        ASSERT(
+                            farm[row][codes[column]],
+                            fatal,
+                            "Could not allocate memory for an entry in the "
+                                "FARM table!");
+                        break;
+                    }
+
+                    default:
+                    {
+                        LOG(
+                            fatal,
+                            "Found an unsupported data type in the FARM "
+                                "binary file!  DataType:  " +
+                                CORE::to_string(data_type) );
+
+                        break;
+                    }
+                };
+
+                if (farm[row][codes[column]])
+                {
+                    // The feature contains the attribute.
+                    //
+                    farm[row][codes[column]]->read(reader);
+                }
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes the FARM table (2-dimensional array that maps features to
+    // attributes) to a binary stream.
+    //
+    void FeatureAttributeMapping::write_farm_table(BinaryWriter &writer)
+    {
+        decode_all_rows();
+
+        ASSERT(
+            farm.size(),
+            fatal,
+            "There are no features in the FARM!");
+
+        ASSERT(
+            farm[0].size(),
+            fatal,
+            "There are no attributes in the FARM!");
+
+        // Write the dimensions of the FARM table.
+        //
+        local_write(
+            writer, static_cast<CORE::UInt16>(farm.size()));
+        int
+            count=0;
+        for (int attr=0; attr < attribute_codes_to_attributes.size(); attr++)
+        {
+             if(attribute_codes_to_attributes[attr].valid())
+                 count++;
+        }
+        local_write(
+            writer,
+            static_cast<CORE::UInt16>(count));
+
+        std::vector<CORE::UInt16>
+            file_codes;
+
+        file_codes.reserve(count);
+
+        for (int attr=0; attr < attribute_codes_to_attributes.size(); attr++)
+        {
+            if(attribute_codes_to_attributes[attr].valid())
+            file_codes.push_back(static_cast<CORE::UInt16>(attr));
+        }
+
+        // The column codes are written as one block.
+        //
+        writer.write_array(file_codes.data(), file_codes.size());
+
+        // Write the entries in the FARM table.
+        //
+        for (int row = 0; row < farm.size();  ++row)
+        {
+            ASSERT(
+                farm[0].size() == farm[row].size(),
+                fatal,
+                "Two rows in the FARM were not the same size!\n"
+                "farm[0] = " + CORE::to_string(farm[0].size()) +
+                "; farm[" + CORE::to_string(row) + "] = " +
+                CORE::to_string(farm[row].size()));
+
+           for (int attr=0; attr < attribute_codes_to_attributes.size(); attr++)
+            {
+                int
+                    column = attr;
+
+                // Write the table entry.
+                //
+                if (attribute_codes_to_attributes[attr].valid())
+                    if(not farm[row][column])
+                {
+                    // The feature does not contain the attribute.
+                    //
+                    local_write(
+                        writer, static_cast<CORE::UInt16>(no_data_type));
+                }
+                else
+                {
+                    // The feature contains the attribute.  Write the correct
+                    // data type for the attribute.
+                    //
+                    if (dynamic_cast<InstantiatedDataType<CORE::Int32> *>(
+                        farm[row][column]))
+                    {
+                        local_write(writer, static_cast<CORE::UInt16>(int32));
+                    }
+                    else if (dynamic_cast<InstantiatedDataType<
+                        CORE::Float64> *>(farm[row][column]))
+                    {
+                        local_write(
+                            writer, static_cast<CORE::UInt16>(float64));
+                    }
+                    else if (dynamic_cast<StringDataType *>(
+                        farm[row][column]))
+                    {
+                        local_write(writer, static_cast<CORE::UInt16>(string));
+                    }
+                    else if (dynamic_cast<EnumerantDataType *>(
+                        farm[row][column]))
+                    {
+                        local_write(
+                            writer, static_cast<CORE::UInt16>(enumeration));
+                    }
+                    else if(dynamic_cast<BooleanDataType *>(farm[row][column]))
+                    {
+                        local_write(
+                            writer, static_cast<CORE::UInt16>(boolean));
+                    }
+                    else if (dynamic_cast<UUIDDataType *>(
+                        farm[row][column]))
+                    {
+                        local_write(writer, static_cast<CORE::UInt16>(uuid));
+                    }
+                    else
+                    {
+                        LOG(
+                            fatal,
+                            "Found an unsupported data type for an entry in "
+                                "the FARM!");
+                    }
+
+                    farm[row][column]->write(writer);
+                }
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes the feature labels and geometries to feature categories map to
+    // the binary stream in a format that the terrain compiler can read.
+    //
+    void FeatureAttributeMapping::dump_feature_labels_geometries_to_categories(
+        BinaryWriter &writer
+    )
+    {
+        FeatureLabelsGeometriesToCategories::const_iterator
+            iter = feature_labels_and_geometries_to_categories.begin();
+
+        // Write the number of items in the map.
+        //
+        CORE::Int32
+            int32 = feature_labels_and_geometries_to_categories.size();
+
+        writer.write(int32);
+
+        // Write the items in the map.
+        //
+        while (iter != feature_labels_and_geometries_to_categories.end())
+        {
+            writer.write_core_string(iter->first.first);
+            int32 = iter->first.second;
+            writer.write(int32);
+            int32 = iter->second;
+            writer.write(int32);
+
+            ++iter;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Reads the feature labels and geometries to feature categories map from
+    // the binary stream.
+    //
+    void FeatureAttributeMapping::load_feature_labels_geometries_to_categories(
+        BinaryReader &reader
+    )
+    {
+        StartupTracePhase
+            phase(
+                "FeatureAttributeMapping::load_feature_labels_geometries_to_categories");
+
+        CORE::Int32
+            num_features,
+            int32;
+        FeatureLabelAndGeometry
+            label_and_geometry;
+        FeatureCategory
+            category;
+
+        feature_labels_and_geometries_to_categories.clear();
+
+        // Read the number of items in the map.
+        //
+        reader.read(num_features);
+
+        // Read the items in the map.
+        //
+        for (int index = 0; index < num_features; ++index)
+        {
+            // Read the feature label.
+            //
+            reader.read_core_string(label_and_geometry.first);
+
+            // Read the geometry.
+            //
+            reader.read(int32);
+            label_and_geometry.second = static_cast<FeatureGeometry>(int32);
+
+            // Read the category.
+            //
+            reader.read(int32);
+            category = int32;
+
+            ASSERT(
+                feature_labels_and_geometries_to_categories.insert(
+                    FeatureLabelsGeometriesToCategories::value_type(
+                        label_and_geometry, category)).second,
+                fatal,
+                "Could not insert a feature label and geometry.");
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes the feature categories to features map to the binary stream in a
+    // format that the terrain compiler can read.
+    //
+    void FeatureAttributeMapping::dump_feature_categories_to_features(
+        BinaryWriter &writer
+    )
+    {
+        // Write the number of items in the map.  Only the valid features are
+        // written, which is what the loader expects.
+        //
+        CORE::Int32
+            int32 = 0;
+
+        for (int i=0; i < feature_categories_to_features.size(); i++)
+            if (feature_categories_to_features[i].valid())
+                ++int32;
+
+        writer.write(int32);
+
+        // Write the items in the map.
+        //
+        for (int i=0; i < feature_categories_to_features.size(); i++)
+            if (feature_categories_to_features[i].valid())
+            {
+                int32 = i;
+                writer.write(int32);
+                feature_categories_to_features[i].dump(writer);
+            }
+    }
+
+    // ------------------------------------------------------------------------
+    // Reads the feature categories to features map from the binary stream.
+    //
+    void FeatureAttributeMapping::load_feature_categories_to_features(
+        BinaryReader &reader
+    )
+    {
+        StartupTracePhase
+            phase(
+                "FeatureAttributeMapping::load_feature_categories_to_features");
+
+        CORE::Int32
+            num_features,
+            category;
+        Feature
+            feature;
+
+        feature_categories_to_features.clear();
+
+        // Read the number of items in the map.
+        //
+        reader.read(num_features);
+
+        feature_categories_to_features.resize(num_features);
+
+        // Read the items in the map.
+        //
+        for (int index = 0; index < num_features; ++index)
+        {
+            // Read the category.
+            //
+            reader.read(category);
+
+            // Read the FARM feature.
+            //
+            feature.load(reader);
+
+            if(feature_categories_to_features.size() < category+1)
+                feature_categories_to_features.resize(category+1);
+
+            feature_categories_to_features[category]=feature;
+            ASSERT(
+                feature_categories_to_features[category].valid(),
+                fatal,
+                "Could not add a feature category.");
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes the attribute codes to attributes map to the binary stream in a
+    // format that the terrain compiler can read.
+    //
+    void FeatureAttributeMapping::dump_attribute_codes_to_attributes(
+        BinaryWriter &writer
+    )
+    {
+
+        // Write the number of items in the map.  Only the valid attributes
+        // are written, each with its code followed by the attribute.
+        //
+        CORE::Int32
+            int32 = 0;
+
+        for (int attr=0; attr < attribute_codes_to_attributes.size(); attr++)
+            if (attribute_codes_to_attributes[attr].valid())
+                ++int32;
+
+        writer.write(int32);
+
+        // Write the items in the map.
+        //
+        for (int attr=0; attr < attribute_codes_to_attributes.size(); attr++)
+        {
+            if (attribute_codes_to_attributes[attr].valid())
+            {
+                int32 = attr;
+                writer.write(int32);
+                attribute_codes_to_attributes[attr].dump(writer);
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Reads the attribute codes to attributes map from the binary stream.
+    //
+    void FeatureAttributeMapping::load_attribute_codes_to_attributes(
+        BinaryReader &reader
+    )
+    {
+        StartupTracePhase
+            phase(
+                "FeatureAttributeMapping::load_attribute_codes_to_attributes");
+
+        CORE::Int32
+            num_attributes,
+            attribute_code;
+        Attribute
+            attribute;
+
+        attribute_codes_to_attributes.clear();
+
+        // Read the number of items in the map.
+        //
+        reader.read(num_attributes);
+
+       attribute_codes_to_attributes.resize(num_attributes+1);
+
+        // Read the items in the map.
+        //
+        for (int index = 0; index < num_attributes; ++index)
+        {
+            // Read the attribute code.
+            //
+            reader.read(attribute_code);
+
+            // Read the FARM attribute.
+            //
+            attribute.load(reader);
+
+            if(attribute_codes_to_attributes.size()< attribute_code+1)
+                attribute_codes_to_attributes.resize(attribute_code+1);
+
+           attribute_codes_to_attributes[attribute_code]=attribute;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes the attribute codes to enums map to the binary stream in a format
+    // that the terrain compiler can read.
+    //
+    void FeatureAttributeMapping::dump_attribute_codes_to_enums(
+        BinaryWriter &writer
+    )
+    {
+        AttributeCodesToEnums::const_iterator
+            attr_iter = attribute_codes_to_enums.begin();
+        AttributeEnums::const_iterator
+            enum_iter;
+
+        // Write the number of items in the map.
+        //
+        CORE::Int32
+            int32 = attribute_codes_to_enums.size();
+
+        writer.write(int32);
+
+        // Write the items in the map.
+        //
+        while (attr_iter != attribute_codes_to_enums.end())
+        {
+            // Write the attribute code.
+            //
+            int32 = attr_iter->first;
+            writer.write(int32);
+
+            // Write the number of enumerations for the attribute.
+            //
+            int32 = attr_iter->second.size();
+            writer.write(int32);
+
+            // Write the enumerations for the attribute.
+            //
+            enum_iter = attr_iter->second.begin();
+
+            while (enum_iter != attr_iter->second.end())
+            {
+                int32 = enum_iter->first;
+                writer.write(int32);
+
+                enum_iter->second.dump(writer);
+
+                ++enum_iter;
+            }
+
+            ++attr_iter;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Reads the attribute codes to enums map from the binary stream.
+    //
+    void FeatureAttributeMapping::load_attribute_codes_to_enums(
+        BinaryReader &reader
+    )
+    {
+        StartupTracePhase
+            phase("FeatureAttributeMapping::load_attribute_codes_to_enums");
+
+        CORE::Int32
+            num_attributes,
+            attr_code,
+            num_enums,
+            enum_code;
+        std::pair<AttributeCodesToEnums::iterator, bool>
+            insert_result;
+        Enumerant
+            enum_value;
+
+        attribute_codes_to_enums.clear();
+
+        // Read the number of items in the map.
+        //
+        reader.read(num_attributes);
+        // Read the items in the map.
+        //
+        for (int attr_index = 0; attr_index < num_attributes; ++attr_index)
+        {
+            // Read the attribute code.
+            //
+            reader.read(attr_code);
+
+            // Insert the attribute code in the map.
+            //
+            insert_result = attribute_codes_to_enums.insert(
+                AttributeCodesToEnums::value_type(
+                    attr_code, AttributeEnums()));
+
+            ASSERT(
+                insert_result.second,
+                fatal,
+                "Could not add an attribute code.");
+
+            // Read the number of enumerations for the attribute.
+            //
+            reader.read(num_enums);
+
+            // Read the enumerations for the attribute.
+            //
+            for (int enum_index = 0; enum_index < num_enums; ++enum_index)
+            {
+                // Read the enumeration code.
+                //
+                reader.read(enum_code);
+
+                // Read the enumeration.
+                //
+                enum_value.load(reader);
+
+                ASSERT(
+                    insert_result.first->second.insert(AttributeEnums::
+                        value_type(enum_code, enum_value)).second,
+                    fatal,
+                    "Could not add an enumeration.");
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes the FARM table to the binary stream in a format that the terrain
+    // compiler can read.
+    //
+    void FeatureAttributeMapping::dump_farm_table(BinaryWriter &writer)
+    {
+        decode_all_rows();
+
+        // Write the number of feature categories.
+        //
+        writer.write(static_cast<CORE::Int32>(farm.size()));
+
+        for (int index = 0; index < farm.size(); ++index)
+        {
+            dump_farm_table_row(writer, index);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes a row of the FARM table to the binary stream in a format that
+    // the terrain compiler can read.
+    //
+    void FeatureAttributeMapping::dump_farm_table_row(
+        BinaryWriter &writer,
+        int index
+    )
+    {
+        FarmAttributeCodeToDataType::const_iterator
+            iter;
+
+        // Write the number of attributes for the feature.
+        //
+        CORE::Int32
+            int32 = farm[index].size(),
+            is_present=0;
+
+        writer.write(int32);
+
+        // Write the attributes for the feature.
+        //
+        iter = farm[index].begin();
+        int32=0;
+        while (iter != farm[index].end())
+        {
+            // Write the attribute code.
+            //
+            writer.write(int32);
+
+            // Write whether the feature contains the attribute.
+            //
+            is_present = *iter ? 1 : 0;
+            writer.write(is_present);
+
+            if (*iter)
+            {
+                // Write the data for the attribute.
+                //
+                (*iter)->dump(writer);
+            }
+            ++int32;
+            ++iter;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Reads the FARM table from the binary stream.
+    //
+    void FeatureAttributeMapping::load_farm_table(BinaryReader &reader)
     {
-        FeatureLabel
-            feature_label;
-        std::string
-            token;
-        FeatureGeometry
-            feature_geometry = null;
-        FeatureLabelsGeometriesToCategories::const_iterator
-            iterator;
-        bool
-            found_next_feature;
-        std::ifstream
-            faa_file(faa_file_label.c_str());
+        StartupTracePhase
+            phase("FeatureAttributeMapping::load_farm_table");
 
-        ASSERT(
-            faa_file.is_open(),
-            fatal,
-            "Could not open the FAA file '" + faa_file_label + "'!");
+        CORE::Int32
+            num_features;
 
-        // Initialize the FARM to the correct size and initialize all of the
-        // pointers in it to null.
+        // Read the number of feature categories.
         //
-        farm.resize(feature_categories_to_features.size());
+        reader.read(num_features);
+        farm.resize(num_features);
 
-        for (int row = 0; row < farm.size(); ++ row)
+        for (int feat_index = 0; feat_index < farm.size(); ++feat_index)
         {
-            farm[row].resize(attribute_codes_to_attributes.size());
-            for (int attr=0; attr < attribute_codes_to_attributes.size(); attr++)
-            {
-                farm[row][attr]=0;
-            }
-
+            load_farm_table_row(reader, feat_index);
         }
+    }
 
-        // Read the feature label, FACC, geometry, usages, attributes, and
-        // attribute ranges for all of the possible features in the terrain
-        // database.
+    // ------------------------------------------------------------------------
+    // Reads a row of the FARM table from the binary stream.  The attributes
+    // must have been loaded.  Rows can be read by several threads at once.
+    //
+    void FeatureAttributeMapping::load_farm_table_row(
+        BinaryReader &reader,
+        int feat_index
+    )
+    {
+        CORE::Int32
+            num_attributes,
+            attr_code,
+            contains_attr;
+        DataType
+            *data_type = NULL;
+
+        // Read the number of attributes for the feature.
         //
-        ASSERT(
-            get_next_string(faa_file, feature_label),
-            fatal,
-            "Could not get the label for a feature in the FAA file!");
+        reader.read(num_attributes);
 
-        std::string
-            next_geometry = "";
+        farm[feat_index].assign(
+            num_attributes, static_cast<DataType *>(0));
 
-        do
+        // Read the attributes for the feature.
+        //
+        for (int attr_index = 0; attr_index < num_attributes; ++attr_index)
         {
-            // Read the geometry.
-            //
-            if (next_geometry == "")
-            {
-                bool success = get_next_string(faa_file, token);
-                if (not success)
-                {
-                    std::cout << "Failed to get geometry for " <<
-                        feature_label << std::endl;
-                }
-
-                ASSERT(
-                    success,
-                    fatal,
-                    "Could not get the geometry for a feature in the FAA file!");
-            }
-            else
-            {
-                token = next_geometry;
-            }
-
-            // Convert the string to a geometry.
+            // Read the attribute code.
             //
-            if (token == farm_point)
-            {
-                feature_geometry = point;
-            }
-            else if (token == farm_linear)
-            {
-                feature_geometry = linear;
-            }
-            else if (token == farm_areal)
-            {
-                feature_geometry = areal;
-            }
-            else
-            {
-                LOG_WITH_STREAM(
-                    fatal,
-                    "Found an unknown feature geometry in the FAA file for label:" <<
-                    feature_label << ".  The geometry was '" << token << "'.");
-            }
+            reader.read(attr_code);
 
-            // Calculate the feature category.
+            // The code indexes both the attributes and the FARM table, so
+            // check it before either is used.
             //
-            iterator = feature_labels_and_geometries_to_categories.find(
-                FeatureLabelAndGeometry(feature_label, feature_geometry));
-
             ASSERT(
-                iterator != feature_labels_and_geometries_to_categories.end(),
+                0 <= attr_code and
+                attr_code < attribute_codes_to_attributes.size() and
+                attr_code < farm[feat_index].size(),
                 fatal,
-                "Found an invalid feature label in the FAA file: EC_Label: " +
-                    feature_label + "; Geometry: " + token);
-
-            // Read the usages and attributes in the feature.
-
-            found_next_feature = false;
-
-            bool
-                got_next_string = get_next_string(faa_file, token);
-            std::string
-                next_token = token;
+                "Found an attribute code that is out of range.");
 
-        #if EDM_DEBUG
-            std::cout <<
-                "Parsing attributes for: " << feature_geometry << ":" <<
-                feature_label << "\n" << std::flush;
-        #endif
+            // Read whether the feature contains the attribute.
+            //
+            reader.read(contains_attr);
 
-            while (not found_next_feature and got_next_string)
+            if (not contains_attr)
             {
-                  if (not updated_usage_bitmask(token,
-                      feature_categories_to_features[iterator->second]))
+                // The feature does not have the attribute.
+                //
+                data_type = 0;
+            }
+            else
+            {
+                // The feature contains the attribute.  Determine the data
+                // type for the attribute.
+                //
+                switch (attribute_codes_to_attributes[attr_code].
+                    get_data_type())
                 {
-                    next_token = token;
-
-                #if EDM_DEBUG
-                    std::cout <<
-                        "\tnext_token: " << next_token << "\n" << std::flush;
-                #endif
+                    case int32:
+                    {
+                        data_type =
+                            new InstantiatedDataType<CORE::Int32>();
+                        break;
+                    }
 
-                    found_next_feature = not (
-                        read_attribute_ranges(
-                            faa_file,
-                            next_token,
-                            next_geometry,
-                            iterator->second));
+                    case float64:
+                    {
+                        data_type =
+                            new InstantiatedDataType<CORE::Float64>();
+                        break;
+                    }
 
-                    if (next_geometry != "")
+                    case string:
                     {
-                        found_next_feature = true;
+                        data_type = new StringDataType();
+                        break;
                     }
 
-                    if (found_next_feature)
+                    case enumeration:
                     {
-                        // Calculate the offsets and overlay size for the
-                        // attributes in the feature.
-                        //
-                        calculate_offsets_overlay_size(iterator->second);
+                        data_type = new EnumerantDataType();
+                        break;
+                    }
 
-                        // The token was a feature label.
-                        //
-                        feature_label = next_token;
+                    case boolean:
+                    {
+                        data_type = new BooleanDataType();
+                        break;
                     }
-                    else if (not faa_file.eof() and next_token == "")
+
+                    case uuid:
                     {
-                        got_next_string = get_next_string(faa_file, next_token);
+                        data_type = new UUIDDataType();
+                        break;
                     }
-                    else
+
+                    default:
                     {
-                        got_next_string = true;
+                        LOG(fatal, "Found an unsupported data type.");
+                        break;
                     }
-                    token = next_token;
-                }
-                else
-                {
-                    ASSERT(
-                        get_next_string(faa_file, token),
-                        fatal,
-                        "Failed to get next token!!");
-                }
+                };
+
+                ASSERT(
+                    data_type,
+                    fatal,
+                    "Could not allocate memory for a data type.");
+
+                // Read the data for the attribute.
+                //
+                data_type->load(reader);
             }
-        }
-        while (found_next_feature);
 
-        // Calculate the offsets and overlay size for the attributes in the
-        // last feature in the FAA file.
-        //
-        calculate_offsets_overlay_size(iterator->second);
+            // Add the attribute and data type to the FARM table.  The
+            // data type is null if the feature does not have the
+            // attribute.
+            //
+            farm[feat_index][attr_code] = data_type;
+        }
+    }
 
-        ASSERT(
-            faa_file.eof(),
-            fatal,
-            "Did not read the entire FAA file!");
+    // ------------------------------------------------------------------------
+    // Initializes the FARM using a binary file.
+    //
+    void FeatureAttributeMapping::initialize_farm_from_binary_file(
+        const std::string &database_directory
+    )
+    {
+        StartupTracePhase
+            phase("FeatureAttributeMapping::initialize_farm_from_binary_file");
 
-        // Ensure that all of the features contains at least one attribute and
-        // usage.
+        // Use the compressed image when there is one.
         //
-        for (int i = 0;
-            i < feature_categories_to_features.size();
-            ++i)
+        std::string
+            compressed_file_name =
+                database_directory + "/" + farm_compressed_input_file;
+        std::ifstream
+            compressed_file(compressed_file_name.c_str());
+
+        if (compressed_file.is_open())
         {
-            if (feature_categories_to_features[i].valid()
-                and
-                0 >= feature_categories_to_features[i].get_attributes_overlay_size())
-            {
-                std::cout << "Feature does not contain an attribute:  " <<
-                    feature_categories_to_features[i] << std::endl;
+            compressed_file.close();
 
-                ASSERT(
-                0 < feature_categories_to_features[i].get_attributes_overlay_size(),
-                    info,
-                    "A feature did not contain at least one attribute!");
+            initialize_farm_from_compressed_file(compressed_file_name);
 
-                if ( ! feature_categories_to_features[i].get_usage_bitmask() )
-                {
-                    std::cout << "Feature does not contain a usage:  " <<
-                        feature_categories_to_features[i] << std::endl;
-                }
+            return;
+        }
 
-                ASSERT(
-                    feature_categories_to_features[i].get_usage_bitmask(),
-                    info,
-                    "A feature did not contain at least one usage!");
-            }
+        // Open the binary file to read.
+        //
+        std::string
+            file_name = database_directory + "/" + farm_binary_input_file;
+        std::ifstream
+            file(file_name.c_str(), std::ios::in | std::ios::binary);
+
+        ASSERT(
+            file.is_open(),
+            fatal,
+            "Could not open the file '" + file_name + "'.");
+
+        if (file.is_open())
+        {
+            // Read the tables and maps for the FARM from the file.
+            //
+            BinaryReader
+                reader(file);
+
+            load_feature_labels_geometries_to_categories(reader);
+            load_feature_categories_to_features(reader);
+            load_attribute_codes_to_attributes(reader);
+            load_attribute_codes_to_enums(reader);
+            load_farm_table(reader);
         }
     }
 
     // ------------------------------------------------------------------------
-    // Reads the FARM table (2-dimensional array that maps features to
-    // attributes) from a binary stream.
+    // Initializes the FARM using a compressed image.  The sections are
+    // decompressed and decoded by a thread per core.  When rows are decoded
+    // on demand, the FARM table sections are left compressed and the image
+    // is kept for decode_row().
     //
-    void FeatureAttributeMapping::read_farm_table(std::istream &stream)
+    void FeatureAttributeMapping::initialize_farm_from_compressed_file(
+        const std::string &file_name
+    )
     {
-        CORE::UInt16
-            num_rows,
-            num_columns,
-            code,
-            code_max=0,
-            data_type;
-        std::vector<AttributeCode>
-            codes;
+        StartupTracePhase
+            phase(
+                "FeatureAttributeMapping::initialize_farm_from_compressed_file");
 
-        // Read the dimensions of the FARM table.
-        //
-        local_read(stream, num_rows);
-        local_read(stream, num_columns);
+        std::unique_ptr<RowsOnDemand>
+            on_demand(new RowsOnDemand);
+        CompressedImageReader
+            &image = on_demand->image;
 
-        for( int column = 0; column < num_columns; ++column )
+        ASSERT(
+            image.open(file_name),
+            fatal,
+            "Could not read the file '" + file_name + "'.");
+
+        const int
+            section_count = image.get_section_count(),
+            thread_count =
+                std::max(
+                    1,
+                    std::min<int>(
+                        section_count,
+                        std::thread::hardware_concurrency()));
+        std::vector< std::vector<char> >
+            buffers(section_count);
+        std::atomic<bool>
+            successful(true);
+
+        farm.clear();
+        farm.resize(image.get_row_count());
+
+        for (int index = 0; index < section_count; ++index)
         {
-            local_read(stream, code);
+            const CompressedSection
+                &section = image.get_section(index);
 
-            if (code > code_max)
-              code_max=code;
-
-            codes.push_back(static_cast<AttributeCode>(code));
+            ASSERT(
+                section.first_row + section.row_count <= farm.size(),
+                fatal,
+                "A FARM table section in '" + file_name + "' is out of "
+                    "range.");
         }
 
-        farm.resize(num_rows);
+        if (rows_on_demand())
+        {
+            on_demand->row_sections.assign(farm.size(), -1);
+            on_demand->rows_decoded.reset(
+                new std::atomic<bool>[farm.size()]);
+            on_demand->section_mutexes.reset(new std::mutex[section_count]);
+            on_demand->sections.resize(section_count);
+            on_demand->rows_left.assign(section_count, 0);
+            on_demand->decoded_row_count = 0;
+
+            for (int index = 0; index < section_count; ++index)
+            {
+                const CompressedSection
+                    &section = image.get_section(index);
 
-        // Read the entries in the FARM table.
-        //
-        for (int row = 0; row < farm.size();  ++row)
+                if (section.kind == farm_table_section)
+                {
+                    std::fill(
+                        on_demand->row_sections.begin() + section.first_row,
+                        on_demand->row_sections.begin() +
+                            section.first_row + section.row_count,
+                        index);
+
+                    on_demand->rows_left[index] = section.row_count;
+                }
+            }
+
+            for (int row = 0; row < farm.size(); ++row)
+            {
+                on_demand->rows_decoded[row] =
+                    on_demand->row_sections[row] < 0;
+            }
+
+            // The first pass reads the row index into the table.
+            //
+            rows_on_demand_table = on_demand.get();
+        }
+
+        for (int pass = 0; pass < (rows_on_demand_table ? 1 : 2); ++pass)
         {
-            // resize to the possible number of attributes for each category
+            std::atomic<int>
+                next_section(0);
+            std::vector<std::thread>
+                workers;
+
+            for (int i = 1; i < thread_count; ++i)
+            {
+                workers.push_back(std::thread(
+                    &FeatureAttributeMapping::decode_compressed_sections,
+                    std::cref(image),
+                    std::ref(buffers),
+                    std::ref(next_section),
+                    std::ref(successful),
+                    pass == 1));
+            }
+
+            // This thread works through the sections too.
             //
-            farm[row].resize(code_max+1);
+            decode_compressed_sections(
+                image, buffers, next_section, successful, pass == 1);
 
-            for (int column = 0; column < num_columns; ++column)
+            for (std::vector<std::thread>::iterator
+                worker_itr = workers.begin();
+                worker_itr != workers.end();
+                ++worker_itr)
             {
-                // Read the data type for the table entry.  Allocate memory for
-                // and read the table entry if need be.
+                worker_itr->join();
+            }
+        }
+
+        ASSERT(
+            successful,
+            fatal,
+            "Could not decode the file '" + file_name + "'.");
+
+        if (rows_on_demand_table)
+        {
+            ASSERT(
+                rows_on_demand_table->row_offsets.size() == farm.size(),
+                fatal,
+                "The row index of '" + file_name + "' does not match its "
+                    "FARM table.");
+
+            rows_decoded = on_demand.release()->rows_decoded.get();
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    void FeatureAttributeMapping::decode_compressed_sections(
+        const CompressedImageReader &image,
+        std::vector< std::vector<char> > &buffers,
+        std::atomic<int> &next_section,
+        std::atomic<bool> &successful,
+        bool decode_rows
+    )
+    {
+        for (int index = next_section++;
+             index < image.get_section_count();
+             index = next_section++)
+        {
+            const CompressedSection
+                &section = image.get_section(index);
+            std::vector<char>
+                &data = buffers[index];
+            bool
+                table_rows = section.kind == farm_table_section;
+
+            if (table_rows and rows_on_demand_table)
+            {
+                // The rows are decoded by decode_row().
                 //
-                local_read(stream, data_type);
+                continue;
+            }
 
-                switch (data_type)
+            if (not decode_rows and not image.decompress(index, data))
+            {
+                successful = false;
+            }
+            else if (decode_rows == table_rows)
+            {
+                BinaryReader
+                    reader(data.empty() ? 0 : &data[0], data.size());
+
+                switch (section.kind)
                 {
-                    case no_data_type:
+                    case feature_categories_section:
                     {
-                        // The feature does not contain the attribute.
-                        //
-                        farm[row][codes[column]]=0;
+                        load_feature_labels_geometries_to_categories(reader);
                         break;
                     }
 
-                    case int32:
+                    case features_section:
                     {
-                        farm[row][codes[column]]=
-                             new InstantiatedDataType<CORE::Int32>();
-
-                        ASSERT(
-                            farm[row][codes[column]],
-                            fatal,
-                            "Could not allocate memory for an entry in the "
-                                "FARM table!");
+                        load_feature_categories_to_features(reader);
                         break;
                     }
 
-                    case float64:
+                    case attributes_section:
                     {
-                        farm[row][codes[column]]=
-                             new InstantiatedDataType<CORE::Float64>();
-
-                        ASSERT(
-                            farm[row][codes[column]],
-                            fatal,
-                            "Could not allocate memory for an entry in the "
-                                "FARM table!");
+                        load_attribute_codes_to_attributes(reader);
                         break;
                     }
 
-                    case string:
+                    case enums_section:
                     {
-                        farm[row][codes[column]]= new StringDataType();
-
-                        ASSERT(
-                            farm[row][codes[column]],
-                            fatal,
-                            "Could not allocate memory for an entry in the "
-                                "FARM table!");
+                        load_attribute_codes_to_enums(reader);
                         break;
                     }
 
-                    case enumeration:
+                    case farm_table_section:
                     {
-                        farm[row][codes[column]]= new EnumerantDataType();
+                        for (int row = section.first_row;
+                             row < section.first_row + section.row_count;
+                             ++row)
+                        {
+                            load_farm_table_row(reader, row);
+                        }
 
-                        ASSERT(
-                            farm[row][codes[column]],
-                            fatal,
-                            "Could not allocate memory for an entry in the "
-                                "FARM table!");
                         break;
                     }
 
-                    case boolean:
+                    case row_index_section:
                     {
-                        farm[row][codes[column]]= new BooleanDataType();
-
-                        ASSERT(
-                            farm[row][codes[column]],
-                            fatal,
-                            "Could not allocate memory for an entry in the "
-                                "FARM table!");
-                        break;
-                    }
+                        // The row index is only needed to decode rows on
+                        // demand.
+                        //
+                        if (rows_on_demand_table)
+                        {
+                            CORE::Int32
+                                row_count;
+                            std::vector<CORE::Int32>
+                                &row_offsets =
+                                    rows_on_demand_table->row_offsets;
 
-                    case uuid:
-                    {
-                        farm[row][codes[column]]= new UUIDDataType();
+                            reader.read(row_count);
 
-                        ASSERT(
-                            farm[row][codes[column]],
-                            fatal,
-                            "Could not allocate memory for an entry in the "
-                                "FARM table!");
-                        break;
-                    }
+                            if (reader.good() and
+                                row_count == static_cast<int>(farm.size()))
+                            {
+                                row_offsets.resize(row_count);
 
-                    default:
-                    {
-                        LOG(
-                            fatal,
-                            "Found an unsupported data type in the FARM "
-                                "binary file!  DataType:  " +
-                                CORE::to_string(data_type) );
+                                if (row_count > 0)
+                                {
+                                    reader.read_array(
+                                        &row_offsets[0], row_count);
+                                }
+                            }
+                        }
 
                         break;
                     }
                 };
 
-                if (farm[row][codes[column]])
+                if (not reader.good())
                 {
-                    // The feature contains the attribute.
-                    //
-                    farm[row][codes[column]]->read(stream);
+                    successful = false;
                 }
+
+                // The data is not needed once it has been decoded.
+                //
+                std::vector<char>().swap(data);
             }
         }
     }
 
     // ------------------------------------------------------------------------
-    // Writes the FARM table (2-dimensional array that maps features to
-    // attributes) to a binary stream.
-    //
-    void FeatureAttributeMapping::write_farm_table(std::ostream &stream)
+    void FeatureAttributeMapping::decode_row(
+        const FeatureCategory &feature_category
+    )
     {
+        RowsOnDemand
+            &table = *rows_on_demand_table;
+        const int
+            section = table.row_sections[feature_category];
+        std::lock_guard<std::mutex>
+            lock(table.section_mutexes[section]);
+
+        // Another thread may have decoded the row while this one waited.
+        //
+        if (table.rows_decoded[feature_category].load(
+                std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        std::vector<char>
+            &data = table.sections[section];
+
+        if (data.empty())
+        {
+            ASSERT(
+                table.image.decompress(section, data),
+                fatal,
+                "Could not decompress a section of the FARM table.");
+        }
+
+        const std::size_t
+            offset = table.row_offsets[feature_category];
+
         ASSERT(
-            farm.size(),
+            offset < data.size(),
             fatal,
-            "There are no features in the FARM!");
+            "A row of the FARM table is outside its section.");
+
+        BinaryReader
+            reader(&data[offset], data.size() - offset);
+
+        load_farm_table_row(reader, feature_category);
 
         ASSERT(
-            farm[0].size(),
+            reader.good(),
             fatal,
-            "There are no attributes in the FARM!");
+            "Could not decode a row of the FARM table.");
 
-        // Write the dimensions of the FARM table.
-        //
-        local_write(
-            stream, static_cast<CORE::UInt16>(farm.size()));
-        int
-            count=0;
-        for (int attr=0; attr < attribute_codes_to_attributes.size(); attr++)
-        {
-             if(attribute_codes_to_attributes[attr].valid())
-                 count++;
-        }
-        local_write(
-            stream,
-            static_cast<CORE::UInt16>(count));
+        table.rows_decoded[feature_category].store(
+            true, std::memory_order_release);
+        ++table.decoded_row_count;
 
-        for (int attr=0; attr < attribute_codes_to_attributes.size(); attr++)
+        // The section is not needed once all of its rows are decoded.
+        //
+        if (--table.rows_left[section] == 0)
         {
-            if(attribute_codes_to_attributes[attr].valid())
-            local_write(stream, static_cast<AttributeCode>(attr));
+            std::vector<char>().swap(data);
         }
+    }
 
-        // Write the entries in the FARM table.
-        //
-        for (int row = 0; row < farm.size();  ++row)
+    // ------------------------------------------------------------------------
+    void FeatureAttributeMapping::decode_all_rows(void)
+    {
+        if (rows_decoded)
         {
-            ASSERT(
-                farm[0].size() == farm[row].size(),
-                fatal,
-                "Two rows in the FARM were not the same size!\n"
-                "farm[0] = " + CORE::to_string(farm[0].size()) +
-                "; farm[" + CORE::to_string(row) + "] = " +
-                CORE::to_string(farm[row].size()));
-
-           for (int attr=0; attr < attribute_codes_to_attributes.size(); attr++)
+            for (int row = 0; row < farm.size(); ++row)
             {
-                int
-                    column = attr;
+                get_farm_row(row);
+            }
+        }
+    }
 
-                // Write the table entry.
-                //
-                if (attribute_codes_to_attributes[attr].valid())
-                    if(not farm[row][column])
-                {
-                    // The feature does not contain the attribute.
-                    //
-                    local_write(
-                        stream, static_cast<CORE::UInt16>(no_data_type));
-                }
-                else
-                {
-                    // The feature contains the attribute.  Write the correct
-                    // data type for the attribute.
-                    //
-                    if (dynamic_cast<InstantiatedDataType<CORE::Int32> *>(
-                        farm[row][column]))
-                    {
-                        local_write(stream, static_cast<CORE::UInt16>(int32));
-                    }
-                    else if (dynamic_cast<InstantiatedDataType<
-                        CORE::Float64> *>(farm[row][column]))
-                    {
-                        local_write(
-                            stream, static_cast<CORE::UInt16>(float64));
-                    }
-                    else if (dynamic_cast<StringDataType *>(
-                        farm[row][column]))
-                    {
-                        local_write(stream, static_cast<CORE::UInt16>(string));
-                    }
-                    else if (dynamic_cast<EnumerantDataType *>(
-                        farm[row][column]))
-                    {
-                        local_write(
-                            stream, static_cast<CORE::UInt16>(enumeration));
-                    }
-                    else if(dynamic_cast<BooleanDataType *>(farm[row][column]))
-                    {
-                        local_write(
-                            stream, static_cast<CORE::UInt16>(boolean));
-                    }
-                    else if (dynamic_cast<UUIDDataType *>(
-                        farm[row][column]))
-                    {
-                        local_write(stream, static_cast<CORE::UInt16>(uuid));
-                    }
-                    else
-                    {
-                        LOG(
-                            fatal,
-                            "Found an unsupported data type for an entry in "
-                                "the FARM!");
-                    }
+    // ------------------------------------------------------------------------
+    bool FeatureAttributeMapping::read_binary_cache(
+        const BinaryCacheKey &key
+    )
+    {
+        StartupTracePhase
+            phase("FeatureAttributeMapping::read_binary_cache");
 
-                    farm[row][column]->write(stream);
-                }
+        std::ifstream
+            file;
+        bool
+            successful = BinaryCache::open(key, file);
+
+        if (successful)
+        {
+            BinaryReader
+                reader(file);
+
+            load_feature_labels_geometries_to_categories(reader);
+            load_feature_categories_to_features(reader);
+            load_attribute_codes_to_attributes(reader);
+            load_attribute_codes_to_enums(reader);
+            load_farm_table(reader);
+
+            successful = reader.good();
+
+            if (not successful)
+            {
+                LOG(
+                    medium,
+                    "Could not read the FARM cache file '" +
+                        BinaryCache::get_file_name(key) + "'.");
+
+                clear_farm_tables();
             }
         }
+
+        return successful;
     }
 
     // ------------------------------------------------------------------------
-    // Writes the feature labels and geometries to feature categories map to
-    // the binary stream in a format that the terrain compiler can read.
-    //
-    void FeatureAttributeMapping::dump_feature_labels_geometries_to_categories(
-        std::ostream &stream
+    void FeatureAttributeMapping::write_binary_cache(
+        const BinaryCacheKey &key
     )
     {
-        FeatureLabelsGeometriesToCategories::const_iterator
-            iter = feature_labels_and_geometries_to_categories.begin();
+        StartupTracePhase
+            phase("FeatureAttributeMapping::write_binary_cache");
 
-        // Write the number of items in the map.
-        //
-        CORE::Int32
-            int32 = feature_labels_and_geometries_to_categories.size();
+        std::ofstream
+            file;
+        std::string
+            temp_file_name;
 
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+        if (BinaryCache::create(key, file, temp_file_name))
+        {
+            {
+                BinaryWriter
+                    writer(file);
+
+                dump_feature_labels_geometries_to_categories(writer);
+                dump_feature_categories_to_features(writer);
+                dump_attribute_codes_to_attributes(writer);
+                dump_attribute_codes_to_enums(writer);
+                dump_farm_table(writer);
+            }
 
-        // Write the items in the map.
+            BinaryCache::publish(key, file, temp_file_name);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    void FeatureAttributeMapping::clear_farm_tables(void)
+    {
+        // Delete the memory for the two-dimensional array.
         //
-        while (iter != feature_labels_and_geometries_to_categories.end())
+        for (int row = 0; row < farm.size(); ++row)
         {
-            CORE::dump_string(stream, iter->first.first);
-            int32 = iter->first.second;
-            stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
-            int32 = iter->second;
-            stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+            for (int col = 0; col < farm[row].size(); ++col)
+            {
+                if (farm[row][col])
+                {
+                    delete farm[row][col];
+                }
+            }
 
-            ++iter;
+            farm[row].clear();
         }
+
+        farm.clear();
+
+        rows_decoded = 0;
+        delete rows_on_demand_table;
+        rows_on_demand_table = 0;
+
+        feature_labels_and_geometries_to_categories.clear();
+        feature_categories_to_features.clear();
+        attribute_codes_to_attributes.clear();
+        attribute_codes_to_enums.clear();
+        attribute_labels_to_attributes.clear();
+        feature_code_categories.clear();
+
+        feature_traits = 0;
+        feature_traits_count = 0;
+        std::vector<char>().swap(feature_traits_storage);
     }
 
     // ------------------------------------------------------------------------
-    // Reads the feature labels and geometries to feature categories map from
-    // the binary stream.
-    //
-    void FeatureAttributeMapping::load_feature_labels_geometries_to_categories(
-        std::istream &stream
-    )
+    void FeatureAttributeMapping::build_feature_traits(void)
     {
-        CORE::Int32
-            num_features,
-            int32;
-        FeatureLabelAndGeometry
-            label_and_geometry;
-        FeatureCategory
-            category;
+        const std::size_t
+            count = feature_categories_to_features.size(),
+            bytes = count * sizeof(FeatureTraits);
+        void
+            *start;
+        std::size_t
+            space;
+        FeatureTraits
+            *traits;
+
+        feature_traits_storage.assign(bytes + cache_line_bytes, 0);
+
+        start = &feature_traits_storage[0];
+        space = feature_traits_storage.size();
+        traits =
+            static_cast<FeatureTraits *>(
+                std::align(cache_line_bytes, bytes, start, space));
+
+        for (std::size_t category = 0; category < count; ++category)
+        {
+            new (&traits[category])
+                FeatureTraits(feature_categories_to_features[category]);
+        }
 
-        feature_labels_and_geometries_to_categories.clear();
+        feature_traits = traits;
+        feature_traits_count = count;
+    }
 
-        // Read the number of items in the map.
-        //
-        stream.read(
-            reinterpret_cast<char *>(&num_features), sizeof(num_features));
+    // ------------------------------------------------------------------------
+    bool FeatureAttributeMapping::initialize(
+        const std::string &database_directory,
+        const std::string &fdf_file_label,
+        const std::string &adf_file_label,
+        const std::string &faa_file_label,
+        const std::string &edcs_3p1_4p3_feature_mapping,
+        const std::string &edcs_3p1_4p3_attribute_mapping,
+        const std::string &edcs_3p1_4p3_enum_mapping
+    )
+    {
+        StartupTracePhase
+            phase("FeatureAttributeMapping::initialize");
 
-        // Read the items in the map.
-        //
-        for (int index = 0; index < num_features; ++index)
+        bool
+            edcs_initialized = false;
+
+        if(initialized())
         {
-            // Read the feature label.
+            edcs_initialized = true;
+        }
+        else
+        {
+            // The FARM has not been initialized.  Initialize it.
             //
-            CORE::load_string(stream, label_and_geometry.first);
+            if (fdf_file_label != "" and
+                adf_file_label != "" and
+                faa_file_label != "")
+            {
+                // Initialize the software to convert EDCS 3.1 to EDCS 4.3.
+                //
+                ASSERT(
+                    EDCSConverter::initialize(
+                        edcs_3p1_4p3_feature_mapping,
+                        edcs_3p1_4p3_attribute_mapping,
+                        edcs_3p1_4p3_enum_mapping),
+                    fatal,
+                    "Could not initialize the EDCS 3.1 to EDCS 4.3 converter.");
 
-            // Read the geometry.
+                edcs_initialized = EDCSConverter::initialized();
+
+                ASSERT(
+                    edcs_initialized,
+                    fatal,
+                    "Could not initialize the EDCS data.");
+
+                // Initialize the FARM using the binary cache, if it is on and
+                // holds the FARM for the configuration files, or else using
+                // the configuration files.
+                //
+                std::vector<std::string>
+                    input_files;
+                BinaryCacheKey
+                    cache_key;
+
+                input_files.push_back(fdf_file_label);
+                input_files.push_back(adf_file_label);
+                input_files.push_back(faa_file_label);
+                input_files.push_back(edcs_3p1_4p3_feature_mapping);
+                input_files.push_back(edcs_3p1_4p3_attribute_mapping);
+                input_files.push_back(edcs_3p1_4p3_enum_mapping);
+
+                bool
+                    use_cache =
+                        BinaryCache::enabled() and
+                        BinaryCache::compute_key(input_files, cache_key);
+
+                if (not use_cache or not read_binary_cache(cache_key))
+                {
+                    read_fdf(fdf_file_label);
+                    read_adf(adf_file_label);
+                    read_faa(faa_file_label);
+
+                    if (use_cache)
+                    {
+                        write_binary_cache(cache_key);
+                    }
+                }
+            }
+            else
+            {
+                // Initialize the EDCS-related maps
+                //
+                edcs_initialized = initialize_edcs_maps(
+                    edcs_3p1_4p3_feature_mapping,
+                    edcs_3p1_4p3_attribute_mapping,
+                    edcs_3p1_4p3_enum_mapping);
+
+                ASSERT(
+                    edcs_initialized,
+                    fatal,
+                    "Could not initialize the EDCS data.");
+
+                // Initialize the FARM using the binary file.
+                //
+                initialize_farm_from_binary_file(database_directory);
+            }
+
+            build_feature_code_categories();
+            build_feature_traits();
+
+            // originally assigned to true but changed to edcs until the
+            // edcs transition is over
             //
-            stream.read(reinterpret_cast<char *>(&int32), sizeof(int32));
-            label_and_geometry.second = static_cast<FeatureGeometry>(int32);
+            farm_initialized = edcs_initialized;
+            ++generation;
 
-            // Read the category.
+            // Initialize the feature categories that are commonly used.
             //
-            stream.read(reinterpret_cast<char *>(&int32), sizeof(int32));
-            category = int32;
+            ASSERT(
+                FeatureCategories::initialize(),
+                fatal,
+                "Could not initialize the feature categories.");
 
+            // Initialize the attribute categories that are commonly used.
+            //
             ASSERT(
-                feature_labels_and_geometries_to_categories.insert(
-                    FeatureLabelsGeometriesToCategories::value_type(
-                        label_and_geometry, category)).second,
+                AttributeCategories::initialize(),
                 fatal,
-                "Could not insert a feature label and geometry.");
+                "Could not initialize the attribute categories.");
+
+            // Initialize the enumerations that are commonly used.
+            //
+            ASSERT(
+                EnumValues::initialize(),
+                fatal,
+                "Could not initialize the commonly used enumeration values.");
+
+            attribute_labels_to_attributes.clear();
         }
+
+        ASSERT(initialized(),fatal,"Farm did not initialize");
+        ASSERT(edcs_initialized,fatal,"EDCS did not initialize");
+        return initialized() and edcs_initialized;
     }
 
     // ------------------------------------------------------------------------
-    // Writes the feature categories to features map to the binary stream in a
-    // format that the terrain compiler can read.
+    // Return:  Is the feature category valid and is not the feature category
+    // used to represent all of the feature types.
     //
-    void FeatureAttributeMapping::dump_feature_categories_to_features(
-        std::ostream &stream
+    bool FeatureAttributeMapping::valid_not_all_feature_category(
+        const FeatureCategory &feature_category
     )
     {
-        // Write the number of items in the map.
-        //
-        CORE::Int32
-            int32 = feature_categories_to_features.size();
-
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+        verify_farm_initialization();
 
-        // Write the items in the map.
-        //
-        for (int i=0; i < feature_categories_to_features.size(); i++)
-            if (feature_categories_to_features[i].valid())
-            {
-                int32 = i;
-                stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
-                feature_categories_to_features[i].dump(stream);
-            }
+        return CORE::ordered<int>(
+            0,
+            feature_category,
+            feature_categories_to_features.size() - 1);
     }
 
     // ------------------------------------------------------------------------
-    // Reads the feature categories to features map from the binary stream.
-    //
-    void FeatureAttributeMapping::load_feature_categories_to_features(
-        std::istream &stream
-    )
+    void FeatureAttributeMapping::destroy(void)
     {
-        CORE::Int32
-            num_features,
-            category;
-        Feature
-            feature;
+        if (initialized())
+        {
+            clear_farm_tables();
 
-        feature_categories_to_features.clear();
+            feature_labels_to_codes.clear();
+            feature_codes_to_labels.clear();
+            attribute_labels_to_codes.clear();
+            attribute_codes_to_labels.clear();
+            enum_labels_to_codes.clear();
+            enum_codes_to_labels.clear();
+            clear_label_filters();
+            clear_code_indexes();
 
-        // Read the number of items in the map.
-        //
-        stream.read(
-            reinterpret_cast<char *>(&num_features), sizeof(num_features));
+            farm_initialized = false;
+            edcs_maps_initialized = false;
+            ++generation;
+        }
+    }
 
-        feature_categories_to_features.resize(num_features);
+    // ------------------------------------------------------------------------
+    void FeatureAttributeMapping::set_rows_on_demand(bool on)
+    {
+        rows_on_demand_set = true;
+        rows_on_demand_on = on;
+    }
 
-        // Read the items in the map.
-        //
-        for (int index = 0; index < num_features; ++index)
+    // ------------------------------------------------------------------------
+    bool FeatureAttributeMapping::rows_on_demand(void)
+    {
+        if (not rows_on_demand_set)
         {
-            // Read the category.
-            //
-            stream.read(reinterpret_cast<char *>(&category), sizeof(category));
+            const char
+                *on = std::getenv("FARM_ROWS_ON_DEMAND");
 
-            // Read the FARM feature.
-            //
-            feature.load(stream);
+            return on and std::string(on) == "1";
+        }
 
-            if(feature_categories_to_features.size() < category+1)
-                feature_categories_to_features.resize(category+1);
+        return rows_on_demand_on;
+    }
+
+    // ------------------------------------------------------------------------
+    int FeatureAttributeMapping::get_decoded_row_count(void)
+    {
+        return
+            rows_on_demand_table ?
+                rows_on_demand_table->decoded_row_count.load() :
+                static_cast<int>(farm.size());
+    }
+
+    // ------------------------------------------------------------------------
+    bool FeatureAttributeMapping::get_features(std::list<Feature> &features)
+    {
+        verify_farm_initialization();
+
+        features.clear();
+
+        for(int i=0; i < feature_categories_to_features.size(); i++)
+            if(feature_categories_to_features[i].valid())
+                features.push_back(feature_categories_to_features[i]);
 
-            feature_categories_to_features[category]=feature;
-            ASSERT(
-                feature_categories_to_features[category].valid(),
-                fatal,
-                "Could not add a feature category.");
-        }
+        return features.size() > 0;
     }
 
     // ------------------------------------------------------------------------
-    // Writes the attribute codes to attributes map to the binary stream in a
-    // format that the terrain compiler can read.
-    //
-    void FeatureAttributeMapping::dump_attribute_codes_to_attributes(
-        std::ostream &stream
+    bool FeatureAttributeMapping::get_feature_label_and_geometries(
+        std::list<FeatureLabelAndGeometry> &feature_label_and_geometries
     )
     {
+        verify_farm_initialization();
 
-        // Write the number of items in the map.
-        //
-        CORE::Int32
-            int32 = attribute_codes_to_attributes.size();
+        feature_label_and_geometries.clear();
 
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+         for(int i=0; i < feature_categories_to_features.size(); i++)
+            if(feature_categories_to_features[i].valid())
+                feature_label_and_geometries.push_back(
+                        FeatureLabelAndGeometry(
+                        feature_categories_to_features[i].get_label(),
+                        feature_categories_to_features[i].get_geometry() ) );
 
-        // Write the items in the map.
-        //
-       for (int attr=0; attr < attribute_codes_to_attributes.size(); attr++)
-        {
-            int32 = attr;
-            if(attribute_codes_to_attributes[attr].valid())
-            stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
-        }
+        return feature_label_and_geometries.size() > 0;
     }
 
     // ------------------------------------------------------------------------
-    // Reads the attribute codes to attributes map from the binary stream.
-    //
-    void FeatureAttributeMapping::load_attribute_codes_to_attributes(
-        std::istream &stream
+    bool FeatureAttributeMapping::get_feature_categories(
+        std::list<FeatureCategory> &feature_categories
     )
     {
-        CORE::Int32
-            num_attributes,
-            attribute_code;
-        Attribute
-            attribute;
+        verify_farm_initialization();
 
-        attribute_codes_to_attributes.clear();
+        feature_categories.clear();
 
-        // Read the number of items in the map.
-        //
-        stream.read(
-            reinterpret_cast<char *>(&num_attributes), sizeof(num_attributes));
+         for(int i=0; i < feature_categories_to_features.size(); i++)
+            if(feature_categories_to_features[i].valid())
+                feature_categories.push_back(i);
 
-       attribute_codes_to_attributes.resize(num_attributes+1);
+        return feature_categories.size() > 0;
+    }
 
-        // Read the items in the map.
-        //
-        for (int index = 0; index < num_attributes; ++index)
+    // ------------------------------------------------------------------------
+    bool FeatureAttributeMapping::get_feature(
+        const FeatureLabel &feature_label,
+        const FeatureGeometry &feature_geometry,
+        Feature &feature
+    )
+    {
+        const Feature
+            *farm_feature = get_feature(feature_label, feature_geometry);
+
+        if ( farm_feature )
         {
-            // Read the attribute code.
-            //
-            stream.read(
-                reinterpret_cast<char *>(&attribute_code),
-                sizeof(attribute_code));
+            feature = *farm_feature;
+        }
 
-            // Read the FARM attribute.
-            //
-            attribute.load(stream);
+        return farm_feature != 0;
+    }
+    // ------------------------------------------------------------------------
+     const Feature *FeatureAttributeMapping::get_feature(
+        const FeatureLabel &feature_label,
+        const FeatureGeometry &feature_geometry)
+    {
+        const Feature *feature = 0;
 
-            if(attribute_codes_to_attributes.size()< attribute_code+1)
-                attribute_codes_to_attributes.resize(attribute_code+1);
+        verify_farm_initialization();
 
-           attribute_codes_to_attributes[attribute_code]=attribute;
+        const FeatureCategory
+            category = find_feature_category(feature_label, feature_geometry);
+
+        if ( category >= 0 )
+        {
+
+            if ( feature_categories_to_features[category].valid() )
+            {
+              feature = &(feature_categories_to_features.at(category));
+            }
         }
+
+        return feature;
     }
 
     // ------------------------------------------------------------------------
-    // Writes the attribute codes to enums map to the binary stream in a format
-    // that the terrain compiler can read.
-    //
-    void FeatureAttributeMapping::dump_attribute_codes_to_enums(
-        std::ostream &stream
+    bool FeatureAttributeMapping::get_feature_category(
+        const FeatureLabel &feature_label,
+        const FeatureGeometry &feature_geometry,
+        FeatureCategory &feature_category
     )
     {
-        AttributeCodesToEnums::const_iterator
-            attr_iter = attribute_codes_to_enums.begin();
-        AttributeEnums::const_iterator
-            enum_iter;
+        FARM_INSTRUMENT_CALL(get_feature_category);
 
-        // Write the number of items in the map.
-        //
-        CORE::Int32
-            int32 = attribute_codes_to_enums.size();
+        bool
+            status = farm_initialized;
 
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+        verify_farm_initialization();
 
-        // Write the items in the map.
-        //
-        while (attr_iter != attribute_codes_to_enums.end())
+        if (status)
         {
-            // Write the attribute code.
-            //
-            int32 = attr_iter->first;
-            stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
-
-            // Write the number of enumerations for the attribute.
-            //
-            int32 = attr_iter->second.size();
-            stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+            const FeatureCategory
+                category =
+                    find_feature_category(feature_label, feature_geometry);
 
-            // Write the enumerations for the attribute.
-            //
-            enum_iter = attr_iter->second.begin();
+            status = category >= 0;
 
-            while (enum_iter != attr_iter->second.end())
+            if (status)
             {
-                int32 = enum_iter->first;
-                stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
-
-                enum_iter->second.dump(stream);
-
-                ++enum_iter;
+                feature_category = category;
             }
-
-            ++attr_iter;
         }
+
+        return status;
     }
 
     // ------------------------------------------------------------------------
-    // Reads the attribute codes to enums map from the binary stream.
-    //
-    void FeatureAttributeMapping::load_attribute_codes_to_enums(
-        std::istream &stream
+    FARM::FeatureCategory FeatureAttributeMapping::get_feature_category(
+        const FeatureLabel &feature_label,
+        const FeatureGeometry &feature_geometry
     )
     {
-        CORE::Int32
-            num_attributes,
-            attr_code,
-            num_enums,
-            enum_code;
-        std::pair<AttributeCodesToEnums::iterator, bool>
-            insert_result;
-        Enumerant
-            enum_value;
+        FARM_INSTRUMENT_CALL(get_feature_category);
 
-        attribute_codes_to_enums.clear();
+        verify_farm_initialization();
 
-        // Read the number of items in the map.
-        //
-        stream.read(
-            reinterpret_cast<char *>(&num_attributes), sizeof(num_attributes));
-        // Read the items in the map.
-        //
-        for (int attr_index = 0; attr_index < num_attributes; ++attr_index)
+        FARM::FeatureCategory
+            cat = find_feature_category(feature_label, feature_geometry);
+
+        if (cat < 0)
         {
-            // Read the attribute code.
-            //
-            stream.read(
-                reinterpret_cast<char *>(&attr_code), sizeof(attr_code));
+            cat = 0;
+        }
 
-            // Insert the attribute code in the map.
-            //
-            insert_result = attribute_codes_to_enums.insert(
-                AttributeCodesToEnums::value_type(
-                    attr_code, AttributeEnums()));
+        return cat;
+    }
 
-            ASSERT(
-                insert_result.second,
-                fatal,
-                "Could not add an attribute code.");
+    // ------------------------------------------------------------------------
+    bool FeatureAttributeMapping::get_feature(
+        const FeatureCategory &feature_category,
+        Feature &feature
+    )
+    {
+        bool
+            status = valid_not_all_feature_category(feature_category);
 
-            // Read the number of enumerations for the attribute.
-            //
-            stream.read(
-                reinterpret_cast<char *>(&num_enums), sizeof(num_enums));
+        if( status )
+        {
 
-            // Read the enumerations for the attribute.
-            //
-            for (int enum_index = 0; enum_index < num_enums; ++enum_index)
+           if ( status=feature_categories_to_features[feature_category].valid())
             {
-                // Read the enumeration code.
-                //
-                stream.read(
-                    reinterpret_cast<char *>(&enum_code), sizeof(enum_code));
+                feature = feature_categories_to_features[feature_category];
+            }
+        }
 
-                // Read the enumeration.
-                //
-                enum_value.load(stream);
+        return status;
+    }
 
-                ASSERT(
-                    insert_result.first->second.insert(AttributeEnums::
-                        value_type(enum_code, enum_value)).second,
-                    fatal,
-                    "Could not add an enumeration.");
+    //--------------------------------------------------------------------------
+    const Feature *FeatureAttributeMapping::get_feature(
+        const FeatureCategory &feature_category)
+    {
+        bool
+            status = valid_not_all_feature_category(feature_category);
+
+        const Feature *feature = 0;
+
+        if( status )
+        {
+            if ( feature_categories_to_features[feature_category].valid() )
+            {
+                feature = &(feature_categories_to_features[feature_category]);
             }
         }
+
+        return feature;
     }
 
     // ------------------------------------------------------------------------
-    // Writes the FARM table to the binary stream in a format that the terrain
-    // compiler can read.
-    //
-    void FeatureAttributeMapping::dump_farm_table(std::ostream &stream)
+    FeatureHandle FeatureAttributeMapping::get_feature_handle(
+        const FeatureCategory &feature_category
+    )
     {
-        FarmAttributeCodeToDataType::const_iterator
-            iter;
+        const Feature
+            *feature = get_feature(feature_category);
 
-        // Write the number of feature categories.
-        //
-        CORE::Int32
-            int32 = farm.size(),
-            is_present=0;
+        if (not feature)
+        {
+            return FeatureHandle();
+        }
 
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+        return
+            FeatureHandle(
+                feature->get_category(),
+                feature->get_code(),
+                feature->get_geometry(),
+                feature->get_label());
+    }
 
-        for (int index = 0; index < farm.size(); ++index)
+    // ------------------------------------------------------------------------
+    FeatureHandle FeatureAttributeMapping::get_feature_handle(
+        const FeatureCode &code,
+        const FeatureGeometry &geometry
+    )
+    {
+        FeatureCategory
+            category;
+
+        if (not get_feature_category_from_code(code, geometry, category))
         {
-            // Write the number of attributes for the feature.
-            //
-            int32 = farm[index].size();
-            stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+            return FeatureHandle();
+        }
 
-            // Write the attributes for the feature.
-            //
-            iter = farm[index].begin();
-            int32=0;
-            while (iter != farm[index].end())
-            {
-                // Write the attribute code.
-                //
-                stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+        return get_feature_handle(category);
+    }
 
-                // Write whether the feature contains the attribute.
-                //
-                is_present = *iter ? 1 : 0;
-                stream.write(reinterpret_cast<char *>(&is_present),
-                sizeof(is_present));
+    // ------------------------------------------------------------------------
+    bool FeatureAttributeMapping::get_feature_label(
+        const FeatureCategory &feature_category,
+        FeatureLabel &feature_label
+    )
+    {
+        const Feature
+            *feature=get_feature( feature_category);
+
+        if( feature )
+            feature_label = feature->get_label();
 
-                if (*iter)
-                {
-                    // Write the data for the attribute.
-                    //
-                    (*iter)->dump(stream);
-                }
-                ++int32;
-                ++iter;
-            }
-        }
+        return (feature !=NULL);
     }
 
     // ------------------------------------------------------------------------
-    // Reads the FARM table from the binary stream.
-    //
-    void FeatureAttributeMapping::load_farm_table(std::istream &stream)
+    bool FeatureAttributeMapping::get_feature_code(
+        const FeatureCategory &feature_category,
+        FeatureCode &feature_code
+    )
     {
-        CORE::Int32
-            num_features,
-            num_attributes,
-            attr_code,
-            contains_attr;
-        AttributeCodesToAttributes::const_iterator
-            iter;
-        DataType
-            *data_type = NULL;
+        const Feature
+            *feature=get_feature( feature_category);
 
-        // Read the number of feature categories.
-        //
-        stream.read(
-            reinterpret_cast<char *>(&num_features), sizeof(num_features));
-        farm.resize(num_features);
+        if( feature )
+            feature_code = feature->get_code();
 
-        for (int feat_index = 0; feat_index < farm.size(); ++feat_index)
-        {
-            // Read the number of attributes for the feature.
-            //
-            stream.read(
-                reinterpret_cast<char *>(&num_attributes),
-                sizeof(num_attributes));
+        return (feature !=NULL);
+    }
 
-            farm[feat_index].clear();
+    // ------------------------------------------------------------------------
+    bool FeatureAttributeMapping::get_feature_label_from_code(
+        const FeatureCode &code,
+        FeatureLabel &label
+    )
+    {
+        const FeatureLabel
+            *code_label = feature_code_labels.find(code);
 
-            // Read the attributes for the feature.
-            //
-            for (int attr_index = 0; attr_index < num_attributes; ++attr_index)
-            {
-                // Read the attribute code.
-                //
-                stream.read(
-                    reinterpret_cast<char *>(&attr_code), sizeof(attr_code));
+        bool
+            status = code_label != 0;
 
-                // Read whether the feature contains the attribute.
-                //
-                stream.read(
-                    reinterpret_cast<char *>(&contains_attr),
-                    sizeof(contains_attr));
+        ASSERT_WITH_STREAM(status,
+            fatal,
+            "Could not get the edcs feature label for feature code: " <<
+                code);
 
-                if (not contains_attr)
-                {
-                    // The feature does not have the attribute.
-                    //
-                    data_type = 0;
-                }
-                else
-                {
-                    // The feature contains the attribute.  Determine the data
-                    // type for the attribute.
-                    //
-                    switch (attribute_codes_to_attributes[attr_code].
-                        get_data_type())
-                    {
-                        case int32:
-                        {
-                            data_type =
-                                new InstantiatedDataType<CORE::Int32>();
-                            break;
-                        }
+        if (status)
+        {
+            label = *code_label;
+        }
 
-                        case float64:
-                        {
-                            data_type =
-                                new InstantiatedDataType<CORE::Float64>();
-                            break;
-                        }
+        return status;
+    }
 
-                        case string:
-                        {
-                            data_type = new StringDataType();
-                            break;
-                        }
+    // ------------------------------------------------------------------------
+    std::size_t FeatureAttributeMapping::get_feature_codes(
+        const LabelView *labels,
+        std::size_t count,
+        FeatureCode *codes,
+        CORE::UInt8 *misses
+    )
+    {
+        return find_labels(
+            feature_label_index, labels, 0, count, codes, misses);
+    }
 
-                        case enumeration:
-                        {
-                            data_type = new EnumerantDataType();
-                            break;
-                        }
+    // ------------------------------------------------------------------------
+    bool FeatureAttributeMapping::get_feature_category_from_code(
+        const FeatureCode &code,
+        const FeatureGeometry &geometry,
+        FeatureCategory &feature_category
+    )
+    {
+        FeatureCategory
+            category = feature_code_categories.find(
+                CORE::Int64(code) * 4 + geometry);
 
-                        case boolean:
-                        {
-                            data_type = new BooleanDataType();
-                            break;
-                        }
+        if (category >= 0)
+        {
+            feature_category = category;
+        }
 
-                        case uuid:
-                        {
-                            data_type = new UUIDDataType();
-                            break;
-                        }
+        return category >= 0;
+    }
 
-                        default:
-                        {
-                            LOG(fatal, "Found an unsupported data type.");
-                            break;
-                        }
-                    };
+    // ------------------------------------------------------------------------
+    bool FeatureAttributeMapping::get_feature_code(
+        const FeatureLabel &label,
+        FeatureCode &code
+    )
+    {
+        FeatureLabelsToCodes::const_iterator
+            code_map_iter = find_label(
+                feature_label_filter, feature_labels_to_codes, label);
 
-                    ASSERT(
-                        data_type,
-                        fatal,
-                        "Could not allocate memory for a data type.");
+        bool
+            status = code_map_iter != feature_labels_to_codes.end();
 
-                    // Read the data for the attribute.
-                    //
-                    data_type->load(stream);
-                }
+        ASSERT_WITH_STREAM(status,
+            fatal,
+            "Could not get the edcs feature code for '" << label << "'.");
 
-                // Add the attribute and data type to the FARM table.
-                //
-                ASSERT(
-                    farm[feat_index][attr_code]=data_type,
-                    fatal,
-                    "Could not add an attribute for a feature.");
-            }
+        if (status)
+        {
+            code = code_map_iter->second;
         }
+
+        return status;
     }
 
     // ------------------------------------------------------------------------
-    // Initializes the FARM using a binary file.
-    //
-    void FeatureAttributeMapping::initialize_farm_from_binary_file(
-        const std::string &database_directory
+    bool FeatureAttributeMapping::get_feature_geometry(
+        const FeatureCategory &feature_category,
+        FeatureGeometry &feature_geometry
     )
     {
-        // Open the binary file to read.
-        //
-        std::string
-            file_name = database_directory + "/" + farm_binary_input_file;
-        std::ifstream
-            file(file_name.c_str(), std::ios::in | std::ios::binary);
+        verify_farm_initialization();
 
-        ASSERT(
-            file.is_open(),
-            fatal,
-            "Could not open the file '" + file_name + "'.");
+        const FeatureTraits
+            &traits = get_feature_traits(feature_category);
 
-        if (file.is_open())
+        if (traits.valid())
         {
-            // Read the tables and maps for the FARM from the file.
-            //
-            load_feature_labels_geometries_to_categories(file);
-            load_feature_categories_to_features(file);
-            load_attribute_codes_to_attributes(file);
-            load_attribute_codes_to_enums(file);
-            load_farm_table(file);
+            feature_geometry = traits.get_geometry();
         }
+
+        return traits.valid();
     }
 
     // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::initialize(
-        const std::string &database_directory,
-        const std::string &fdf_file_label,
-        const std::string &adf_file_label,
-        const std::string &faa_file_label,
-        const std::string &edcs_3p1_4p3_feature_mapping,
-        const std::string &edcs_3p1_4p3_attribute_mapping,
-        const std::string &edcs_3p1_4p3_enum_mapping
+    bool FeatureAttributeMapping::get_usage_bitmask(
+        const FeatureCategory &feature_category,
+        UsageBitmask &usage_bitmask
     )
     {
-        bool
-            edcs_initialized = false;
+        verify_farm_initialization();
 
-        if(initialized())
+        const FeatureTraits
+            &traits = get_feature_traits(feature_category);
+
+        if (traits.valid())
         {
-            edcs_initialized = true;
+            usage_bitmask = traits.get_usage_bitmask();
         }
-        else
-        {
-            // The FARM has not been initialized.  Initialize it.
-            //
-            if (fdf_file_label != "" and
-                adf_file_label != "" and
-                faa_file_label != "")
-            {
-                // Initialize the software to convert EDCS 3.1 to EDCS 4.3.
-                //
-                ASSERT(
-                    EDCSConverter::initialize(
-                        edcs_3p1_4p3_feature_mapping,
-                        edcs_3p1_4p3_attribute_mapping,
-                        edcs_3p1_4p3_enum_mapping),
-                    fatal,
-                    "Could not initialize the EDCS 3.1 to EDCS 4.3 converter.");
 
-                edcs_initialized = EDCSConverter::initialized();
+        return traits.valid();
+    }
 
-                ASSERT(
-                    edcs_initialized,
-                    fatal,
-                    "Could not initialize the EDCS data.");
+    // ------------------------------------------------------------------------
+    bool FeatureAttributeMapping::get_feature_precedence(
+        const FeatureCategory &feature_category,
+        FeaturePrecedence &feature_precedence
+    )
+    {
+        verify_farm_initialization();
 
-                // Initialize the FARM using the configuration files.
-                //
-                read_fdf(fdf_file_label);
-                read_adf(adf_file_label);
-                read_faa(faa_file_label);
-            }
-            else
-            {
-                // Initialize the EDCS-related maps
-                //
-                edcs_initialized = initialize_edcs_maps(
-                    edcs_3p1_4p3_feature_mapping,
-                    edcs_3p1_4p3_attribute_mapping,
-                    edcs_3p1_4p3_enum_mapping);
+        const FeatureTraits
+            &traits = get_feature_traits(feature_category);
 
-                ASSERT(
-                    edcs_initialized,
-                    fatal,
-                    "Could not initialize the EDCS data.");
+        if (traits.valid())
+        {
+            feature_precedence = traits.get_precedence();
+        }
 
-                // Initialize the FARM using the binary file.
-                //
-                initialize_farm_from_binary_file(database_directory);
-            }
+        return traits.valid();
+    }
 
-            // originally assigned to true but changed to edcs until the
-            // edcs transition is over
-            //
-            farm_initialized = edcs_initialized;
+    // ------------------------------------------------------------------------
+    bool FeatureAttributeMapping::get_attributes_overlay_size(
+        const FeatureCategory &feature_category,
+        int &attributes_overlay_size
+    )
+    {
+        verify_farm_initialization();
 
-            // Initialize the feature categories that are commonly used.
-            //
-            ASSERT(
-                FeatureCategories::initialize(),
-                fatal,
-                "Could not initialize the feature categories.");
+        const FeatureTraits
+            &traits = get_feature_traits(feature_category);
 
-            // Initialize the attribute categories that are commonly used.
-            //
-            ASSERT(
-                AttributeCategories::initialize(),
-                fatal,
-                "Could not initialize the attribute categories.");
+        if (traits.valid())
+        {
+            attributes_overlay_size = traits.get_attributes_overlay_size();
+        }
 
-            // Initialize the enumerations that are commonly used.
-            //
-            ASSERT(
-                EnumValues::initialize(),
-                fatal,
-                "Could not initialize the commonly used enumeration values.");
+        return traits.valid();
+    }
 
-            attribute_labels_to_attributes.clear();
-        }
+    // ------------------------------------------------------------------------
+    bool FeatureAttributeMapping::valid_feature(
+        const Feature &feature
+    )
+    {
+        verify_farm_initialization();
 
-        ASSERT(initialized(),fatal,"Farm did not initialize");
-        ASSERT(edcs_initialized,fatal,"EDCS did not initialize");
-        return initialized() and edcs_initialized;
+        return feature.valid() and CORE::ordered<int>(
+            0,
+            feature.get_category(),
+            feature_categories_to_features.size());
     }
 
     // ------------------------------------------------------------------------
-    // Return:  Is the feature category valid and is not the feature category
-    // used to represent all of the feature types.
-    //
-    bool FeatureAttributeMapping::valid_not_all_feature_category(
+    bool FeatureAttributeMapping::valid_feature_category(
         const FeatureCategory &feature_category
     )
     {
@@ -3183,740 +5026,1205 @@ namespace FARM
         return CORE::ordered<int>(
             0,
             feature_category,
-            feature_categories_to_features.size() - 1);
+            feature_categories_to_features.size());
     }
 
     // ------------------------------------------------------------------------
-    void FeatureAttributeMapping::destroy(void)
+    bool FeatureAttributeMapping::get_all_features_category(
+        FeatureCategory &feature_category
+    )
     {
-        if (initialized())
-        {
-            // Delete the memory for the two-dimensional array.
-            //
-            for (int row = 0; row < farm.size(); ++row)
-            {
-                for (int col = 0; col < farm[row].size(); ++col)
-                {
-                    if (farm[row][col])
-                    {
-                        delete farm[row][col];
-                    }
-                }
-
-                farm[row].clear();
-            }
-
-            farm.clear();
-
-            feature_labels_and_geometries_to_categories.clear();
-            feature_categories_to_features.clear();
-            attribute_codes_to_attributes.clear();
-            attribute_codes_to_enums.clear();
-            attribute_labels_to_attributes.clear();
+        verify_farm_initialization();
 
-            feature_labels_to_codes.clear();
-            feature_codes_to_labels.clear();
-            attribute_labels_to_codes.clear();
-            attribute_codes_to_labels.clear();
-            enum_labels_to_codes.clear();
-            enum_codes_to_labels.clear();
+        feature_category = feature_categories_to_features.size();
 
-            farm_initialized = false;
-            edcs_maps_initialized = false;
-        }
+        return initialized();
     }
 
     // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_features(std::list<Feature> &features)
+    bool FeatureAttributeMapping::is_all_features(
+        const FeatureCategory &feature_category
+    )
     {
         verify_farm_initialization();
 
-        features.clear();
-
-        for(int i=0; i < feature_categories_to_features.size(); i++)
-            if(feature_categories_to_features[i].valid())
-                features.push_back(feature_categories_to_features[i]);
-
-        return features.size() > 0;
+        return feature_category == feature_categories_to_features.size();
     }
 
     // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_feature_label_and_geometries(
-        std::list<FeatureLabelAndGeometry> &feature_label_and_geometries
+    bool FeatureAttributeMapping::get_all_attributes(
+        std::list<Attribute> &attributes
     )
     {
+        int
+                count=0;
         verify_farm_initialization();
 
-        feature_label_and_geometries.clear();
+        attributes.clear();
 
-         for(int i=0; i < feature_categories_to_features.size(); i++)
-            if(feature_categories_to_features[i].valid())
-                feature_label_and_geometries.push_back(
-                        FeatureLabelAndGeometry(
-                        feature_categories_to_features[i].get_label(),
-                        feature_categories_to_features[i].get_geometry() ) );
+        for(int attr=0; attr< attribute_codes_to_attributes.size(); attr++)
+        {
+             if(attribute_codes_to_attributes[attr].valid())
+             {
+            attributes.push_back( attribute_codes_to_attributes[attr] );
+             count++;
+             }
+        }
 
-        return feature_label_and_geometries.size() > 0;
+        return attributes.size() == count;
     }
 
     // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_feature_categories(
-        std::list<FeatureCategory> &feature_categories
+    bool FeatureAttributeMapping::get_all_attribute_categories(
+        std::list<AttributeCategory> &attribute_categories
     )
     {
+        int
+                count=0;
         verify_farm_initialization();
 
-        feature_categories.clear();
+        attribute_categories.clear();
 
-         for(int i=0; i < feature_categories_to_features.size(); i++)
-            if(feature_categories_to_features[i].valid())
-                feature_categories.push_back(i);
+        for(int attr=0; attr< attribute_codes_to_attributes.size(); attr++)
+        {
+             if(attribute_codes_to_attributes[attr].valid())
+             {
+            attribute_categories.push_back( attr );
+            count++;
+             }
+        }
 
-        return feature_categories.size() > 0;
+        return attribute_categories.size() ==
+                count;
     }
 
     // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_feature(
-        const FeatureLabel &feature_label,
-        const FeatureGeometry &feature_geometry,
-        Feature &feature
+    bool FeatureAttributeMapping::get_attribute(
+        const AttributeCategory &attribute_category,
+        Attribute &attribute
     )
     {
-        bool
-            status;
-
-        verify_farm_initialization();
-
-        FeatureLabelAndGeometry
-            label_and_geometry = FeatureLabelAndGeometry(
-                feature_label,
-                feature_geometry );
-
-        FeatureLabelsGeometriesToCategories::iterator
-            category_itr = feature_labels_and_geometries_to_categories.find(
-                label_and_geometry );
+        FARM_INSTRUMENT_CALL(get_attribute);
 
-        status =
-            category_itr != feature_labels_and_geometries_to_categories.end();
+        bool
+            success = false;
 
-        if ( status )
+        if (success=attribute_codes_to_attributes[ attribute_category ].valid())
         {
-            if ( status=feature_categories_to_features[category_itr->second]
-                .valid() )
-
-                feature = feature_categories_to_features[category_itr->second];
+            attribute = attribute_codes_to_attributes[ attribute_category ];
         }
 
-        return status;
+        return success;
     }
+
     // ------------------------------------------------------------------------
-     const Feature *FeatureAttributeMapping::get_feature(
-        const FeatureLabel &feature_label,
-        const FeatureGeometry &feature_geometry)
+    bool FeatureAttributeMapping::get_attribute_label(
+        const AttributeCategory &attribute_category,
+        AttributeLabel &attribute_label
+    )
     {
         bool
-            status;
-
-        Feature *feature = 0;
-
-        verify_farm_initialization();
-
-        FeatureLabelAndGeometry
-            label_and_geometry = FeatureLabelAndGeometry(
-                feature_label,
-                feature_geometry );
-
-        FeatureLabelsGeometriesToCategories::iterator
-            category_itr = feature_labels_and_geometries_to_categories.find(
-                label_and_geometry );
-
-        status =
-            category_itr != feature_labels_and_geometries_to_categories.end();
+            successful =
+                CORE::ordered(
+                    0,
+                    attribute_category,
+                    static_cast<int>(
+                        attribute_codes_to_attributes.size() - 1)) and
+                attribute_codes_to_attributes[attribute_category].valid();
 
-        if ( status )
+        if (successful)
         {
-
-            if ( feature_categories_to_features[category_itr->second].valid() )
-            {
-              feature = &(feature_categories_to_features.at(category_itr->second));
-            }
+            attribute_label =
+                attribute_codes_to_attributes[attribute_category].get_label();
         }
 
-        return feature;
+        return successful;
     }
 
     // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_feature_category(
-        const FeatureLabel &feature_label,
-        const FeatureGeometry &feature_geometry,
-        FeatureCategory &feature_category
+    bool FeatureAttributeMapping::get_attribute_code(
+        const AttributeLabel &label,
+        AttributeCode &code
     )
     {
+        AttributeLabelsToCodes::const_iterator
+            code_map_iter = find_label(
+                attribute_label_filter, attribute_labels_to_codes, label);
         bool
-            status = farm_initialized;
-
-        verify_farm_initialization();
+            status = code_map_iter != attribute_labels_to_codes.end();
 
         if (status)
         {
-            FeatureLabelAndGeometry
-                label_and_geometry =
-                    FeatureLabelAndGeometry(feature_label, feature_geometry );
-
-            FeatureLabelsGeometriesToCategories::iterator
-                category_itr = feature_labels_and_geometries_to_categories.
-                    find(label_and_geometry);
-
-            status = category_itr !=
-                feature_labels_and_geometries_to_categories.end();
-
-            if (status)
-            {
-                feature_category = category_itr->second;
-            }
+            code = code_map_iter->second;
         }
 
         return status;
     }
 
     // ------------------------------------------------------------------------
-    FARM::FeatureCategory FeatureAttributeMapping::get_feature_category(
-        const FeatureLabel &feature_label,
-        const FeatureGeometry &feature_geometry
+    std::size_t FeatureAttributeMapping::get_attribute_codes(
+        const LabelView *labels,
+        std::size_t count,
+        AttributeCode *codes,
+        CORE::UInt8 *misses
     )
     {
-        verify_farm_initialization();
-
-        FeatureLabelAndGeometry
-            label_and_geometry = FeatureLabelAndGeometry(
-                feature_label,
-                feature_geometry );
-
-        FeatureLabelsGeometriesToCategories::iterator
-            category_itr = feature_labels_and_geometries_to_categories.find(
-                label_and_geometry );
+        return find_labels(
+            attribute_label_index, labels, 0, count, codes, misses);
+    }
 
-        FARM::FeatureCategory cat = 0;
+    // ------------------------------------------------------------------------
+    AttributeHandle FeatureAttributeMapping::get_attribute_handle(
+        const AttributeCode &code
+    )
+    {
+        const AttributeLabel
+            *label = attribute_code_labels.find(code);
 
-        if (category_itr != feature_labels_and_geometries_to_categories.end())
+        if (not label)
         {
-            cat = category_itr->second;
+            return AttributeHandle();
         }
 
-        return cat;
+        return AttributeHandle(code, *label);
     }
 
     // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_feature(
-        const FeatureCategory &feature_category,
-        Feature &feature
+    CORE::UInt64 FeatureAttributeMapping::resolve_tag(
+        const char *label,
+        const AttributeDataType &data_type,
+        std::atomic<CORE::UInt64> &resolved
     )
     {
-        bool
-            status = valid_not_all_feature_category(feature_category);
-
-        if( status )
+        CORE::UInt32
+            current_generation = get_generation();
+        LabelView
+            view;
+        AttributeCode
+            code;
+        CORE::UInt8
+            miss;
+        AttributeCategory
+            attribute_category = -1;
+        CORE::UInt64
+            result;
+
+        view.data = label;
+        view.size = std::strlen(label);
+
+        if (farm_initialized and
+            get_attribute_codes(&view, 1, &code, &miss) == 0 and
+            valid_attribute_category(code))
         {
-
-           if ( status=feature_categories_to_features[feature_category].valid())
+            if (attribute_codes_to_attributes[code].get_data_type() ==
+                data_type)
             {
-                feature = feature_categories_to_features[feature_category];
+                attribute_category = code;
+            }
+            else
+            {
+                LOG_WITH_STREAM(
+                    fatal,
+                    "The attribute tag " << label << " is of data type " <<
+                        data_type << ", but the FARM attribute is of data " <<
+                        "type " <<
+                        attribute_codes_to_attributes[code].get_data_type() <<
+                        ".  Regenerate the attribute tags.");
             }
         }
 
-        return status;
+        result =
+            static_cast<CORE::UInt64>(current_generation) << 32 |
+            static_cast<CORE::UInt32>(attribute_category);
+
+        resolved.store(result, std::memory_order_release);
+
+        return result;
     }
 
-    //--------------------------------------------------------------------------
-    const Feature *FeatureAttributeMapping::get_feature(
-        const FeatureCategory &feature_category)
+    // ------------------------------------------------------------------------
+    bool FeatureAttributeMapping::get_attribute_label_from_code(
+        const AttributeCode &code,
+        AttributeLabel &label
+    )
     {
+        const AttributeLabel
+            *code_label = attribute_code_labels.find(code);
+
         bool
-            status = valid_not_all_feature_category(feature_category);
+            status = code_label != 0;
 
-        const Feature *feature = 0;
+        ASSERT_WITH_STREAM(status,
+            fatal,
+            "Could not get the edcs attribute label for attribute code: " <<
+                code);
 
-        if( status )
+        if (status)
         {
-            if ( feature_categories_to_features[feature_category].valid() )
-            {
-                feature = &(feature_categories_to_features[feature_category]);
-            }
+            label = *code_label;
         }
 
-        return feature;
+        return status;
     }
 
     // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_feature_label(
-        const FeatureCategory &feature_category,
-        FeatureLabel &feature_label
+    bool FeatureAttributeMapping::get_attribute_units(
+        const AttributeCategory &attribute_category,
+        AttributeUnits &attribute_units
     )
     {
-        const Feature
-            *feature=get_feature( feature_category);
+        bool
+            successful =
+                attribute_codes_to_attributes[attribute_category].valid();
 
-        if( feature )
-            feature_label = feature->get_label();
+        if (successful)
 
-        return (feature !=NULL);
+            attribute_units =
+                attribute_codes_to_attributes[attribute_category].get_units();
+
+        return successful;
     }
 
     // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_feature_code(
-        const FeatureCategory &feature_category,
-        FeatureCode &feature_code
+    bool FeatureAttributeMapping::is_editable(
+        const AttributeCategory &attribute_category
     )
     {
-        const Feature
-            *feature=get_feature( feature_category);
+        bool
+            successful =
+                attribute_codes_to_attributes[attribute_category].valid();
 
-        if( feature )
-            feature_code = feature->get_code();
+        if (successful)
+        {
+           return
+           attribute_codes_to_attributes[attribute_category].get_editability();
+        }
+        else
+        {
+            return false;
+        }
 
-        return (feature !=NULL);
     }
 
     // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_feature_label_from_code(
-        const FeatureCode &code,
-        FeatureLabel &label
+    bool FeatureAttributeMapping::get_attribute(
+        const AttributeLabel &attribute_label,
+        Attribute &attribute
     )
     {
-        FeatureCodesToLabels::iterator
-            label_map_iter = feature_codes_to_labels.find(code);
+        FARM_INSTRUMENT_CALL(get_attribute);
 
+        // Look in the cache for the attribute label.
+        //
+        std::map<AttributeLabel, Attribute>::const_iterator
+            iter = attribute_labels_to_attributes.find(attribute_label);
         bool
-            status = label_map_iter != feature_codes_to_labels.end();
+            successful = iter != attribute_labels_to_attributes.end();
 
-        ASSERT(status,
-            fatal,
-            "Could not get the edcs feature label for feature code: "
-                + code);
+        FARM_INSTRUMENT_CACHE(get_attribute, successful);
 
-        if (status)
+        if (successful)
         {
-            label = label_map_iter->second;
+            // Found the attribute label in the cache.  Return the FARM
+            // attribute.
+            //
+            attribute = iter->second;
         }
+        else
+        {
+            // Could not find the attribute label in the cache.  Get the FARM
+            // attribute.
+            //
+            successful =
+                attribute.set_label(attribute_label) and
+                attribute.valid();
 
-        return status;
+            if (successful)
+            {
+                AttributeCode
+                    code = attribute.get_code();
+
+                if (attribute_codes_to_attributes.size() < (code + 1))
+                {
+                    attribute_codes_to_attributes.resize(code + 1);
+                }
+
+                // Make sure the editability is set for the attribute.
+                //
+                attribute = attribute_codes_to_attributes[code];
+
+                successful = attribute.valid();
+
+                if (successful)
+                {
+                    // Add the attribute label to the cache.
+                    //
+                    ASSERT(
+                        attribute_labels_to_attributes.insert(
+                            std::map<AttributeLabel, Attribute>::value_type(
+                                attribute_label, attribute)).second,
+                        high,
+                        "Could not cache an attribute label.");
+                }
+            }
+        }
+
+        return successful;
     }
 
     // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_feature_code(
-        const FeatureLabel &label,
-        FeatureCode &code
+    bool FeatureAttributeMapping::get_attribute_category(
+        const AttributeLabel &attribute_label,
+        AttributeCategory &attribute_category
     )
     {
-        FeatureLabelsToCodes::iterator
-            code_map_iter = feature_labels_to_codes.find(label);
+        FARM_INSTRUMENT_CALL(get_attribute_category);
 
+        // Try to find the attribute label in the cache.
+        //
+        std::map<AttributeLabel, Attribute>::const_iterator
+            iter = attribute_labels_to_attributes.find(attribute_label);
         bool
-            status = code_map_iter != feature_labels_to_codes.end();
+            successful = iter != attribute_labels_to_attributes.end();
 
-        ASSERT(status,
-            fatal,
-            "Could not get the edcs feature code for '" + label + "'.");
+        FARM_INSTRUMENT_CACHE(get_attribute_category, successful);
 
-        if (status)
+        if (successful)
         {
-            code = code_map_iter->second;
+            // Find the attribute label in the cache.  Get the attribute
+            // category.
+            //
+            attribute_category = iter->second.get_category();
         }
+        else if (attribute_label_filter.may_contain(attribute_label))
+        {
+            // Could not find the attribute label in the cache.  Get the FARM
+            // attribute for the label.  Labels that the filter rejects are
+            // not cached, so unknown labels do not fill the cache.
+            //
+            Attribute
+                attribute;
 
-        return status;
-    }
+            successful = get_attribute(attribute_label, attribute);
 
-    // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_feature_geometry(
-        const FeatureCategory &feature_category,
-        FeatureGeometry &feature_geometry
-    )
-    {
-        const Feature
-            *feature = get_feature(feature_category);
+            if (successful)
+            {
+                // Get the attribute category and add the attribute label to
+                // the cache.
+                //
+                attribute_category = attribute.get_code();
+            }
+            else
+            {
 
-        if( feature )
-            feature_geometry = feature->get_geometry();
+                ASSERT(
+                    attribute_labels_to_attributes.insert(
+                        std::map<AttributeLabel, Attribute>::value_type(
+                            attribute_label, attribute)).second,
+                    high,
+                    "Could not cache an attribute label.");
+            }
+        }
 
-        return (feature !=NULL);
+        return successful;
     }
 
     // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_usage_bitmask(
-        const FeatureCategory &feature_category,
-        UsageBitmask &usage_bitmask
+    void FeatureAttributeMapping::get_label_filter_statistics(
+        std::vector<LabelFilterStatistics> &statistics
     )
     {
-        const Feature
-            *feature = get_feature( feature_category );
-
-        if( feature )
-            usage_bitmask = feature->get_usage_bitmask();
-
-        return (feature != NULL);
+        statistics.clear();
+        statistics.push_back(feature_label_filter.get_statistics());
+        statistics.push_back(attribute_label_filter.get_statistics());
     }
 
     // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_feature_precedence(
-        const FeatureCategory &feature_category,
-        FeaturePrecedence &feature_precedence
+    void FeatureAttributeMapping::get_memory_footprint(
+        MemoryFootprint &footprint
     )
     {
-        const Feature
-            *feature = get_feature( feature_category );
+        FootprintAccumulator
+            accumulator(footprint);
 
-        if( feature )
-            feature_precedence = feature->get_precedence();
+        // The FARM table, by feature category.
+        //
+        accumulator.begin_structure("FARM table");
+        accumulator.add_bytes(sizeof(farm));
+        accumulator.add_vector(farm);
 
-        return (feature != NULL);
-    }
+        for (std::vector<FarmAttributeCodeToDataType>::size_type row = 0;
+             row < farm.size(); ++row)
+        {
+            FeatureFootprint
+                feature;
+            CORE::Int64
+                first_bytes = accumulator.get_bytes(),
+                first_allocations = accumulator.get_allocations();
+
+            feature.category = row;
+            feature.geometry = null;
+            feature.attributes = 0;
+            feature.enumerants = 0;
+
+            if (row < feature_categories_to_features.size())
+            {
+                feature.label =
+                    feature_categories_to_features[row].get_label();
+                feature.geometry =
+                    feature_categories_to_features[row].get_geometry();
+            }
 
-    // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_attributes_overlay_size(
-        const FeatureCategory &feature_category,
-        int &attributes_overlay_size
-    )
-    {
-        const Feature
-            *feature = get_feature( feature_category );
+            accumulator.add_vector(farm[row]);
 
-        if( feature )
-            attributes_overlay_size = feature->get_attributes_overlay_size();
+            for (FarmAttributeCodeToDataType::size_type column = 0;
+                 column < farm[row].size(); ++column)
+            {
+                if (farm[row][column])
+                {
+                    feature.attributes++;
+                    feature.enumerants +=
+                        add_data_type(accumulator, *farm[row][column]);
+                }
+            }
 
-        return (feature != NULL);
-    }
+            feature.bytes = accumulator.get_bytes() - first_bytes;
+            feature.allocations =
+                accumulator.get_allocations() - first_allocations;
 
-    // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::valid_feature(
-        const Feature &feature
-    )
-    {
-        verify_farm_initialization();
+            footprint.features.push_back(feature);
+        }
 
-        return feature.valid() and CORE::ordered<int>(
-            0,
-            feature.get_category(),
-            feature_categories_to_features.size());
-    }
+        accumulator.end_structure();
 
-    // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::valid_feature_category(
-        const FeatureCategory &feature_category
-    )
-    {
-        verify_farm_initialization();
+        // The features and attributes.
+        //
+        accumulator.begin_structure("feature categories to features");
+        accumulator.add_bytes(sizeof(feature_categories_to_features));
+        accumulator.add_vector(feature_categories_to_features);
 
-        return CORE::ordered<int>(
-            0,
-            feature_category,
-            feature_categories_to_features.size());
-    }
+        for (FeatureCategoriesToFeatures::const_iterator feature =
+                 feature_categories_to_features.begin();
+             feature != feature_categories_to_features.end(); ++feature)
+        {
+            std::ostringstream
+                key;
 
-    // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_all_features_category(
-        FeatureCategory &feature_category
-    )
-    {
-        verify_farm_initialization();
+            key << feature->get_label() << ' ' << feature->get_geometry();
+            accumulator.add_element(key.str());
+            accumulator.add_string(feature->get_label());
+        }
 
-        feature_category = feature_categories_to_features.size();
+        accumulator.end_structure();
 
-        return initialized();
-    }
+        accumulator.begin_structure("attribute codes to attributes");
+        accumulator.add_bytes(sizeof(attribute_codes_to_attributes));
+        accumulator.add_vector(attribute_codes_to_attributes);
+        accumulator.add_distinct_elements(
+            attribute_codes_to_attributes.size());
 
-    // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::is_all_features(
-        const FeatureCategory &feature_category
-    )
-    {
-        verify_farm_initialization();
+        for (AttributeCodesToAttributes::const_iterator attribute =
+                 attribute_codes_to_attributes.begin();
+             attribute != attribute_codes_to_attributes.end(); ++attribute)
+        {
+            add_strings(accumulator, *attribute);
+        }
 
-        return feature_category == feature_categories_to_features.size();
-    }
+        accumulator.end_structure();
 
-    // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_all_attributes(
-        std::list<Attribute> &attributes
-    )
-    {
-        int
-                count=0;
-        verify_farm_initialization();
+        // The enumerants of each attribute.
+        //
+        accumulator.begin_structure("attribute codes to enumerants");
+        accumulator.add_bytes(sizeof(attribute_codes_to_enums));
+        accumulator.add_tree(attribute_codes_to_enums);
 
-        attributes.clear();
+        for (AttributeCodesToEnums::const_iterator attribute =
+                 attribute_codes_to_enums.begin();
+             attribute != attribute_codes_to_enums.end(); ++attribute)
+        {
+            accumulator.add_tree(attribute->second);
+            accumulator.add_distinct_elements(attribute->second.size());
 
-        for(int attr=0; attr< attribute_codes_to_attributes.size(); attr++)
+            for (AttributeEnums::const_iterator enumerant =
+                     attribute->second.begin();
+                 enumerant != attribute->second.end(); ++enumerant)
+            {
+                add_strings(accumulator, enumerant->second);
+            }
+        }
+
+        accumulator.end_structure();
+
+        // The label maps.
+        //
+        add_map(
+            accumulator,
+            "feature labels and geometries",
+            feature_labels_and_geometries_to_categories);
+        add_map(
+            accumulator,
+            "attribute label cache",
+            attribute_labels_to_attributes);
+        add_map(
+            accumulator, "feature labels to codes", feature_labels_to_codes);
+        add_map(
+            accumulator, "feature codes to labels", feature_codes_to_labels);
+        add_map(
+            accumulator,
+            "attribute labels to codes",
+            attribute_labels_to_codes);
+        add_map(
+            accumulator,
+            "attribute codes to labels",
+            attribute_codes_to_labels);
+        add_map(
+            accumulator, "enumerant labels to codes", enum_labels_to_codes);
+        add_map(
+            accumulator, "enumerant codes to labels", enum_codes_to_labels);
+
+        // The compressed image that rows are decoded from on demand.
+        //
+        if (rows_on_demand_table)
         {
-             if(attribute_codes_to_attributes[attr].valid())
-             {
-            attributes.push_back( attribute_codes_to_attributes[attr] );
-             count++;
-             }
+            const RowsOnDemand
+                &table = *rows_on_demand_table;
+
+            accumulator.begin_structure("rows on demand");
+            accumulator.add_bytes(sizeof(table));
+            accumulator.add_allocation(table.image.get_image_bytes());
+            accumulator.add_vector(table.row_sections);
+            accumulator.add_vector(table.row_offsets);
+            accumulator.add_allocation(
+                farm.size() * sizeof(std::atomic<bool>));
+            accumulator.add_vector(table.sections);
+            accumulator.add_vector(table.rows_left);
+
+            for (std::size_t section = 0;
+                 section < table.sections.size();
+                 ++section)
+            {
+                if (not table.sections[section].empty())
+                {
+                    accumulator.add_vector(table.sections[section]);
+                }
+            }
+
+            accumulator.end_structure();
         }
 
-        return attributes.size() == count;
-    }
+        // The code indexes.  Their sparse codes are few, and not counted.
+        //
+        accumulator.begin_structure("code indexes");
+        accumulator.add_bytes(
+            sizeof(feature_code_labels) +
+                sizeof(attribute_code_labels) +
+                sizeof(enum_code_labels) +
+                sizeof(feature_code_categories) +
+                3 * sizeof(LabelIndex));
+
+        const LabelIndex
+            *label_indexes[] = {
+                &feature_label_index,
+                &attribute_label_index,
+                &enum_label_index};
+
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            if (label_indexes[i]->get_bytes())
+            {
+                accumulator.add_allocation(label_indexes[i]->get_bytes());
+            }
+        }
 
-    // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_all_attribute_categories(
-        std::list<AttributeCategory> &attribute_categories
-    )
-    {
-        int
-                count=0;
-        verify_farm_initialization();
+        if (feature_code_labels.get_dense_bytes())
+        {
+            accumulator.add_allocation(feature_code_labels.get_dense_bytes());
+        }
 
-        attribute_categories.clear();
+        if (attribute_code_labels.get_dense_bytes())
+        {
+            accumulator.add_allocation(
+                attribute_code_labels.get_dense_bytes());
+        }
 
-        for(int attr=0; attr< attribute_codes_to_attributes.size(); attr++)
+        if (enum_code_labels.get_dense_bytes())
         {
-             if(attribute_codes_to_attributes[attr].valid())
-             {
-            attribute_categories.push_back( attr );
-            count++;
-             }
+            accumulator.add_allocation(enum_code_labels.get_dense_bytes());
+        }
+
+        if (feature_code_categories.get_dense_bytes())
+        {
+            accumulator.add_allocation(
+                feature_code_categories.get_dense_bytes());
+        }
+
+        accumulator.end_structure();
+
+        // The feature traits.
+        //
+        accumulator.begin_structure("feature traits");
+        accumulator.add_bytes(sizeof(feature_traits_storage));
+
+        if (not feature_traits_storage.empty())
+        {
+            accumulator.add_vector(feature_traits_storage);
         }
 
-        return attribute_categories.size() ==
-                count;
-    }
+        accumulator.end_structure();
+
+        // The label filters.
+        //
+        std::vector<LabelFilterStatistics>
+            statistics;
+
+        get_label_filter_statistics(statistics);
 
-    // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_attribute(
-        const AttributeCategory &attribute_category,
-        Attribute &attribute
-    )
-    {
-        bool
-            success = false;
+        accumulator.begin_structure("label filters");
+        accumulator.add_bytes(3 * sizeof(LabelFilter));
 
-        if (success=attribute_codes_to_attributes[ attribute_category ].valid())
+        for (std::vector<LabelFilterStatistics>::size_type i = 0;
+             i < statistics.size(); ++i)
         {
-            attribute = attribute_codes_to_attributes[ attribute_category ];
+            if (statistics[i].bits > 0)
+            {
+                accumulator.add_allocation(statistics[i].bits / 8);
+            }
         }
 
-        return success;
+        accumulator.end_structure();
     }
 
     // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_attribute_label(
-        const AttributeCategory &attribute_category,
-        AttributeLabel &attribute_label
+    void FeatureAttributeMapping::get_fingerprint(
+        SchemaFingerprint &fingerprint
     )
     {
-        bool
-            successful =
-                CORE::ordered(
-                    0,
-                    attribute_category,
-                    static_cast<int>(
-                        attribute_codes_to_attributes.size() - 1)) and
-                attribute_codes_to_attributes[attribute_category].valid();
+        // Changing what is hashed changes every fingerprint; bump the
+        // version with it so that the change is deliberate.
+        //
+        const CORE::Int64
+            fingerprint_version = 1;
+        FingerprintHasher
+            schema_hasher,
+            attribute_hasher;
 
-        if (successful)
+        verify_farm_initialization();
+        decode_all_rows();
+
+        fingerprint.clear();
+
+        // The attribute definitions and the enumerants of each attribute.
+        //
+        for (AttributeCodesToAttributes::size_type code = 0;
+             code < attribute_codes_to_attributes.size(); ++code)
         {
-            attribute_label =
-                attribute_codes_to_attributes[attribute_category].get_label();
+            const Attribute
+                &attribute = attribute_codes_to_attributes[code];
+
+            if (attribute.valid())
+            {
+                attribute_hasher.add(code);
+                attribute_hasher.add_string(attribute.get_label());
+                attribute_hasher.add(attribute.get_data_type());
+                attribute_hasher.add(attribute.get_units());
+                attribute_hasher.add(attribute.get_editability());
+            }
         }
 
-        return successful;
-    }
+        for (AttributeCodesToEnums::const_iterator attribute =
+                 attribute_codes_to_enums.begin();
+             attribute != attribute_codes_to_enums.end(); ++attribute)
+        {
+            attribute_hasher.add(attribute->first);
+            attribute_hasher.add(
+                static_cast<CORE::Int64>(attribute->second.size()));
 
-    // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_attribute_code(
-        const AttributeLabel &label,
-        AttributeCode &code
-    )
-    {
-        AttributeLabelsToCodes::iterator
-            code_map_iter = attribute_labels_to_codes.find(label);
-        bool
-            status = code_map_iter != attribute_labels_to_codes.end();
+            for (AttributeEnums::const_iterator enumerant =
+                     attribute->second.begin();
+                 enumerant != attribute->second.end(); ++enumerant)
+            {
+                add_enumerant(attribute_hasher, enumerant->second);
+            }
+        }
 
-        if (status)
+        fingerprint.attributes = attribute_hasher.get_fingerprint();
+
+        // The feature and the FARM table row of each feature category.
+        //
+        for (std::vector<FarmAttributeCodeToDataType>::size_type row = 0;
+             row < farm.size(); ++row)
         {
-            code = code_map_iter->second;
-        }
+            FeatureFingerprint
+                feature;
+            FingerprintHasher
+                hasher;
 
-        return status;
-    }
+            feature.category = row;
 
-    // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_attribute_label_from_code(
-        const AttributeCode &code,
-        AttributeLabel &label
-    )
-    {
-        AttributeCodesToLabels::iterator
-            label_map_iter = attribute_codes_to_labels.find(code);
+            if (row < feature_categories_to_features.size() and
+                feature_categories_to_features[row].valid())
+            {
+                const Feature
+                    &definition = feature_categories_to_features[row];
+
+                hasher.add(definition.get_code());
+                hasher.add_string(definition.get_label());
+                hasher.add(definition.get_geometry());
+                hasher.add(definition.get_usage_bitmask());
+                hasher.add(definition.get_precedence());
+                hasher.add(definition.get_attributes_overlay_size());
+            }
 
-        bool
-            status = label_map_iter != attribute_codes_to_labels.end();
+            for (FarmAttributeCodeToDataType::size_type column = 0;
+                 column < farm[row].size(); ++column)
+            {
+                if (farm[row][column])
+                {
+                    hasher.add(column);
+                    add_data_type(hasher, *farm[row][column]);
+                }
+            }
 
-        ASSERT(status,
-            fatal,
-            "Could not get the edcs attribute label for attribute code: "
-                + code);
+            feature.fingerprint = hasher.get_fingerprint();
+            fingerprint.features.push_back(feature);
+        }
 
-        if (status)
+        // The schema fingerprint covers the attributes and every feature
+        // category.
+        //
+        schema_hasher.add(fingerprint_version);
+        schema_hasher.add_fingerprint(fingerprint.attributes);
+
+        for (std::vector<FeatureFingerprint>::size_type i = 0;
+             i < fingerprint.features.size(); ++i)
         {
-            label = label_map_iter->second;
+            schema_hasher.add(fingerprint.features[i].category);
+            schema_hasher.add_fingerprint(fingerprint.features[i].fingerprint);
         }
 
-        return status;
+        fingerprint.fingerprint = schema_hasher.get_fingerprint();
     }
 
     // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_attribute_units(
-        const AttributeCategory &attribute_category,
-        AttributeUnits &attribute_units
-    )
+    void FeatureAttributeMapping::get_overlay_layout(OverlayLayout &layout)
     {
-        bool
-            successful =
-                attribute_codes_to_attributes[attribute_category].valid();
+        verify_farm_initialization();
+        decode_all_rows();
 
-        if (successful)
+        layout.categories.clear();
 
-            attribute_units =
-                attribute_codes_to_attributes[attribute_category].get_units();
+        for (FeatureCategoriesToFeatures::size_type row = 0;
+             row < feature_categories_to_features.size() and
+                 row < farm.size();
+             ++row)
+        {
+            const Feature
+                &feature = feature_categories_to_features[row];
+            OverlayCategoryLayout
+                category;
 
-        return successful;
+            if (not feature.valid())
+            {
+                continue;
+            }
+
+            category.category = row;
+            category.label = feature.get_label();
+            category.geometry = feature.get_geometry();
+            category.overlay_size = feature.get_attributes_overlay_size();
+
+            for (FarmAttributeCodeToDataType::size_type column = 0;
+                 column < farm[row].size() and
+                     column < attribute_codes_to_attributes.size();
+                 ++column)
+            {
+                DataType
+                    *data_type = farm[row][column];
+
+                if (not data_type)
+                {
+                    continue;
+                }
+
+                const InstantiatedDataType<CORE::Int32>
+                    *int32_data_type =
+                        dynamic_cast<InstantiatedDataType<CORE::Int32> *>(
+                            data_type);
+                const InstantiatedDataType<CORE::Float64>
+                    *float64_data_type =
+                        dynamic_cast<InstantiatedDataType<CORE::Float64> *>(
+                            data_type);
+                const BooleanDataType
+                    *boolean_data_type =
+                        dynamic_cast<BooleanDataType *>(data_type);
+                const EnumerantDataType
+                    *enumerant_data_type =
+                        dynamic_cast<EnumerantDataType *>(data_type);
+                OverlayAttributeLayout
+                    attribute;
+
+                attribute.code = column;
+                attribute.label =
+                    attribute_codes_to_attributes[column].get_label();
+                attribute.data_type =
+                    attribute_codes_to_attributes[column].get_data_type();
+                attribute.offset = data_type->get_offset();
+                attribute.default_value = 0.0;
+                attribute.minimum = 0.0;
+                attribute.maximum = 0.0;
+                attribute.default_enumerant = -1;
+
+                if (int32_data_type)
+                {
+                    attribute.default_value = int32_data_type->get_default();
+                    attribute.minimum = int32_data_type->get_minimum();
+                    attribute.maximum = int32_data_type->get_maximum();
+                }
+                else if (float64_data_type)
+                {
+                    attribute.default_value =
+                        float64_data_type->get_default();
+                    attribute.minimum = float64_data_type->get_minimum();
+                    attribute.maximum = float64_data_type->get_maximum();
+                }
+                else if (boolean_data_type)
+                {
+                    attribute.default_value =
+                        boolean_data_type->get_default();
+                    attribute.maximum = 1.0;
+                }
+                else if (enumerant_data_type)
+                {
+                    const Enumerants
+                        &valid_enums = enumerant_data_type->enumerants();
+
+                    attribute.default_enumerant =
+                        enumerant_data_type->get_default();
+
+                    for (Enumerants::const_iterator enumerant =
+                             valid_enums.begin();
+                         enumerant != valid_enums.end(); ++enumerant)
+                    {
+                        attribute.enumerants.push_back(std::make_pair(
+                            enumerant->get_ee_code(),
+                            enumerant->get_ee_label()));
+                    }
+
+                    std::sort(
+                        attribute.enumerants.begin(),
+                        attribute.enumerants.end());
+                }
+
+                category.attributes.push_back(attribute);
+            }
+
+            layout.categories.push_back(category);
+        }
     }
 
     // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::is_editable(
-        const AttributeCategory &attribute_category
-    )
+    void FeatureAttributeMapping::build_flat_image(std::vector<char> &image)
     {
-        bool
-            successful =
-                attribute_codes_to_attributes[attribute_category].valid();
+        std::vector<FeatureCategory>
+            feature_map;
+        std::vector<AttributeCategory>
+            attribute_map;
 
-        if (successful)
+        verify_farm_initialization();
+
+        for (FeatureCategoriesToFeatures::size_type category = 0;
+             category < feature_categories_to_features.size();
+             ++category)
         {
-           return
-           attribute_codes_to_attributes[attribute_category].get_editability();
+            feature_map.push_back(category);
         }
-        else
+
+        for (AttributeCodesToAttributes::size_type code = 0;
+             code < attribute_codes_to_attributes.size();
+             ++code)
         {
-            return false;
+            attribute_map.push_back(
+                attribute_codes_to_attributes[code].valid() ? code : -1);
         }
 
+        build_flat_image(feature_map, attribute_map, false, image);
     }
 
     // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_attribute(
-        const AttributeLabel &attribute_label,
-        Attribute &attribute
+    bool FeatureAttributeMapping::build_trimmed_flat_image(
+        const TrimManifest &manifest,
+        std::vector<char> &image
     )
     {
-        // Look in the cache for the attribute label.
-        //
-        std::map<AttributeLabel, Attribute>::const_iterator
-            iter = attribute_labels_to_attributes.find(attribute_label);
+        const std::vector<TrimFeatureUse>
+            &feature_uses = manifest.get_features();
+        const std::vector<TrimAttributeUse>
+            &attribute_uses = manifest.get_attributes();
+        std::vector<CORE::UInt64>
+            feature_counts(feature_categories_to_features.size(), 0),
+            attribute_counts(attribute_codes_to_attributes.size(), 0);
+        std::vector<bool>
+            kept_features(feature_categories_to_features.size(), false),
+            kept_attributes(attribute_codes_to_attributes.size(), false);
+        std::vector<std::pair<CORE::UInt64, int> >
+            feature_order,
+            attribute_order;
+        std::vector<FeatureCategory>
+            feature_map;
+        std::vector<AttributeCategory>
+            attribute_map;
         bool
-            successful = iter != attribute_labels_to_attributes.end();
+            successful = true;
 
-        if (successful)
+        verify_farm_initialization();
+
+        for (std::size_t index = 0; index < feature_uses.size(); ++index)
         {
-            // Found the attribute label in the cache.  Return the FARM
-            // attribute.
-            //
-            attribute = iter->second;
+            FeatureCategory
+                feature_category;
+
+            if (get_feature_category(
+                    feature_uses[index].label,
+                    feature_uses[index].geometry,
+                    feature_category))
+            {
+                kept_features[feature_category] = true;
+                feature_counts[feature_category] += feature_uses[index].count;
+            }
+            else
+            {
+                LOG_WITH_STREAM(
+                    high,
+                    "The FARM does not have the feature '" <<
+                        feature_uses[index].label << "' of geometry " <<
+                        feature_uses[index].geometry << " of the manifest.");
+                successful = false;
+            }
         }
-        else
+
+        for (std::size_t index = 0; index < attribute_uses.size(); ++index)
         {
-            // Could not find the attribute label in the cache.  Get the FARM
-            // attribute.
-            //
-            successful =
-                attribute.set_label(attribute_label) and
-                attribute.valid();
+            AttributeCategory
+                attribute_category;
 
-            if (successful)
+            if (get_attribute_category(
+                    attribute_uses[index].label, attribute_category))
             {
-                AttributeCode
-                    code = attribute.get_code();
+                kept_attributes[attribute_category] = true;
+                attribute_counts[attribute_category] +=
+                    attribute_uses[index].count;
+            }
+            else
+            {
+                LOG(
+                    high,
+                    "The FARM does not have the attribute '" +
+                        attribute_uses[index].label + "' of the manifest.");
+                successful = false;
+            }
+        }
 
-                if (attribute_codes_to_attributes.size() < (code + 1))
+        // Without attributes in the manifest, every attribute of the kept
+        // features is kept, and is used as often as they are.
+        //
+        if (attribute_uses.empty())
+        {
+            for (FeatureCategory category = 0;
+                 category < static_cast<FeatureCategory>(kept_features.size());
+                 ++category)
+            {
+                if (not kept_features[category])
                 {
-                    attribute_codes_to_attributes.resize(code + 1);
+                    continue;
                 }
 
-                // Make sure the editability is set for the attribute.
-                //
-                attribute = attribute_codes_to_attributes[code];
-
-                successful = attribute.valid();
+                const FarmAttributeCodeToDataType
+                    &row = get_farm_row(category);
 
-                if (successful)
+                for (std::size_t code = 0; code < row.size(); ++code)
                 {
-                    // Add the attribute label to the cache.
-                    //
-                    ASSERT(
-                        attribute_labels_to_attributes.insert(
-                            std::map<AttributeLabel, Attribute>::value_type(
-                                attribute_label, attribute)).second,
-                        high,
-                        "Could not cache an attribute label.");
+                    if (row[code])
+                    {
+                        kept_attributes[code] = true;
+                        attribute_counts[code] += feature_counts[category];
+                    }
                 }
             }
         }
 
+        // Number the kept categories and attributes by decreasing use, and
+        // by their FARM codes among equals.
+        //
+        for (std::size_t category = 0;
+             category < kept_features.size();
+             ++category)
+        {
+            if (kept_features[category])
+            {
+                feature_order.push_back(
+                    std::make_pair(~feature_counts[category], category));
+            }
+        }
+
+        for (std::size_t code = 0; code < kept_attributes.size(); ++code)
+        {
+            if (kept_attributes[code])
+            {
+                attribute_order.push_back(
+                    std::make_pair(~attribute_counts[code], code));
+            }
+        }
+
+        std::sort(feature_order.begin(), feature_order.end());
+        std::sort(attribute_order.begin(), attribute_order.end());
+
+        for (std::size_t index = 0; index < feature_order.size(); ++index)
+        {
+            feature_map.push_back(feature_order[index].second);
+        }
+
+        for (std::size_t index = 0; index < attribute_order.size(); ++index)
+        {
+            attribute_map.push_back(attribute_order[index].second);
+        }
+
+        build_flat_image(feature_map, attribute_map, true, image);
+
         return successful;
     }
 
     // ------------------------------------------------------------------------
-    bool FeatureAttributeMapping::get_attribute_category(
-        const AttributeLabel &attribute_label,
-        AttributeCategory &attribute_category
+    void FeatureAttributeMapping::build_flat_image(
+        const std::vector<FeatureCategory> &feature_map,
+        const std::vector<AttributeCategory> &attribute_map,
+        bool trimmed,
+        std::vector<char> &image
     )
     {
-        // Try to find the attribute label in the cache.
-        //
-        std::map<AttributeLabel, Attribute>::const_iterator
-            iter = attribute_labels_to_attributes.find(attribute_label);
-        bool
-            successful = iter != attribute_labels_to_attributes.end();
+        FlatImageBuilder
+            builder;
+        OverlayLayout
+            layout;
+        SchemaFingerprint
+            fingerprint;
+        std::vector<int>
+            layout_indexes(feature_categories_to_features.size(), -1);
+        std::vector<AttributeCategory>
+            image_codes(attribute_codes_to_attributes.size(), -1);
+        std::vector<std::map<EnumerantCode, EnumerantLabel> >
+            attribute_enumerants(attribute_map.size());
+
+        get_overlay_layout(layout);
+        get_fingerprint(fingerprint);
+
+        for (std::size_t index = 0; index < layout.categories.size(); ++index)
+        {
+            layout_indexes[layout.categories[index].category] = index;
+        }
 
-        if (successful)
+        for (std::size_t code = 0; code < attribute_map.size(); ++code)
         {
-            // Find the attribute label in the cache.  Get the attribute
-            // category.
-            //
-            attribute_category = iter->second.get_category();
+            if (attribute_map[code] >= 0)
+            {
+                image_codes[attribute_map[code]] = code;
+            }
         }
-        else
+
+        // The enumerants of an attribute are those valid for any feature of
+        // the image.
+        //
+        for (std::size_t category = 0;
+             category < feature_map.size();
+             ++category)
         {
-            // Could not find the attribute label in the cache.  Get the FARM
-            // attribute for the label.
-            //
-            Attribute
-                attribute;
+            if (layout_indexes[feature_map[category]] < 0)
+            {
+                continue;
+            }
 
-            successful = get_attribute(attribute_label, attribute);
+            const std::vector<OverlayAttributeLayout>
+                &attributes =
+                    layout.categories[
+                        layout_indexes[feature_map[category]]].attributes;
 
-            if (successful)
+            for (std::size_t column = 0; column < attributes.size(); ++column)
             {
-                // Get the attribute category and add the attribute label to
-                // the cache.
-                //
-                attribute_category = attribute.get_code();
+                AttributeCategory
+                    code = image_codes[attributes[column].code];
+
+                if (code >= 0)
+                {
+                    attribute_enumerants[code].insert(
+                        attributes[column].enumerants.begin(),
+                        attributes[column].enumerants.end());
+                }
+            }
+        }
+
+        for (std::size_t code = 0; code < attribute_map.size(); ++code)
+        {
+            if (attribute_map[code] >= 0)
+            {
+                builder.add_attribute(
+                    code,
+                    attribute_codes_to_attributes[attribute_map[code]],
+                    std::vector<std::pair<EnumerantCode, EnumerantLabel> >(
+                        attribute_enumerants[code].begin(),
+                        attribute_enumerants[code].end()));
+            }
+        }
+
+        // The features keep the offsets and overlay size of the FARM, so a
+        // trimmed feature only drops the cells of attributes not kept.
+        //
+        for (std::size_t category = 0;
+             category < feature_map.size();
+             ++category)
+        {
+            if (layout_indexes[feature_map[category]] < 0)
+            {
+                continue;
             }
-            else
+
+            OverlayCategoryLayout
+                &feature_layout =
+                    layout.categories[layout_indexes[feature_map[category]]];
+            std::vector<OverlayAttributeLayout>
+                cells;
+
+            for (std::size_t column = 0;
+                 column < feature_layout.attributes.size();
+                 ++column)
             {
+                AttributeCategory
+                    code = image_codes[feature_layout.attributes[column].code];
 
-                ASSERT(
-                    attribute_labels_to_attributes.insert(
-                        std::map<AttributeLabel, Attribute>::value_type(
-                            attribute_label, attribute)).second,
-                    high,
-                    "Could not cache an attribute label.");
+                if (code >= 0)
+                {
+                    cells.push_back(feature_layout.attributes[column]);
+                    cells.back().code = code;
+                }
             }
+
+            feature_layout.category = category;
+            feature_layout.attributes.swap(cells);
+
+            builder.add_feature(
+                feature_categories_to_features[feature_map[category]],
+                feature_layout);
         }
 
-        return successful;
+        if (trimmed)
+        {
+            builder.set_code_maps(
+                feature_map,
+                attribute_map,
+                feature_categories_to_features.size(),
+                attribute_codes_to_attributes.size());
+        }
+
+        builder.set_fingerprint(fingerprint.fingerprint);
+        builder.build(image);
     }
 
     // ------------------------------------------------------------------------
@@ -3932,11 +6240,14 @@ namespace FARM
         {
             attributes.clear();
 
+            const FarmAttributeCodeToDataType
+                &row = get_farm_row(feature_category);
+
             // Find the attributes that are contained in the feature.
             //
             for (int attr=0; attr < attribute_codes_to_attributes.size(); attr++)
             {
-                if (farm[feature_category][attr])
+                if (row[attr])
                 {
                     attributes.push_back(attribute_codes_to_attributes[attr]);
                 }
@@ -3959,11 +6270,14 @@ namespace FARM
         {
             attribute_labels.clear();
 
+            const FarmAttributeCodeToDataType
+                &row = get_farm_row(feature_category);
+
             // Find the attributes that are contained in the feature.
             //
             for (int attr=0; attr<attribute_codes_to_attributes.size(); attr++)
             {
-                if (farm[feature_category][attr])
+                if (row[attr])
                 {
                     attribute_labels.push_back(
                         attribute_codes_to_attributes[attr].get_label() );
@@ -3987,11 +6301,14 @@ namespace FARM
         {
             attribute_categories.clear();
 
+            const FarmAttributeCodeToDataType
+                &row = get_farm_row(feature_category);
+
             // Find the attributes that are contained in the feature.
             //
-            for (int attr=0; attr<farm[feature_category].size(); attr++)
+            for (int attr=0; attr<row.size(); attr++)
             {
-                if (farm[feature_category][attr])
+                if (row[attr])
                 {
                     attribute_categories.push_back(attr);
                 }
@@ -4014,18 +6331,21 @@ namespace FARM
         {
             string_attributes.clear();
 
+            const FarmAttributeCodeToDataType
+                &row = get_farm_row(feature_category);
+
             // Find the attributes that are strings and are contained in the
             // feature.
             //
-           for (int attr=0; attr<farm[feature_category].size(); attr++)
+           for (int attr=0; attr<row.size(); attr++)
             {
-                if (farm[feature_category][attr] and
+                if (row[attr] and
                     attribute_codes_to_attributes[attr].get_data_type() ==
                     string)
                 {
                     string_attributes.push_back(StringAttribute(
                         attr,
-                        farm[feature_category][attr]->get_offset()));
+                        row[attr]->get_offset()));
                 }
             }
         }
@@ -4050,6 +6370,8 @@ namespace FARM
         const Attribute &attribute
     )
     {
+        FARM_INSTRUMENT_CALL(valid_attribute);
+
          return  valid_attribute_category(attribute.get_category());
 
     }
@@ -4061,6 +6383,8 @@ namespace FARM
         const int attribute_value
     )
     {
+        FARM_INSTRUMENT_CALL(valid_attribute);
+
         bool
             successful;
         int
@@ -4077,7 +6401,7 @@ namespace FARM
             fatal,
             "Passed an invalid attribute category to valid_attribute.");
 
-        successful = farm[feature_category][attribute_category] and
+        successful = get_farm_row(feature_category)[attribute_category] and
             attribute_codes_to_attributes[attribute_category].
             get_data_type() == int32;
 
@@ -4101,6 +6425,8 @@ namespace FARM
         const double attribute_value
     )
     {
+        FARM_INSTRUMENT_CALL(valid_attribute);
+
         bool
             successful;
         double
@@ -4117,7 +6443,7 @@ namespace FARM
             fatal,
             "Passed an invalid attribute category to valid_attribute.");
 
-        successful = farm[feature_category][attribute_category] and
+        successful = get_farm_row(feature_category)[attribute_category] and
             attribute_codes_to_attributes[attribute_category].
             get_data_type() == float64;
 
@@ -4141,6 +6467,8 @@ namespace FARM
         const std::string &// Leaving name blank as it is unused parameter and used for function overloading 
     )
     {
+        FARM_INSTRUMENT_CALL(valid_attribute);
+
         ASSERT(
             valid_not_all_feature_category(feature_category),
             fatal,
@@ -4151,7 +6479,7 @@ namespace FARM
             fatal,
             "Passed an invalid attribute category to valid_attribute.");
 
-        return farm[feature_category][attribute_category] and
+        return get_farm_row(feature_category)[attribute_category] and
             attribute_codes_to_attributes[attribute_category].
             get_data_type() == string;
     }
@@ -4163,6 +6491,8 @@ namespace FARM
         const Enumerant &attribute_value
     )
     {
+        FARM_INSTRUMENT_CALL(valid_attribute);
+
         ASSERT(
             valid_not_all_feature_category(feature_category),
             fatal,
@@ -4174,7 +6504,7 @@ namespace FARM
             "Passed an invalid attribute category to valid_attribute.");
 
         return
-            farm[feature_category][attribute_category] and
+            get_farm_row(feature_category)[attribute_category] and
             attribute_codes_to_attributes[attribute_category].
                 get_data_type() == enumeration and
             attribute_value.valid() and
@@ -4193,6 +6523,8 @@ namespace FARM
         const bool // Leaving name blank since its an unused parameter and used for function overloading 
     )
     {
+        FARM_INSTRUMENT_CALL(valid_attribute);
+
         ASSERT(
             valid_not_all_feature_category(feature_category),
             fatal,
@@ -4204,7 +6536,7 @@ namespace FARM
             "Passed an invalid attribute category to valid_attribute() "
                 "(bool).");
 
-        return farm[feature_category][attribute_category] and
+        return get_farm_row(feature_category)[attribute_category] and
             attribute_codes_to_attributes[attribute_category].
             get_data_type() == boolean;
     }
@@ -4216,6 +6548,8 @@ namespace FARM
         const CORE::UUID & //Leaving name blank since its an unused parameter and used for function overloading
     )
     {
+        FARM_INSTRUMENT_CALL(valid_attribute);
+
         ASSERT(
             valid_not_all_feature_category(feature_category),
             fatal,
@@ -4226,11 +6560,49 @@ namespace FARM
             fatal,
             "Passed an invalid attribute category to valid_attribute.");
 
-        return farm[feature_category][attribute_category] and
+        return get_farm_row(feature_category)[attribute_category] and
             attribute_codes_to_attributes[attribute_category].
             get_data_type() == uuid;
     }
 
+    // ------------------------------------------------------------------------
+    bool FeatureAttributeMapping::valid_enumerant(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category,
+        const EnumerantCode &enumerant_code
+    )
+    {
+        bool
+            successful =
+                valid_not_all_feature_category(feature_category) and
+                valid_attribute_category(attribute_category) and
+                contains_attribute(feature_category, attribute_category) and
+                attribute_codes_to_attributes[attribute_category].
+                    get_data_type() == enumeration;
+
+        if (successful)
+        {
+            // Compare the codes only so that no enumerant labels need to be
+            // looked up.
+            //
+            const Enumerants
+                &enumerants = static_cast<EnumerantDataType *>(
+                    farm[feature_category][attribute_category])->enumerants();
+
+            successful = false;
+
+            for (Enumerants::const_iterator
+                enum_itr = enumerants.begin();
+                not successful and enum_itr != enumerants.end();
+                ++enum_itr)
+            {
+                successful = enum_itr->get_ee_code() == enumerant_code;
+            }
+        }
+
+        return successful;
+    }
+
     // ------------------------------------------------------------------------
     bool FeatureAttributeMapping::get_default(
         const FeatureCategory &feature_category,
@@ -4494,8 +6866,8 @@ namespace FARM
         Enumerant &enum_value
     )
     {
-        AttributeLabel
-            attribute_label;
+        FARM_INSTRUMENT_CALL(get_enumeration_value);
+
         Enumerant
             enum_tmp;
         Enumerants::const_iterator
@@ -4513,32 +6885,33 @@ namespace FARM
             // The feature contains the attribute and the attribute is an
             // enumeration.  Get the enumeration value.
             //
-            attribute_label=
-                attribute_codes_to_attributes[attribute_category].get_label();
+            const AttributeLabel
+                &attribute_label = attribute_codes_to_attributes[
+                    attribute_category].get_label();
 
             enum_tmp = Enumerant( attribute_label, enumerant_label );
 
-            ASSERT(
+            ASSERT_WITH_STREAM(
                 enum_tmp.valid(),
                 info,
                 "Attribute Label and Enumerant Label do not make a valid "
-                    "Enumerant: EA_Label = " + attribute_label +
-                    "; EE_Label = " + enumerant_label);
+                    "Enumerant: EA_Label = " << attribute_label <<
+                    "; EE_Label = " << enumerant_label);
 
             enum_itr = static_cast<EnumerantDataType *>(
                 farm[feature_category][attribute_category])->enumerants().
                     find(enum_tmp);
 
-            ASSERT(
+            ASSERT_WITH_STREAM(
                 enum_itr != static_cast<EnumerantDataType *>(
                     farm[feature_category][attribute_category])->
                         enumerants().end(),
                 info,
-                "The enumerant '" + enumerant_label + "' is not valid.");
+                "The enumerant '" << enumerant_label << "' is not valid.");
 
             if (successful)
             {
-                enum_value = enum_tmp;
+                enum_value = std::move(enum_tmp);
             }
         }
 
@@ -4553,6 +6926,8 @@ namespace FARM
         Enumerant &enum_value
     )
     {
+        FARM_INSTRUMENT_CALL(get_enumeration_value);
+
         Enumerant
             enum_tmp;
         Enumerants::const_iterator
@@ -4592,7 +6967,7 @@ namespace FARM
 
             if (successful)
             {
-                enum_value = enum_tmp;
+                enum_value = std::move(enum_tmp);
             }
         }
 
@@ -4606,27 +6981,56 @@ namespace FARM
         EnumerantLabel &enumerant_label
     )
     {
-        AttributeEnumCodePair
-            code(attrib_label, enumerant_code);
-
-        EnumerantCodesToLabels::iterator
-            label_map_iter = enum_codes_to_labels.find(code);
+        // Search the code indexes first, which unlike the map do not need
+        // the attribute label copied into a key.  Only codes that the
+        // indexes do not hold are looked up in the map.
+        //
+        const LabelView
+            attribute_view = make_label_view(attrib_label);
+        AttributeCode
+            attribute_code;
+        CORE::UInt8
+            miss;
+        const EnumerantLabel
+            *code_label =
+                attribute_label_index.find(
+                    &attribute_view, 1, -999, &attribute_code, &miss) == 0 ?
+                find_enum_code_label(attribute_code, enumerant_code) :
+                0;
+
+        if (not code_label)
+        {
+            EnumerantCodesToLabels::const_iterator
+                label_map_iter = enum_codes_to_labels.find(
+                    AttributeEnumCodePair(attrib_label, enumerant_code));
 
-        bool
-            status = label_map_iter != enum_codes_to_labels.end();
+            if (label_map_iter != enum_codes_to_labels.end())
+            {
+                code_label = &label_map_iter->second;
+            }
+        }
 
-        ASSERT(status,
+        ASSERT_WITH_STREAM(code_label,
             fatal,
-            "Could not get the edcs enumerant label for attribute: "
-                + attrib_label + ", enumerant code: "
-                + CORE::to_string(enumerant_code));
+            "Could not get the edcs enumerant label for attribute: " <<
+                attrib_label << ", enumerant code: " << enumerant_code);
 
-        if (status)
+        if (code_label)
         {
-            enumerant_label = label_map_iter->second;
+            enumerant_label = *code_label;
         }
 
-        return status;
+        return code_label != 0;
+    }
+
+    // ------------------------------------------------------------------------
+    const EnumerantLabel &
+        FeatureAttributeMapping::get_enumerant_label_unchecked(
+            const AttributeCode &attribute_code,
+            const EnumerantCode &enumerant_code
+        )
+    {
+        return *find_enum_code_label(attribute_code, enumerant_code);
     }
 
     // ------------------------------------------------------------------------
@@ -4636,22 +7040,73 @@ namespace FARM
         EnumerantCode &enumerant_code
     )
     {
-        AttributeEnumPair
-            label(attrib_label, enumerant_label);
-
-        EnumerantLabelsToCodes::iterator
-            code_map_iter = enum_labels_to_codes.find(label);
+        // Search the hash index of enum_labels_to_codes, which unlike the
+        // map does not need the labels copied into a key.
+        //
+        const LabelView
+            attribute_view = make_label_view(attrib_label),
+            enumerant_view = make_label_view(enumerant_label);
+        EnumerantCode
+            code;
+        CORE::UInt8
+            miss;
         bool
-            status = code_map_iter != enum_labels_to_codes.end();
+            status =
+                enum_label_index.find(
+                    &attribute_view, &enumerant_view, 1, -999, &code, &miss)
+                    == 0;
 
         if (status)
         {
-            enumerant_code = code_map_iter->second;
+            enumerant_code = code;
         }
 
         return status;
     }
 
+    // ------------------------------------------------------------------------
+    std::size_t FeatureAttributeMapping::get_enumerant_codes(
+        const LabelView *attribute_labels,
+        const LabelView *enumerant_labels,
+        std::size_t count,
+        EnumerantCode *codes,
+        CORE::UInt8 *misses
+    )
+    {
+        return find_labels(
+            enum_label_index,
+            attribute_labels,
+            enumerant_labels,
+            count,
+            codes,
+            misses);
+    }
+
+    // ------------------------------------------------------------------------
+    EnumerantHandle FeatureAttributeMapping::get_enumerant_handle(
+        const AttributeCode &attribute_code,
+        const EnumerantCode &enumerant_code
+    )
+    {
+        const AttributeLabel
+            *attribute_label = attribute_code_labels.find(attribute_code);
+        const EnumerantLabel
+            *enumerant_label =
+                find_enum_code_label(attribute_code, enumerant_code);
+
+        if (not attribute_label or not enumerant_label)
+        {
+            return EnumerantHandle();
+        }
+
+        return
+            EnumerantHandle(
+                attribute_code,
+                enumerant_code,
+                *attribute_label,
+                *enumerant_label);
+    }
+
     // ------------------------------------------------------------------------
     bool FeatureAttributeMapping::get_offsets_and_data_types(
         const FeatureCategory &feature_category,
@@ -4667,17 +7122,20 @@ namespace FARM
         {
             offsets_and_data_types.clear();
 
+            const FarmAttributeCodeToDataType
+                &row = get_farm_row(feature_category);
+
             // Get the offsets and data types for the attributes in the
             // feature.
             //
             for (int attr=0;attr<attribute_codes_to_attributes.size();attr++)
             {
-                if (farm[feature_category][attr])
+                if (row[attr])
                 {
                     // The feature contains the attribute.
 
                     offsets_and_data_types.push_back(OffsetAndDataType(
-                        farm[feature_category][attr]->get_offset(),
+                        row[attr]->get_offset(),
                      attribute_codes_to_attributes[attr].get_data_type()));
                 }
             }
@@ -4693,6 +7151,9 @@ namespace FARM
         std::string &failure_reason
     )
     {
+        StartupTracePhase
+            phase("FeatureAttributeMapping::read");
+
         CORE::UInt16
             little_endian;
         const CORE::Version
@@ -4702,7 +7163,8 @@ namespace FARM
         std::ifstream
             file;
         bool
-            edcs_initialized = false;
+            edcs_initialized = false,
+            swap_bytes = false;
 
         if (failure_reason == "" and not initialized())
         {
@@ -4731,7 +7193,10 @@ namespace FARM
                 LOG(fatal, failure_reason);
             }
 
-            // Read and check the endianness for the FARM.
+            // Read the endianness for the FARM.  The flag is 1 in the byte
+            // order of the machine that wrote the FARM if it is little
+            // endian, and 0 if it is big endian.  A FARM of the other byte
+            // order is read by swapping the bytes of every value.
             //
             if (failure_reason == "")
             {
@@ -4739,7 +7204,25 @@ namespace FARM
                     reinterpret_cast<char *>(&little_endian),
                     sizeof(little_endian));
 
-                if (little_endian != CORE::little_endian())
+                if (little_endian == 0 or
+                    little_endian == 1 or
+                    ByteSwap::swap(little_endian) == 1)
+                {
+                    ByteOrder
+                        file_order =
+                            little_endian == 0 ?
+                                big_endian_order : little_endian_order;
+
+                    swap_bytes = file_order != ByteSwap::get_host_order();
+
+                    if (swap_bytes)
+                    {
+                        LOG(info,
+                            "Swapping the bytes of a FARM written on a "
+                                "machine of the other byte order.");
+                    }
+                }
+                else
                 {
                     failure_reason =
                         "The endianness for the FARM is incorrect.";
@@ -4752,7 +7235,43 @@ namespace FARM
             //
             if (failure_reason == "")
             {
-                if (not file_vers.read(file))
+                bool
+                    version_read;
+
+                if (swap_bytes and not version_is_three_int32s(attr_vers))
+                {
+                    LOG(high,
+                        "The layout of the version is not known, so the "
+                            "bytes of the FARM cannot be swapped.");
+
+                    version_read = false;
+                }
+                else if (swap_bytes)
+                {
+                    // The version is three Int32's; swap them before the
+                    // version reads them.
+                    //
+                    CORE::Int32
+                        fields[3];
+
+                    file.read(
+                        reinterpret_cast<char *>(fields), sizeof(fields));
+                    ByteSwap::swap(fields, sizeof(fields[0]), 3);
+
+                    std::istringstream
+                        version_stream(
+                            std::string(
+                                reinterpret_cast<char *>(fields),
+                                sizeof(fields)));
+
+                    version_read = file and file_vers.read(version_stream);
+                }
+                else
+                {
+                    version_read = file_vers.read(file);
+                }
+
+                if (not version_read)
                 {
                     LOG(fatal,
                         "Could not read the version of the terrain database!");
@@ -4794,74 +7313,94 @@ namespace FARM
 
             if (failure_reason == "")
             {
-                // Read the 2-dimensional feature to attribute mapping array.
+                // The remainder of the file is read through one block
+                // buffered reader.
                 //
-                read_farm_table(file);
+                BinaryReader
+                    reader(file);
 
-                // Read the data structures for the feature categories.
+                reader.set_swap_bytes(swap_bytes);
+
+                // Read the 2-dimensional feature to attribute mapping array.
                 //
-                read_map<
-                    FeatureLabelAndGeometry,
-                    FeatureLabelAndGeometry,
-                    FeatureCategory,
-                    CORE::UInt16>(
-                        file, feature_labels_and_geometries_to_categories);
-
-                typedef std::map<FeatureCategory, Feature>
-                        CtoFtype;
-                CtoFtype CtoF;
-                read_map<FeatureCategory, CORE::UInt16, Feature, Feature>(
-                    file, CtoF);
-
-                 // Put it into vector
-                 //
-                 feature_categories_to_features.resize(CtoF.size());
-                 for (CtoFtype::const_iterator code_itr = CtoF.begin();
-                      code_itr != CtoF.end();
-                      ++code_itr)
-                 {
-                      feature_categories_to_features[code_itr->first]=
-                            code_itr->second;
-
-                 }
-                // Read the data structures for the attribute categories.
+                read_farm_table(reader);
+
+                // Read the maps for the feature and attribute categories.
                 //
-                typedef std::map<AttributeCode, Attribute>
-                AtoAtype;
-                AtoAtype AtoA;
-
-                read_map<
-                    AttributeCode,
-                    CORE::UInt16,
-                    Attribute,
-                    Attribute>(file, AtoA);
-
-                 // Put it into vector
-                 //
-                  int
-                        code_max=0;
-
-                  for (AtoAtype::const_iterator code_itr = AtoA.begin();
-                      code_itr != AtoA.end();
-                      ++code_itr)
-
-                      if(code_itr->first > code_max)
-                          code_max=code_itr->first;
-
-                 attribute_codes_to_attributes.resize(code_max+1);
-                 for (AtoAtype::const_iterator code_itr = AtoA.begin();
-                      code_itr != AtoA.end();
-                      ++code_itr)
-
-                          attribute_codes_to_attributes[code_itr->first]=
+                {
+                    StartupTracePhase
+                        phase("FeatureAttributeMapping::read_maps");
+
+                    // Read the data structures for the feature categories.
+                    //
+                    read_map<
+                        FeatureLabelAndGeometry,
+                        FeatureLabelAndGeometry,
+                        FeatureCategory,
+                        CORE::UInt16>(
+                            reader,
+                            feature_labels_and_geometries_to_categories);
+
+                    typedef std::map<FeatureCategory, Feature>
+                            CtoFtype;
+                    CtoFtype CtoF;
+                    read_map<FeatureCategory, CORE::UInt16, Feature, Feature>(
+                        reader, CtoF);
+
+                     // Put it into vector
+                     //
+                     feature_categories_to_features.resize(CtoF.size());
+                     for (CtoFtype::const_iterator code_itr = CtoF.begin();
+                          code_itr != CtoF.end();
+                          ++code_itr)
+                     {
+                          feature_categories_to_features[code_itr->first]=
                                 code_itr->second;
 
+                     }
+                    // Read the data structures for the attribute categories.
+                    //
+                    typedef std::map<AttributeCode, Attribute>
+                    AtoAtype;
+                    AtoAtype AtoA;
+
+                    read_map<
+                        AttributeCode,
+                        CORE::UInt16,
+                        Attribute,
+                        Attribute>(reader, AtoA);
+
+                     // Put it into vector
+                     //
+                      int
+                            code_max=0;
+
+                      for (AtoAtype::const_iterator code_itr = AtoA.begin();
+                          code_itr != AtoA.end();
+                          ++code_itr)
+
+                          if(code_itr->first > code_max)
+                              code_max=code_itr->first;
+
+                     attribute_codes_to_attributes.resize(code_max+1);
+                     for (AtoAtype::const_iterator code_itr = AtoA.begin();
+                          code_itr != AtoA.end();
+                          ++code_itr)
+
+                              attribute_codes_to_attributes[code_itr->first]=
+                                    code_itr->second;
+                }
+
             }
 
             farm_initialized = failure_reason == "";
+            ++generation;
 
             if (farm_initialized)
             {
+                build_feature_code_categories();
+                build_feature_traits();
+
                 ASSERT(
                     FeatureCategories::initialize(),
                     fatal,
@@ -4901,9 +7440,24 @@ namespace FARM
 
     // ------------------------------------------------------------------------
     bool FeatureAttributeMapping::write(
-        const std::string &database_directory
+        const std::string &database_directory,
+        ByteOrder byte_order
     )
     {
+        bool
+            swap_bytes = byte_order != ByteSwap::get_host_order();
+        CORE::Version
+            version(CORE::Version::land_version);
+
+        if (swap_bytes and not version_is_three_int32s(version))
+        {
+            LOG(high,
+                "The layout of the version is not known, so the FARM cannot "
+                    "be written in the other byte order.");
+
+            return false;
+        }
+
         std::ofstream
             file(
                 (database_directory + "/otf/" + farm_file_label).c_str(),
@@ -4919,21 +7473,51 @@ namespace FARM
         // Write the endianness for the FARM.
         //
         CORE::UInt16
-            little_endian = CORE::little_endian() ? 1 : 0;
+            little_endian = byte_order == little_endian_order ? 1 : 0;
+
+        if (swap_bytes)
+        {
+            little_endian = ByteSwap::swap(little_endian);
+        }
 
         file.write(
             reinterpret_cast<char *>(&little_endian), sizeof(little_endian));
 
         // Write the version of the file.
         //
-        CORE::Version
-            version(CORE::Version::land_version);
+        if (swap_bytes)
+        {
+            // The version is three Int32's, as checked above; they are
+            // written from its accessors.
+            //
+            CORE::Int32
+                fields[3] =
+                {
+                    version.get_version(),
+                    version.get_format(),
+                    version.get_update()
+                };
+
+            ByteSwap::swap(fields, sizeof(fields[0]), 3);
+
+            file.write(reinterpret_cast<char *>(fields), sizeof(fields));
+        }
+        else
+        {
+            version.write(file);
+        }
+
+        // The remainder of the file is written through one block buffered
+        // writer.
+        //
+        BinaryWriter
+            writer(file);
 
-        version.write(file);
+        writer.set_swap_bytes(swap_bytes);
 
         // Write the 2-dimensional feature to attribute mapping array.
         //
-        write_farm_table(file);
+        write_farm_table(writer);
 
         // Write the data structures for the feature categories.
         //
@@ -4941,7 +7525,7 @@ namespace FARM
             FeatureLabelAndGeometry,
             FeatureLabelAndGeometry,
             FeatureCategory,
-            CORE::UInt16>(file, feature_labels_and_geometries_to_categories);
+            CORE::UInt16>(writer, feature_labels_and_geometries_to_categories);
         // Convert vector to map for writing to DB
         //
         typedef std::map<FeatureCategory, Feature>
@@ -4952,7 +7536,8 @@ namespace FARM
                  CtoF.insert(CtoFtype::value_type(
                         i,
                         feature_categories_to_features[i]));
-        write_map<FeatureCategory, CORE::UInt16, Feature, Feature>(file, CtoF);
+        write_map<FeatureCategory, CORE::UInt16, Feature, Feature>(
+            writer, CtoF);
 
         // Write the data structures for the attribute categories.
         //
@@ -4968,7 +7553,9 @@ namespace FARM
             AttributeCode,
             CORE::Int32,
             Attribute,
-            Attribute>(file, AtoA);
+            Attribute>(writer, AtoA);
+
+        writer.flush();
 
         return file.good();
     }
@@ -5017,15 +7604,181 @@ namespace FARM
                 {
                     file.precision(20);
 
+                    BinaryWriter
+                        writer(file);
+
                     // Write the tables and maps in the FARM to the file.
                     //
-                    dump_feature_labels_geometries_to_categories(file);
-                    dump_feature_categories_to_features(file);
-                    dump_attribute_codes_to_attributes(file);
-                    dump_attribute_codes_to_enums(file);
-                    dump_farm_table(file);
+                    dump_feature_labels_geometries_to_categories(writer);
+                    dump_feature_categories_to_features(writer);
+                    dump_attribute_codes_to_attributes(writer);
+                    dump_attribute_codes_to_enums(writer);
+                    dump_farm_table(writer);
+
+                    writer.flush();
+                    successful = file.good();
+                }
+            }
+        }
+
+        return successful;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FeatureAttributeMapping::dump_compressed(
+        const std::string &output_dir
+    )
+    {
+        std::cout << "Dumping the compressed FARM." << std::endl;
+
+        bool
+            successful = initialized();
+
+        ASSERT(
+            successful, high, "The FARM was used before it was initialized.");
+
+        if (successful)
+        {
+            // Create the output directory.
+            //
+            successful = CORE::DirectoryParser::verify_dir(output_dir);
+
+            ASSERT(
+                successful,
+                high,
+                "Could not create the directory '" + output_dir + "'.");
+        }
+
+        if (successful)
+        {
+            CompressedImageWriter
+                image;
+
+            // Each map is a section.
+            //
+            for (int kind = feature_categories_section;
+                 kind < farm_table_section;
+                 ++kind)
+            {
+                std::ostringstream
+                    section;
+
+                {
+                    BinaryWriter
+                        writer(section);
+
+                    switch (kind)
+                    {
+                        case feature_categories_section:
+                        {
+                            dump_feature_labels_geometries_to_categories(
+                                writer);
+                            break;
+                        }
+
+                        case features_section:
+                        {
+                            dump_feature_categories_to_features(writer);
+                            break;
+                        }
+
+                        case attributes_section:
+                        {
+                            dump_attribute_codes_to_attributes(writer);
+                            break;
+                        }
+
+                        case enums_section:
+                        {
+                            dump_attribute_codes_to_enums(writer);
+                            break;
+                        }
+                    };
+                }
+
+                image.add_section(
+                    static_cast<CompressedSectionKind>(kind), section.str());
+            }
+
+            // The FARM table is split into sections of whole rows.  The
+            // offset of each row in its section is kept for the row index.
+            //
+            int
+                first_row = 0;
+            std::vector<CORE::Int32>
+                row_offsets;
+
+            decode_all_rows();
+
+            while (first_row < farm.size())
+            {
+                std::ostringstream
+                    section;
+                int
+                    row = first_row;
+
+                {
+                    BinaryWriter
+                        writer(section);
+
+                    while (row < farm.size() and
+                           static_cast<std::size_t>(section.tellp()) <
+                               compressed_table_section_bytes)
+                    {
+                        row_offsets.push_back(section.tellp());
+
+                        dump_farm_table_row(writer, row);
+                        writer.flush();
+
+                        ++row;
+                    }
+                }
+
+                image.add_section(
+                    farm_table_section,
+                    section.str(),
+                    first_row,
+                    row - first_row);
+
+                first_row = row;
+            }
+
+            // The row index lets rows be decoded on demand.
+            //
+            {
+                std::ostringstream
+                    section;
+
+                {
+                    BinaryWriter
+                        writer(section);
+
+                    writer.write(static_cast<CORE::Int32>(row_offsets.size()));
+
+                    if (not row_offsets.empty())
+                    {
+                        writer.write_array(
+                            &row_offsets[0], row_offsets.size());
+                    }
                 }
+
+                image.add_section(row_index_section, section.str());
             }
+
+            std::string
+                file_name = output_dir + "/" + farm_compressed_input_file;
+
+            successful = image.write(file_name);
+
+            ASSERT(
+                successful,
+                high,
+                "Could not write the file '" + file_name + "'.");
+
+            LOG_WITH_STREAM(
+                info,
+                "Compressed the FARM from " << image.get_data_bytes() <<
+                    " to " << image.get_compressed_bytes() << " bytes.");
         }
 
         return successful;
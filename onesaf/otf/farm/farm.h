@@ -18,16 +18,27 @@
  */
 #ifndef FARM_H
 #define FARM_H
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <list>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "farm_data_types.h"
 #include "farm_attribute.h"
+#include "farm_binary_cache.h"
+#include "farm_byte_swap.h"
+#include "farm_compressed_image.h"
 #include "farm_feature.h"
+#include "farm_fingerprint.h"
 #include "farm_enumerant.h"
+#include "farm_handles.h"
+#include "farm_label_filter.h"
+#include "farm_label_index.h"
+#include "farm_memory_footprint.h"
+#include "farm_typed_attribute.h"
 
 #include "core/angle.h"
 #include "core/linear.h"
@@ -44,6 +55,12 @@ namespace FARM
     typedef std::pair<FARM::AttributeLabel, FARM::EnumerantLabel>
         AttributeEnumPair;
 
+    // The overlay layout and the trim manifest are only passed by reference,
+    // so the tools that build them include their headers.
+    //
+    struct OverlayLayout;
+    class TrimManifest;
+
     // ------------------------------------------------------------------------
     // The FARM is either initialized by reading from configuration files or by
     // reading from the terrain database.  The FDF file contains the label,
@@ -61,7 +78,9 @@ namespace FARM
 
         // Initializes the FARM using the feature configuration files or the
         // FARM.bin file in the database directory if the configuration files
-        // do not exist.
+        // do not exist.  When the BinaryCache is on, the FARM is loaded from
+        // its image if the configuration files have not changed, and the
+        // image is rebuilt after they are parsed otherwise.
         //
         // Return:  Was the FARM initialized successfully?
         //
@@ -75,6 +94,25 @@ namespace FARM
             const std::string &edcs_3p1_4p3_enum_mapping
         );
 
+        // Turns on or off decoding FARM table rows on demand, which takes
+        // effect at the next initialize().  When it is on and the FARM is
+        // read from a compressed image with a row index, only the maps are
+        // decoded at startup; each row and its enumerants are decoded the
+        // first time the row is queried, so a process that uses a few
+        // feature categories loads only those.  Until it is set, it is on
+        // when the environment variable FARM_ROWS_ON_DEMAND is set to 1.
+        //
+        static void set_rows_on_demand(bool on);
+
+        // Return:  Are FARM table rows decoded on demand?
+        //
+        static bool rows_on_demand(void);
+
+        // Return:  The number of FARM table rows that have been decoded, which
+        // is every row unless rows are decoded on demand.
+        //
+        static int get_decoded_row_count(void);
+
         // Releases any memory that was allocated for the FARM.
         //
         static void destroy(void);
@@ -150,6 +188,34 @@ namespace FARM
             FARM::Feature &feature
         );
 
+        // Returns the FARM's own feature of the feature label and geometry,
+        // or of the feature category, without copying it.  The feature is
+        // valid until the FARM is destroyed.
+        //
+        // Return:  The feature, or null if the FARM does not have it.
+        //
+        static const FARM::Feature *get_feature(
+            const FeatureLabel &feature_label,
+            const FeatureGeometry &feature_geometry
+        );
+
+        static const FARM::Feature *get_feature(
+            const FeatureCategory &feature_category
+        );
+
+        // Return:  A handle to the feature of the feature category, or of
+        // the feature code and geometry.  The handle is not valid if the
+        // FARM does not have the feature.
+        //
+        static FeatureHandle get_feature_handle(
+            const FeatureCategory &feature_category
+        );
+
+        static FeatureHandle get_feature_handle(
+            const FeatureCode &code,
+            const FeatureGeometry &geometry
+        );
+
         // Returns the feature label associated with the feature category.
         //
         // Return:  Was the feature returned successfully?
@@ -175,6 +241,16 @@ namespace FARM
             FeatureLabel &label
         );
 
+        // Returns the feature category of the feature code and geometry.
+        //
+        // Return:  Does the FARM have a feature of the code and geometry?
+        //
+        static bool get_feature_category_from_code(
+            const FeatureCode &code,
+            const FeatureGeometry &geometry,
+            FeatureCategory &feature_category
+        );
+
         // Returns the respective feature code for the given feature label.
         //
         static bool get_feature_code(
@@ -182,6 +258,20 @@ namespace FARM
             FeatureCode &code
         );
 
+        // Returns the feature codes of a batch of feature labels, such as
+        // those of the records of a terrain source file.  A label that is
+        // not found gets the code -999 and a miss of 1, and the others a
+        // miss of 0.  Large batches are split between threads.
+        //
+        // Return:  The number of labels that were not found.
+        //
+        static std::size_t get_feature_codes(
+            const LabelView *labels,
+            std::size_t count,
+            FeatureCode *codes,
+            CORE::UInt8 *misses
+        );
+
         // Returns the feature geometry associated with the feature category.
         //
         // Return:  Was the feature returned successfully?
@@ -219,6 +309,19 @@ namespace FARM
             int &attributes_overlay_size
         );
 
+        // Returns the geometry, usages, precedence, and attributes overlay
+        // size of the feature category in one 16 byte record, for code that
+        // reads them for every feature every tick.  The record is read from
+        // an array indexed by category, without the checks and lookups of
+        // get_feature().
+        //
+        // Return:  The traits of the feature, which are not valid if the
+        // FARM has no such feature.
+        //
+        static const FeatureTraits &get_feature_traits(
+            const FARM::FeatureCategory &feature_category
+        );
+
         // Return:  Is the feature category valid for the terrain database?
         //
         static bool valid_feature(
@@ -316,6 +419,23 @@ namespace FARM
             AttributeCode &code
         );
 
+        // Returns the attribute codes of a batch of attribute labels, as
+        // get_feature_codes() does.
+        //
+        // Return:  The number of labels that were not found.
+        //
+        static std::size_t get_attribute_codes(
+            const LabelView *labels,
+            std::size_t count,
+            AttributeCode *codes,
+            CORE::UInt8 *misses
+        );
+
+        // Return:  A handle to the attribute of the attribute code, which is
+        // not valid if the FARM does not have the attribute.
+        //
+        static AttributeHandle get_attribute_handle(const AttributeCode &code);
+
         // Returns the data type associated with the attribute category.
         //
         // Return:  Was the data type returned successfully?
@@ -349,6 +469,49 @@ namespace FARM
             const AttributeCategory &attribute_category
         );
 
+        // Returns the counters of the filters that reject unknown feature
+        // and attribute labels before the label tables are searched.
+        //
+        static void get_label_filter_statistics(
+            std::vector<LabelFilterStatistics> &statistics
+        );
+
+        // Walks every FARM structure and returns the memory it uses, by
+        // structure and by feature category.  The walk takes a while on a
+        // large FARM, so it should not be done while the FARM is in use.
+        //
+        static void get_memory_footprint(MemoryFootprint &footprint);
+
+        // Returns the fingerprint of the FARM schema and of each feature
+        // category, which peers compare to confirm that they share the same
+        // FARM.
+        //
+        static void get_fingerprint(SchemaFingerprint &fingerprint);
+
+        // Returns the attribute overlay of every feature category, which is
+        // saved with the overlays written with this FARM so that
+        // OverlayMigration can migrate them to a later FARM.
+        //
+        static void get_overlay_layout(OverlayLayout &layout);
+
+        // Builds a flat image of the FARM, which FlatFarm queries in place
+        // and SharedFarm shares between processes.
+        //
+        static void build_flat_image(std::vector<char> &image);
+
+        // Builds a trimmed flat image that holds only the feature categories
+        // and attributes of the manifest.  They are numbered from zero, most
+        // used first, and the image maps the new codes to those of this
+        // FARM.  Enumerant codes, attribute offsets, and overlay sizes are
+        // kept, so overlays written with this FARM are read unchanged.
+        //
+        // Return:  Was every entry of the manifest in this FARM?
+        //
+        static bool build_trimmed_flat_image(
+            const TrimManifest &manifest,
+            std::vector<char> &image
+        );
+
         // Returns all the attributes in a feature with the feature category.
         //
         // Return:  Were the attribute categories returned successfully?
@@ -453,6 +616,15 @@ namespace FARM
             const CORE::UUID &attribute_value
         );
 
+        // Return:  Is the enumerant code one of the valid enumerants for the
+        // given feature and attribute?
+        //
+        static bool valid_enumerant(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category,
+            const EnumerantCode &enumerant_code
+        );
+
         // Returns the default attribute value for the given feature and
         // attribute.
         //
@@ -587,6 +759,28 @@ namespace FARM
             EnumerantCode &enumerant_code
         );
 
+        // Returns the enumerant codes of a batch of attribute and enumerant
+        // label pairs, as get_feature_codes() does.
+        //
+        // Return:  The number of pairs that were not found.
+        //
+        static std::size_t get_enumerant_codes(
+            const LabelView *attribute_labels,
+            const LabelView *enumerant_labels,
+            std::size_t count,
+            EnumerantCode *codes,
+            CORE::UInt8 *misses
+        );
+
+        // Return:  A handle to the enumerant of the attribute code and
+        // enumerant code, which is not valid if the FARM does not have the
+        // enumerant.
+        //
+        static EnumerantHandle get_enumerant_handle(
+            const AttributeCode &attribute_code,
+            const EnumerantCode &enumerant_code
+        );
+
         // Returns the offset of the attribute from the beginning of the
         // attributes overlay for a feature with the feature category.
         //
@@ -609,6 +803,135 @@ namespace FARM
             OffsetsAndDataTypes &offsets_and_data_types
         );
 
+        // The unchecked queries, for loops whose feature and attribute
+        // categories have already been checked, as with contains_attribute()
+        // and get_data_type().  They neither check their arguments nor log:
+        // the feature category must be valid, the feature must contain the
+        // attribute, and the attribute must be of the data type of the
+        // query.
+
+        // Return:  The offset of the attribute in the attributes overlay of
+        // a feature with the feature category.
+        //
+        static AttributeOffset get_attribute_offset_unchecked(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category
+        );
+
+        // Return:  Is the Int32 attribute value within the range of the
+        // attribute for the given feature?
+        //
+        static bool valid_attribute_unchecked(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category,
+            const int attribute_value
+        );
+
+        // Return:  Is the Float64 attribute value within the range of the
+        // attribute for the given feature?
+        //
+        static bool valid_attribute_unchecked(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category,
+            const double attribute_value
+        );
+
+        // Return:  Is the enumerant code one of the valid enumerants of the
+        // enumerated attribute for the given feature?
+        //
+        static bool valid_enumerant_unchecked(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category,
+            const EnumerantCode &enumerant_code
+        );
+
+        // Returns the minimum and maximum values of the Int32 attribute for
+        // the given feature.
+        //
+        static void get_min_max_unchecked(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category,
+            int &minimum_value,
+            int &maximum_value
+        );
+
+        // Returns the minimum and maximum values of the Float64 attribute
+        // for the given feature.
+        //
+        static void get_min_max_unchecked(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category,
+            double &minimum_value,
+            double &maximum_value
+        );
+
+        // Return:  The label of the enumerant of the attribute, which must
+        // be in the FARM.  The label is valid until the FARM is destroyed.
+        //
+        static const EnumerantLabel &get_enumerant_label_unchecked(
+            const AttributeCode &attribute_code,
+            const EnumerantCode &enumerant_code
+        );
+
+        // The typed accessors of the attribute of an attribute tag, which
+        // carries the C++ type of the attribute's values (see
+        // farm_typed_attribute.h).  A value of the wrong type does not
+        // compile.  The tag's attribute is looked up once for each FARM that
+        // is loaded, so an access is a bounds-checked load from the FARM
+        // table.  Each returns false if the feature does not contain the
+        // attribute, or if the FARM has no attribute of the tag's label and
+        // data type.
+
+        // Returns the value of the tag's attribute in the attributes overlay
+        // of a feature with the feature category.
+        //
+        // Return:  Was the attribute value returned successfully?
+        //
+        template<class Tag>
+        static bool get(
+            const FeatureCategory &feature_category,
+            const char *overlay,
+            typename Tag::Value &value
+        );
+
+        // Return:  Is the value valid for the given feature and the tag's
+        // attribute?
+        //
+        template<class Tag, class Value>
+        static bool valid(
+            const FeatureCategory &feature_category,
+            const Value &value
+        );
+
+        // Returns the minimum and maximum values of the tag's attribute for
+        // the given feature.  Only numeric attributes have bounds.
+        //
+        // Return:  Were the minimum and maximum values returned
+        // successfully?
+        //
+        template<class Tag>
+        static bool bounds(
+            const FeatureCategory &feature_category,
+            typename Tag::Value &minimum_value,
+            typename Tag::Value &maximum_value
+        );
+
+        // Returns the default value of the tag's attribute for the given
+        // feature.
+        //
+        // Return:  Was the default value returned successfully?
+        //
+        template<class Tag>
+        static bool get_default(
+            const FeatureCategory &feature_category,
+            typename Tag::Value &default_value
+        );
+
+        // Return:  The generation of the FARM, which changes whenever the
+        // FARM is loaded or destroyed.
+        //
+        static CORE::UInt32 get_generation(void);
+
         // Return:  Was the data for the FARM read successfully?
         //
         static bool read(
@@ -619,11 +942,18 @@ namespace FARM
             std::string &failure_reason
         );
 
+        // Writes the FARM in the byte order of this machine, or in the
+        // other byte order for a machine of that order.  read() accepts
+        // either.  The other byte order is only written, and read, when
+        // CORE::Version is serialized as its three Int32 fields, since CORE
+        // writes the version.
+        //
         // Return:  Was the data in the FARM written successfully?
         //
         static bool write(
-            const std::string &database_directory  // Directory to write the
+            const std::string &database_directory, // Directory to write the
                                                    // FARM data to.
+            ByteOrder byte_order = ByteSwap::get_host_order()
         );
 
         /**
@@ -637,6 +967,19 @@ namespace FARM
          */
         static bool dump(const std::string &output_dir);
 
+        /**
+         * Writes the contents of the FARM to the compressed image "FARM.binz"
+         * in the given directory.  The image holds the data of FARM.bin in
+         * sections that are compressed separately, so they can be decoded in
+         * parallel.  When the image is in the database directory, the FARM
+         * is initialized from it instead of from FARM.bin.
+         *
+         * @param output_dir Directory to write the compressed image to.
+         *
+         * @return Was the compressed image created successfully?
+         */
+        static bool dump_compressed(const std::string &output_dir);
+
         /**
          * Returns whether features in the given feature category are supposed
          * to be integrated in the ITIN.
@@ -716,6 +1059,16 @@ namespace FARM
 
       private:
 
+        // Builds a flat image of the feature categories and attributes in
+        // the maps, which give the FARM code of each code of the image.
+        //
+        static void build_flat_image(
+            const std::vector<FeatureCategory> &feature_map,
+            const std::vector<AttributeCategory> &attribute_map,
+            bool trimmed,
+            std::vector<char> &image
+        );
+
         static void read_fdf(const std::string &fdf_file_label);
 
         static void read_adf(const std::string &adf_file_label);
@@ -733,50 +1086,117 @@ namespace FARM
 
         static void read_faa(const std::string &faa_file_label);
 
-        static void read_farm_table(std::istream &stream);
+        static void read_farm_table(BinaryReader &reader);
 
-        static void write_farm_table(std::ostream &stream);
+        static void write_farm_table(BinaryWriter &writer);
 
         static void dump_feature_labels_geometries_to_categories(
-            std::ostream &stream
+            BinaryWriter &writer
         );
 
         static void load_feature_labels_geometries_to_categories(
-            std::istream &stream
+            BinaryReader &reader
         );
 
-        static void dump_feature_categories_to_features(std::ostream &stream);
+        static void dump_feature_categories_to_features(BinaryWriter &writer);
+
+        static void load_feature_categories_to_features(BinaryReader &reader);
 
-        static void load_feature_categories_to_features(std::istream &stream);
+        static void dump_attribute_codes_to_attributes(BinaryWriter &writer);
 
-        static void dump_attribute_codes_to_attributes(std::ostream &stream);
+        static void load_attribute_codes_to_attributes(BinaryReader &reader);
 
-        static void load_attribute_codes_to_attributes(std::istream &stream);
+        static void dump_attribute_codes_to_enums(BinaryWriter &writer);
 
-        static void dump_attribute_codes_to_enums(std::ostream &stream);
+        static void load_attribute_codes_to_enums(BinaryReader &reader);
 
-        static void load_attribute_codes_to_enums(std::istream &stream);
+        static void dump_farm_table(BinaryWriter &writer);
 
-        static void dump_farm_table(std::ostream &stream);
+        static void load_farm_table(BinaryReader &reader);
 
-        static void load_farm_table(std::istream &stream);
+        static void dump_farm_table_row(BinaryWriter &writer, int index);
+
+        static void load_farm_table_row(BinaryReader &reader, int feat_index);
 
         static void initialize_farm_from_binary_file(
             const std::string &database_directory
         );
 
-        static const FARM::Feature *get_feature(
-            const FeatureLabel &feature_label,
-            const FeatureGeometry &feature_geometry
+        static void initialize_farm_from_compressed_file(
+            const std::string &file_name
         );
 
-        static const FARM::Feature *get_feature(
-            const FeatureCategory &feature_category
+        // Takes sections of the compressed image until none are left.  The
+        // first pass decompresses every section and decodes the maps; the
+        // second decodes the FARM table rows, which need the attributes.
+        //
+        static void decode_compressed_sections(
+            const CompressedImageReader &image,
+            std::vector< std::vector<char> > &buffers,
+            std::atomic<int> &next_section,
+            std::atomic<bool> &successful,
+            bool decode_rows
         );
 
+        // Loads the FARM from the binary cache.  The FARM tables are left
+        // empty if the image could not be read.
+        //
+        // Return:  Was the FARM loaded?
+        //
+        static bool read_binary_cache(const BinaryCacheKey &key);
+
+        // Writes the FARM to the binary cache.
+        //
+        static void write_binary_cache(const BinaryCacheKey &key);
+
+        // Releases the FARM table and clears the feature and attribute maps.
+        //
+        static void clear_farm_tables(void);
+
+        // Builds the traits of the feature categories from their features.
+        //
+        static void build_feature_traits(void);
+
         static bool
             farm_initialized; // Has the FARM been initialized?
 
+        static std::atomic<CORE::UInt32>
+            generation; // Changes whenever the FARM is loaded or destroyed.
+
+        // The traits of every feature category, indexed by category, on a
+        // cache line boundary.  Null until the FARM is loaded.
+        //
+        static const FeatureTraits
+            *feature_traits;
+        static FeatureCategory
+            feature_traits_count;
+
+        // The traits returned for categories that have none.
+        //
+        static const FeatureTraits
+            no_feature_traits;
+
+        // Looks up the attribute category of an attribute tag in the FARM of
+        // the current generation, and saves it with the generation.  Logs if
+        // the attribute's data type is not the tag's.
+        //
+        // Return:  The saved generation and category.
+        //
+        static CORE::UInt64 resolve_tag(
+            const char *label,
+            const AttributeDataType &data_type,
+            std::atomic<CORE::UInt64> &resolved
+        );
+
+        // Return:  The FARM table entry of the tag's attribute for a feature
+        // with the feature category, or null if the feature does not contain
+        // the attribute.
+        //
+        template<class Tag>
+        static typename AttributeValue<Tag::data_type>::Cell *get_tag_cell(
+            const FeatureCategory &feature_category
+        );
+
         typedef std::vector<FARM::DataType *>
             FarmAttributeCodeToDataType;
 
@@ -788,6 +1208,30 @@ namespace FARM
         static std::vector<FarmAttributeCodeToDataType>
             farm;
 
+        // Whether each row of the FARM table has been decoded, or null if
+        // every row is decoded at startup.
+        //
+        static const std::atomic<bool>
+            *rows_decoded;
+
+        // Return:  The row of the FARM table, which is decoded first if rows
+        // are decoded on demand and it has not been.  The feature category
+        // must be in range.
+        //
+        static FarmAttributeCodeToDataType &get_farm_row(
+            const FeatureCategory &feature_category
+        );
+
+        // Decodes a row of the FARM table from the compressed image.  Each
+        // row is decoded once, by the first thread that asks for it.
+        //
+        static void decode_row(const FeatureCategory &feature_category);
+
+        // Decodes the rows that have not been decoded, for the functions
+        // that walk the whole FARM table.
+        //
+        static void decode_all_rows(void);
+
         typedef std::vector<FARM::Attribute>
             AttributeCodesToAttributes;
 
@@ -813,6 +1257,21 @@ namespace FARM
             "The FARM was used before it was initialized!");
     }
 
+    // ------------------------------------------------------------------------
+    inline FeatureAttributeMapping::FarmAttributeCodeToDataType &
+        FeatureAttributeMapping::get_farm_row(
+            const FeatureCategory &feature_category
+        )
+    {
+        if (rows_decoded and
+            not rows_decoded[feature_category].load(std::memory_order_acquire))
+        {
+            decode_row(feature_category);
+        }
+
+        return farm[feature_category];
+    }
+
     // ------------------------------------------------------------------------
     inline bool FeatureAttributeMapping::get_data_type(
         const AttributeCategory &attribute_category,
@@ -837,7 +1296,8 @@ namespace FARM
             CORE::ordered(
                 0,
                 attribute_category,
-                static_cast<int>(farm[feature_category].size() - 1)) and
+                static_cast<int>(
+                    get_farm_row(feature_category).size() - 1)) and
             farm[feature_category][attribute_category];
     }
 
@@ -860,6 +1320,217 @@ namespace FARM
 
         return successful;
     }
+
+    // ------------------------------------------------------------------------
+    inline const FeatureTraits &FeatureAttributeMapping::get_feature_traits(
+        const FeatureCategory &feature_category
+    )
+    {
+        return
+            CORE::ordered(0, feature_category, feature_traits_count - 1) ?
+                feature_traits[feature_category] :
+                no_feature_traits;
+    }
+
+    // ------------------------------------------------------------------------
+    inline AttributeOffset
+        FeatureAttributeMapping::get_attribute_offset_unchecked(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category
+        )
+    {
+        return get_farm_row(feature_category)[attribute_category]->
+            get_offset();
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool FeatureAttributeMapping::valid_attribute_unchecked(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category,
+        const int attribute_value
+    )
+    {
+        return AttributeValue<int32>::valid(
+            *static_cast<AttributeValue<int32>::Cell *>(
+                get_farm_row(feature_category)[attribute_category]),
+            attribute_value);
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool FeatureAttributeMapping::valid_attribute_unchecked(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category,
+        const double attribute_value
+    )
+    {
+        return AttributeValue<float64>::valid(
+            *static_cast<AttributeValue<float64>::Cell *>(
+                get_farm_row(feature_category)[attribute_category]),
+            attribute_value);
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool FeatureAttributeMapping::valid_enumerant_unchecked(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category,
+        const EnumerantCode &enumerant_code
+    )
+    {
+        return AttributeValue<enumeration>::valid(
+            *static_cast<AttributeValue<enumeration>::Cell *>(
+                get_farm_row(feature_category)[attribute_category]),
+            enumerant_code);
+    }
+
+    // ------------------------------------------------------------------------
+    inline void FeatureAttributeMapping::get_min_max_unchecked(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category,
+        int &minimum_value,
+        int &maximum_value
+    )
+    {
+        const AttributeValue<int32>::Cell
+            *cell = static_cast<AttributeValue<int32>::Cell *>(
+                get_farm_row(feature_category)[attribute_category]);
+
+        minimum_value = cell->get_minimum();
+        maximum_value = cell->get_maximum();
+    }
+
+    // ------------------------------------------------------------------------
+    inline void FeatureAttributeMapping::get_min_max_unchecked(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category,
+        double &minimum_value,
+        double &maximum_value
+    )
+    {
+        const AttributeValue<float64>::Cell
+            *cell = static_cast<AttributeValue<float64>::Cell *>(
+                get_farm_row(feature_category)[attribute_category]);
+
+        minimum_value = cell->get_minimum();
+        maximum_value = cell->get_maximum();
+    }
+
+    // ------------------------------------------------------------------------
+    inline CORE::UInt32 FeatureAttributeMapping::get_generation(void)
+    {
+        return generation.load(std::memory_order_acquire);
+    }
+
+    // ------------------------------------------------------------------------
+    template<class Tag>
+    inline typename AttributeValue<Tag::data_type>::Cell *
+        FeatureAttributeMapping::get_tag_cell(
+            const FeatureCategory &feature_category
+        )
+    {
+        CORE::UInt64
+            resolved =
+                AttributeTagCategory<Tag>::resolved.load(
+                    std::memory_order_acquire);
+        AttributeCategory
+            attribute_category;
+
+        if (static_cast<CORE::UInt32>(resolved >> 32) != get_generation())
+        {
+            resolved =
+                resolve_tag(
+                    Tag::label(),
+                    Tag::data_type,
+                    AttributeTagCategory<Tag>::resolved);
+        }
+
+        attribute_category =
+            static_cast<CORE::Int32>(resolved & 0xffffffffu);
+
+        return contains_attribute(feature_category, attribute_category) ?
+            static_cast<typename AttributeValue<Tag::data_type>::Cell *>(
+                farm[feature_category][attribute_category]) :
+            0;
+    }
+
+    // ------------------------------------------------------------------------
+    template<class Tag>
+    inline bool FeatureAttributeMapping::get(
+        const FeatureCategory &feature_category,
+        const char *overlay,
+        typename Tag::Value &value
+    )
+    {
+        typename AttributeValue<Tag::data_type>::Cell
+            *cell = get_tag_cell<Tag>(feature_category);
+
+        if (cell)
+        {
+            value =
+                AttributeValue<Tag::data_type>::load(
+                    overlay + cell->get_offset());
+        }
+
+        return cell != 0;
+    }
+
+    // ------------------------------------------------------------------------
+    template<class Tag, class Value>
+    inline bool FeatureAttributeMapping::valid(
+        const FeatureCategory &feature_category,
+        const Value &value
+    )
+    {
+        static_assert(
+            std::is_same<Value, typename Tag::Value>::value,
+            "The value is not of the type of the attribute tag.");
+
+        const typename AttributeValue<Tag::data_type>::Cell
+            *cell = get_tag_cell<Tag>(feature_category);
+
+        return cell and AttributeValue<Tag::data_type>::valid(*cell, value);
+    }
+
+    // ------------------------------------------------------------------------
+    template<class Tag>
+    inline bool FeatureAttributeMapping::bounds(
+        const FeatureCategory &feature_category,
+        typename Tag::Value &minimum_value,
+        typename Tag::Value &maximum_value
+    )
+    {
+        static_assert(
+            AttributeValue<Tag::data_type>::ordered,
+            "Only numeric attributes have bounds.");
+
+        const typename AttributeValue<Tag::data_type>::Cell
+            *cell = get_tag_cell<Tag>(feature_category);
+
+        if (cell)
+        {
+            minimum_value = cell->get_minimum();
+            maximum_value = cell->get_maximum();
+        }
+
+        return cell != 0;
+    }
+
+    // ------------------------------------------------------------------------
+    template<class Tag>
+    inline bool FeatureAttributeMapping::get_default(
+        const FeatureCategory &feature_category,
+        typename Tag::Value &default_value
+    )
+    {
+        const typename AttributeValue<Tag::data_type>::Cell
+            *cell = get_tag_cell<Tag>(feature_category);
+
+        if (cell)
+        {
+            default_value = cell->get_default();
+        }
+
+        return cell != 0;
+    }
 }
 
 #endif
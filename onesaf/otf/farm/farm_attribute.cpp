@@ -16,11 +16,23 @@
  * this document shall be referred to U.S. Army PEO STRI.
  *
  */
+#include <type_traits>
+
 #include "core/core_string.h"
 #include "core/sys_types.h"
 #include "farm.h"
 #include "farm_attribute.h"
 
+namespace
+{
+    // attribute_codes_to_attributes is resized in place, so its attributes
+    // must move rather than copy their labels.
+    //
+    static_assert(
+        std::is_nothrow_move_constructible<FARM::Attribute>::value and
+            std::is_nothrow_move_assignable<FARM::Attribute>::value,
+        "An Attribute must move without throwing.");
+}
 
 namespace FARM
 {
@@ -156,89 +168,97 @@ namespace FARM
     // ------------------------------------------------------------------------
     void Attribute::write(std::ostream &stream) const
     {
-        CORE::Int32
-            tmp_code = code,
-            tmp_data_type = static_cast<CORE::Int32>(data_type),
-            tmp_units = static_cast<CORE::Int32>(units),
-            tmp_editability = editability;
+        BinaryWriter
+            writer(stream, 0);
 
-        stream.write(reinterpret_cast<char *>(&tmp_code), sizeof(tmp_code));
-
-        stream.write(
-            reinterpret_cast<char *>(&tmp_data_type), sizeof(tmp_data_type));
+        write(writer);
+    }
 
-        stream.write(reinterpret_cast<char *>(&tmp_units), sizeof(tmp_units));
+    // ------------------------------------------------------------------------
+    void Attribute::write(BinaryWriter &writer) const
+    {
+        const CORE::Int32
+            values[] =
+            {
+                code,
+                static_cast<CORE::Int32>(data_type),
+                static_cast<CORE::Int32>(units),
+                editability
+            };
 
-        stream.write(
-            reinterpret_cast<char *>(&tmp_editability),
-            sizeof(tmp_editability));
+        writer.write_array(values, sizeof(values) / sizeof(values[0]));
     }
 
     // ------------------------------------------------------------------------
     void Attribute::read(std::istream &stream)
     {
-        int
-            tmp_code,
-            tmp_data_type,
-            tmp_units,
-            tmp_editability;
+        BinaryReader
+            reader(stream, 0);
 
-        stream.read(reinterpret_cast<char *>(&tmp_code), sizeof(tmp_code));
-
-        stream.read(
-            reinterpret_cast<char *>(&tmp_data_type), sizeof(tmp_data_type));
+        read(reader);
+    }
 
-        stream.read(reinterpret_cast<char *>(&tmp_units), sizeof(tmp_units));
+    // ------------------------------------------------------------------------
+    void Attribute::read(BinaryReader &reader)
+    {
+        CORE::Int32
+            values[4];
 
-        stream.read(
-            reinterpret_cast<char *>(&tmp_editability),
-            sizeof(tmp_editability));
+        reader.read_array(values, sizeof(values) / sizeof(values[0]));
 
-        set_code(tmp_code);
-        data_type = static_cast<AttributeDataType>(tmp_data_type);
-        units = static_cast<AttributeUnits>(tmp_units);
-        editability = tmp_editability;
+        set_code(values[0]);
+        data_type = static_cast<AttributeDataType>(values[1]);
+        units = static_cast<AttributeUnits>(values[2]);
+        editability = values[3];
     }
 
     // ------------------------------------------------------------------------
     void Attribute::dump(std::ostream &stream) const
     {
-        CORE::dump_string(stream, label);
+        BinaryWriter
+            writer(stream, 0);
 
-        CORE::Int32
-            int32 = code;
-
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
-
-        int32 = data_type;
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
-
-        int32 = units;
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+        dump(writer);
+    }
 
-        int32 = editability ? 1 : 0;
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+    // ------------------------------------------------------------------------
+    void Attribute::dump(BinaryWriter &writer) const
+    {
+        const CORE::Int32
+            values[] =
+            {
+                code,
+                data_type,
+                units,
+                editability ? 1 : 0
+            };
+
+        writer.write_core_string(label);
+        writer.write_array(values, sizeof(values) / sizeof(values[0]));
     }
 
     // ------------------------------------------------------------------------
     void Attribute::load(std::istream &stream)
     {
-        CORE::Int32
-            int32;
+        BinaryReader
+            reader(stream, 0);
 
-        CORE::load_string(stream, label);
-
-        stream.read(reinterpret_cast<char *>(&int32), sizeof(int32));
-        code = int32;
+        load(reader);
+    }
 
-        stream.read(reinterpret_cast<char *>(&int32), sizeof(int32));
-        data_type = static_cast<AttributeDataType>(int32);
+    // ------------------------------------------------------------------------
+    void Attribute::load(BinaryReader &reader)
+    {
+        CORE::Int32
+            values[4];
 
-        stream.read(reinterpret_cast<char *>(&int32), sizeof(int32));
-        units = static_cast<AttributeUnits>(int32);
+        reader.read_core_string(label);
 
-        stream.read(reinterpret_cast<char *>(&int32), sizeof(int32));
-        editability = int32;
+        reader.read_array(values, sizeof(values) / sizeof(values[0]));
+        code = values[0];
+        data_type = static_cast<AttributeDataType>(values[1]);
+        units = static_cast<AttributeUnits>(values[2]);
+        editability = values[3];
     }
 
     // ------------------------------------------------------------------------
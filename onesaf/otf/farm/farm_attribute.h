@@ -20,9 +20,11 @@
 #define FARM_ATTRIBUTE_H
 #include <iostream>
 #include <string>
+#include <utility>
 
 #include "core/sys_types.h"
 #include "core/uuid.h"
+#include "farm_binary_codec.h"
 
 namespace FARM
 {
@@ -93,6 +95,10 @@ namespace FARM
         //
         Attribute(const Attribute &rhs);
 
+        // Move Constructor.  The label is moved, not copied.
+        //
+        Attribute(Attribute &&rhs) noexcept;
+
         // Sets tje attribute code for the attribute,
         // clears the rest of the class members, and
         // deteremines the new attribute label for the new code.
@@ -162,24 +168,36 @@ namespace FARM
         //
         Attribute &operator=(const Attribute &rhs);
 
+        // Moves the argument attribute into the attribute.
+        //
+        Attribute &operator=(Attribute &&rhs) noexcept;
+
         // Writes the attribute to the output stream.
         //
         void write(std::ostream &stream) const;
 
+        void write(BinaryWriter &writer) const;
+
         // Reads the attribute in from the input stream.
         //
         void read(std::istream &stream);
 
+        void read(BinaryReader &reader);
+
         // Writes the contents of this class instance to the given binary
         // stream in a format that can be read by the terrain compiler.
         //
         void dump(std::ostream &stream) const;
 
+        void dump(BinaryWriter &writer) const;
+
         // Reads the contents of this class instance from the given binary
         // stream.
         //
         void load(std::istream &stream);
 
+        void load(BinaryReader &reader);
+
       private:
 
         AttributeLabel
@@ -345,13 +363,23 @@ namespace FARM
     }
 
     // ------------------------------------------------------------------------
-    inline Attribute::Attribute(const Attribute &rhs)
+    inline Attribute::Attribute(const Attribute &rhs) :
+        label(rhs.label),
+        code(rhs.code),
+        data_type(rhs.data_type),
+        units(rhs.units),
+        editability(rhs.editability)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    inline Attribute::Attribute(Attribute &&rhs) noexcept :
+        label(std::move(rhs.label)),
+        code(rhs.code),
+        data_type(rhs.data_type),
+        units(rhs.units),
+        editability(rhs.editability)
     {
-        code = rhs.get_code();
-        label = rhs.get_label();
-        data_type = rhs.get_data_type();
-        units = rhs.get_units();
-        editability = rhs.get_editability();
     }
 
     // ------------------------------------------------------------------------
@@ -440,11 +468,23 @@ namespace FARM
     // ------------------------------------------------------------------------
     inline Attribute &Attribute::operator=(const Attribute &rhs)
     {
-        code = rhs.get_code();
-        label = rhs.get_label();
-        data_type = rhs.get_data_type();
-        units = rhs.get_units();
-        editability = rhs.get_editability();
+        code = rhs.code;
+        label = rhs.label;
+        data_type = rhs.data_type;
+        units = rhs.units;
+        editability = rhs.editability;
+
+        return *this;
+    }
+
+    // ------------------------------------------------------------------------
+    inline Attribute &Attribute::operator=(Attribute &&rhs) noexcept
+    {
+        code = rhs.code;
+        label = std::move(rhs.label);
+        data_type = rhs.data_type;
+        units = rhs.units;
+        editability = rhs.editability;
 
         return *this;
     }
@@ -0,0 +1,325 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <unistd.h>
+
+#include "core/logger.h"
+#include "farm_binary_cache.h"
+
+namespace
+{
+    const char
+        cache_magic[8] = {'F', 'A', 'R', 'M', 'C', 'A', 'C', 'H'};
+
+    // Change the format whenever the layout of the FARM binary data changes,
+    // so the images written by older software are rebuilt.
+    //
+    const CORE::UInt32
+        cache_format = 1,
+        byte_order_mark = 0x01020304;
+
+    const CORE::UInt64
+        fnv_offset_basis = 14695981039346656037ULL,
+        fnv_prime = 1099511628211ULL;
+
+    const std::size_t
+        hash_block_size = 64 * 1024;
+
+    const std::string
+        cache_file_prefix = "FARM.",
+        cache_file_suffix = ".cache";
+
+    // The header at the start of an image.
+    //
+    struct CacheHeader
+    {
+        char
+            magic[8];
+        CORE::UInt32
+            format,
+            byte_order;
+        CORE::UInt64
+            hash,
+            input_bytes,
+            data_bytes;         // Size of the FARM data after the header
+    };
+
+    std::mutex
+        cache_mutex;
+
+    bool
+        directory_set = false;
+
+    std::string
+        cache_directory;
+
+    // ------------------------------------------------------------------------
+    // Return:  The hash updated with the bytes.
+    //
+    CORE::UInt64 fnv1a(
+        const char *bytes,
+        std::size_t size,
+        CORE::UInt64 hash)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<unsigned char>(bytes[i]);
+            hash *= fnv_prime;
+        }
+
+        return hash;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The hash updated with the value.
+    //
+    CORE::UInt64 fnv1a(CORE::UInt64 value, CORE::UInt64 hash)
+    {
+        return fnv1a(
+            reinterpret_cast<const char *>(&value), sizeof(value), hash);
+    }
+}
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    void BinaryCache::set_directory(const std::string &directory)
+    {
+        std::lock_guard<std::mutex>
+            lock(cache_mutex);
+
+        directory_set = true;
+        cache_directory = directory;
+    }
+
+    // ------------------------------------------------------------------------
+    std::string BinaryCache::get_directory(void)
+    {
+        std::lock_guard<std::mutex>
+            lock(cache_mutex);
+
+        if (not directory_set)
+        {
+            const char
+                *directory = std::getenv("FARM_CACHE_DIR");
+
+            return directory ? directory : "";
+        }
+
+        return cache_directory;
+    }
+
+    // ------------------------------------------------------------------------
+    bool BinaryCache::enabled(void)
+    {
+        return not get_directory().empty();
+    }
+
+    // ------------------------------------------------------------------------
+    std::string BinaryCache::get_file_name(const BinaryCacheKey &key)
+    {
+        std::ostringstream
+            name;
+
+        name << get_directory() << "/" << cache_file_prefix << std::hex
+             << std::setfill('0') << std::setw(16) << key.hash
+             << cache_file_suffix;
+
+        return name.str();
+    }
+
+    // ------------------------------------------------------------------------
+    bool BinaryCache::compute_key(
+        const std::vector<std::string> &input_files,
+        BinaryCacheKey &key
+    )
+    {
+        std::vector<char>
+            block(hash_block_size);
+        bool
+            successful = true;
+
+        key.hash = fnv_offset_basis;
+        key.input_bytes = 0;
+
+        for (std::size_t index = 0;
+             successful and index < input_files.size();
+             ++index)
+        {
+            std::ifstream
+                file(input_files[index].c_str(), std::ios::binary);
+            CORE::UInt64
+                file_bytes = 0;
+
+            successful = file.is_open();
+
+            while (successful and file)
+            {
+                file.read(&block[0], block.size());
+
+                key.hash = fnv1a(&block[0], file.gcount(), key.hash);
+                file_bytes += file.gcount();
+            }
+
+            successful = successful and file.eof();
+
+            // The size ends each file, so moving bytes from one file to the
+            // next changes the key.
+            //
+            key.hash = fnv1a(file_bytes, key.hash);
+            key.input_bytes += file_bytes;
+        }
+
+        return successful;
+    }
+
+    // ------------------------------------------------------------------------
+    bool BinaryCache::open(
+        const BinaryCacheKey &key,
+        std::ifstream &file
+    )
+    {
+        CacheHeader
+            header;
+        std::streamoff
+            file_bytes;
+
+        file.open(
+            get_file_name(key).c_str(), std::ios::in | std::ios::binary);
+
+        if (not file.is_open())
+        {
+            return false;
+        }
+
+        file.seekg(0, std::ios::end);
+        file_bytes = file.tellg();
+        file.seekg(0, std::ios::beg);
+
+        file.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+        bool
+            valid =
+                file.good() and
+                std::memcmp(header.magic, cache_magic, sizeof(cache_magic))
+                    == 0 and
+                header.format == cache_format and
+                header.byte_order == byte_order_mark and
+                header.hash == key.hash and
+                header.input_bytes == key.input_bytes and
+                static_cast<CORE::UInt64>(file_bytes) ==
+                    sizeof(header) + header.data_bytes;
+
+        if (not valid)
+        {
+            file.close();
+        }
+
+        return valid;
+    }
+
+    // ------------------------------------------------------------------------
+    bool BinaryCache::create(
+        const BinaryCacheKey &key,
+        std::ofstream &file,
+        std::string &temp_file_name
+    )
+    {
+        std::ostringstream
+            name;
+        CacheHeader
+            header;
+
+        // The process id keeps two processes that build the same image from
+        // writing the same temporary file.
+        //
+        name << get_file_name(key) << ".tmp." << getpid();
+        temp_file_name = name.str();
+
+        file.open(
+            temp_file_name.c_str(),
+            std::ios::out | std::ios::trunc | std::ios::binary);
+
+        if (not file.is_open())
+        {
+            LOG(
+                medium,
+                "Could not create the FARM cache file '" + temp_file_name +
+                    "'.");
+
+            return false;
+        }
+
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+        header.format = cache_format;
+        header.byte_order = byte_order_mark;
+        header.hash = key.hash;
+        header.input_bytes = key.input_bytes;
+        header.data_bytes = 0;
+
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        return file.good();
+    }
+
+    // ------------------------------------------------------------------------
+    bool BinaryCache::publish(
+        const BinaryCacheKey &key,
+        std::ofstream &file,
+        const std::string &temp_file_name
+    )
+    {
+        CORE::UInt64
+            data_bytes =
+                static_cast<CORE::UInt64>(file.tellp()) - sizeof(CacheHeader);
+
+        // The size of the data is written last, so an image that was not
+        // written completely never matches its header.
+        //
+        file.seekp(offsetof(CacheHeader, data_bytes));
+        file.write(
+            reinterpret_cast<const char *>(&data_bytes), sizeof(data_bytes));
+        file.close();
+
+        bool
+            successful =
+                not file.fail() and
+                std::rename(
+                    temp_file_name.c_str(), get_file_name(key).c_str()) == 0;
+
+        if (not successful)
+        {
+            std::remove(temp_file_name.c_str());
+
+            LOG(
+                medium,
+                "Could not write the FARM cache file '" + get_file_name(key) +
+                    "'.");
+        }
+
+        return successful;
+    }
+}
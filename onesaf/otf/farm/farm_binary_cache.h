@@ -0,0 +1,123 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef FARM_BINARY_CACHE_H
+#define FARM_BINARY_CACHE_H
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "core/sys_types.h"
+
+namespace FARM
+{
+    // Identifies the configuration files that a cached FARM was built from.
+    //
+    struct BinaryCacheKey
+    {
+        CORE::UInt64
+            hash,               // Of the contents of the files, in order
+            input_bytes;        // Total size of the files
+    };
+
+    // ------------------------------------------------------------------------
+    // A persistent binary image of a FARM that was initialized from the FDF,
+    // ADF, and FAA files.  The image is keyed by a content hash of those
+    // files and of the EDCS mapping files, so a later start with the same
+    // files can load the image instead of parsing the text.
+    //
+    // The cache is off until a directory is given with set_directory(), or
+    // with the environment variable FARM_CACHE_DIR.  The directory holds an
+    // image for each key, FARM.<key>.cache with the hash of the key in hex,
+    // so terrains with different files can share the directory.  An image
+    // is written to a temporary file in the directory and then renamed over
+    // its name, so readers only ever see a complete image.  When an input
+    // changes, the next text initialization writes an image under the new
+    // key; the image of the old key is left for the terrains that still use
+    // it, and is removed by clearing the directory.
+    //
+    // The header stores the key, the byte order, and the size of the image,
+    // and open() rejects an image whose header or size does not match.
+    // ------------------------------------------------------------------------
+    class BinaryCache
+    {
+      public:
+
+        // Sets the cache directory.  An empty directory turns the cache off
+        // and FARM_CACHE_DIR is no longer consulted.
+        //
+        static void set_directory(const std::string &directory);
+
+        // Return:  The cache directory, or "" if the cache is off.
+        //
+        static std::string get_directory(void);
+
+        // Return:  Is the cache on?
+        //
+        static bool enabled(void);
+
+        // Return:  The name of the cached image for the key.
+        //
+        static std::string get_file_name(const BinaryCacheKey &key);
+
+        // Computes the key of the cache from the contents of the files.
+        //
+        // Return:  Were all of the files read?
+        //
+        static bool compute_key(
+            const std::vector<std::string> &input_files,
+            BinaryCacheKey &key
+        );
+
+        // Opens the cached image and checks its header against the key.  The
+        // file is left at the start of the FARM data.
+        //
+        // Return:  Does the image hold the FARM for the key?
+        //
+        static bool open(
+            const BinaryCacheKey &key,
+            std::ifstream &file
+        );
+
+        // Creates a temporary file in the cache directory and writes the
+        // header for the key.  The FARM data is written after it and the file
+        // is passed to publish().
+        //
+        // Return:  Was the temporary file created?
+        //
+        static bool create(
+            const BinaryCacheKey &key,
+            std::ofstream &file,
+            std::string &temp_file_name
+        );
+
+        // Completes the header of the temporary file, closes it, and renames
+        // it over the cached image for the key.  The temporary file is
+        // removed if that fails.
+        //
+        // Return:  Was the image replaced?
+        //
+        static bool publish(
+            const BinaryCacheKey &key,
+            std::ofstream &file,
+            const std::string &temp_file_name
+        );
+    };
+}
+
+#endif
@@ -0,0 +1,394 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#include <algorithm>
+
+#include "core/core_string.h"
+#include "core/logger.h"
+#include "farm_binary_codec.h"
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    BinaryWriter::BinaryWriter(
+        std::ostream &stream,
+        std::size_t block_size
+    ) :
+        stream(stream),
+        core_stream(this),
+        buffer(block_size),
+        failed(false),
+        swap_bytes(false)
+    {
+        if (not buffer.empty())
+        {
+            setp(&buffer[0], &buffer[0] + buffer.size());
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    BinaryWriter::~BinaryWriter(void)
+    {
+        write_buffer();
+    }
+
+    // ------------------------------------------------------------------------
+    void BinaryWriter::write_core_string(const std::string &string)
+    {
+        CORE::dump_string(core_stream, string);
+
+        if (not core_stream)
+        {
+            failed = true;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    bool BinaryWriter::flush(void)
+    {
+        write_buffer();
+
+        return not failed;
+    }
+
+    // ------------------------------------------------------------------------
+    BinaryWriter::int_type BinaryWriter::overflow(int_type character)
+    {
+        write_buffer();
+
+        if (not traits_type::eq_int_type(character, traits_type::eof()))
+        {
+            char
+                byte = traits_type::to_char_type(character);
+
+            xsputn(&byte, 1);
+        }
+
+        return failed ? traits_type::eof() : traits_type::not_eof(character);
+    }
+
+    // ------------------------------------------------------------------------
+    std::streamsize BinaryWriter::xsputn(
+        const char *characters,
+        std::streamsize count)
+    {
+        std::size_t
+            size = count;
+
+        if (static_cast<std::size_t>(epptr() - pptr()) < size)
+        {
+            write_buffer();
+        }
+
+        if (size <= static_cast<std::size_t>(epptr() - pptr()))
+        {
+            std::memcpy(pptr(), characters, size);
+            pbump(static_cast<int>(size));
+        }
+        else if (not failed and stream.rdbuf())
+        {
+            // Blocks that do not fit in the buffer go straight to the stream.
+            //
+            if (stream.rdbuf()->sputn(characters, count) != count)
+            {
+                failed = true;
+                stream.setstate(std::ios::badbit);
+            }
+        }
+        else
+        {
+            failed = true;
+        }
+
+        return failed ? 0 : count;
+    }
+
+    // ------------------------------------------------------------------------
+    int BinaryWriter::sync(void)
+    {
+        write_buffer();
+
+        return failed ? -1 : 0;
+    }
+
+    // ------------------------------------------------------------------------
+    void BinaryWriter::write_buffer(void)
+    {
+        std::streamsize
+            size = pptr() - pbase();
+
+        if (size > 0)
+        {
+            if (not failed and
+                (not stream.rdbuf() or
+                 stream.rdbuf()->sputn(pbase(), size) != size))
+            {
+                failed = true;
+                stream.setstate(std::ios::badbit);
+            }
+
+            setp(pbase(), epptr());
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    void BinaryWriter::write_swapped(
+        const void *values,
+        std::size_t value_size,
+        std::size_t count)
+    {
+        const char
+            *bytes = static_cast<const char *>(values);
+        char
+            block[4096];
+        std::size_t
+            block_count = sizeof(block) / value_size;
+
+        // Swap a copy of the values a block at a time; the caller's values
+        // are left as they are.
+        //
+        while (count > 0)
+        {
+            std::size_t
+                copy_count = std::min(count, block_count),
+                size = copy_count * value_size;
+
+            std::memcpy(block, bytes, size);
+            ByteSwap::swap(block, value_size, copy_count);
+            write_bytes(block, size);
+
+            bytes += size;
+            count -= copy_count;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    BinaryReader::BinaryReader(
+        std::istream &stream,
+        std::size_t block_size
+    ) :
+        detached_stream(0),
+        stream(stream),
+        core_stream(this),
+        buffer(block_size),
+        failed(false),
+        swap_bytes(false)
+    {
+        if (not buffer.empty())
+        {
+            setg(&buffer[0], &buffer[0], &buffer[0]);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    BinaryReader::BinaryReader(
+        const char *data,
+        std::size_t size
+    ) :
+        detached_stream(0),
+        stream(detached_stream),
+        core_stream(this),
+        failed(false),
+        swap_bytes(false)
+    {
+        // The get area is never written through; the detached stream has no
+        // buffer, so the reader stops at the end of the memory.
+        //
+        char
+            *begin = const_cast<char *>(data);
+
+        setg(begin, begin, begin + size);
+    }
+
+    // ------------------------------------------------------------------------
+    BinaryReader::~BinaryReader(void)
+    {
+        std::streamoff
+            unread = egptr() - gptr();
+
+        // Return the bytes that were read ahead.
+        //
+        if (unread > 0 and stream.rdbuf())
+        {
+            stream.rdbuf()->pubseekoff(-unread, std::ios::cur, std::ios::in);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    bool BinaryReader::read_bytes(void *bytes, std::size_t size)
+    {
+        std::streamsize
+            count = size;
+        bool
+            successful =
+                static_cast<std::size_t>(egptr() - gptr()) >= size;
+
+        if (successful)
+        {
+            std::memcpy(bytes, gptr(), size);
+            gbump(static_cast<int>(size));
+        }
+        else
+        {
+            std::streamsize
+                read = xsgetn(static_cast<char *>(bytes), count);
+
+            successful = read == count;
+
+            if (not successful)
+            {
+                std::memset(
+                    static_cast<char *>(bytes) + read, 0, count - read);
+
+                failed = true;
+                stream.setstate(std::ios::eofbit | std::ios::failbit);
+            }
+        }
+
+        return successful;
+    }
+
+    // ------------------------------------------------------------------------
+    bool BinaryReader::read_core_string(std::string &string)
+    {
+        ASSERT(
+            not swap_bytes,
+            high,
+            "A CORE string can not be read from a FARM of the other byte "
+                "order.");
+
+        CORE::load_string(core_stream, string);
+
+        if (not core_stream)
+        {
+            failed = true;
+            stream.setstate(std::ios::eofbit | std::ios::failbit);
+        }
+
+        return not failed;
+    }
+
+    // ------------------------------------------------------------------------
+    BinaryReader::int_type BinaryReader::underflow(void)
+    {
+        int_type
+            character = traits_type::eof();
+
+        if (failed or not stream.rdbuf())
+        {
+            // Nothing more can be read.
+        }
+        else if (buffer.empty())
+        {
+            character = stream.rdbuf()->sgetc();
+        }
+        else
+        {
+            std::streamsize
+                read = stream.rdbuf()->sgetn(&buffer[0], buffer.size());
+
+            setg(
+                &buffer[0],
+                &buffer[0],
+                &buffer[0] + std::max<std::streamsize>(read, 0));
+
+            if (read > 0)
+            {
+                character = traits_type::to_int_type(*gptr());
+            }
+        }
+
+        return character;
+    }
+
+    // ------------------------------------------------------------------------
+    BinaryReader::int_type BinaryReader::uflow(void)
+    {
+        int_type
+            character = traits_type::eof();
+
+        if (buffer.empty())
+        {
+            if (not failed and stream.rdbuf())
+            {
+                character = stream.rdbuf()->sbumpc();
+            }
+        }
+        else
+        {
+            character = std::streambuf::uflow();
+        }
+
+        return character;
+    }
+
+    // ------------------------------------------------------------------------
+    std::streamsize BinaryReader::xsgetn(
+        char *characters,
+        std::streamsize count)
+    {
+        std::streamsize
+            read = 0;
+
+        while (read < count)
+        {
+            std::streamsize
+                available = egptr() - gptr();
+
+            if (available > 0)
+            {
+                // Use the bytes that are buffered.
+                //
+                std::streamsize
+                    size = std::min(available, count - read);
+
+                std::memcpy(characters + read, gptr(), size);
+                gbump(static_cast<int>(size));
+                read += size;
+            }
+            else if (failed or not stream.rdbuf())
+            {
+                break;
+            }
+            else if (count - read >= static_cast<std::streamsize>(
+                         buffer.size()))
+            {
+                // Blocks that do not fit in the buffer, and every read of an
+                // unbuffered reader, go straight to the stream.
+                //
+                std::streamsize
+                    wanted = count - read,
+                    size = stream.rdbuf()->sgetn(characters + read, wanted);
+
+                read += std::max<std::streamsize>(size, 0);
+
+                if (size < wanted)
+                {
+                    break;
+                }
+            }
+            else if (traits_type::eq_int_type(
+                         underflow(), traits_type::eof()))
+            {
+                break;
+            }
+        }
+
+        return read;
+    }
+}
@@ -0,0 +1,345 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef FARM_BINARY_CODEC_H
+#define FARM_BINARY_CODEC_H
+#include <cstring>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "core/sys_types.h"
+#include "farm_byte_swap.h"
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    // Writes the FARM binary files through a block buffer.  Values are copied
+    // into the buffer after one bounds check, and a full block is handed to
+    // the stream's buffer in one call, which a file stream writes with one
+    // system call.  Values are written in the byte order of the host, like
+    // std::ostream::write(), unless the writer is told to swap their bytes.
+    //
+    // A block size of 0 writes each value straight to the stream.  That is
+    // for writing one object to a stream that the caller keeps writing to.
+    //
+    // The buffer is written to the stream by flush() and by the destructor.
+    // A failed write sets the stream's badbit.
+    // ------------------------------------------------------------------------
+    class BinaryWriter : private std::streambuf
+    {
+      public:
+
+        enum
+        {
+            default_block_size = 256 * 1024
+        };
+
+        explicit BinaryWriter(
+            std::ostream &stream,
+            std::size_t block_size = default_block_size
+        );
+
+        ~BinaryWriter(void);
+
+        // Writes a value of a plain old data type.
+        //
+        template<class Type>
+        void write(const Type &value);
+
+        template<class Type>
+        void write_array(const Type *values, std::size_t count);
+
+        void write_bytes(const void *bytes, std::size_t size);
+
+        // Writes a string in the format of CORE::dump_string().  Such a
+        // string is always in the byte order of the host.
+        //
+        void write_core_string(const std::string &string);
+
+        // Sets whether the bytes of each value written by write() and
+        // write_array() are reversed, to write a file for a machine of the
+        // other byte order.  write_bytes() never swaps.
+        //
+        void set_swap_bytes(bool swap_bytes);
+
+        // Return:  Were all of the values written to the stream?
+        //
+        bool flush(void);
+
+        // Return:  Has every write succeeded so far?
+        //
+        bool good(void) const;
+
+      private:
+
+        BinaryWriter(const BinaryWriter &);
+        BinaryWriter &operator=(const BinaryWriter &);
+
+        virtual int_type overflow(int_type character);
+
+        virtual std::streamsize xsputn(
+            const char *characters,
+            std::streamsize count);
+
+        virtual int sync(void);
+
+        // Writes the buffered bytes to the stream.
+        //
+        void write_buffer(void);
+
+        // Writes the values with their bytes reversed.
+        //
+        void write_swapped(
+            const void *values,
+            std::size_t value_size,
+            std::size_t count);
+
+        std::ostream
+            &stream;
+        std::ostream
+            core_stream;        // Writes through this buffer
+        std::vector<char>
+            buffer;
+        bool
+            failed,
+            swap_bytes;
+    };
+
+    // ------------------------------------------------------------------------
+    // Reads the FARM binary files through a block buffer; the reading
+    // counterpart of BinaryWriter.  A block is read from the stream's buffer
+    // in one call, and values are copied out of it after one bounds check.
+    //
+    // A block size of 0 reads each value straight from the stream.  Otherwise
+    // the reader reads ahead, and the destructor seeks the stream back to the
+    // first byte that was not used, so the stream can be read on afterwards
+    // if it can seek.
+    //
+    // A short read zeroes the rest of the value and sets the stream's eofbit
+    // and failbit, as std::istream::read() does.
+    //
+    // A reader can also be made over a block of memory, such as a section
+    // that was just decompressed; the values are then copied straight out of
+    // the memory.
+    //
+    // A reader told to swap bytes reads a file written on a machine of the
+    // other byte order.  Arrays are swapped in place after they are copied,
+    // with the vector kernels of ByteSwap.
+    // ------------------------------------------------------------------------
+    class BinaryReader : private std::streambuf
+    {
+      public:
+
+        enum
+        {
+            default_block_size = 256 * 1024
+        };
+
+        explicit BinaryReader(
+            std::istream &stream,
+            std::size_t block_size = default_block_size
+        );
+
+        // Reads from the memory, which must outlive the reader.
+        //
+        BinaryReader(
+            const char *data,
+            std::size_t size
+        );
+
+        ~BinaryReader(void);
+
+        // Reads a value of a plain old data type.
+        //
+        // Return:  Was the value read?
+        //
+        template<class Type>
+        bool read(Type &value);
+
+        template<class Type>
+        bool read_array(Type *values, std::size_t count);
+
+        bool read_bytes(void *bytes, std::size_t size);
+
+        // Reads a string in the format of CORE::load_string().  Such a
+        // string can not be read from a file of the other byte order.
+        //
+        bool read_core_string(std::string &string);
+
+        // Sets whether the bytes of each value read by read() and
+        // read_array() are reversed.  read_bytes() never swaps.
+        //
+        void set_swap_bytes(bool swap_bytes);
+
+        // Return:  Has every read succeeded so far?
+        //
+        bool good(void) const;
+
+        // Return:  Has every byte of the stream or memory been read?
+        //
+        bool at_end(void);
+
+      private:
+
+        BinaryReader(const BinaryReader &);
+        BinaryReader &operator=(const BinaryReader &);
+
+        virtual int_type underflow(void);
+
+        virtual int_type uflow(void);
+
+        virtual std::streamsize xsgetn(
+            char *characters,
+            std::streamsize count);
+
+        std::istream
+            detached_stream;    // Stands in for the stream of a memory reader
+        std::istream
+            &stream;
+        std::istream
+            core_stream;        // Reads through this buffer
+        std::vector<char>
+            buffer;
+        bool
+            failed,
+            swap_bytes;
+    };
+
+    // ------------------------------------------------------------------------
+    template<class Type>
+    inline void BinaryWriter::write(const Type &value)
+    {
+        const Type
+            output = swap_bytes ? ByteSwap::swap(value) : value;
+
+        if (static_cast<std::size_t>(epptr() - pptr()) >= sizeof(output))
+        {
+            std::memcpy(pptr(), &output, sizeof(output));
+            pbump(sizeof(output));
+        }
+        else
+        {
+            write_bytes(&output, sizeof(output));
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    template<class Type>
+    inline void BinaryWriter::write_array(
+        const Type *values,
+        std::size_t count)
+    {
+        if (swap_bytes)
+        {
+            write_swapped(values, sizeof(Type), count);
+        }
+        else
+        {
+            write_bytes(values, count * sizeof(Type));
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    inline void BinaryWriter::write_bytes(const void *bytes, std::size_t size)
+    {
+        if (static_cast<std::size_t>(epptr() - pptr()) >= size)
+        {
+            std::memcpy(pptr(), bytes, size);
+            pbump(static_cast<int>(size));
+        }
+        else
+        {
+            xsputn(static_cast<const char *>(bytes), size);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    inline void BinaryWriter::set_swap_bytes(bool swap_bytes)
+    {
+        this->swap_bytes = swap_bytes;
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool BinaryWriter::good(void) const
+    {
+        return not failed;
+    }
+
+    // ------------------------------------------------------------------------
+    template<class Type>
+    inline bool BinaryReader::read(Type &value)
+    {
+        bool
+            successful =
+                static_cast<std::size_t>(egptr() - gptr()) >= sizeof(value);
+
+        if (successful)
+        {
+            std::memcpy(&value, gptr(), sizeof(value));
+            gbump(sizeof(value));
+        }
+        else
+        {
+            successful = read_bytes(&value, sizeof(value));
+        }
+
+        if (swap_bytes)
+        {
+            value = ByteSwap::swap(value);
+        }
+
+        return successful;
+    }
+
+    // ------------------------------------------------------------------------
+    template<class Type>
+    inline bool BinaryReader::read_array(Type *values, std::size_t count)
+    {
+        bool
+            successful = read_bytes(values, count * sizeof(Type));
+
+        if (swap_bytes)
+        {
+            ByteSwap::swap(values, sizeof(Type), count);
+        }
+
+        return successful;
+    }
+
+    // ------------------------------------------------------------------------
+    inline void BinaryReader::set_swap_bytes(bool swap_bytes)
+    {
+        this->swap_bytes = swap_bytes;
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool BinaryReader::good(void) const
+    {
+        return not failed;
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool BinaryReader::at_end(void)
+    {
+        return gptr() == egptr() and underflow() == traits_type::eof();
+    }
+}
+
+#endif
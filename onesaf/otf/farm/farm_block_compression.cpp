@@ -0,0 +1,321 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#include <cstring>
+
+#include "core/sys_types.h"
+#include "farm_block_compression.h"
+
+namespace
+{
+    const std::size_t
+        min_match = 4,
+        last_literals = 5,      // The format ends a block with literals
+        match_find_limit = 12,  // No match starts in the last 12 bytes
+        max_offset = 65535,
+        hash_bits = 16;
+
+    // ------------------------------------------------------------------------
+    // Return:  The four bytes at the address.
+    //
+    inline CORE::UInt32 read32(const char *bytes)
+    {
+        CORE::UInt32
+            value;
+
+        std::memcpy(&value, bytes, sizeof(value));
+
+        return value;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The hash table slot for four bytes.
+    //
+    inline std::size_t hash(CORE::UInt32 value)
+    {
+        return (value * 2654435761U) >> (32 - hash_bits);
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes the 255-byte continuation of a literal or match length.
+    //
+    inline void write_length(std::size_t length, char *&output)
+    {
+        while (length >= 255)
+        {
+            *output++ = static_cast<char>(255);
+            length -= 255;
+        }
+
+        *output++ = static_cast<char>(length);
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes one sequence: the literals from anchor to match, then a match
+    // of match_length bytes at the offset, if match_length is not zero.
+    //
+    void write_sequence(
+        const char *anchor,
+        std::size_t literal_length,
+        std::size_t offset,
+        std::size_t match_length,
+        char *&output)
+    {
+        char
+            *token = output++;
+        std::size_t
+            match_code = match_length ? match_length - min_match : 0;
+
+        *token = static_cast<char>(
+            ((literal_length < 15 ? literal_length : 15) << 4) |
+            (match_code < 15 ? match_code : 15));
+
+        if (literal_length >= 15)
+        {
+            write_length(literal_length - 15, output);
+        }
+
+        if (literal_length)
+        {
+            std::memcpy(output, anchor, literal_length);
+            output += literal_length;
+        }
+
+        if (match_length)
+        {
+            *output++ = static_cast<char>(offset & 0xff);
+            *output++ = static_cast<char>(offset >> 8);
+
+            if (match_code >= 15)
+            {
+                write_length(match_code - 15, output);
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Reads the 255-byte continuation of a literal or match length.
+    //
+    // Return:  Was the length inside the block?
+    //
+    inline bool read_length(
+        const unsigned char *&input,
+        const unsigned char *input_end,
+        std::size_t &length)
+    {
+        unsigned char
+            byte;
+
+        do
+        {
+            if (input >= input_end)
+            {
+                return false;
+            }
+
+            byte = *input++;
+            length += byte;
+        }
+        while (byte == 255);
+
+        return true;
+    }
+}
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    std::size_t BlockCompression::get_compress_bound(std::size_t size)
+    {
+        return size + size / 255 + 16;
+    }
+
+    // ------------------------------------------------------------------------
+    void BlockCompression::compress(
+        const char *source,
+        std::size_t size,
+        std::vector<char> &compressed
+    )
+    {
+        std::vector<CORE::Int32>
+            table(std::size_t(1) << hash_bits, -1);
+        std::size_t
+            anchor = 0,
+            position = 0;
+
+        compressed.resize(get_compress_bound(size));
+
+        char
+            *output = &compressed[0];
+
+        if (size > match_find_limit)
+        {
+            const std::size_t
+                match_limit = size - last_literals,
+                search_limit = size - match_find_limit;
+
+            while (position < search_limit)
+            {
+                CORE::UInt32
+                    sequence = read32(source + position);
+                CORE::Int32
+                    &slot = table[hash(sequence)],
+                    candidate = slot;
+
+                slot = static_cast<CORE::Int32>(position);
+
+                if (candidate < 0 or
+                    position - candidate > max_offset or
+                    read32(source + candidate) != sequence)
+                {
+                    ++position;
+                    continue;
+                }
+
+                std::size_t
+                    match = candidate,
+                    length = min_match;
+
+                // Extend the match back over the pending literals and
+                // forward up to the literals that end the block.
+                //
+                while (position > anchor and match > 0 and
+                       source[position - 1] == source[match - 1])
+                {
+                    --position;
+                    --match;
+                    ++length;
+                }
+
+                while (position + length < match_limit and
+                       source[position + length] == source[match + length])
+                {
+                    ++length;
+                }
+
+                write_sequence(
+                    source + anchor,
+                    position - anchor,
+                    position - match,
+                    length,
+                    output);
+
+                position += length;
+                anchor = position;
+            }
+        }
+
+        write_sequence(source + anchor, size - anchor, 0, 0, output);
+
+        compressed.resize(output - &compressed[0]);
+    }
+
+    // ------------------------------------------------------------------------
+    bool BlockCompression::decompress(
+        const char *source,
+        std::size_t size,
+        char *destination,
+        std::size_t destination_size
+    )
+    {
+        const unsigned char
+            *input = reinterpret_cast<const unsigned char *>(source),
+            *input_end = input + size;
+        std::size_t
+            written = 0;
+
+        while (input < input_end)
+        {
+            unsigned char
+                token = *input++;
+            std::size_t
+                literal_length = token >> 4,
+                match_length = token & 15,
+                offset;
+
+            if (literal_length == 15 and
+                not read_length(input, input_end, literal_length))
+            {
+                return false;
+            }
+
+            if (literal_length > static_cast<std::size_t>(input_end - input) or
+                literal_length > destination_size - written)
+            {
+                return false;
+            }
+
+            std::memcpy(destination + written, input, literal_length);
+            input += literal_length;
+            written += literal_length;
+
+            if (input == input_end)
+            {
+                // The last sequence has no match.
+                //
+                break;
+            }
+
+            if (input_end - input < 2)
+            {
+                return false;
+            }
+
+            offset = input[0] | (input[1] << 8);
+            input += 2;
+
+            if (match_length == 15 and
+                not read_length(input, input_end, match_length))
+            {
+                return false;
+            }
+
+            match_length += min_match;
+
+            if (offset == 0 or offset > written or
+                match_length > destination_size - written)
+            {
+                return false;
+            }
+
+            char
+                *output = destination + written;
+            const char
+                *match = output - offset;
+
+            if (offset >= match_length)
+            {
+                std::memcpy(output, match, match_length);
+            }
+            else
+            {
+                // The match overlaps the bytes it produces, which is how
+                // runs are encoded, so it is copied a byte at a time.
+                //
+                for (std::size_t i = 0; i < match_length; ++i)
+                {
+                    output[i] = match[i];
+                }
+            }
+
+            written += match_length;
+        }
+
+        return written == destination_size;
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef FARM_BLOCK_COMPRESSION_H
+#define FARM_BLOCK_COMPRESSION_H
+#include <cstddef>
+#include <vector>
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    // Compresses blocks of memory in the LZ4 block format: a sequence of
+    // literal runs and back references of at least four bytes into the
+    // previous 64 KB.  The compressor is the greedy single-pass one, which
+    // trades some ratio for speed; the decompressor is fast enough that
+    // reading a compressed FARM costs little more than reading it raw.
+    //
+    // Blocks are independent; they carry no sizes or checksums, so the
+    // caller stores the uncompressed size of each block next to it.
+    // ------------------------------------------------------------------------
+    class BlockCompression
+    {
+      public:
+
+        // Return:  The largest size that a block of the given size can
+        // compress to.
+        //
+        static std::size_t get_compress_bound(std::size_t size);
+
+        // Compresses the block into the buffer, which is resized to the
+        // compressed size.
+        //
+        static void compress(
+            const char *source,
+            std::size_t size,
+            std::vector<char> &compressed
+        );
+
+        // Decompresses the block, which must decompress to exactly
+        // destination_size bytes.  Every reference is checked against the
+        // buffers, so a damaged block fails rather than overruns.
+        //
+        // Return:  Was the block decompressed?
+        //
+        static bool decompress(
+            const char *source,
+            std::size_t size,
+            char *destination,
+            std::size_t destination_size
+        );
+    };
+}
+
+#endif
@@ -0,0 +1,191 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#include "core/logger.h"
+#include "farm_byte_swap.h"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+    const std::size_t
+        vector_bytes = 16;
+
+    // ------------------------------------------------------------------------
+    // Swaps the values that do not fill a whole vector.
+    //
+    template<class Type>
+    void swap_values(char *bytes, std::size_t count)
+    {
+        Type
+            value;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::memcpy(&value, bytes + i * sizeof(value), sizeof(value));
+            value = FARM::ByteSwap::swap(value);
+            std::memcpy(bytes + i * sizeof(value), &value, sizeof(value));
+        }
+    }
+
+#if defined(__SSSE3__)
+    // ------------------------------------------------------------------------
+    // Return:  The 16 bytes shuffled by the mask for the value size.
+    //
+    template<std::size_t value_size>
+    inline __m128i swap_vector(__m128i vector)
+    {
+        const __m128i
+            mask =
+                value_size == 2 ?
+                    _mm_setr_epi8(
+                        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14) :
+                value_size == 4 ?
+                    _mm_setr_epi8(
+                        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12) :
+                    _mm_setr_epi8(
+                        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+        return _mm_shuffle_epi8(vector, mask);
+    }
+#elif defined(__SSE2__)
+    // ------------------------------------------------------------------------
+    // Return:  The 16 bytes with the bytes of each value reversed.  SSE2 has
+    // no byte shuffle, so the bytes of each 16-bit word are swapped with
+    // shifts and the words are then reversed within each value.
+    //
+    template<std::size_t value_size>
+    inline __m128i swap_vector(__m128i vector)
+    {
+        vector = _mm_or_si128(
+            _mm_slli_epi16(vector, 8), _mm_srli_epi16(vector, 8));
+
+        if (value_size == 4)
+        {
+            vector = _mm_shufflelo_epi16(vector, _MM_SHUFFLE(2, 3, 0, 1));
+            vector = _mm_shufflehi_epi16(vector, _MM_SHUFFLE(2, 3, 0, 1));
+        }
+        else if (value_size == 8)
+        {
+            vector = _mm_shufflelo_epi16(vector, _MM_SHUFFLE(0, 1, 2, 3));
+            vector = _mm_shufflehi_epi16(vector, _MM_SHUFFLE(0, 1, 2, 3));
+        }
+
+        return vector;
+    }
+#elif defined(__ARM_NEON)
+    // ------------------------------------------------------------------------
+    // Return:  The 16 bytes with the bytes of each value reversed.
+    //
+    template<std::size_t value_size>
+    inline uint8x16_t swap_vector(uint8x16_t vector)
+    {
+        return
+            value_size == 2 ? vrev16q_u8(vector) :
+            value_size == 4 ? vrev32q_u8(vector) :
+                vrev64q_u8(vector);
+    }
+#endif
+
+    // ------------------------------------------------------------------------
+    // Swaps the values a vector at a time, then the rest one at a time.
+    //
+    template<class Type>
+    void swap_array(char *bytes, std::size_t count)
+    {
+        std::size_t
+            size = count * sizeof(Type),
+            vector_end = size - size % vector_bytes,
+            offset = 0;
+
+#if defined(__SSSE3__) || defined(__SSE2__)
+        for (; offset < vector_end; offset += vector_bytes)
+        {
+            __m128i
+                *address = reinterpret_cast<__m128i *>(bytes + offset);
+
+            _mm_storeu_si128(
+                address, swap_vector<sizeof(Type)>(_mm_loadu_si128(address)));
+        }
+#elif defined(__ARM_NEON)
+        for (; offset < vector_end; offset += vector_bytes)
+        {
+            uint8_t
+                *address = reinterpret_cast<uint8_t *>(bytes + offset);
+
+            vst1q_u8(address, swap_vector<sizeof(Type)>(vld1q_u8(address)));
+        }
+#else
+        (void) vector_end;
+#endif
+
+        swap_values<Type>(bytes + offset, (size - offset) / sizeof(Type));
+    }
+}
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    void ByteSwap::swap(
+        void *values,
+        std::size_t value_size,
+        std::size_t count
+    )
+    {
+        char
+            *bytes = static_cast<char *>(values);
+
+        switch (value_size)
+        {
+            case 1:
+            {
+                break;
+            }
+
+            case 2:
+            {
+                swap_array<CORE::UInt16>(bytes, count);
+                break;
+            }
+
+            case 4:
+            {
+                swap_array<CORE::UInt32>(bytes, count);
+                break;
+            }
+
+            case 8:
+            {
+                swap_array<CORE::UInt64>(bytes, count);
+                break;
+            }
+
+            default:
+            {
+                LOG(fatal, "Can not swap the bytes of a value of that size.");
+                break;
+            }
+        };
+    }
+}
@@ -0,0 +1,129 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef FARM_BYTE_SWAP_H
+#define FARM_BYTE_SWAP_H
+#include <cstddef>
+#include <cstring>
+
+#include "core/sys_types.h"
+
+namespace FARM
+{
+    // The byte order of a FARM file.
+    //
+    enum ByteOrder
+    {
+        little_endian_order,
+        big_endian_order
+    };
+
+    // ------------------------------------------------------------------------
+    // Reverses the bytes of integers and doubles, so a FARM written on a
+    // machine of the other byte order can be read.  Arrays are swapped 16
+    // bytes at a time with the byte shuffles of SSSE3, SSE2, or NEON,
+    // whichever the compiler targets, and a value at a time otherwise.
+    // ------------------------------------------------------------------------
+    class ByteSwap
+    {
+      public:
+
+        // Return:  The byte order of this machine.
+        //
+        static ByteOrder get_host_order(void);
+
+        // Return:  The value with its bytes reversed.  Values of one byte
+        // are returned as they are.
+        //
+        template<class Type>
+        static Type swap(const Type &value);
+
+        // Reverses the bytes of each of the values in place.  The values are
+        // 1, 2, 4, or 8 bytes long and need not be aligned.
+        //
+        static void swap(
+            void *values,
+            std::size_t value_size,
+            std::size_t count
+        );
+    };
+
+    // ------------------------------------------------------------------------
+    inline ByteOrder ByteSwap::get_host_order(void)
+    {
+        return CORE::little_endian() ? little_endian_order : big_endian_order;
+    }
+
+    // ------------------------------------------------------------------------
+    template<class Type>
+    inline Type ByteSwap::swap(const Type &value)
+    {
+        Type
+            swapped = value;
+
+        if (sizeof(Type) == 2)
+        {
+            CORE::UInt16
+                bits;
+
+            std::memcpy(&bits, &value, sizeof(bits));
+            bits = static_cast<CORE::UInt16>((bits << 8) | (bits >> 8));
+            std::memcpy(&swapped, &bits, sizeof(bits));
+        }
+        else if (sizeof(Type) == 4)
+        {
+            CORE::UInt32
+                bits;
+
+            std::memcpy(&bits, &value, sizeof(bits));
+#if defined(__GNUC__)
+            bits = __builtin_bswap32(bits);
+#else
+            bits =
+                (bits << 24) | ((bits << 8) & 0x00ff0000U) |
+                ((bits >> 8) & 0x0000ff00U) | (bits >> 24);
+#endif
+            std::memcpy(&swapped, &bits, sizeof(bits));
+        }
+        else if (sizeof(Type) == 8)
+        {
+            CORE::UInt64
+                bits;
+
+            std::memcpy(&bits, &value, sizeof(bits));
+#if defined(__GNUC__)
+            bits = __builtin_bswap64(bits);
+#else
+            bits =
+                ((bits & 0x00000000ffffffffULL) << 32) |
+                ((bits & 0xffffffff00000000ULL) >> 32);
+            bits =
+                ((bits & 0x0000ffff0000ffffULL) << 16) |
+                ((bits & 0xffff0000ffff0000ULL) >> 16);
+            bits =
+                ((bits & 0x00ff00ff00ff00ffULL) << 8) |
+                ((bits & 0xff00ff00ff00ff00ULL) >> 8);
+#endif
+            std::memcpy(&swapped, &bits, sizeof(bits));
+        }
+
+        return swapped;
+    }
+}
+
+#endif
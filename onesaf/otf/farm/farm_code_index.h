@@ -0,0 +1,200 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef FARM_CODE_INDEX_H
+#define FARM_CODE_INDEX_H
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "core/sys_types.h"
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    // Finds values by integer code.  FACC and EDCS codes are small and
+    // nearly contiguous, so the codes from zero up to a limit index an array
+    // directly; the few codes past the limit or below zero are kept in a
+    // map.  The limit is the largest code for which the array has no more
+    // than four slots per code below it.
+    //
+    // The index is built once, after which lookups may run concurrently.
+    // ------------------------------------------------------------------------
+    template <class Value>
+    class CodeIndex
+    {
+      public:
+
+        typedef std::vector<std::pair<CORE::Int64, Value> >
+            Entries;
+
+        // Lookups of codes that are not in the index return missing.
+        //
+        CodeIndex(const Value &new_missing);
+
+        void clear(void);
+
+        // Builds the index from entries sorted by code.  Only the first
+        // value of a code is kept.
+        //
+        void build(const Entries &entries);
+
+        // Return:  The value for the code, or the missing value.
+        //
+        const Value &find(CORE::Int64 code) const;
+
+        // Return:  The codes from zero that index the array.
+        //
+        std::size_t get_dense_size(void) const;
+
+        // Return:  The codes kept in the map.
+        //
+        std::size_t get_sparse_size(void) const;
+
+        // Return:  The heap bytes of the array.
+        //
+        std::size_t get_dense_bytes(void) const;
+
+      private:
+
+        typedef std::map<CORE::Int64, Value>
+            SparseCodes;
+
+        Value
+            missing;
+        std::vector<Value>
+            dense;
+        SparseCodes
+            sparse;
+    };
+
+    // ------------------------------------------------------------------------
+    template <class Value>
+    CodeIndex<Value>::CodeIndex(const Value &new_missing) :
+        missing(new_missing)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    template <class Value>
+    void CodeIndex<Value>::clear(void)
+    {
+        std::vector<Value>().swap(dense);
+        sparse.clear();
+    }
+
+    // ------------------------------------------------------------------------
+    template <class Value>
+    void CodeIndex<Value>::build(const Entries &entries)
+    {
+        const CORE::Int64
+            slots_per_code = 4,
+            minimum_slots = 64;
+        CORE::Int64
+            limit = -1,
+            codes_below = 0;
+
+        clear();
+
+        for (typename Entries::size_type index = 0;
+             index < entries.size();
+             ++index)
+        {
+            if (entries[index].first >= 0)
+            {
+                ++codes_below;
+
+                if (entries[index].first <
+                    codes_below * slots_per_code + minimum_slots)
+                {
+                    limit = entries[index].first;
+                }
+            }
+        }
+
+        dense.assign(limit + 1, missing);
+
+        for (typename Entries::size_type index = 0;
+             index < entries.size();
+             ++index)
+        {
+            const CORE::Int64
+                code = entries[index].first;
+
+            if (index > 0 and code == entries[index - 1].first)
+            {
+                continue;
+            }
+
+            if (code >= 0 and code <= limit)
+            {
+                dense[code] = entries[index].second;
+            }
+            else
+            {
+                sparse.insert(
+                    typename SparseCodes::value_type(
+                        code, entries[index].second));
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    template <class Value>
+    inline const Value &CodeIndex<Value>::find(CORE::Int64 code) const
+    {
+        if (static_cast<CORE::UInt64>(code) < dense.size())
+        {
+            return dense[code];
+        }
+
+        if (sparse.empty())
+        {
+            return missing;
+        }
+
+        typename SparseCodes::const_iterator
+            sparse_itr = sparse.find(code);
+
+        return sparse_itr == sparse.end() ? missing : sparse_itr->second;
+    }
+
+    // ------------------------------------------------------------------------
+    template <class Value>
+    std::size_t CodeIndex<Value>::get_dense_size(void) const
+    {
+        return dense.size();
+    }
+
+    // ------------------------------------------------------------------------
+    template <class Value>
+    std::size_t CodeIndex<Value>::get_sparse_size(void) const
+    {
+        return sparse.size();
+    }
+
+    // ------------------------------------------------------------------------
+    template <class Value>
+    std::size_t CodeIndex<Value>::get_dense_bytes(void) const
+    {
+        return dense.capacity() * sizeof(Value);
+    }
+}
+
+#endif
@@ -0,0 +1,314 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#include <cstring>
+#include <fstream>
+
+#include "core/logger.h"
+#include "farm_block_compression.h"
+#include "farm_compressed_image.h"
+
+namespace
+{
+    const char
+        image_magic[8] = {'F', 'A', 'R', 'M', 'L', 'Z', '4', 'I'};
+
+    // Format 2 added the row index section, which every image has.
+    //
+    const CORE::UInt32
+        image_format = 2,
+        byte_order_mark = 0x01020304;
+
+    // A block can not decompress to more than this many times its size,
+    // which bounds the buffer for a damaged directory entry.
+    //
+    const CORE::UInt64
+        max_expansion = 256;
+
+    // The header at the start of an image.  The directory of sections
+    // follows it.
+    //
+    struct ImageHeader
+    {
+        char
+            magic[8];
+        CORE::UInt32
+            format,
+            byte_order,
+            section_count,
+            row_count;
+    };
+}
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    void CompressedImageWriter::add_section(
+        CompressedSectionKind kind,
+        const std::string &data,
+        int first_row,
+        int row_count
+    )
+    {
+        CompressedSection
+            section;
+
+        payloads.push_back(std::vector<char>());
+
+        BlockCompression::compress(data.data(), data.size(), payloads.back());
+
+        section.kind = kind;
+        section.first_row = first_row;
+        section.row_count = row_count;
+        section.offset = 0;
+        section.compressed_bytes = payloads.back().size();
+        section.data_bytes = data.size();
+
+        sections.push_back(section);
+    }
+
+    // ------------------------------------------------------------------------
+    bool CompressedImageWriter::write(const std::string &file_name) const
+    {
+        std::ofstream
+            file(file_name.c_str(), std::ios::out | std::ios::binary);
+        ImageHeader
+            header;
+        std::vector<CompressedSection>
+            directory(sections);
+        CORE::UInt64
+            offset =
+                sizeof(header) +
+                sizeof(CompressedSection) * directory.size();
+
+        ASSERT(
+            file.is_open(),
+            high,
+            "Could not create the file '" + file_name + "'.");
+
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, image_magic, sizeof(image_magic));
+        header.format = image_format;
+        header.byte_order = byte_order_mark;
+        header.section_count = directory.size();
+        header.row_count = 0;
+
+        for (std::size_t index = 0; index < directory.size(); ++index)
+        {
+            directory[index].offset = offset;
+            offset += directory[index].compressed_bytes;
+            header.row_count += directory[index].row_count;
+        }
+
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        if (not directory.empty())
+        {
+            file.write(
+                reinterpret_cast<const char *>(&directory[0]),
+                sizeof(CompressedSection) * directory.size());
+        }
+
+        for (std::size_t index = 0; index < payloads.size(); ++index)
+        {
+            if (not payloads[index].empty())
+            {
+                file.write(&payloads[index][0], payloads[index].size());
+            }
+        }
+
+        file.close();
+
+        return not file.fail();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::UInt64 CompressedImageWriter::get_data_bytes(void) const
+    {
+        CORE::UInt64
+            bytes = 0;
+
+        for (std::size_t index = 0; index < sections.size(); ++index)
+        {
+            bytes += sections[index].data_bytes;
+        }
+
+        return bytes;
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::UInt64 CompressedImageWriter::get_compressed_bytes(void) const
+    {
+        CORE::UInt64
+            bytes = 0;
+
+        for (std::size_t index = 0; index < sections.size(); ++index)
+        {
+            bytes += sections[index].compressed_bytes;
+        }
+
+        return bytes;
+    }
+
+    // ------------------------------------------------------------------------
+    CompressedImageReader::CompressedImageReader(void) :
+        row_count(0)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    bool CompressedImageReader::open(const std::string &file_name)
+    {
+        std::ifstream
+            file(file_name.c_str(), std::ios::in | std::ios::binary);
+        ImageHeader
+            header;
+        bool
+            successful = file.is_open();
+
+        image.clear();
+        sections.clear();
+        row_count = 0;
+
+        if (successful)
+        {
+            file.seekg(0, std::ios::end);
+            image.resize(static_cast<std::size_t>(file.tellg()));
+            file.seekg(0, std::ios::beg);
+
+            successful = image.size() >= sizeof(header);
+        }
+
+        if (successful)
+        {
+            file.read(&image[0], image.size());
+            std::memcpy(&header, &image[0], sizeof(header));
+
+            successful =
+                file.good() and
+                std::memcmp(header.magic, image_magic, sizeof(image_magic))
+                    == 0 and
+                header.format == image_format and
+                header.byte_order == byte_order_mark and
+                header.section_count <=
+                    (image.size() - sizeof(header)) /
+                        sizeof(CompressedSection);
+        }
+
+        if (successful)
+        {
+            bool
+                row_index = false;
+
+            sections.resize(header.section_count);
+
+            if (not sections.empty())
+            {
+                std::memcpy(
+                    &sections[0],
+                    &image[sizeof(header)],
+                    sizeof(CompressedSection) * sections.size());
+            }
+
+            // Every section must lie inside the file, and the image must
+            // have a row index.
+            //
+            for (std::size_t index = 0;
+                 successful and index < sections.size();
+                 ++index)
+            {
+                const CompressedSection
+                    &section = sections[index];
+
+                successful =
+                    section.offset <= image.size() and
+                    section.compressed_bytes <=
+                        image.size() - section.offset and
+                    section.data_bytes <=
+                        section.compressed_bytes * max_expansion and
+                    section.kind <= row_index_section;
+
+                row_count += section.row_count;
+                row_index = row_index or section.kind == row_index_section;
+            }
+
+            successful =
+                successful and
+                row_count == header.row_count and
+                row_index;
+        }
+
+        if (not successful)
+        {
+            LOG(
+                high,
+                "The compressed FARM image '" + file_name + "' could not be "
+                    "read.");
+
+            image.clear();
+            sections.clear();
+            row_count = 0;
+        }
+
+        return successful;
+    }
+
+    // ------------------------------------------------------------------------
+    int CompressedImageReader::get_section_count(void) const
+    {
+        return sections.size();
+    }
+
+    // ------------------------------------------------------------------------
+    const CompressedSection &CompressedImageReader::get_section(
+        int index
+    ) const
+    {
+        return sections[index];
+    }
+
+    // ------------------------------------------------------------------------
+    int CompressedImageReader::get_row_count(void) const
+    {
+        return row_count;
+    }
+
+    // ------------------------------------------------------------------------
+    std::size_t CompressedImageReader::get_image_bytes(void) const
+    {
+        return image.size();
+    }
+
+    // ------------------------------------------------------------------------
+    bool CompressedImageReader::decompress(
+        int index,
+        std::vector<char> &data
+    ) const
+    {
+        const CompressedSection
+            &section = sections[index];
+
+        data.resize(section.data_bytes);
+
+        return BlockCompression::decompress(
+            &image[0] + section.offset,
+            section.compressed_bytes,
+            data.empty() ? 0 : &data[0],
+            data.size());
+    }
+}
@@ -0,0 +1,151 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef FARM_COMPRESSED_IMAGE_H
+#define FARM_COMPRESSED_IMAGE_H
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "core/sys_types.h"
+
+namespace FARM
+{
+    // The sections of a compressed FARM image.  Each map of the FARM is one
+    // section; the FARM table is split into sections of consecutive rows.
+    //
+    enum CompressedSectionKind
+    {
+        feature_categories_section,     // Labels and geometries to categories
+        features_section,               // Categories to features
+        attributes_section,             // Codes to attributes
+        enums_section,                  // Attribute codes to enumerations
+        farm_table_section,             // Rows of the FARM table
+        row_index_section               // Where each row starts in its section
+    };
+
+    // Where a section is stored in a compressed FARM image.
+    //
+    struct CompressedSection
+    {
+        CORE::UInt32
+            kind,
+            first_row,          // Of a FARM table section
+            row_count;          // Of a FARM table section
+        CORE::UInt64
+            offset,             // From the start of the file
+            compressed_bytes,
+            data_bytes;
+    };
+
+    // ------------------------------------------------------------------------
+    // Builds a compressed FARM image: a header, a directory of sections, and
+    // the sections, each compressed on its own by BlockCompression so that
+    // they can be decompressed and decoded in parallel.  The data in a
+    // section is in the format of FeatureAttributeMapping::dump().
+    //
+    // Like FARM.bin, the image is in the byte order of the machine that
+    // wrote it; a reader on the other byte order rejects it.
+    // ------------------------------------------------------------------------
+    class CompressedImageWriter
+    {
+      public:
+
+        // Compresses the data and adds it as the next section.
+        //
+        void add_section(
+            CompressedSectionKind kind,
+            const std::string &data,
+            int first_row = 0,
+            int row_count = 0
+        );
+
+        // Writes the image to the file.
+        //
+        // Return:  Was the image written?
+        //
+        bool write(const std::string &file_name) const;
+
+        // Return:  The total size of the sections before compression.
+        //
+        CORE::UInt64 get_data_bytes(void) const;
+
+        // Return:  The total size of the sections after compression.
+        //
+        CORE::UInt64 get_compressed_bytes(void) const;
+
+      private:
+
+        std::vector<CompressedSection>
+            sections;
+        std::vector< std::vector<char> >
+            payloads;
+    };
+
+    // ------------------------------------------------------------------------
+    // Reads a compressed FARM image.  The file is read into memory in one
+    // piece by open(); decompress() may then be called from several threads
+    // at once.
+    // ------------------------------------------------------------------------
+    class CompressedImageReader
+    {
+      public:
+
+        CompressedImageReader(void);
+
+        // Reads the image and checks its header and directory.
+        //
+        // Return:  Was the image read?
+        //
+        bool open(const std::string &file_name);
+
+        // Return:  The number of sections in the image.
+        //
+        int get_section_count(void) const;
+
+        const CompressedSection &get_section(int index) const;
+
+        // Return:  The number of FARM table rows in the image.
+        //
+        int get_row_count(void) const;
+
+        // Return:  The size of the image in memory.
+        //
+        std::size_t get_image_bytes(void) const;
+
+        // Decompresses the section into the buffer.
+        //
+        // Return:  Was the section decompressed?
+        //
+        bool decompress(
+            int index,
+            std::vector<char> &data
+        ) const;
+
+      private:
+
+        std::vector<char>
+            image;
+        std::vector<CompressedSection>
+            sections;
+        int
+            row_count;
+    };
+}
+
+#endif
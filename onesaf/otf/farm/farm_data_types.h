@@ -24,6 +24,7 @@
 
 #include "core/compare.h"
 #include "core/sys_types.h"
+#include "farm_binary_codec.h"
 #include "farm_enumerant.h"
 
 namespace FARM
@@ -68,21 +69,39 @@ namespace FARM
 
         // Writes the data in the class to the stream.
         //
-        virtual void write(std::ostream &stream) const;
+        void write(std::ostream &stream) const;
+
+        // Writes the data in the class through the binary writer.
+        //
+        virtual void write(BinaryWriter &writer) const;
 
         // Reads the data in the class from the stream.
         //
-        virtual void read(std::istream &stream);
+        void read(std::istream &stream);
+
+        // Reads the data in the class through the binary reader.
+        //
+        virtual void read(BinaryReader &reader);
 
         // Writes the contents of this class instance to the given binary
         // stream in a format that can be read by the terrain compiler.
         //
-        virtual void dump(std::ostream &stream) const;
+        void dump(std::ostream &stream) const;
+
+        // Writes the contents of this class instance through the binary
+        // writer in the terrain compiler format.
+        //
+        virtual void dump(BinaryWriter &writer) const;
 
         // Reads the contents of this class instance from the given binary
         // stream.
         //
-        virtual void load(std::istream &stream);
+        void load(std::istream &stream);
+
+        // Reads the contents of this class instance through the binary
+        // reader.
+        //
+        virtual void load(BinaryReader &reader);
 
       private:
 
@@ -120,45 +139,50 @@ namespace FARM
         //
         DatabaseDataType get_default(void) const;
 
-        // Writes the data in the class to the stream.
+        using DataType::write;
+        using DataType::read;
+        using DataType::dump;
+        using DataType::load;
+
+        // Writes the data in the class through the binary writer.
         //
-        virtual void write(std::ostream &stream) const;
+        virtual void write(BinaryWriter &writer) const;
 
-        // Reads the data in the class from the stream.
+        // Reads the data in the class through the binary reader.
         //
-        virtual void read(std::istream &stream);
+        virtual void read(BinaryReader &reader);
 
-        // Writes the contents of this class instance to the given binary
-        // stream in a format that can be read by the terrain compiler.
+        // Writes the contents of this class instance through the binary
+        // writer in a format that can be read by the terrain compiler.
         //
-        virtual void dump(std::ostream &stream) const;
+        virtual void dump(BinaryWriter &writer) const;
 
-        // Reads the contents of this class instance from the given binary
-        // stream.
+        // Reads the contents of this class instance through the binary
+        // reader.
         //
-        virtual void load(std::istream &stream);
+        virtual void load(BinaryReader &reader);
 
       private:
 
-        // Writes the values in this class instance to the binary stream as
-        // Int32's.
+        // Writes the values in this class instance through the binary writer
+        // as Int32's.
         //
-        void dump_int32(std::ostream &stream) const;
+        void dump_int32(BinaryWriter &writer) const;
 
-        // Reads the values in this class instance from the binary stream as
-        // Int32's.
+        // Reads the values in this class instance through the binary reader
+        // as Int32's.
         //
-        void load_int32(std::istream &stream);
+        void load_int32(BinaryReader &reader);
 
-        // Writes the values in this class instance to the binary stream as
-        // Float64's.
+        // Writes the values in this class instance through the binary writer
+        // as Float64's.
         //
-        void dump_float64(std::ostream &stream) const;
+        void dump_float64(BinaryWriter &writer) const;
 
-        // Reads the values in this class instance from the binary stream as
-        // Float64's.
+        // Reads the values in this class instance through the binary reader
+        // as Float64's.
         //
-        void load_float64(std::istream &stream);
+        void load_float64(BinaryReader &reader);
 
         DatabaseDataType
             def,
@@ -191,19 +215,24 @@ namespace FARM
 
         bool get_default(void) const;
 
-        virtual void write(std::ostream &stream) const;
+        using DataType::write;
+        using DataType::read;
+        using DataType::dump;
+        using DataType::load;
 
-        virtual void read(std::istream &stream);
+        virtual void write(BinaryWriter &writer) const;
 
-        // Writes the contents of this class instance to the given binary
-        // stream in a format that can be read by the terrain compiler.
+        virtual void read(BinaryReader &reader);
+
+        // Writes the contents of this class instance through the binary
+        // writer in a format that can be read by the terrain compiler.
         //
-        virtual void dump(std::ostream &stream) const;
+        virtual void dump(BinaryWriter &writer) const;
 
-        // Reads the contents of this class instance from the given binary
-        // stream.
+        // Reads the contents of this class instance through the binary
+        // reader.
         //
-        virtual void load(std::istream &stream);
+        virtual void load(BinaryReader &reader);
 
       private:
 
@@ -232,27 +261,36 @@ namespace FARM
         //
         EnumerantCode get_default(void) const;
 
+        // Return:  The default enumerant for the attribute.
+        //
+        const Enumerant &get_default_enumerant(void) const;
+
         // Return:  The valid enumerations for the attribute.
         //
         const Enumerants &enumerants(void) const;
 
-        // Writes the data in the class to the stream.
+        using DataType::write;
+        using DataType::read;
+        using DataType::dump;
+        using DataType::load;
+
+        // Writes the data in the class through the binary writer.
         //
-        virtual void write(std::ostream &stream) const;
+        virtual void write(BinaryWriter &writer) const;
 
-        // Reads the data in the class from the stream.
+        // Reads the data in the class through the binary reader.
         //
-        virtual void read(std::istream &stream);
+        virtual void read(BinaryReader &reader);
 
-        // Writes the contents of this class instance to the given binary
-        // stream in a format that can be read by the terrain compiler.
+        // Writes the contents of this class instance through the binary
+        // writer in a format that can be read by the terrain compiler.
         //
-        virtual void dump(std::ostream &stream) const;
+        virtual void dump(BinaryWriter &writer) const;
 
-        // Reads the contents of this class instance from the given binary
-        // stream.
+        // Reads the contents of this class instance through the binary
+        // reader.
         //
-        virtual void load(std::istream &stream);
+        virtual void load(BinaryReader &reader);
 
       private:
 
@@ -276,36 +314,64 @@ namespace FARM
     // -----------------------------------------------------------------------
     inline void FARM::DataType::write(std::ostream &stream) const
     {
-        AttributeOffset
-            attribute_offset = offset;
+        BinaryWriter
+            writer(stream, 0);
 
-        stream.write(
-            reinterpret_cast<const char *>(&attribute_offset),
-            sizeof(attribute_offset));
+        write(writer);
+    }
+
+    // -----------------------------------------------------------------------
+    inline void FARM::DataType::write(BinaryWriter &writer) const
+    {
+        writer.write(offset);
     }
 
     // ------------------------------------------------------------------------
     inline void FARM::DataType::read(std::istream &stream)
     {
-        stream.read(reinterpret_cast<char *>(&offset), sizeof(offset));
+        BinaryReader
+            reader(stream, 0);
+
+        read(reader);
+    }
+
+    // ------------------------------------------------------------------------
+    inline void FARM::DataType::read(BinaryReader &reader)
+    {
+        reader.read(offset);
     }
 
     // -----------------------------------------------------------------------
     inline void FARM::DataType::dump(std::ostream &stream) const
     {
-        CORE::Int32
-            int32 = offset;
+        BinaryWriter
+            writer(stream, 0);
+
+        dump(writer);
+    }
 
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+    // -----------------------------------------------------------------------
+    inline void FARM::DataType::dump(BinaryWriter &writer) const
+    {
+        writer.write(static_cast<CORE::Int32>(offset));
     }
 
     // -----------------------------------------------------------------------
     inline void FARM::DataType::load(std::istream &stream)
+    {
+        BinaryReader
+            reader(stream, 0);
+
+        load(reader);
+    }
+
+    // -----------------------------------------------------------------------
+    inline void FARM::DataType::load(BinaryReader &reader)
     {
         CORE::Int32
             int32;
 
-        stream.read(reinterpret_cast<char *>(&int32), sizeof(int32));
+        reader.read(int32);
         offset = int32;
     }
 
@@ -332,60 +398,54 @@ namespace FARM
     }
 
     // ------------------------------------------------------------------------
-    inline void FARM::EnumerantDataType::write(std::ostream &stream) const
+    inline void FARM::EnumerantDataType::write(BinaryWriter &writer) const
     {
         Enumerants::const_iterator
             iterator = valid_enums.begin();
-        CORE::Int32
-            num_valid_enums = valid_enums.size();
 
-        DataType::write(stream);
+        DataType::write(writer);
 
         // Write the default enumeration value.
         //
-        def.write(stream);
+        def.write(writer);
 
         // Write the valid enumerations.
         //
-        stream.write(
-            reinterpret_cast<char *>(&num_valid_enums),
-            sizeof(num_valid_enums));
+        writer.write(static_cast<CORE::Int32>(valid_enums.size()));
 
         while (iterator != valid_enums.end())
         {
-            iterator->write(stream);
+            iterator->write(writer);
 
             ++iterator;
         }
     }
 
     // ------------------------------------------------------------------------
-    inline void FARM::EnumerantDataType::read(std::istream &stream)
+    inline void FARM::EnumerantDataType::read(BinaryReader &reader)
     {
         Enumerant
             valid_enum;
         CORE::Int32
             num_valid_enums;
 
-        DataType::read(stream);
+        DataType::read(reader);
 
         // Read the default enumeration value.
         //
-        valid_enum.read(stream);
+        valid_enum.read(reader);
         def = valid_enum;
 
         // Read the valid enumerations.
         //
         valid_enums.clear();
 
-        stream.read(
-            reinterpret_cast<char *>(&num_valid_enums),
-            sizeof(num_valid_enums));
+        reader.read(num_valid_enums);
 
         for (int index = 0; index < num_valid_enums; ++index)
         {
             valid_enum = Enumerant();
-            valid_enum.read(stream);
+            valid_enum.read(reader);
 
             ASSERT(
                 valid_enums.insert(valid_enum).second,
@@ -396,40 +456,37 @@ namespace FARM
     }
 
     // ------------------------------------------------------------------------
-    inline void FARM::EnumerantDataType::dump(std::ostream &stream) const
+    inline void FARM::EnumerantDataType::dump(BinaryWriter &writer) const
     {
         Enumerants::const_iterator
             iter = valid_enums.begin();
 
-        DataType::dump(stream);
+        DataType::dump(writer);
 
         // Write the default enumeration value.
         //
-        def.dump(stream);
+        def.dump(writer);
 
         // Write the valid enumerations.
         //
-        CORE::Int32
-            int32 = valid_enums.size();
-
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+        writer.write(static_cast<CORE::Int32>(valid_enums.size()));
 
         while (iter != valid_enums.end())
         {
-            iter->dump(stream);
+            iter->dump(writer);
 
             ++iter;
         }
     }
 
     // ------------------------------------------------------------------------
-    inline void FARM::EnumerantDataType::load(std::istream &stream)
+    inline void FARM::EnumerantDataType::load(BinaryReader &reader)
     {
-        DataType::load(stream);
+        DataType::load(reader);
 
         // Read the default enumeration value.
         //
-        def.load(stream);
+        def.load(reader);
 
         // Read the valid enumerations.
         //
@@ -440,11 +497,11 @@ namespace FARM
 
         valid_enums.clear();
 
-        stream.read(reinterpret_cast<char *>(&num_enums), sizeof(num_enums));
+        reader.read(num_enums);
 
         for (int index = 0; index < num_enums; ++index)
         {
-            enum_value.load(stream);
+            enum_value.load(reader);
 
             ASSERT(
                 valid_enums.insert(enum_value).second,
@@ -533,52 +590,50 @@ namespace FARM
     // ------------------------------------------------------------------------
     template<class DatabaseDataType>
     inline void InstantiatedDataType<DatabaseDataType>::write(
-        std::ostream &stream
+        BinaryWriter &writer
     ) const
     {
-        DatabaseDataType
-            def_value = def,
-            min_value = min,
-            max_value = max;
+        const DatabaseDataType
+            values[] = { def, min, max };
 
-        DataType::write(stream);
+        DataType::write(writer);
 
-        stream.write(
-            reinterpret_cast<const char *>(&def_value), sizeof(def_value));
-        stream.write(
-            reinterpret_cast<const char *>(&min_value), sizeof(min_value));
-        stream.write(
-            reinterpret_cast<const char *>(&max_value), sizeof(max_value));
+        writer.write_array(values, 3);
     }
 
     // ------------------------------------------------------------------------
     template<class DatabaseDataType>
     inline void InstantiatedDataType<DatabaseDataType>::read(
-        std::istream &stream
+        BinaryReader &reader
     )
     {
-        DataType::read(stream);
+        DatabaseDataType
+            values[3];
+
+        DataType::read(reader);
+
+        reader.read_array(values, 3);
 
-        stream.read(reinterpret_cast<char *>(&def), sizeof(def));
-        stream.read(reinterpret_cast<char *>(&min), sizeof(min));
-        stream.read(reinterpret_cast<char *>(&max), sizeof(max));
+        def = values[0];
+        min = values[1];
+        max = values[2];
     }
 
     // ------------------------------------------------------------------------
     template<class DatabaseDataType>
     inline void InstantiatedDataType<DatabaseDataType>::dump(
-        std::ostream &stream
+        BinaryWriter &writer
     ) const
     {
-        DataType::dump(stream);
+        DataType::dump(writer);
 
         if (sizeof(def) == 4)
         {
-            dump_int32(stream);
+            dump_int32(writer);
         }
         else if (sizeof(def) == 8)
         {
-            dump_float64(stream);
+            dump_float64(writer);
         }
         else
         {
@@ -589,18 +644,18 @@ namespace FARM
     // ------------------------------------------------------------------------
     template<class DatabaseDataType>
     inline void InstantiatedDataType<DatabaseDataType>::load(
-        std::istream &stream
+        BinaryReader &reader
     )
     {
-        DataType::load(stream);
+        DataType::load(reader);
 
         if (sizeof(def) == 4)
         {
-            load_int32(stream);
+            load_int32(reader);
         }
         else if (sizeof(def) == 8)
         {
-            load_float64(stream);
+            load_float64(reader);
         }
         else
         {
@@ -611,75 +666,67 @@ namespace FARM
     // ------------------------------------------------------------------------
     template<class DatabaseDataType>
     inline void InstantiatedDataType<DatabaseDataType>::dump_int32(
-        std::ostream &stream
+        BinaryWriter &writer
     ) const
     {
-        CORE::Int32
-            int32 = static_cast<CORE::Int32>(def);
-
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
-
-        int32 = static_cast<CORE::Int32>(min);
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+        const CORE::Int32
+            values[] =
+            {
+                static_cast<CORE::Int32>(def),
+                static_cast<CORE::Int32>(min),
+                static_cast<CORE::Int32>(max)
+            };
 
-        int32 = static_cast<CORE::Int32>(max);
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+        writer.write_array(values, 3);
     }
 
     // ------------------------------------------------------------------------
     template<class DatabaseDataType>
     inline void InstantiatedDataType<DatabaseDataType>::load_int32(
-        std::istream &stream
+        BinaryReader &reader
     )
     {
         CORE::Int32
-            int32;
-
-        stream.read(reinterpret_cast<char *>(&int32), sizeof(int32));
-        def = static_cast<DatabaseDataType>(int32);
+            values[3];
 
-        stream.read(reinterpret_cast<char *>(&int32), sizeof(int32));
-        min = static_cast<DatabaseDataType>(int32);
+        reader.read_array(values, 3);
 
-        stream.read(reinterpret_cast<char *>(&int32), sizeof(int32));
-        max = static_cast<DatabaseDataType>(int32);
+        def = static_cast<DatabaseDataType>(values[0]);
+        min = static_cast<DatabaseDataType>(values[1]);
+        max = static_cast<DatabaseDataType>(values[2]);
     }
 
     // ------------------------------------------------------------------------
     template<class DatabaseDataType>
     inline void InstantiatedDataType<DatabaseDataType>::dump_float64(
-        std::ostream &stream
+        BinaryWriter &writer
     ) const
     {
-        CORE::Float64
-            float64 = static_cast<CORE::Float64>(def);
-
-        stream.write(reinterpret_cast<char *>(&float64), sizeof(float64));
+        const CORE::Float64
+            values[] =
+            {
+                static_cast<CORE::Float64>(def),
+                static_cast<CORE::Float64>(min),
+                static_cast<CORE::Float64>(max)
+            };
 
-        float64 = static_cast<CORE::Float64>(min);
-        stream.write(reinterpret_cast<char *>(&float64), sizeof(float64));
-
-        float64 = static_cast<CORE::Float64>(max);
-        stream.write(reinterpret_cast<char *>(&float64), sizeof(float64));
+        writer.write_array(values, 3);
     }
 
     // ------------------------------------------------------------------------
     template<class DatabaseDataType>
     inline void InstantiatedDataType<DatabaseDataType>::load_float64(
-        std::istream &stream
+        BinaryReader &reader
     )
     {
         CORE::Float64
-            float64;
-
-        stream.read(reinterpret_cast<char *>(&float64), sizeof(float64));
-        def = static_cast<DatabaseDataType>(float64);
+            values[3];
 
-        stream.read(reinterpret_cast<char *>(&float64), sizeof(float64));
-        min = static_cast<DatabaseDataType>(float64);
+        reader.read_array(values, 3);
 
-        stream.read(reinterpret_cast<char *>(&float64), sizeof(float64));
-        max = static_cast<DatabaseDataType>(float64);
+        def = static_cast<DatabaseDataType>(values[0]);
+        min = static_cast<DatabaseDataType>(values[1]);
+        max = static_cast<DatabaseDataType>(values[2]);
     }
 
     // ------------------------------------------------------------------------
@@ -698,50 +745,43 @@ namespace FARM
         def = value;
     }
     // ------------------------------------------------------------------------
-    inline void BooleanDataType::write(std::ostream &stream) const
+    inline void BooleanDataType::write(BinaryWriter &writer) const
     {
-        CORE::Int32
-            def_value = def;
-
-        DataType::write(stream);
+        DataType::write(writer);
 
-        stream.write(
-            reinterpret_cast<const char *>(&def_value), sizeof(def_value));
+        writer.write(static_cast<CORE::Int32>(def));
     }
 
     // ------------------------------------------------------------------------
-    inline void BooleanDataType::read(std::istream &stream)
+    inline void BooleanDataType::read(BinaryReader &reader)
     {
         CORE::Int32
             def_value;
 
-        DataType::read(stream);
+        DataType::read(reader);
 
-        stream.read(reinterpret_cast<char *>(&def_value), sizeof(def_value));
+        reader.read(def_value);
 
         def = def_value;
     }
 
     // ------------------------------------------------------------------------
-    inline void BooleanDataType::dump(std::ostream &stream) const
+    inline void BooleanDataType::dump(BinaryWriter &writer) const
     {
-        DataType::dump(stream);
+        DataType::dump(writer);
 
-        CORE::Int32
-            int32 = def ? 1 : 0;
-
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+        writer.write(static_cast<CORE::Int32>(def ? 1 : 0));
     }
 
     // ------------------------------------------------------------------------
-    inline void BooleanDataType::load(std::istream &stream)
+    inline void BooleanDataType::load(BinaryReader &reader)
     {
         CORE::Int32
             int32;
 
-        DataType::load(stream);
+        DataType::load(reader);
 
-        stream.read(reinterpret_cast<char *>(&int32), sizeof(int32));
+        reader.read(int32);
         def = int32;
     }
 
@@ -768,6 +808,13 @@ namespace FARM
         return def.get_ee_code();
     }
 
+    // ------------------------------------------------------------------------
+    inline const Enumerant &EnumerantDataType::get_default_enumerant(
+        void) const
+    {
+        return def;
+    }
+
     // ------------------------------------------------------------------------
     inline const Enumerants &EnumerantDataType::enumerants(void) const
     {
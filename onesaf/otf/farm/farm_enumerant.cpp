@@ -16,9 +16,23 @@
  * this document shall be referred to U.S. Army PEO STRI.
  *
  */
+#include <type_traits>
+
 #include "farm_enumerant.h"
 #include "farm.h"
 
+namespace
+{
+    // Enumerants are moved into the enumerant maps and returned by value.
+    // Standard containers only move rather than copy them when the move
+    // cannot throw.
+    //
+    static_assert(
+        std::is_nothrow_move_constructible<FARM::Enumerant>::value and
+            std::is_nothrow_move_assignable<FARM::Enumerant>::value,
+        "An Enumerant must move without throwing.");
+}
+
 namespace FARM
 {
     // ------------------------------------------------------------------------
@@ -29,16 +43,24 @@ namespace FARM
 
         // Get the attribute label and enumerant label.
         //
+        const EnumerantHandle
+            handle = FeatureAttributeMapping::get_enumerant_handle(
+                ea_code, ee_code);
         bool
-            status =
-                FeatureAttributeMapping::get_attribute_label_from_code(ea_code, ea_label) and
-                FeatureAttributeMapping::get_enumerant_label(ea_label, ee_code, ee_label);
+            status = handle.valid();
 
-        if (not status)
+        if (status)
+        {
+            ea_label = handle.get_ea_label();
+            ee_label = handle.get_ee_label();
+        }
+        else
         {
             LOG_WITH_STREAM(
                 fatal,
-                "Enumeration Codes Invalid:  EA_Label: " << ea_label <<
+                "Enumeration Codes Invalid:  EA_Label: " <<
+                    FeatureAttributeMapping::get_attribute_handle(
+                        ea_code).get_label() <<
                     "; EA_Code: " << ea_code << "; EE_Code: " << ee_code);
 
             ea_code = -999;
@@ -78,35 +100,64 @@ namespace FARM
     }
 
     // ------------------------------------------------------------------------
-    void Enumerant::dump(std::ostream &stream) const
+    void Enumerant::write(std::ostream &stream) const
     {
-        CORE::dump_string(stream, ea_label);
+        BinaryWriter
+            writer(stream, 0);
 
-        CORE::Int32
-            int32 = ea_code;
+        write(writer);
+    }
 
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+    // ------------------------------------------------------------------------
+    void Enumerant::read(std::istream &stream)
+    {
+        BinaryReader
+            reader(stream, 0);
 
-        CORE::dump_string(stream, ee_label);
+        read(reader);
+    }
 
-        int32 = ee_code;
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+    // ------------------------------------------------------------------------
+    void Enumerant::dump(std::ostream &stream) const
+    {
+        BinaryWriter
+            writer(stream, 0);
+
+        dump(writer);
+    }
+
+    // ------------------------------------------------------------------------
+    void Enumerant::dump(BinaryWriter &writer) const
+    {
+        writer.write_core_string(ea_label);
+        writer.write(static_cast<CORE::Int32>(ea_code));
+        writer.write_core_string(ee_label);
+        writer.write(static_cast<CORE::Int32>(ee_code));
     }
 
     // ------------------------------------------------------------------------
     void Enumerant::load(std::istream &stream)
+    {
+        BinaryReader
+            reader(stream, 0);
+
+        load(reader);
+    }
+
+    // ------------------------------------------------------------------------
+    void Enumerant::load(BinaryReader &reader)
     {
         CORE::Int32
             int32;
 
-        CORE::load_string(stream, ea_label);
+        reader.read_core_string(ea_label);
 
-        stream.read(reinterpret_cast<char *>(&int32), sizeof(int32));
+        reader.read(int32);
         ea_code = int32;
 
-        CORE::load_string(stream, ee_label);
+        reader.read_core_string(ee_label);
 
-        stream.read(reinterpret_cast<char *>(&int32), sizeof(int32));
+        reader.read(int32);
         ee_code = int32;
     }
 }
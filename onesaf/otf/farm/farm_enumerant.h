@@ -53,6 +53,7 @@
 
 #include <iostream>
 #include <string>
+#include <utility>
 
 #include "core/byte_array.h"
 #include "core/core_string.h"
@@ -91,13 +92,17 @@ namespace FARM
         // Constructs a Enumerant with the given attribute and enumerant labels.
         //
         Enumerant(
-            const std::string new_ea_label,
-            const std::string new_ee_label);
+            const std::string &new_ea_label,
+            const std::string &new_ee_label);
 
         // Copy constructor.
         //
         Enumerant(const Enumerant &rhs);
 
+        // Move constructor.  The labels are moved, not copied.
+        //
+        Enumerant(Enumerant &&rhs) noexcept;
+
         // Sets the enumerant with the attribute and enumerant code given.
         //
         bool set_codes(
@@ -149,6 +154,10 @@ namespace FARM
         //
         Enumerant &operator=(const Enumerant &rhs);
 
+        // Moves the argument enumerant into the enumerant.
+        //
+        Enumerant &operator=(Enumerant &&rhs) noexcept;
+
         // Reads/writes the class to/from the binary byte array as big endian.
         // The byte array pointer is positioned immediately after the last byte
         // read or written.  The byte size of the data fields in the class does
@@ -166,20 +175,28 @@ namespace FARM
         //
         void write(std::ostream &stream) const;
 
+        void write(BinaryWriter &writer) const;
+
         // Reads the enumerant in from an input stream.
         //
         void read(std::istream &stream);
 
+        void read(BinaryReader &reader);
+
         // Writes the contents of this class instance to the given binary
         // stream in a format that can be read by the terrain compiler.
         //
         void dump(std::ostream &stream) const;
 
+        void dump(BinaryWriter &writer) const;
+
         // Reads the contents of this class instance from the given binary
         // stream.
         //
         void load(std::istream &stream);
 
+        void load(BinaryReader &reader);
+
       private:
 
         EnumerantLabel
@@ -218,7 +235,7 @@ namespace FARM
 
         // Sets the enumerant value of the enumerant attribute.
         //
-        void set_value( const Enumerant new_value );
+        void set_value( const Enumerant &new_value );
 
         // Gets the enumerant value of the enumerant attribute.
         //
@@ -256,18 +273,27 @@ namespace FARM
 
     // ------------------------------------------------------------------------
     inline Enumerant::Enumerant(
-        const std::string new_ea_label,
-        const std::string new_ee_label)
+        const std::string &new_ea_label,
+        const std::string &new_ee_label)
     {
         set_labels( new_ea_label, new_ee_label );
     }
 
     // ------------------------------------------------------------------------
     inline Enumerant::Enumerant(const Enumerant &rhs):
-    ea_code(rhs.get_ea_code()),
-    ee_code(rhs.get_ee_code()),
-    ea_label(rhs.get_ea_label()),
-    ee_label(rhs.get_ee_label())
+    ee_label(rhs.ee_label),
+    ea_label(rhs.ea_label),
+    ee_code(rhs.ee_code),
+    ea_code(rhs.ea_code)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    inline Enumerant::Enumerant(Enumerant &&rhs) noexcept:
+    ee_label(std::move(rhs.ee_label)),
+    ea_label(std::move(rhs.ea_label)),
+    ee_code(rhs.ee_code),
+    ea_code(rhs.ea_code)
     {
     }
 
@@ -336,10 +362,23 @@ namespace FARM
         const Enumerant &rhs
     )
     {
-        ea_code  = rhs.get_ea_code();
-        ee_code  = rhs.get_ee_code();
-        ea_label = rhs.get_ea_label();
-        ee_label = rhs.get_ee_label();
+        ea_code  = rhs.ea_code;
+        ee_code  = rhs.ee_code;
+        ea_label = rhs.ea_label;
+        ee_label = rhs.ee_label;
+
+        return *this;
+    }
+
+    // ------------------------------------------------------------------------
+    inline Enumerant &Enumerant::operator=(
+        Enumerant &&rhs
+    ) noexcept
+    {
+        ea_code  = rhs.ea_code;
+        ee_code  = rhs.ee_code;
+        ea_label = std::move(rhs.ea_label);
+        ee_label = std::move(rhs.ee_label);
 
         return *this;
     }
@@ -377,11 +416,10 @@ namespace FARM
 
         if( not status )
         {
-            LOG(
+            LOG_WITH_STREAM(
                 fatal,
-                "Enumeration Codes Invalid From Byte Array:  EA_Code: " +
-                    CORE::to_string(ea_code) + "; EE_Code: " +
-                    CORE::to_string(ee_code));
+                "Enumeration Codes Invalid From Byte Array:  EA_Code: " <<
+                    ea_code_tmp << "; EE_Code: " << ee_code_tmp);
 
             ea_code  = -999;
             ee_code  = -999;
@@ -397,35 +435,23 @@ namespace FARM
     }
 
     // ------------------------------------------------------------------------
-    inline void Enumerant::write(std::ostream &stream) const
+    inline void Enumerant::write(BinaryWriter &writer) const
     {
-        CORE::Int32
-            ea_code_tmp = ea_code,
-            ee_code_tmp = ee_code;
-
-        stream.write(
-            reinterpret_cast<char *>(&ea_code_tmp),
-            sizeof(ea_code_tmp));
+        const CORE::Int32
+            codes[] = { ea_code, ee_code };
 
-        stream.write(
-            reinterpret_cast<char *>(&ee_code_tmp),
-            sizeof(ee_code_tmp));
+        writer.write_array(codes, 2);
     }
 
     // ------------------------------------------------------------------------
-    inline void Enumerant::read(std::istream &stream)
+    inline void Enumerant::read(BinaryReader &reader)
     {
         CORE::Int32
-            ea_code_tmp,
-            ee_code_tmp;
-
-        stream.read(
-            reinterpret_cast<char *>(&ea_code_tmp), sizeof(ea_code_tmp));
+            codes[2];
 
-        stream.read(
-            reinterpret_cast<char *>(&ee_code_tmp), sizeof(ee_code_tmp));
+        reader.read_array(codes, 2);
 
-        set_codes(ea_code_tmp, ee_code_tmp);
+        set_codes(codes[0], codes[1]);
     }
 
     // ------------------------------------------------------------------------
@@ -451,14 +477,13 @@ namespace FARM
     // ------------------------------------------------------------------------
     inline EnumerantAttribute::EnumerantAttribute(
         const EnumerantAttribute &rhs
-    ) : Attribute(rhs.get_label())
+    ) : Attribute(rhs), value(rhs.get_value())
     {
-        set_value( rhs.get_value() );
         set_data_type( enumeration );
     }
 
     // ------------------------------------------------------------------------
-    inline void EnumerantAttribute::set_value( const Enumerant new_value )
+    inline void EnumerantAttribute::set_value( const Enumerant &new_value )
     {
         value = new_value;
     }
@@ -16,11 +16,27 @@
  * this document shall be referred to U.S. Army PEO STRI.
  *
  */
+#include <type_traits>
+
 #include "core/core_string.h"
 #include "core/sys_types.h"
 #include "farm.h"
 #include "farm_feature.h"
 
+namespace
+{
+    static_assert(
+        sizeof(FARM::FeatureTraits) == 16,
+        "A FeatureTraits must stay 16 bytes, four to a cache line.");
+
+    // The FARM tables are vectors of features, which only move their
+    // elements when they grow if the moves cannot throw.
+    //
+    static_assert(
+        std::is_nothrow_move_constructible<FARM::Feature>::value and
+            std::is_nothrow_move_assignable<FARM::Feature>::value,
+        "A Feature must move without throwing.");
+}
 
 namespace FARM
 {
@@ -302,21 +318,16 @@ namespace FARM
 {
     bool Feature::set_category( const FARM::FeatureCategory &new_category )
     {
-        FARM::Feature
-            new_feature;
-        bool
-            status = true;
-
-        status = FARM::FeatureAttributeMapping::get_feature(
-            new_category,
-            new_feature );
+        const FARM::Feature
+            *new_feature =
+                FARM::FeatureAttributeMapping::get_feature( new_category );
 
-        if ( status )
+        if ( new_feature )
         {
-            *this = new_feature;
+            *this = *new_feature;
         }
 
-        return status;
+        return new_feature != 0;
     }
 
     // ------------------------------------------------------------------------
@@ -325,6 +336,31 @@ namespace FARM
         const FARM::FeatureGeometry &new_geometry,
         const FARM::FeatureCategory &new_category )
     {
+        // Copy the FARM's feature of the code and geometry, if it has one,
+        // rather than looking up its label only to replace it.
+        //
+        if (new_category == -999)
+        {
+            FARM::FeatureCategory
+                code_category;
+            const FARM::Feature
+                *new_feature = 0;
+
+            if (FARM::FeatureAttributeMapping::get_feature_category_from_code(
+                    new_code, new_geometry, code_category))
+            {
+                new_feature =
+                    FARM::FeatureAttributeMapping::get_feature(code_category);
+            }
+
+            if (new_feature)
+            {
+                *this = *new_feature;
+
+                return true;
+            }
+        }
+
         code = new_code;
         geometry = new_geometry;
         category = new_category;
@@ -347,24 +383,13 @@ namespace FARM
 
         if (status and category == -999)
         {
-            FARM::Feature
-                new_feature;
+            status = false;
 
-            status = FARM::FeatureAttributeMapping::get_feature(
-                label, geometry, new_feature);
-
-            if (status)
-            {
-                *this = new_feature;
-            }
-            else
-            {
-                LOG(
-                    medium,
-                    "Could not get FARM::Feature from FeatureLabel: " +
-                        label + "; and Geometry: " +
-                        CORE::to_string( geometry ) );
-            }
+            LOG(
+                medium,
+                "Could not get FARM::Feature from FeatureLabel: " +
+                    label + "; and Geometry: " +
+                    CORE::to_string( geometry ) );
         }
 
         return status;
@@ -376,13 +401,6 @@ namespace FARM
         const FARM::FeatureGeometry &new_geometry,
         const FARM::FeatureCategory &new_category )
     {
-        label = new_label;
-        geometry = new_geometry;
-        category = new_category;
-        usage_bitmask = static_cast<FARM::UsageBitmask>( 0 );
-        precedence = 0;
-        attributes_overlay_size = 0;
-
         FARM::FeatureCode
             new_code;
         bool
@@ -396,25 +414,28 @@ namespace FARM
         }
         else
         {
-            LOG(info, "Feature Label Invalid:  EC_Label: " + label);
+            LOG(info, "Feature Label Invalid:  EC_Label: " + new_label);
 
             category = -999;
             label = "";
             code = -999;
             geometry = FARM::null;
+            usage_bitmask = static_cast<FARM::UsageBitmask>( 0 );
+            precedence = 0;
+            attributes_overlay_size = 0;
         }
 
         if (status and category == -999)
         {
-            FARM::Feature
-                new_feature;
+            const FARM::Feature
+                *new_feature = FARM::FeatureAttributeMapping::get_feature(
+                    label, geometry);
 
-            status = FARM::FeatureAttributeMapping::get_feature(
-                label, geometry, new_feature);
+            status = new_feature != 0;
 
             if (status)
             {
-                *this = new_feature;
+                *this = *new_feature;
             }
             else
             {
@@ -463,7 +484,7 @@ namespace FARM
     }
 
     // ------------------------------------------------------------------------
-    FARM::FeatureLabel Feature::get_label( void ) const
+    const FARM::FeatureLabel &Feature::get_label( void ) const
     {
         return label;
     }
@@ -524,136 +545,138 @@ namespace FARM
     Feature& Feature::operator=(
         const Feature &rhs )
     {
-        category = rhs.get_category();
-        code = rhs.get_code();
-        label = rhs.get_label();
-        geometry = rhs.get_geometry();
-        usage_bitmask = rhs.get_usage_bitmask();
-        precedence = rhs.get_precedence();
-        attributes_overlay_size = rhs.get_attributes_overlay_size();
+        category = rhs.category;
+        code = rhs.code;
+        label = rhs.label;
+        geometry = rhs.geometry;
+        usage_bitmask = rhs.usage_bitmask;
+        precedence = rhs.precedence;
+        attributes_overlay_size = rhs.attributes_overlay_size;
 
         return *this;
     }
 
     // ------------------------------------------------------------------------
-    void Feature::write(std::ostream &stream) const
+    Feature& Feature::operator=(
+        Feature &&rhs ) noexcept
     {
-        CORE::Int32
-            tmp_category = category,
-            tmp_code = code,
-            tmp_geometry = static_cast<CORE::Int32>(geometry),
-            tmp_bitmask = static_cast<CORE::Int32>(usage_bitmask),
-            tmp_precedence = precedence,
-            tmp_overlay_size = attributes_overlay_size;
-
-        stream.write(
-            reinterpret_cast<char *>(&tmp_category), sizeof(tmp_category));
-
-        stream.write(reinterpret_cast<char *>(&tmp_code), sizeof(tmp_code));
+        category = rhs.category;
+        code = rhs.code;
+        label = std::move(rhs.label);
+        geometry = rhs.geometry;
+        usage_bitmask = rhs.usage_bitmask;
+        precedence = rhs.precedence;
+        attributes_overlay_size = rhs.attributes_overlay_size;
 
-        stream.write(
-            reinterpret_cast<char *>(&tmp_geometry), sizeof(tmp_geometry));
+        return *this;
+    }
 
-        stream.write(
-            reinterpret_cast<char *>(&tmp_bitmask), sizeof(tmp_bitmask));
+    // ------------------------------------------------------------------------
+    void Feature::write(std::ostream &stream) const
+    {
+        BinaryWriter
+            writer(stream, 0);
 
-        stream.write(
-            reinterpret_cast<char *>(&tmp_precedence), sizeof(tmp_precedence));
+        write(writer);
+    }
 
-        stream.write(
-            reinterpret_cast<char *>(&tmp_overlay_size),
-            sizeof(tmp_overlay_size));
+    // ------------------------------------------------------------------------
+    void Feature::write(BinaryWriter &writer) const
+    {
+        const CORE::Int32
+            values[] =
+            {
+                category,
+                code,
+                static_cast<CORE::Int32>(geometry),
+                static_cast<CORE::Int32>(usage_bitmask),
+                precedence,
+                attributes_overlay_size
+            };
+
+        writer.write_array(values, sizeof(values) / sizeof(values[0]));
     }
 
     // ------------------------------------------------------------------------
     void Feature::read(std::istream &stream)
     {
-        int
-            tmp_category,
-            tmp_code,
-            tmp_geometry,
-            tmp_bitmask,
-            tmp_precedence,
-            tmp_overlay_size;
-
-        stream.read(
-            reinterpret_cast<char *>(&tmp_category), sizeof(tmp_category));
-
-        stream.read(reinterpret_cast<char *>(&tmp_code), sizeof(tmp_code));
+        BinaryReader
+            reader(stream, 0);
 
-        stream.read(
-            reinterpret_cast<char *>(&tmp_geometry), sizeof(tmp_geometry));
-
-        stream.read(
-            reinterpret_cast<char *>(&tmp_bitmask), sizeof(tmp_bitmask));
+        read(reader);
+    }
 
-        stream.read(
-            reinterpret_cast<char *>(&tmp_precedence), sizeof(tmp_precedence));
+    // ------------------------------------------------------------------------
+    void Feature::read(BinaryReader &reader)
+    {
+        CORE::Int32
+            values[6];
 
-        stream.read(
-            reinterpret_cast<char *>(&tmp_overlay_size),
-            sizeof(tmp_overlay_size));
+        reader.read_array(values, sizeof(values) / sizeof(values[0]));
 
         set_code_and_geometry(
-            tmp_code,
-            static_cast<FARM::FeatureGeometry>( tmp_geometry ),
-            tmp_category );
-        usage_bitmask = static_cast<FARM::UsageBitmask>( tmp_bitmask ),
-        precedence = tmp_precedence,
-        attributes_overlay_size = tmp_overlay_size;
+            values[1],
+            static_cast<FARM::FeatureGeometry>(values[2]),
+            values[0]);
+        usage_bitmask = static_cast<FARM::UsageBitmask>(values[3]);
+        precedence = values[4];
+        attributes_overlay_size = values[5];
     }
 
     // ------------------------------------------------------------------------
     void Feature::dump(std::ostream &stream) const
     {
-        CORE::Int32
-            int32 = category;
-
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
-
-        CORE::dump_string(stream, label);
-
-        int32 = code;
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+        BinaryWriter
+            writer(stream, 0);
 
-        int32 = geometry;
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+        dump(writer);
+    }
 
-        int32 = usage_bitmask;
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+    // ------------------------------------------------------------------------
+    void Feature::dump(BinaryWriter &writer) const
+    {
+        const CORE::Int32
+            values[] =
+            {
+                code,
+                geometry,
+                usage_bitmask,
+                precedence,
+                attributes_overlay_size
+            };
+
+        writer.write(static_cast<CORE::Int32>(category));
+        writer.write_core_string(label);
+        writer.write_array(values, sizeof(values) / sizeof(values[0]));
+    }
 
-        int32 = precedence;
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+    // ------------------------------------------------------------------------
+    void Feature::load(std::istream &stream)
+    {
+        BinaryReader
+            reader(stream, 0);
 
-        int32 = attributes_overlay_size;
-        stream.write(reinterpret_cast<char *>(&int32), sizeof(int32));
+        load(reader);
     }
 
     // ------------------------------------------------------------------------
-    void Feature::load(std::istream &stream)
+    void Feature::load(BinaryReader &reader)
     {
         CORE::Int32
-            int32;
+            int32,
+            values[5];
 
-        stream.read(reinterpret_cast<char *>(&int32), sizeof(int32));
+        reader.read(int32);
         category = int32;
 
-        CORE::load_string(stream, label);
-
-        stream.read(reinterpret_cast<char *>(&int32), sizeof(int32));
-        code = int32;
-
-        stream.read(reinterpret_cast<char *>(&int32), sizeof(int32));
-        geometry = static_cast<FeatureGeometry>(int32);
-
-        stream.read(reinterpret_cast<char *>(&int32), sizeof(int32));
-        usage_bitmask = static_cast<UsageBitmask>(int32);
-
-        stream.read(reinterpret_cast<char *>(&int32), sizeof(int32));
-        precedence = int32;
+        reader.read_core_string(label);
 
-        stream.read(reinterpret_cast<char *>(&int32), sizeof(int32));
-        attributes_overlay_size = int32;
+        reader.read_array(values, sizeof(values) / sizeof(values[0]));
+        code = values[0];
+        geometry = static_cast<FeatureGeometry>(values[1]);
+        usage_bitmask = static_cast<UsageBitmask>(values[2]);
+        precedence = values[3];
+        attributes_overlay_size = values[4];
     }
 
     // ------------------------------------------------------------------------
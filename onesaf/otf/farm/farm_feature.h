@@ -21,7 +21,9 @@
 #include <iostream>
 #include <list>
 #include <string>
+#include <utility>
 
+#include "core/sys_types.h"
 #include "farm_attribute.h"
 
 namespace FARM
@@ -151,6 +153,10 @@ namespace FARM
         //
         Feature(const Feature &rhs);
 
+        // Move constructor.  The label is moved, not copied.
+        //
+        Feature(Feature &&rhs) noexcept;
+
         // Sets the feature category of the feature and re-computes the code
         // and geometry from the FARM with the new category.
         //
@@ -199,7 +205,7 @@ namespace FARM
 
         // Gets the Feature Label.
         //
-        FARM::FeatureLabel get_label( void ) const;
+        const FARM::FeatureLabel &get_label( void ) const;
 
         // Gets the Feature geometry.
         //
@@ -234,24 +240,36 @@ namespace FARM
         //
         Feature &operator=( const Feature &rhs );
 
+        // Moves the argument feature into the feature.
+        //
+        Feature &operator=( Feature &&rhs ) noexcept;
+
         // Writes the feature out to an output stream.
         //
         void write(std::ostream &stream) const;
 
+        void write(BinaryWriter &writer) const;
+
         // Reads the feature in from an input stream.
         //
         void read(std::istream &stream);
 
+        void read(BinaryReader &reader);
+
         // Writes the contents of this class instance to the given binary stream
         // in a format that can be read by the terrain compiler.
         //
         void dump(std::ostream &stream) const;
 
+        void dump(BinaryWriter &writer) const;
+
         // Reads the contents of this class instance from the given binary
         // stream.
         //
         void load(std::istream &stream);
 
+        void load(BinaryReader &reader);
+
       private:
 
         FARM::FeatureCategory
@@ -278,6 +296,56 @@ namespace FARM
         const Feature &feature
     );
 
+    // ------------------------------------------------------------------------
+    // The numeric fields of a feature that are read every tick, packed into
+    // 16 bytes so that four share a cache line.  FeatureAttributeMapping
+    // keeps the traits of every feature category in one array on a cache
+    // line boundary; see FeatureAttributeMapping::get_feature_traits().
+    // ------------------------------------------------------------------------
+    class FeatureTraits
+    {
+      public:
+
+        // Constructs the traits of a category that has no feature, which
+        // are not valid.
+        //
+        FeatureTraits(void);
+
+        // Constructs the traits of the feature, which are not valid if the
+        // feature is not.
+        //
+        explicit FeatureTraits(const Feature &feature);
+
+        FARM::FeatureGeometry get_geometry(void) const;
+
+        FARM::UsageBitmask get_usage_bitmask(void) const;
+
+        FARM::FeaturePrecedence get_precedence(void) const;
+
+        int get_attributes_overlay_size(void) const;
+
+        // Return:  Does the feature have any of the usages?
+        //
+        bool has_usage(const FARM::UsageBitmask &usages) const;
+
+        // Return:  Are these the traits of a valid feature?
+        //
+        bool valid(void) const;
+
+      private:
+
+        CORE::UInt32
+            usage_bitmask;
+        CORE::Int32
+            attributes_overlay_size;
+        CORE::Int32
+            precedence;
+        CORE::UInt8
+            geometry;           // The FeatureGeometry, null if not valid
+        CORE::UInt8
+            reserved[3];
+    };
+
     // ------------------------------------------------------------------------
     inline Feature::Feature()
     {
@@ -315,15 +383,85 @@ namespace FARM
     }
 
     // ------------------------------------------------------------------------
-    inline Feature::Feature(const Feature &rhs)
+    inline Feature::Feature(const Feature &rhs) :
+        category(rhs.category),
+        label(rhs.label),
+        code(rhs.code),
+        geometry(rhs.geometry),
+        usage_bitmask(rhs.usage_bitmask),
+        precedence(rhs.precedence),
+        attributes_overlay_size(rhs.attributes_overlay_size)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    inline Feature::Feature(Feature &&rhs) noexcept :
+        category(rhs.category),
+        label(std::move(rhs.label)),
+        code(rhs.code),
+        geometry(rhs.geometry),
+        usage_bitmask(rhs.usage_bitmask),
+        precedence(rhs.precedence),
+        attributes_overlay_size(rhs.attributes_overlay_size)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    inline FeatureTraits::FeatureTraits(void) :
+        usage_bitmask(0),
+        attributes_overlay_size(0),
+        precedence(0),
+        geometry(FARM::null)
+    {
+        reserved[0] = reserved[1] = reserved[2] = 0;
+    }
+
+    // ------------------------------------------------------------------------
+    inline FeatureTraits::FeatureTraits(const Feature &feature) :
+        usage_bitmask(feature.get_usage_bitmask()),
+        attributes_overlay_size(feature.get_attributes_overlay_size()),
+        precedence(feature.get_precedence()),
+        geometry(feature.valid() ? feature.get_geometry() : FARM::null)
+    {
+        reserved[0] = reserved[1] = reserved[2] = 0;
+    }
+
+    // ------------------------------------------------------------------------
+    inline FARM::FeatureGeometry FeatureTraits::get_geometry(void) const
+    {
+        return static_cast<FARM::FeatureGeometry>(geometry);
+    }
+
+    // ------------------------------------------------------------------------
+    inline FARM::UsageBitmask FeatureTraits::get_usage_bitmask(void) const
+    {
+        return static_cast<FARM::UsageBitmask>(usage_bitmask);
+    }
+
+    // ------------------------------------------------------------------------
+    inline FARM::FeaturePrecedence FeatureTraits::get_precedence(void) const
+    {
+        return precedence;
+    }
+
+    // ------------------------------------------------------------------------
+    inline int FeatureTraits::get_attributes_overlay_size(void) const
+    {
+        return attributes_overlay_size;
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool FeatureTraits::has_usage(
+        const FARM::UsageBitmask &usages
+    ) const
+    {
+        return (usage_bitmask & usages) != 0;
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool FeatureTraits::valid(void) const
     {
-        category = rhs.get_category();
-        code = rhs.get_code();
-        label = rhs.get_label();
-        geometry = rhs.get_geometry();
-        usage_bitmask = rhs.get_usage_bitmask();
-        precedence = rhs.get_precedence();
-        attributes_overlay_size = rhs.get_attributes_overlay_size();
+        return geometry != FARM::null;
     }
 }
 #endif
@@ -0,0 +1,329 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include "farm_fingerprint.h"
+
+namespace
+{
+    const CORE::UInt64
+        c1 = 0x87c37b91114253d5ULL,
+        c2 = 0x4cf5ad432745937fULL;
+
+    // ------------------------------------------------------------------------
+    inline CORE::UInt64 rotate_left(CORE::UInt64 value, int bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The 8 bytes as a little endian integer.
+    //
+    inline CORE::UInt64 get_word(const unsigned char *bytes)
+    {
+        CORE::UInt64
+            word = 0;
+
+        for (int i = 7; i >= 0; --i)
+        {
+            word = (word << 8) | bytes[i];
+        }
+
+        return word;
+    }
+
+    // ------------------------------------------------------------------------
+    inline CORE::UInt64 mix_first(CORE::UInt64 k1)
+    {
+        k1 *= c1;
+        k1 = rotate_left(k1, 31);
+        k1 *= c2;
+
+        return k1;
+    }
+
+    // ------------------------------------------------------------------------
+    inline CORE::UInt64 mix_second(CORE::UInt64 k2)
+    {
+        k2 *= c2;
+        k2 = rotate_left(k2, 33);
+        k2 *= c1;
+
+        return k2;
+    }
+
+    // ------------------------------------------------------------------------
+    inline CORE::UInt64 finalize(CORE::UInt64 k)
+    {
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdULL;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53ULL;
+        k ^= k >> 33;
+
+        return k;
+    }
+}
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    Fingerprint::Fingerprint(void) :
+        high(0),
+        low(0)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    bool Fingerprint::operator==(const Fingerprint &rhs) const
+    {
+        return high == rhs.high and low == rhs.low;
+    }
+
+    // ------------------------------------------------------------------------
+    bool Fingerprint::operator!=(const Fingerprint &rhs) const
+    {
+        return not (*this == rhs);
+    }
+
+    // ------------------------------------------------------------------------
+    std::string Fingerprint::to_string(void) const
+    {
+        std::ostringstream
+            text;
+
+        text << std::hex << std::setfill('0') << std::setw(16) << high <<
+            std::setw(16) << low;
+
+        return text.str();
+    }
+
+    // ------------------------------------------------------------------------
+    void SchemaFingerprint::clear(void)
+    {
+        fingerprint = Fingerprint();
+        attributes = Fingerprint();
+        features.clear();
+    }
+
+    // ------------------------------------------------------------------------
+    bool SchemaFingerprint::get_differences(
+        const SchemaFingerprint &other,
+        std::vector<FeatureCategory> &categories
+    ) const
+    {
+        std::vector<FeatureFingerprint>::size_type
+            i = 0,
+            j = 0;
+
+        categories.clear();
+
+        // The features are in the order of their categories.
+        //
+        while (i < features.size() or j < other.features.size())
+        {
+            if (j == other.features.size() or
+                (i < features.size() and
+                 features[i].category < other.features[j].category))
+            {
+                categories.push_back(features[i++].category);
+            }
+            else if (i == features.size() or
+                     other.features[j].category < features[i].category)
+            {
+                categories.push_back(other.features[j++].category);
+            }
+            else
+            {
+                if (features[i].fingerprint != other.features[j].fingerprint)
+                {
+                    categories.push_back(features[i].category);
+                }
+
+                ++i;
+                ++j;
+            }
+        }
+
+        return fingerprint == other.fingerprint;
+    }
+
+    // ------------------------------------------------------------------------
+    void SchemaFingerprint::display(std::ostream &stream) const
+    {
+        std::ios::fmtflags
+            flags = stream.flags();
+
+        stream << "FARM schema fingerprint:  " << fingerprint.to_string() <<
+            std::endl << "attribute fingerprint:    " <<
+            attributes.to_string() << std::endl;
+
+        for (std::vector<FeatureFingerprint>::size_type i = 0;
+             i < features.size(); ++i)
+        {
+            stream << std::setw(8) << features[i].category << "  " <<
+                features[i].fingerprint.to_string() << std::endl;
+        }
+
+        stream.flags(flags);
+    }
+
+    // ------------------------------------------------------------------------
+    FingerprintHasher::FingerprintHasher(void) :
+        h1(0),
+        h2(0),
+        length(0),
+        block_size(0)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    void FingerprintHasher::add(CORE::Int64 value)
+    {
+        CORE::UInt64
+            bits = static_cast<CORE::UInt64>(value);
+        unsigned char
+            bytes[8];
+
+        for (int i = 0; i < 8; ++i)
+        {
+            bytes[i] = static_cast<unsigned char>(bits >> (8 * i));
+        }
+
+        add_bytes(bytes, sizeof(bytes));
+    }
+
+    // ------------------------------------------------------------------------
+    void FingerprintHasher::add_double(CORE::Float64 value)
+    {
+        CORE::Int64
+            bits;
+
+        // Zero has one fingerprint whatever its sign.
+        //
+        if (value == 0.0)
+        {
+            value = 0.0;
+        }
+
+        std::memcpy(&bits, &value, sizeof(bits));
+        add(bits);
+    }
+
+    // ------------------------------------------------------------------------
+    void FingerprintHasher::add_string(const std::string &string)
+    {
+        add(static_cast<CORE::Int64>(string.size()));
+        add_bytes(
+            reinterpret_cast<const unsigned char *>(string.data()),
+            string.size());
+    }
+
+    // ------------------------------------------------------------------------
+    void FingerprintHasher::add_fingerprint(const Fingerprint &fingerprint)
+    {
+        add(static_cast<CORE::Int64>(fingerprint.high));
+        add(static_cast<CORE::Int64>(fingerprint.low));
+    }
+
+    // ------------------------------------------------------------------------
+    Fingerprint FingerprintHasher::get_fingerprint(void) const
+    {
+        CORE::UInt64
+            k1 = 0,
+            k2 = 0,
+            f1 = h1,
+            f2 = h2;
+        Fingerprint
+            fingerprint;
+
+        // Mix in the bytes of the partial block.
+        //
+        for (std::size_t i = block_size; i > 8; --i)
+        {
+            k2 ^= static_cast<CORE::UInt64>(block[i - 1]) << (8 * (i - 9));
+        }
+
+        for (std::size_t i = std::min<std::size_t>(block_size, 8); i > 0; --i)
+        {
+            k1 ^= static_cast<CORE::UInt64>(block[i - 1]) << (8 * (i - 1));
+        }
+
+        if (block_size > 8)
+        {
+            f2 ^= mix_second(k2);
+        }
+
+        if (block_size > 0)
+        {
+            f1 ^= mix_first(k1);
+        }
+
+        f1 ^= length;
+        f2 ^= length;
+        f1 += f2;
+        f2 += f1;
+        f1 = finalize(f1);
+        f2 = finalize(f2);
+        f1 += f2;
+        f2 += f1;
+
+        fingerprint.high = f1;
+        fingerprint.low = f2;
+
+        return fingerprint;
+    }
+
+    // ------------------------------------------------------------------------
+    void FingerprintHasher::add_bytes(
+        const unsigned char *bytes,
+        std::size_t size)
+    {
+        length += size;
+
+        while (size > 0)
+        {
+            std::size_t
+                count = std::min(size, sizeof(block) - block_size);
+
+            std::memcpy(block + block_size, bytes, count);
+            block_size += count;
+            bytes += count;
+            size -= count;
+
+            if (block_size == sizeof(block))
+            {
+                h1 ^= mix_first(get_word(block));
+                h1 = rotate_left(h1, 27);
+                h1 += h2;
+                h1 = h1 * 5 + 0x52dce729;
+
+                h2 ^= mix_second(get_word(block + 8));
+                h2 = rotate_left(h2, 31);
+                h2 += h1;
+                h2 = h2 * 5 + 0x38495ab5;
+
+                block_size = 0;
+            }
+        }
+    }
+}
@@ -0,0 +1,143 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef FARM_FINGERPRINT_H
+#define FARM_FINGERPRINT_H
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "core/sys_types.h"
+#include "farm_feature.h"
+
+namespace FARM
+{
+    // A 128-bit hash of part of the FARM schema.
+    //
+    struct Fingerprint
+    {
+        CORE::UInt64
+            high,
+            low;
+
+        Fingerprint(void);
+
+        bool operator==(const Fingerprint &rhs) const;
+
+        bool operator!=(const Fingerprint &rhs) const;
+
+        // Return:  The fingerprint as 32 hexadecimal digits.
+        //
+        std::string to_string(void) const;
+    };
+
+    // The fingerprint of the FARM table row and feature of one feature
+    // category.
+    //
+    struct FeatureFingerprint
+    {
+        FeatureCategory
+            category;
+        Fingerprint
+            fingerprint;
+    };
+
+    // ------------------------------------------------------------------------
+    // The fingerprint of the whole FARM schema and of each feature category,
+    // as returned by FeatureAttributeMapping::get_fingerprint().  Two
+    // processes with the same schema fingerprint have the same feature
+    // categories, attribute codes, data types, offsets, and enumerant
+    // domains, so they can exchange category codes and attribute overlays.
+    // When the schema fingerprints differ, the feature fingerprints tell
+    // which categories differ.
+    //
+    // Values are hashed in a fixed byte order, so the fingerprints of the
+    // same schema are the same on every platform.
+    // ------------------------------------------------------------------------
+    struct SchemaFingerprint
+    {
+        Fingerprint
+            fingerprint,
+            attributes;     // The attribute and enumerant definitions
+        std::vector<FeatureFingerprint>
+            features;
+
+        void clear(void);
+
+        // Returns the feature categories whose fingerprints differ from
+        // those of the other schema, including the categories only one of
+        // the schemas has.
+        //
+        // Return:  Are the schemas the same?
+        //
+        bool get_differences(
+            const SchemaFingerprint &other,
+            std::vector<FeatureCategory> &categories
+        ) const;
+
+        // Writes the schema fingerprint and the fingerprint of each feature
+        // category.
+        //
+        void display(std::ostream &stream) const;
+    };
+
+    // ------------------------------------------------------------------------
+    // Computes a fingerprint a value at a time with 128-bit MurmurHash3.
+    // Used by the FARM to fill in a SchemaFingerprint.
+    // ------------------------------------------------------------------------
+    class FingerprintHasher
+    {
+      public:
+
+        FingerprintHasher(void);
+
+        // Adds an integer as 8 little endian bytes.
+        //
+        void add(CORE::Int64 value);
+
+        // Adds the bits of a double.
+        //
+        void add_double(CORE::Float64 value);
+
+        // Adds the length and the characters of a string.
+        //
+        void add_string(const std::string &string);
+
+        void add_fingerprint(const Fingerprint &fingerprint);
+
+        // Return:  The fingerprint of the values added so far.
+        //
+        Fingerprint get_fingerprint(void) const;
+
+      private:
+
+        void add_bytes(const unsigned char *bytes, std::size_t size);
+
+        CORE::UInt64
+            h1,
+            h2,
+            length;
+        unsigned char
+            block[16];
+        std::size_t
+            block_size;
+    };
+}
+
+#endif
@@ -0,0 +1,1420 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+#include "core/logger.h"
+#include "farm_byte_swap.h"
+#include "farm_flat_image.h"
+
+namespace
+{
+    const char
+        image_magic[8] = {'F', 'A', 'R', 'M', 'F', 'L', 'A', 'T'};
+
+    // Format 2 added the code maps of trimmed images.
+    //
+    const CORE::UInt32
+        image_format = 2,
+        byte_order_mark = 0x01020304;
+
+    // Return:  The FNV-1a hash of the label.
+    //
+    CORE::UInt32 hash_label(const char *label, std::size_t size)
+    {
+        CORE::UInt32
+            hash = 2166136261u;
+
+        for (std::size_t index = 0; index < size; ++index)
+        {
+            hash ^= static_cast<unsigned char>(label[index]);
+            hash *= 16777619u;
+        }
+
+        return hash;
+    }
+
+    // Return:  The hash of a feature label and geometry.
+    //
+    CORE::UInt32 hash_feature(
+        const char *label,
+        std::size_t size,
+        CORE::Int32 geometry
+    )
+    {
+        return
+            hash_label(label, size) ^
+            static_cast<CORE::UInt32>(geometry) * 0x9e3779b1u;
+    }
+
+    // Return:  The smallest power of two that is at least twice the count,
+    // so that an index is never more than half full.
+    //
+    CORE::UInt32 get_index_size(std::size_t count)
+    {
+        CORE::UInt32
+            size = 2;
+
+        while (size < count * 2)
+        {
+            size *= 2;
+        }
+
+        return size;
+    }
+
+    // Return:  The offset rounded up to an eight byte boundary.
+    //
+    CORE::UInt64 align(CORE::UInt64 offset)
+    {
+        return (offset + 7) & ~static_cast<CORE::UInt64>(7);
+    }
+
+    // Adds the strings of an image once each.
+    //
+    class StringTable
+    {
+      public:
+
+        // Return:  The offset of the string in the table.
+        //
+        CORE::UInt32 add(const std::string &value)
+        {
+            std::map<std::string, CORE::UInt32>::const_iterator
+                found = offsets.find(value);
+
+            if (found != offsets.end())
+            {
+                return found->second;
+            }
+
+            CORE::UInt32
+                offset = data.size();
+
+            data.insert(data.end(), value.begin(), value.end());
+            data.push_back('\0');
+            offsets[value] = offset;
+
+            return offset;
+        }
+
+        std::vector<char>
+            data;
+
+      private:
+
+        std::map<std::string, CORE::UInt32>
+            offsets;
+    };
+
+    // Orders cells by attribute code.
+    //
+    bool cell_code_less(
+        const FARM::FlatCell &cell,
+        CORE::Int32 attribute_code
+    )
+    {
+        return cell.attribute_code < attribute_code;
+    }
+
+    bool attribute_code_less(
+        const FARM::OverlayAttributeLayout &lhs,
+        const FARM::OverlayAttributeLayout &rhs
+    )
+    {
+        return lhs.code < rhs.code;
+    }
+
+    // Orders enumerants by code.
+    //
+    bool enumerant_code_less(
+        const FARM::FlatEnumerant &enumerant,
+        CORE::Int32 code
+    )
+    {
+        return enumerant.code < code;
+    }
+
+    // Return:  Is the section of count records of the size within the
+    // image, on an eight byte boundary?
+    //
+    bool valid_section(
+        CORE::UInt64 offset,
+        CORE::UInt64 count,
+        CORE::UInt64 record_size,
+        CORE::UInt64 image_bytes
+    )
+    {
+        return
+            offset % 8 == 0 and
+            offset <= image_bytes and
+            count <= (image_bytes - offset) / record_size;
+    }
+
+    // Copies a code map into its section of the image, if it has one.
+    //
+    void copy_map(
+        const std::vector<CORE::Int32> &map,
+        CORE::UInt64 offset,
+        std::vector<char> &image
+    )
+    {
+        if (not map.empty())
+        {
+            std::memcpy(
+                &image[offset], &map[0], sizeof(CORE::Int32) * map.size());
+        }
+    }
+
+    // Return:  Is the size of the index a power of two?
+    //
+    bool valid_index_size(CORE::UInt32 size)
+    {
+        return size != 0 and (size & (size - 1)) == 0;
+    }
+}
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    FlatImageBuilder::FlatImageBuilder(void) :
+        full_feature_count(0),
+        full_attribute_count(0)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    void FlatImageBuilder::add_attribute(
+        const AttributeCode &code,
+        const Attribute &attribute,
+        const std::vector<std::pair<EnumerantCode, EnumerantLabel> >
+            &enumerants
+    )
+    {
+        ASSERT(
+            code >= 0,
+            fatal,
+            "Added an attribute without a code to a flat FARM image.");
+
+        if (attributes.size() <= static_cast<std::size_t>(code))
+        {
+            AttributeEntry
+                empty;
+
+            std::memset(&empty.attribute, 0, sizeof(empty.attribute));
+            empty.attribute.label = flat_no_string;
+
+            attributes.resize(code + 1, empty);
+        }
+
+        AttributeEntry
+            &entry = attributes[code];
+
+        entry.label = attribute.get_label();
+        entry.attribute.label = 0;
+        entry.attribute.data_type = attribute.get_data_type();
+        entry.attribute.units = attribute.get_units();
+        entry.attribute.editable = attribute.get_editability();
+        entry.enumerants = enumerants;
+
+        std::sort(entry.enumerants.begin(), entry.enumerants.end());
+    }
+
+    // ------------------------------------------------------------------------
+    void FlatImageBuilder::add_feature(
+        const Feature &feature,
+        const OverlayCategoryLayout &layout
+    )
+    {
+        ASSERT(
+            layout.category >= 0,
+            fatal,
+            "Added a feature without a category to a flat FARM image.");
+
+        if (features.size() <= static_cast<std::size_t>(layout.category))
+        {
+            FeatureEntry
+                empty;
+
+            std::memset(&empty.feature, 0, sizeof(empty.feature));
+            empty.feature.label = flat_no_string;
+
+            features.resize(layout.category + 1, empty);
+        }
+
+        FeatureEntry
+            &entry = features[layout.category];
+
+        entry.label = feature.get_label();
+        entry.feature.label = 0;
+        entry.feature.code = feature.get_code();
+        entry.feature.geometry = feature.get_geometry();
+        entry.feature.usage_bitmask = feature.get_usage_bitmask();
+        entry.feature.precedence = feature.get_precedence();
+        entry.feature.overlay_size = layout.overlay_size;
+        entry.cells = layout.attributes;
+
+        std::sort(entry.cells.begin(), entry.cells.end(), attribute_code_less);
+    }
+
+    // ------------------------------------------------------------------------
+    void FlatImageBuilder::set_fingerprint(const Fingerprint &new_fingerprint)
+    {
+        fingerprint = new_fingerprint;
+    }
+
+    // ------------------------------------------------------------------------
+    void FlatImageBuilder::set_code_maps(
+        const std::vector<FeatureCategory> &new_feature_map,
+        const std::vector<AttributeCategory> &new_attribute_map,
+        int new_full_feature_count,
+        int new_full_attribute_count
+    )
+    {
+        feature_map = new_feature_map;
+        attribute_map = new_attribute_map;
+        full_feature_count = new_full_feature_count;
+        full_attribute_count = new_full_attribute_count;
+    }
+
+    // ------------------------------------------------------------------------
+    void FlatImageBuilder::build(std::vector<char> &image) const
+    {
+        FlatImageHeader
+            header;
+        StringTable
+            strings;
+        std::vector<FlatFeature>
+            flat_features(features.size());
+        std::vector<FlatAttribute>
+            flat_attributes(attributes.size());
+        std::vector<FlatCell>
+            flat_cells;
+        std::vector<FlatEnumerant>
+            flat_enumerants;
+        std::vector<CORE::UInt32>
+            feature_index,
+            attribute_index;
+        std::vector<CORE::Int32>
+            trimmed_feature_map,
+            trimmed_attribute_map,
+            full_feature_map,
+            full_attribute_map;
+        std::size_t
+            feature_count = 0,
+            attribute_count = 0;
+
+        // Add the attributes and all of their enumerants first, so that a
+        // cell that allows every enumerant shares the list of its attribute.
+        //
+        for (std::size_t code = 0; code < attributes.size(); ++code)
+        {
+            const AttributeEntry
+                &entry = attributes[code];
+
+            flat_attributes[code] = entry.attribute;
+            flat_attributes[code].first_enumerant = flat_enumerants.size();
+            flat_attributes[code].enumerant_count = entry.enumerants.size();
+
+            if (entry.attribute.label == flat_no_string)
+            {
+                continue;
+            }
+
+            flat_attributes[code].label = strings.add(entry.label);
+            ++attribute_count;
+
+            for (std::size_t index = 0;
+                 index < entry.enumerants.size();
+                 ++index)
+            {
+                FlatEnumerant
+                    enumerant;
+
+                enumerant.code = entry.enumerants[index].first;
+                enumerant.label = strings.add(entry.enumerants[index].second);
+
+                flat_enumerants.push_back(enumerant);
+            }
+        }
+
+        for (std::size_t category = 0; category < features.size(); ++category)
+        {
+            const FeatureEntry
+                &entry = features[category];
+
+            flat_features[category] = entry.feature;
+            flat_features[category].first_cell = flat_cells.size();
+            flat_features[category].cell_count = entry.cells.size();
+
+            if (entry.feature.label == flat_no_string)
+            {
+                continue;
+            }
+
+            flat_features[category].label = strings.add(entry.label);
+            ++feature_count;
+
+            for (std::size_t index = 0; index < entry.cells.size(); ++index)
+            {
+                const OverlayAttributeLayout
+                    &attribute = entry.cells[index];
+                FlatCell
+                    cell;
+
+                std::memset(&cell, 0, sizeof(cell));
+                cell.attribute_code = attribute.code;
+                cell.offset = attribute.offset;
+                cell.default_enumerant = attribute.default_enumerant;
+                cell.default_value = attribute.default_value;
+                cell.minimum = attribute.minimum;
+                cell.maximum = attribute.maximum;
+                cell.first_enumerant = flat_enumerants.size();
+                cell.enumerant_count = attribute.enumerants.size();
+
+                if (attribute.code >= 0 and
+                    static_cast<std::size_t>(attribute.code) <
+                        attributes.size() and
+                    attributes[attribute.code].enumerants ==
+                        attribute.enumerants)
+                {
+                    cell.first_enumerant =
+                        flat_attributes[attribute.code].first_enumerant;
+                }
+                else
+                {
+                    for (std::size_t value = 0;
+                         value < attribute.enumerants.size();
+                         ++value)
+                    {
+                        FlatEnumerant
+                            enumerant;
+
+                        enumerant.code = attribute.enumerants[value].first;
+                        enumerant.label =
+                            strings.add(attribute.enumerants[value].second);
+
+                        flat_enumerants.push_back(enumerant);
+                    }
+                }
+
+                flat_cells.push_back(cell);
+            }
+        }
+
+        // Index the labels by open addressing.  A slot holds the category
+        // plus one, so that zero marks an empty slot.
+        //
+        feature_index.assign(get_index_size(feature_count), 0);
+        attribute_index.assign(get_index_size(attribute_count), 0);
+
+        for (std::size_t category = 0; category < features.size(); ++category)
+        {
+            const FeatureEntry
+                &entry = features[category];
+            CORE::UInt32
+                mask = feature_index.size() - 1,
+                slot;
+
+            if (entry.feature.label == flat_no_string)
+            {
+                continue;
+            }
+
+            slot = hash_feature(
+                entry.label.data(),
+                entry.label.size(),
+                entry.feature.geometry) & mask;
+
+            while (feature_index[slot])
+            {
+                slot = (slot + 1) & mask;
+            }
+
+            feature_index[slot] = category + 1;
+        }
+
+        for (std::size_t code = 0; code < attributes.size(); ++code)
+        {
+            const AttributeEntry
+                &entry = attributes[code];
+            CORE::UInt32
+                mask = attribute_index.size() - 1,
+                slot;
+
+            if (entry.attribute.label == flat_no_string)
+            {
+                continue;
+            }
+
+            slot = hash_label(entry.label.data(), entry.label.size()) & mask;
+
+            while (attribute_index[slot])
+            {
+                slot = (slot + 1) & mask;
+            }
+
+            attribute_index[slot] = code + 1;
+        }
+
+        // A trimmed image maps its codes to the full FARM both ways.
+        //
+        if (not feature_map.empty())
+        {
+            trimmed_feature_map.assign(flat_features.size(), -1);
+            trimmed_attribute_map.assign(flat_attributes.size(), -1);
+            full_feature_map.assign(full_feature_count, -1);
+            full_attribute_map.assign(full_attribute_count, -1);
+
+            for (std::size_t category = 0;
+                 category < feature_map.size() and
+                    category < trimmed_feature_map.size();
+                 ++category)
+            {
+                trimmed_feature_map[category] = feature_map[category];
+
+                if (feature_map[category] >= 0 and
+                    feature_map[category] < full_feature_count)
+                {
+                    full_feature_map[feature_map[category]] = category;
+                }
+            }
+
+            for (std::size_t code = 0;
+                 code < attribute_map.size() and
+                    code < trimmed_attribute_map.size();
+                 ++code)
+            {
+                trimmed_attribute_map[code] = attribute_map[code];
+
+                if (attribute_map[code] >= 0 and
+                    attribute_map[code] < full_attribute_count)
+                {
+                    full_attribute_map[attribute_map[code]] = code;
+                }
+            }
+        }
+
+        // Lay out the sections.
+        //
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, image_magic, sizeof(image_magic));
+        header.format = image_format;
+        header.byte_order = byte_order_mark;
+        header.fingerprint_high = fingerprint.high;
+        header.fingerprint_low = fingerprint.low;
+        header.feature_count = flat_features.size();
+        header.attribute_count = flat_attributes.size();
+        header.cell_count = flat_cells.size();
+        header.enumerant_count = flat_enumerants.size();
+        header.feature_index_size = feature_index.size();
+        header.attribute_index_size = attribute_index.size();
+        header.string_bytes = strings.data.size();
+
+        header.features = align(sizeof(header));
+        header.attributes = align(
+            header.features + sizeof(FlatFeature) * flat_features.size());
+        header.cells = align(
+            header.attributes +
+                sizeof(FlatAttribute) * flat_attributes.size());
+        header.enumerants = align(
+            header.cells + sizeof(FlatCell) * flat_cells.size());
+        header.feature_index = align(
+            header.enumerants +
+                sizeof(FlatEnumerant) * flat_enumerants.size());
+        header.attribute_index = align(
+            header.feature_index +
+                sizeof(CORE::UInt32) * feature_index.size());
+        header.strings = align(
+            header.attribute_index +
+                sizeof(CORE::UInt32) * attribute_index.size());
+        header.image_bytes = align(header.strings + strings.data.size());
+
+        if (not feature_map.empty())
+        {
+            header.full_feature_count = full_feature_map.size();
+            header.full_attribute_count = full_attribute_map.size();
+            header.feature_map = header.image_bytes;
+            header.attribute_map = align(
+                header.feature_map +
+                    sizeof(CORE::Int32) * trimmed_feature_map.size());
+            header.full_feature_map = align(
+                header.attribute_map +
+                    sizeof(CORE::Int32) * trimmed_attribute_map.size());
+            header.full_attribute_map = align(
+                header.full_feature_map +
+                    sizeof(CORE::Int32) * full_feature_map.size());
+            header.image_bytes = align(
+                header.full_attribute_map +
+                    sizeof(CORE::Int32) * full_attribute_map.size());
+        }
+
+        image.assign(header.image_bytes, 0);
+
+        std::memcpy(&image[0], &header, sizeof(header));
+
+        if (not flat_features.empty())
+        {
+            std::memcpy(
+                &image[header.features],
+                &flat_features[0],
+                sizeof(FlatFeature) * flat_features.size());
+        }
+
+        if (not flat_attributes.empty())
+        {
+            std::memcpy(
+                &image[header.attributes],
+                &flat_attributes[0],
+                sizeof(FlatAttribute) * flat_attributes.size());
+        }
+
+        if (not flat_cells.empty())
+        {
+            std::memcpy(
+                &image[header.cells],
+                &flat_cells[0],
+                sizeof(FlatCell) * flat_cells.size());
+        }
+
+        if (not flat_enumerants.empty())
+        {
+            std::memcpy(
+                &image[header.enumerants],
+                &flat_enumerants[0],
+                sizeof(FlatEnumerant) * flat_enumerants.size());
+        }
+
+        std::memcpy(
+            &image[header.feature_index],
+            &feature_index[0],
+            sizeof(CORE::UInt32) * feature_index.size());
+
+        std::memcpy(
+            &image[header.attribute_index],
+            &attribute_index[0],
+            sizeof(CORE::UInt32) * attribute_index.size());
+
+        if (not strings.data.empty())
+        {
+            std::memcpy(
+                &image[header.strings],
+                &strings.data[0],
+                strings.data.size());
+        }
+
+        copy_map(trimmed_feature_map, header.feature_map, image);
+        copy_map(trimmed_attribute_map, header.attribute_map, image);
+        copy_map(full_feature_map, header.full_feature_map, image);
+        copy_map(full_attribute_map, header.full_attribute_map, image);
+    }
+
+    // ------------------------------------------------------------------------
+    FlatFarm::FlatFarm(void) :
+        base(0),
+        header(0),
+        features(0),
+        attributes(0),
+        cells(0),
+        enumerants(0),
+        feature_index(0),
+        attribute_index(0),
+        strings(0),
+        feature_map(0),
+        attribute_map(0),
+        full_feature_map(0),
+        full_attribute_map(0)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::write_image(
+        const std::string &file_name,
+        const std::vector<char> &image
+    )
+    {
+        std::ofstream
+            file(file_name.c_str(), std::ios::out | std::ios::binary);
+
+        ASSERT(
+            file.is_open(),
+            high,
+            "Could not create the file '" + file_name + "'.");
+
+        if (not image.empty())
+        {
+            file.write(&image[0], image.size());
+        }
+
+        file.close();
+
+        return not file.fail();
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::read_image(
+        const std::string &file_name,
+        std::vector<char> &image
+    )
+    {
+        std::ifstream
+            file(file_name.c_str(), std::ios::in | std::ios::binary);
+        bool
+            successful = file.is_open();
+
+        image.clear();
+
+        if (successful)
+        {
+            file.seekg(0, std::ios::end);
+            image.resize(static_cast<std::size_t>(file.tellg()));
+            file.seekg(0, std::ios::beg);
+
+            successful = not image.empty();
+        }
+
+        if (successful)
+        {
+            file.read(&image[0], image.size());
+
+            successful = file.good();
+        }
+
+        ASSERT(
+            successful,
+            high,
+            "Could not read the flat FARM image '" + file_name + "'.");
+
+        return successful;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::open(const void *image, std::size_t size)
+    {
+        const FlatImageHeader
+            *image_header = static_cast<const FlatImageHeader *>(image);
+        bool
+            successful;
+
+        close();
+
+        successful =
+            image and
+            reinterpret_cast<std::size_t>(image) % 8 == 0 and
+            size >= sizeof(FlatImageHeader) and
+            std::memcmp(
+                image_header->magic, image_magic, sizeof(image_magic)) == 0;
+
+        if (not successful)
+        {
+            LOG(high, "The memory does not hold a flat FARM image.");
+
+            return false;
+        }
+
+        if (image_header->byte_order != byte_order_mark or
+            image_header->format != image_format)
+        {
+            LOG_WITH_STREAM(
+                high,
+                "The flat FARM image is format " <<
+                    (image_header->byte_order == byte_order_mark ?
+                        image_header->format :
+                        ByteSwap::swap(image_header->format)) <<
+                    (image_header->byte_order == byte_order_mark ?
+                        "" : " of the other byte order") <<
+                    "; format " << image_format << " is expected.");
+
+            return false;
+        }
+
+        successful =
+            image_header->image_bytes <= size and
+            valid_section(
+                image_header->features,
+                image_header->feature_count,
+                sizeof(FlatFeature),
+                image_header->image_bytes) and
+            valid_section(
+                image_header->attributes,
+                image_header->attribute_count,
+                sizeof(FlatAttribute),
+                image_header->image_bytes) and
+            valid_section(
+                image_header->cells,
+                image_header->cell_count,
+                sizeof(FlatCell),
+                image_header->image_bytes) and
+            valid_section(
+                image_header->enumerants,
+                image_header->enumerant_count,
+                sizeof(FlatEnumerant),
+                image_header->image_bytes) and
+            valid_index_size(image_header->feature_index_size) and
+            valid_section(
+                image_header->feature_index,
+                image_header->feature_index_size,
+                sizeof(CORE::UInt32),
+                image_header->image_bytes) and
+            valid_index_size(image_header->attribute_index_size) and
+            valid_section(
+                image_header->attribute_index,
+                image_header->attribute_index_size,
+                sizeof(CORE::UInt32),
+                image_header->image_bytes) and
+            valid_section(
+                image_header->strings,
+                image_header->string_bytes,
+                1,
+                image_header->image_bytes) and
+            (image_header->string_bytes == 0 or
+                static_cast<const char *>(image)[
+                    image_header->strings + image_header->string_bytes - 1] ==
+                    '\0') and
+            (image_header->feature_map == 0 or (
+                valid_section(
+                    image_header->feature_map,
+                    image_header->feature_count,
+                    sizeof(CORE::Int32),
+                    image_header->image_bytes) and
+                valid_section(
+                    image_header->attribute_map,
+                    image_header->attribute_count,
+                    sizeof(CORE::Int32),
+                    image_header->image_bytes) and
+                valid_section(
+                    image_header->full_feature_map,
+                    image_header->full_feature_count,
+                    sizeof(CORE::Int32),
+                    image_header->image_bytes) and
+                valid_section(
+                    image_header->full_attribute_map,
+                    image_header->full_attribute_count,
+                    sizeof(CORE::Int32),
+                    image_header->image_bytes)));
+
+        ASSERT(successful, high, "The flat FARM image is damaged.");
+
+        if (successful)
+        {
+            base = static_cast<const char *>(image);
+            header = image_header;
+            features =
+                reinterpret_cast<const FlatFeature *>(
+                    base + header->features);
+            attributes =
+                reinterpret_cast<const FlatAttribute *>(
+                    base + header->attributes);
+            cells =
+                reinterpret_cast<const FlatCell *>(base + header->cells);
+            enumerants =
+                reinterpret_cast<const FlatEnumerant *>(
+                    base + header->enumerants);
+            feature_index =
+                reinterpret_cast<const CORE::UInt32 *>(
+                    base + header->feature_index);
+            attribute_index =
+                reinterpret_cast<const CORE::UInt32 *>(
+                    base + header->attribute_index);
+            strings = base + header->strings;
+
+            if (header->feature_map)
+            {
+                feature_map =
+                    reinterpret_cast<const CORE::Int32 *>(
+                        base + header->feature_map);
+                attribute_map =
+                    reinterpret_cast<const CORE::Int32 *>(
+                        base + header->attribute_map);
+                full_feature_map =
+                    reinterpret_cast<const CORE::Int32 *>(
+                        base + header->full_feature_map);
+                full_attribute_map =
+                    reinterpret_cast<const CORE::Int32 *>(
+                        base + header->full_attribute_map);
+            }
+        }
+
+        return successful;
+    }
+
+    // ------------------------------------------------------------------------
+    void FlatFarm::close(void)
+    {
+        base = 0;
+        header = 0;
+        features = 0;
+        attributes = 0;
+        cells = 0;
+        enumerants = 0;
+        feature_index = 0;
+        attribute_index = 0;
+        strings = 0;
+        feature_map = 0;
+        attribute_map = 0;
+        full_feature_map = 0;
+        full_attribute_map = 0;
+    }
+
+    // ------------------------------------------------------------------------
+    Fingerprint FlatFarm::get_fingerprint(void) const
+    {
+        Fingerprint
+            fingerprint;
+
+        if (header)
+        {
+            fingerprint.high = header->fingerprint_high;
+            fingerprint.low = header->fingerprint_low;
+        }
+
+        return fingerprint;
+    }
+
+    // ------------------------------------------------------------------------
+    std::size_t FlatFarm::get_image_bytes(void) const
+    {
+        return header ? header->image_bytes : 0;
+    }
+
+    // ------------------------------------------------------------------------
+    int FlatFarm::get_feature_category_count(void) const
+    {
+        return header ? header->feature_count : 0;
+    }
+
+    // ------------------------------------------------------------------------
+    int FlatFarm::get_attribute_category_count(void) const
+    {
+        return header ? header->attribute_count : 0;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::is_trimmed(void) const
+    {
+        return feature_map != 0;
+    }
+
+    // ------------------------------------------------------------------------
+    FeatureCategory FlatFarm::get_full_feature_category(
+        const FeatureCategory &feature_category
+    ) const
+    {
+        if (not valid_feature_category(feature_category))
+        {
+            return -1;
+        }
+
+        return feature_map ? feature_map[feature_category] : feature_category;
+    }
+
+    // ------------------------------------------------------------------------
+    FeatureCategory FlatFarm::get_trimmed_feature_category(
+        const FeatureCategory &full_feature_category
+    ) const
+    {
+        if (not feature_map)
+        {
+            return
+                valid_feature_category(full_feature_category) ?
+                    full_feature_category : -1;
+        }
+
+        return
+            full_feature_category >= 0 and
+            static_cast<CORE::UInt32>(full_feature_category) <
+                header->full_feature_count ?
+                    full_feature_map[full_feature_category] : -1;
+    }
+
+    // ------------------------------------------------------------------------
+    AttributeCategory FlatFarm::get_full_attribute_category(
+        const AttributeCategory &attribute_category
+    ) const
+    {
+        if (not get_attribute_label(attribute_category))
+        {
+            return -1;
+        }
+
+        return
+            attribute_map ?
+                attribute_map[attribute_category] : attribute_category;
+    }
+
+    // ------------------------------------------------------------------------
+    AttributeCategory FlatFarm::get_trimmed_attribute_category(
+        const AttributeCategory &full_attribute_category
+    ) const
+    {
+        if (not attribute_map)
+        {
+            return
+                get_attribute_label(full_attribute_category) ?
+                    full_attribute_category : -1;
+        }
+
+        return
+            full_attribute_category >= 0 and
+            static_cast<CORE::UInt32>(full_attribute_category) <
+                header->full_attribute_count ?
+                    full_attribute_map[full_attribute_category] : -1;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::valid_feature_category(
+        const FeatureCategory &feature_category
+    ) const
+    {
+        return get_feature(feature_category) != 0;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::get_feature_category(
+        const FeatureLabel &feature_label,
+        const FeatureGeometry &feature_geometry,
+        FeatureCategory &feature_category
+    ) const
+    {
+        if (not header)
+        {
+            return false;
+        }
+
+        CORE::UInt32
+            mask = header->feature_index_size - 1,
+            slot = hash_feature(
+                feature_label.data(),
+                feature_label.size(),
+                feature_geometry) & mask;
+
+        // The index is never full, so the probe ends at an empty slot.
+        //
+        while (feature_index[slot])
+        {
+            const FlatFeature
+                &feature = features[feature_index[slot] - 1];
+
+            if (feature.geometry == feature_geometry and
+                feature_label.compare(strings + feature.label) == 0)
+            {
+                feature_category = feature_index[slot] - 1;
+
+                return true;
+            }
+
+            slot = (slot + 1) & mask;
+        }
+
+        return false;
+    }
+
+    // ------------------------------------------------------------------------
+    const char *FlatFarm::get_feature_label(
+        const FeatureCategory &feature_category
+    ) const
+    {
+        const FlatFeature
+            *feature = get_feature(feature_category);
+
+        return feature ? strings + feature->label : 0;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::get_attribute_category(
+        const AttributeLabel &attribute_label,
+        AttributeCategory &attribute_category
+    ) const
+    {
+        if (not header)
+        {
+            return false;
+        }
+
+        CORE::UInt32
+            mask = header->attribute_index_size - 1,
+            slot = hash_label(
+                attribute_label.data(), attribute_label.size()) & mask;
+
+        while (attribute_index[slot])
+        {
+            if (attribute_label.compare(
+                    strings + attributes[attribute_index[slot] - 1].label) ==
+                0)
+            {
+                attribute_category = attribute_index[slot] - 1;
+
+                return true;
+            }
+
+            slot = (slot + 1) & mask;
+        }
+
+        return false;
+    }
+
+    // ------------------------------------------------------------------------
+    const char *FlatFarm::get_attribute_label(
+        const AttributeCategory &attribute_category
+    ) const
+    {
+        return
+            header and
+            attribute_category >= 0 and
+            static_cast<CORE::UInt32>(attribute_category) <
+                header->attribute_count and
+            attributes[attribute_category].label != flat_no_string ?
+                strings + attributes[attribute_category].label : 0;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::get_data_type(
+        const AttributeCategory &attribute_category,
+        AttributeDataType &data_type
+    ) const
+    {
+        bool
+            successful = get_attribute_label(attribute_category) != 0;
+
+        if (successful)
+        {
+            data_type = static_cast<AttributeDataType>(
+                attributes[attribute_category].data_type);
+        }
+
+        return successful;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::contains_attribute(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category
+    ) const
+    {
+        return get_cell(feature_category, attribute_category) != 0;
+    }
+
+    // ------------------------------------------------------------------------
+    const FlatCell *FlatFarm::get_cell(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category
+    ) const
+    {
+        const FlatFeature
+            *feature = get_feature(feature_category);
+
+        if (not feature)
+        {
+            return 0;
+        }
+
+        const FlatCell
+            *first = cells + feature->first_cell,
+            *last = first + feature->cell_count,
+            *cell = std::lower_bound(
+                first, last, attribute_category, cell_code_less);
+
+        return
+            cell != last and cell->attribute_code == attribute_category ?
+                cell : 0;
+    }
+
+    // ------------------------------------------------------------------------
+    const FlatCell *FlatFarm::get_typed_cell(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category,
+        AttributeDataType data_type
+    ) const
+    {
+        AttributeDataType
+            attribute_data_type;
+
+        return
+            get_data_type(attribute_category, attribute_data_type) and
+            attribute_data_type == data_type ?
+                get_cell(feature_category, attribute_category) : 0;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::get_attribute_offset(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category,
+        AttributeOffset &attribute_offset
+    ) const
+    {
+        const FlatCell
+            *cell = get_cell(feature_category, attribute_category);
+
+        if (cell)
+        {
+            attribute_offset = cell->offset;
+        }
+
+        return cell != 0;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::valid_attribute(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category,
+        const int attribute_value
+    ) const
+    {
+        const FlatCell
+            *cell = get_typed_cell(
+                feature_category, attribute_category, int32);
+
+        return
+            cell and
+            cell->minimum <= attribute_value and
+            attribute_value <= cell->maximum;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::valid_attribute(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category,
+        const double attribute_value
+    ) const
+    {
+        const FlatCell
+            *cell = get_typed_cell(
+                feature_category, attribute_category, float64);
+
+        return
+            cell and
+            cell->minimum <= attribute_value and
+            attribute_value <= cell->maximum;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::valid_attribute(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category,
+        const bool // Unused; selects the overload
+    ) const
+    {
+        return
+            get_typed_cell(feature_category, attribute_category, boolean) != 0;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::valid_enumerant(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category,
+        const EnumerantCode &enumerant_code
+    ) const
+    {
+        const FlatCell
+            *cell = get_typed_cell(
+                feature_category, attribute_category, enumeration);
+
+        if (not cell)
+        {
+            return false;
+        }
+
+        const FlatEnumerant
+            *first = enumerants + cell->first_enumerant,
+            *last = first + cell->enumerant_count,
+            *enumerant = std::lower_bound(
+                first, last, enumerant_code, enumerant_code_less);
+
+        return enumerant != last and enumerant->code == enumerant_code;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::get_default(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category,
+        int &default_value
+    ) const
+    {
+        const FlatCell
+            *cell = get_typed_cell(
+                feature_category, attribute_category, int32);
+
+        if (cell)
+        {
+            default_value = static_cast<int>(cell->default_value);
+        }
+
+        return cell != 0;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::get_default(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category,
+        double &default_value
+    ) const
+    {
+        const FlatCell
+            *cell = get_typed_cell(
+                feature_category, attribute_category, float64);
+
+        if (cell)
+        {
+            default_value = cell->default_value;
+        }
+
+        return cell != 0;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::get_default(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category,
+        bool &default_value
+    ) const
+    {
+        const FlatCell
+            *cell = get_typed_cell(
+                feature_category, attribute_category, boolean);
+
+        if (cell)
+        {
+            default_value = cell->default_value != 0.0;
+        }
+
+        return cell != 0;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::get_default_enumerant(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category,
+        EnumerantCode &default_value
+    ) const
+    {
+        const FlatCell
+            *cell = get_typed_cell(
+                feature_category, attribute_category, enumeration);
+
+        if (cell)
+        {
+            default_value = cell->default_enumerant;
+        }
+
+        return cell != 0;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::get_min_max(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category,
+        int &minimum_value,
+        int &maximum_value
+    ) const
+    {
+        const FlatCell
+            *cell = get_typed_cell(
+                feature_category, attribute_category, int32);
+
+        if (cell)
+        {
+            minimum_value = static_cast<int>(cell->minimum);
+            maximum_value = static_cast<int>(cell->maximum);
+        }
+
+        return cell != 0;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::get_min_max(
+        const FeatureCategory &feature_category,
+        const AttributeCategory &attribute_category,
+        double &minimum_value,
+        double &maximum_value
+    ) const
+    {
+        const FlatCell
+            *cell = get_typed_cell(
+                feature_category, attribute_category, float64);
+
+        if (cell)
+        {
+            minimum_value = cell->minimum;
+            maximum_value = cell->maximum;
+        }
+
+        return cell != 0;
+    }
+
+    // ------------------------------------------------------------------------
+    bool FlatFarm::get_enumerant_code(
+        const AttributeCategory &attribute_category,
+        const EnumerantLabel &enumerant_label,
+        EnumerantCode &enumerant_code
+    ) const
+    {
+        if (not get_attribute_label(attribute_category))
+        {
+            return false;
+        }
+
+        // An attribute has few enumerants, so they are searched in order.
+        //
+        const FlatAttribute
+            &attribute = attributes[attribute_category];
+
+        for (CORE::UInt32 index = 0;
+             index < attribute.enumerant_count;
+             ++index)
+        {
+            const FlatEnumerant
+                &enumerant = enumerants[attribute.first_enumerant + index];
+
+            if (enumerant_label.compare(strings + enumerant.label) == 0)
+            {
+                enumerant_code = enumerant.code;
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // ------------------------------------------------------------------------
+    const char *FlatFarm::get_enumerant_label(
+        const AttributeCategory &attribute_category,
+        const EnumerantCode &enumerant_code
+    ) const
+    {
+        if (not get_attribute_label(attribute_category))
+        {
+            return 0;
+        }
+
+        const FlatAttribute
+            &attribute = attributes[attribute_category];
+        const FlatEnumerant
+            *first = enumerants + attribute.first_enumerant,
+            *last = first + attribute.enumerant_count,
+            *enumerant = std::lower_bound(
+                first, last, enumerant_code, enumerant_code_less);
+
+        return
+            enumerant != last and enumerant->code == enumerant_code ?
+                strings + enumerant->label : 0;
+    }
+}
@@ -0,0 +1,529 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef FARM_FLAT_IMAGE_H
+#define FARM_FLAT_IMAGE_H
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/sys_types.h"
+#include "farm_attribute.h"
+#include "farm_enumerant.h"
+#include "farm_feature.h"
+#include "farm_fingerprint.h"
+#include "farm_overlay_migration.h"
+
+namespace FARM
+{
+    // The offset of a missing string in a flat image.
+    //
+    const CORE::UInt32
+        flat_no_string = 0xffffffff;
+
+    // A feature category of a flat image.  The category of a row that has
+    // no feature has no label.
+    //
+    struct FlatFeature
+    {
+        CORE::UInt32
+            label;              // Offset in the strings
+        CORE::Int32
+            code,
+            geometry,
+            usage_bitmask,
+            precedence,
+            overlay_size;
+        CORE::UInt32
+            first_cell,
+            cell_count;
+    };
+
+    // An attribute of a flat image, by attribute code.
+    //
+    struct FlatAttribute
+    {
+        CORE::UInt32
+            label;              // Offset in the strings
+        CORE::Int32
+            data_type,
+            units,
+            editable;
+        CORE::UInt32
+            first_enumerant,    // All enumerants of the attribute, by code
+            enumerant_count;
+    };
+
+    // An attribute of a feature category: one entry of the FARM table.  The
+    // cells of a category are sorted by attribute code.  The default and the
+    // range of an integer, real, or boolean attribute are held as doubles.
+    //
+    struct FlatCell
+    {
+        CORE::Int32
+            attribute_code,
+            offset,
+            default_enumerant;
+        CORE::UInt32
+            first_enumerant,    // The valid enumerants, by code
+            enumerant_count,
+            reserved;
+        CORE::Float64
+            default_value,
+            minimum,
+            maximum;
+    };
+
+    struct FlatEnumerant
+    {
+        CORE::Int32
+            code;
+        CORE::UInt32
+            label;              // Offset in the strings
+    };
+
+    // The header at the start of a flat image.  Every section starts on an
+    // eight byte boundary and is found by its offset from the start of the
+    // image.
+    //
+    struct FlatImageHeader
+    {
+        char
+            magic[8];
+        CORE::UInt32
+            format,
+            byte_order;
+        CORE::UInt64
+            image_bytes;
+        CORE::UInt64
+            fingerprint_high,   // The schema fingerprint of the FARM
+            fingerprint_low;
+        CORE::UInt32
+            feature_count,
+            attribute_count,
+            cell_count,
+            enumerant_count,
+            feature_index_size, // Slots; a power of two
+            attribute_index_size,
+            string_bytes,
+            full_feature_count, // Of the full FARM of a trimmed image, or 0
+            full_attribute_count,
+            reserved;
+        CORE::UInt64
+            features,
+            attributes,
+            cells,
+            enumerants,
+            feature_index,      // (label, geometry) to category + 1, or 0
+            attribute_index,    // Label to attribute code + 1, or 0
+            strings,            // Labels, each ended by a null
+            feature_map,        // The full category of each category
+            attribute_map,      // The full code of each attribute
+            full_feature_map,   // The category of each full category, or -1
+            full_attribute_map; // The code of each full attribute, or -1
+    };
+
+    // ------------------------------------------------------------------------
+    // Builds a flat FARM image: a position independent copy of the feature,
+    // attribute, and enumerant definitions and the FARM table in one block
+    // of memory, with hashed label indexes.  It holds no pointers, so it can
+    // be mapped at any address, by several processes at once, and queried in
+    // place by FlatFarm without being decoded.
+    //
+    // A trimmed image holds some of the categories and attributes of the full
+    // FARM under new codes, and maps between its codes and the full ones.
+    //
+    // Like FARM.bin, the image is in the byte order of the machine that
+    // built it.
+    // ------------------------------------------------------------------------
+    class FlatImageBuilder
+    {
+      public:
+
+        FlatImageBuilder(void);
+
+        // Adds the attribute under the given code, with all of its
+        // enumerants.  Attributes that are not added have no label.
+        //
+        void add_attribute(
+            const AttributeCode &code,
+            const Attribute &attribute,
+            const std::vector<std::pair<EnumerantCode, EnumerantLabel> >
+                &enumerants
+        );
+
+        // Adds the feature of the category of the layout and the attributes
+        // of the layout.  Categories that are not added have no feature.
+        //
+        void add_feature(
+            const Feature &feature,
+            const OverlayCategoryLayout &layout
+        );
+
+        void set_fingerprint(const Fingerprint &new_fingerprint);
+
+        // Makes the image a trimmed image.  The maps give the full category
+        // of each category and the full code of each attribute.
+        //
+        void set_code_maps(
+            const std::vector<FeatureCategory> &new_feature_map,
+            const std::vector<AttributeCategory> &new_attribute_map,
+            int new_full_feature_count,
+            int new_full_attribute_count
+        );
+
+        // Lays out the image.
+        //
+        void build(std::vector<char> &image) const;
+
+      private:
+
+        struct FeatureEntry
+        {
+            FeatureLabel
+                label;
+            FlatFeature
+                feature;
+            std::vector<OverlayAttributeLayout>
+                cells;
+        };
+
+        struct AttributeEntry
+        {
+            AttributeLabel
+                label;
+            FlatAttribute
+                attribute;
+            std::vector<std::pair<EnumerantCode, EnumerantLabel> >
+                enumerants;
+        };
+
+        std::vector<FeatureEntry>
+            features;
+        std::vector<AttributeEntry>
+            attributes;
+        Fingerprint
+            fingerprint;
+        std::vector<FeatureCategory>
+            feature_map;
+        std::vector<AttributeCategory>
+            attribute_map;
+        int
+            full_feature_count,
+            full_attribute_count;
+    };
+
+    // ------------------------------------------------------------------------
+    // A read-only view of a flat FARM image.  Its queries mirror those of
+    // FeatureAttributeMapping, but they answer from the image in place, so a
+    // process that maps an image (see SharedFarm) can use the FARM without
+    // loading it.  Invalid categories make a query fail rather than assert.
+    // The image must stay mapped while the view is used; the view may be
+    // used from several threads at once.
+    // ------------------------------------------------------------------------
+    class FlatFarm
+    {
+      public:
+
+        FlatFarm(void);
+
+        // Checks the header and the section bounds of the image and uses it.
+        //
+        // Return:  Is the image a flat FARM image of this byte order?
+        //
+        bool open(const void *image, std::size_t size);
+
+        void close(void);
+
+        bool is_open(void) const;
+
+        // Writes an image to a file.
+        //
+        // Return:  Was the image written?
+        //
+        static bool write_image(
+            const std::string &file_name,
+            const std::vector<char> &image
+        );
+
+        // Reads an image from a file into memory, for open().
+        //
+        // Return:  Was the file read?
+        //
+        static bool read_image(
+            const std::string &file_name,
+            std::vector<char> &image
+        );
+
+        // Return:  The schema fingerprint of the FARM of the image, or of
+        // the full FARM of a trimmed image.
+        //
+        Fingerprint get_fingerprint(void) const;
+
+        std::size_t get_image_bytes(void) const;
+
+        int get_feature_category_count(void) const;
+
+        int get_attribute_category_count(void) const;
+
+        // Return:  Is the image a trimmed image?
+        //
+        bool is_trimmed(void) const;
+
+        // Return:  The category of the full FARM for a category of the
+        // image, or -1 if it is not valid.  Without trimming the categories
+        // are the same.
+        //
+        FeatureCategory get_full_feature_category(
+            const FeatureCategory &feature_category
+        ) const;
+
+        // Return:  The category of the image for a category of the full
+        // FARM, or -1 if the image does not have it.
+        //
+        FeatureCategory get_trimmed_feature_category(
+            const FeatureCategory &full_feature_category
+        ) const;
+
+        // Return:  The attribute code of the full FARM for an attribute of
+        // the image, or -1 if it is not valid.
+        //
+        AttributeCategory get_full_attribute_category(
+            const AttributeCategory &attribute_category
+        ) const;
+
+        // Return:  The attribute code of the image for an attribute of the
+        // full FARM, or -1 if the image does not have it.
+        //
+        AttributeCategory get_trimmed_attribute_category(
+            const AttributeCategory &full_attribute_category
+        ) const;
+
+        // Return:  Does the category have a feature?
+        //
+        bool valid_feature_category(
+            const FeatureCategory &feature_category
+        ) const;
+
+        // Return:  Was the feature category found?
+        //
+        bool get_feature_category(
+            const FeatureLabel &feature_label,
+            const FeatureGeometry &feature_geometry,
+            FeatureCategory &feature_category
+        ) const;
+
+        // Return:  The label of the feature, or 0 for an invalid category.
+        //
+        const char *get_feature_label(
+            const FeatureCategory &feature_category
+        ) const;
+
+        // Return:  The feature of the category, or 0 for an invalid
+        // category.
+        //
+        const FlatFeature *get_feature(
+            const FeatureCategory &feature_category
+        ) const;
+
+        // Return:  Was the attribute found?
+        //
+        bool get_attribute_category(
+            const AttributeLabel &attribute_label,
+            AttributeCategory &attribute_category
+        ) const;
+
+        // Return:  The label of the attribute, or 0 for an invalid category.
+        //
+        const char *get_attribute_label(
+            const AttributeCategory &attribute_category
+        ) const;
+
+        // Return:  Was the data type returned?
+        //
+        bool get_data_type(
+            const AttributeCategory &attribute_category,
+            AttributeDataType &data_type
+        ) const;
+
+        bool contains_attribute(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category
+        ) const;
+
+        // Return:  The FARM table entry, or 0 if the feature does not have
+        // the attribute.
+        //
+        const FlatCell *get_cell(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category
+        ) const;
+
+        // Return:  Was the attribute offset returned?
+        //
+        bool get_attribute_offset(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category,
+            AttributeOffset &attribute_offset
+        ) const;
+
+        // Return:  Is the attribute value valid for the given feature and
+        // attribute?
+        //
+        bool valid_attribute(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category,
+            const int attribute_value
+        ) const;
+
+        bool valid_attribute(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category,
+            const double attribute_value
+        ) const;
+
+        bool valid_attribute(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category,
+            const bool attribute_value
+        ) const;
+
+        // Return:  Is the enumerant code one of the valid enumerants for the
+        // given feature and attribute?
+        //
+        bool valid_enumerant(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category,
+            const EnumerantCode &enumerant_code
+        ) const;
+
+        // Return:  Was the default attribute value returned?
+        //
+        bool get_default(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category,
+            int &default_value
+        ) const;
+
+        bool get_default(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category,
+            double &default_value
+        ) const;
+
+        bool get_default(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category,
+            bool &default_value
+        ) const;
+
+        bool get_default_enumerant(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category,
+            EnumerantCode &default_value
+        ) const;
+
+        // Return:  Were the minimum and maximum attribute values returned?
+        //
+        bool get_min_max(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category,
+            int &minimum_value,
+            int &maximum_value
+        ) const;
+
+        bool get_min_max(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category,
+            double &minimum_value,
+            double &maximum_value
+        ) const;
+
+        // Return:  Was the enumerant of the attribute found?
+        //
+        bool get_enumerant_code(
+            const AttributeCategory &attribute_category,
+            const EnumerantLabel &enumerant_label,
+            EnumerantCode &enumerant_code
+        ) const;
+
+        // Return:  The label of the enumerant of the attribute, or 0 if it
+        // was not found.
+        //
+        const char *get_enumerant_label(
+            const AttributeCategory &attribute_category,
+            const EnumerantCode &enumerant_code
+        ) const;
+
+      private:
+
+        // Return:  The cell of the attribute if it has the data type.
+        //
+        const FlatCell *get_typed_cell(
+            const FeatureCategory &feature_category,
+            const AttributeCategory &attribute_category,
+            AttributeDataType data_type
+        ) const;
+
+        const char
+            *base;
+        const FlatImageHeader
+            *header;
+        const FlatFeature
+            *features;
+        const FlatAttribute
+            *attributes;
+        const FlatCell
+            *cells;
+        const FlatEnumerant
+            *enumerants;
+        const CORE::UInt32
+            *feature_index,
+            *attribute_index;
+        const char
+            *strings;
+        const CORE::Int32
+            *feature_map,
+            *attribute_map,
+            *full_feature_map,
+            *full_attribute_map;
+    };
+
+    // ------------------------------------------------------------------------
+    inline bool FlatFarm::is_open(void) const
+    {
+        return header != 0;
+    }
+
+    // ------------------------------------------------------------------------
+    inline const FlatFeature *FlatFarm::get_feature(
+        const FeatureCategory &feature_category
+    ) const
+    {
+        return
+            header and
+            feature_category >= 0 and
+            static_cast<CORE::UInt32>(feature_category) <
+                header->feature_count and
+            features[feature_category].label != flat_no_string ?
+                &features[feature_category] : 0;
+    }
+}
+
+#endif
@@ -0,0 +1,414 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef FARM_HANDLES_H
+#define FARM_HANDLES_H
+#include <string>
+
+#include "farm_attribute.h"
+#include "farm_enumerant.h"
+#include "farm_feature.h"
+
+namespace FARM
+{
+    // The label of handles that do not refer to anything in the FARM.
+    //
+    extern const std::string
+        no_handle_label;
+
+    // ------------------------------------------------------------------------
+    // Handles are the allocation-free counterparts of Feature, Attribute, and
+    // Enumerant.  A handle holds the codes and a reference to the label kept
+    // by the FARM instead of a copy of it, so handles may be copied, stored,
+    // and compared without touching the heap.  They are returned by the
+    // FeatureAttributeMapping::get_*_handle() functions and refer to the
+    // labels of the FARM until it is destroyed or initialized again.
+    // ------------------------------------------------------------------------
+
+    // ------------------------------------------------------------------------
+    // Refers to a feature of the FARM.
+    //
+    class FeatureHandle
+    {
+      public:
+
+        // Constructs a handle that does not refer to a feature.
+        //
+        FeatureHandle(void);
+
+        // Constructs a handle to the feature with the label kept by the FARM.
+        //
+        FeatureHandle(
+            const FeatureCategory &new_category,
+            const FeatureCode &new_code,
+            const FeatureGeometry &new_geometry,
+            const FeatureLabel &new_label);
+
+        FeatureCategory get_category(void) const;
+
+        FeatureCode get_code(void) const;
+
+        FeatureGeometry get_geometry(void) const;
+
+        // Return:  The label of the feature, or an empty label.
+        //
+        const FeatureLabel &get_label(void) const;
+
+        // Return:  Does the handle refer to a feature?
+        //
+        bool valid(void) const;
+
+        // Return:  Do the handles refer to the same feature?
+        //
+        bool operator==(const FeatureHandle &rhs) const;
+
+        bool operator!=(const FeatureHandle &rhs) const;
+
+        // Return:  Is the feature category less than that of the argument?
+        //
+        bool operator<(const FeatureHandle &rhs) const;
+
+      private:
+
+        const FeatureLabel
+            *label;
+        FeatureCategory
+            category;
+        FeatureCode
+            code;
+        FeatureGeometry
+            geometry;
+    };
+
+    // ------------------------------------------------------------------------
+    // Refers to an attribute of the FARM.
+    //
+    class AttributeHandle
+    {
+      public:
+
+        // Constructs a handle that does not refer to an attribute.
+        //
+        AttributeHandle(void);
+
+        // Constructs a handle to the attribute with the label kept by the
+        // FARM.
+        //
+        AttributeHandle(
+            const AttributeCode &new_code,
+            const AttributeLabel &new_label);
+
+        AttributeCode get_code(void) const;
+
+        // Return:  The attribute category, which is the attribute code.
+        //
+        AttributeCategory get_category(void) const;
+
+        // Return:  The label of the attribute, or an empty label.
+        //
+        const AttributeLabel &get_label(void) const;
+
+        // Return:  Does the handle refer to an attribute?
+        //
+        bool valid(void) const;
+
+        // Return:  Do the handles refer to the same attribute?
+        //
+        bool operator==(const AttributeHandle &rhs) const;
+
+        bool operator!=(const AttributeHandle &rhs) const;
+
+        // Return:  Is the attribute code less than that of the argument?
+        //
+        bool operator<(const AttributeHandle &rhs) const;
+
+      private:
+
+        const AttributeLabel
+            *label;
+        AttributeCode
+            code;
+    };
+
+    // ------------------------------------------------------------------------
+    // Refers to an enumerant of an attribute of the FARM.
+    //
+    class EnumerantHandle
+    {
+      public:
+
+        // Constructs a handle that does not refer to an enumerant.
+        //
+        EnumerantHandle(void);
+
+        // Constructs a handle to the enumerant with the labels kept by the
+        // FARM.
+        //
+        EnumerantHandle(
+            const AttributeCode &new_ea_code,
+            const EnumerantCode &new_ee_code,
+            const AttributeLabel &new_ea_label,
+            const EnumerantLabel &new_ee_label);
+
+        AttributeCode get_ea_code(void) const;
+
+        EnumerantCode get_ee_code(void) const;
+
+        // Return:  The label of the attribute, or an empty label.
+        //
+        const AttributeLabel &get_ea_label(void) const;
+
+        // Return:  The label of the enumerant, or an empty label.
+        //
+        const EnumerantLabel &get_ee_label(void) const;
+
+        // Return:  Does the handle refer to an enumerant?
+        //
+        bool valid(void) const;
+
+        // Return:  Do the handles refer to the same enumerant?
+        //
+        bool operator==(const EnumerantHandle &rhs) const;
+
+        bool operator!=(const EnumerantHandle &rhs) const;
+
+        // Return:  Is the enumerant less than the argument enumerant?
+        // (Compares the attribute codes, then the enumerant codes.)
+        //
+        bool operator<(const EnumerantHandle &rhs) const;
+
+      private:
+
+        const AttributeLabel
+            *ea_label;
+        const EnumerantLabel
+            *ee_label;
+        AttributeCode
+            ea_code;
+        EnumerantCode
+            ee_code;
+    };
+
+    // ------------------------------------------------------------------------
+    inline FeatureHandle::FeatureHandle(void) :
+        label(&no_handle_label),
+        category(-999),
+        code(-999),
+        geometry(null)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    inline FeatureHandle::FeatureHandle(
+        const FeatureCategory &new_category,
+        const FeatureCode &new_code,
+        const FeatureGeometry &new_geometry,
+        const FeatureLabel &new_label
+    ) :
+        label(&new_label),
+        category(new_category),
+        code(new_code),
+        geometry(new_geometry)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    inline FeatureCategory FeatureHandle::get_category(void) const
+    {
+        return category;
+    }
+
+    // ------------------------------------------------------------------------
+    inline FeatureCode FeatureHandle::get_code(void) const
+    {
+        return code;
+    }
+
+    // ------------------------------------------------------------------------
+    inline FeatureGeometry FeatureHandle::get_geometry(void) const
+    {
+        return geometry;
+    }
+
+    // ------------------------------------------------------------------------
+    inline const FeatureLabel &FeatureHandle::get_label(void) const
+    {
+        return *label;
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool FeatureHandle::valid(void) const
+    {
+        return code != -999 and geometry != null;
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool FeatureHandle::operator==(const FeatureHandle &rhs) const
+    {
+        return
+            category == rhs.category and
+            code == rhs.code and
+            geometry == rhs.geometry;
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool FeatureHandle::operator!=(const FeatureHandle &rhs) const
+    {
+        return not (*this == rhs);
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool FeatureHandle::operator<(const FeatureHandle &rhs) const
+    {
+        return category < rhs.category;
+    }
+
+    // ------------------------------------------------------------------------
+    inline AttributeHandle::AttributeHandle(void) :
+        label(&no_handle_label),
+        code(-999)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    inline AttributeHandle::AttributeHandle(
+        const AttributeCode &new_code,
+        const AttributeLabel &new_label
+    ) :
+        label(&new_label),
+        code(new_code)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    inline AttributeCode AttributeHandle::get_code(void) const
+    {
+        return code;
+    }
+
+    // ------------------------------------------------------------------------
+    inline AttributeCategory AttributeHandle::get_category(void) const
+    {
+        return code;
+    }
+
+    // ------------------------------------------------------------------------
+    inline const AttributeLabel &AttributeHandle::get_label(void) const
+    {
+        return *label;
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool AttributeHandle::valid(void) const
+    {
+        return code != -999;
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool AttributeHandle::operator==(const AttributeHandle &rhs) const
+    {
+        return code == rhs.code;
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool AttributeHandle::operator!=(const AttributeHandle &rhs) const
+    {
+        return code != rhs.code;
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool AttributeHandle::operator<(const AttributeHandle &rhs) const
+    {
+        return code < rhs.code;
+    }
+
+    // ------------------------------------------------------------------------
+    inline EnumerantHandle::EnumerantHandle(void) :
+        ea_label(&no_handle_label),
+        ee_label(&no_handle_label),
+        ea_code(-999),
+        ee_code(-999)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    inline EnumerantHandle::EnumerantHandle(
+        const AttributeCode &new_ea_code,
+        const EnumerantCode &new_ee_code,
+        const AttributeLabel &new_ea_label,
+        const EnumerantLabel &new_ee_label
+    ) :
+        ea_label(&new_ea_label),
+        ee_label(&new_ee_label),
+        ea_code(new_ea_code),
+        ee_code(new_ee_code)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    inline AttributeCode EnumerantHandle::get_ea_code(void) const
+    {
+        return ea_code;
+    }
+
+    // ------------------------------------------------------------------------
+    inline EnumerantCode EnumerantHandle::get_ee_code(void) const
+    {
+        return ee_code;
+    }
+
+    // ------------------------------------------------------------------------
+    inline const AttributeLabel &EnumerantHandle::get_ea_label(void) const
+    {
+        return *ea_label;
+    }
+
+    // ------------------------------------------------------------------------
+    inline const EnumerantLabel &EnumerantHandle::get_ee_label(void) const
+    {
+        return *ee_label;
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool EnumerantHandle::valid(void) const
+    {
+        return ea_code != -999 and ee_code != -999;
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool EnumerantHandle::operator==(const EnumerantHandle &rhs) const
+    {
+        return ea_code == rhs.ea_code and ee_code == rhs.ee_code;
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool EnumerantHandle::operator!=(const EnumerantHandle &rhs) const
+    {
+        return not (*this == rhs);
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool EnumerantHandle::operator<(const EnumerantHandle &rhs) const
+    {
+        return
+            ea_code < rhs.ea_code or
+            (ea_code == rhs.ea_code and ee_code < rhs.ee_code);
+    }
+}
+
+#endif
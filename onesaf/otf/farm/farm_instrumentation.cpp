@@ -0,0 +1,426 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#include <atomic>
+#include <iomanip>
+
+#include "farm_instrumentation.h"
+
+namespace
+{
+    const char
+        *function_names[FARM::instrumented_function_count] =
+        {
+            "get_attribute",
+            "get_attribute_category",
+            "get_feature_category",
+            "valid_attribute",
+            "get_enumeration_value",
+            "convert_feature",
+            "convert_value",
+            "convert_values",
+            "down_convert_values"
+        };
+
+    // ------------------------------------------------------------------------
+    // Return:  The nanoseconds of the percentile of the latency buckets.
+    //
+    CORE::UInt64 get_bucket_percentile(
+        const CORE::UInt64 *buckets,
+        CORE::UInt64 samples,
+        double fraction)
+    {
+        CORE::UInt64
+            wanted = static_cast<CORE::UInt64>(fraction * samples),
+            counted = 0;
+
+        if (samples == 0)
+        {
+            return 0;
+        }
+
+        for (int i = 0; i < FARM::FunctionStatistics::latency_bucket_count;
+             ++i)
+        {
+            counted += buckets[i];
+
+            if (counted > wanted or counted == samples)
+            {
+                return CORE::UInt64(2) << i;
+            }
+        }
+
+        return 0;
+    }
+}
+
+#if defined(FARM_INSTRUMENTATION)
+
+namespace
+{
+    typedef std::atomic<CORE::UInt64>
+        Counter;
+
+    // The counters of one shard.  A shard starts on a cache line of its own.
+    //
+    struct alignas(64) Shard
+    {
+        Counter
+            calls[FARM::instrumented_function_count],
+            cache_hits[FARM::instrumented_function_count],
+            cache_misses[FARM::instrumented_function_count],
+            samples[FARM::instrumented_function_count],
+            sampled_ns[FARM::instrumented_function_count],
+            latency_buckets[FARM::instrumented_function_count]
+                [FARM::FunctionStatistics::latency_bucket_count];
+    };
+
+    Shard
+        shards[FARM::Instrumentation::shard_count];
+
+    std::atomic<CORE::UInt32>
+        next_shard(0),
+        sample_interval(FARM::Instrumentation::default_sample_interval);
+
+    thread_local Shard
+        *thread_shard = 0;
+
+    thread_local CORE::UInt32
+        calls_until_sample = 0;
+
+    // ------------------------------------------------------------------------
+    // Return:  The shard of the calling thread.  Threads are dealt shards in
+    //          turn, so the first shard_count threads have their own.
+    //
+    Shard &get_shard(void)
+    {
+        if (not thread_shard)
+        {
+            thread_shard = &shards[
+                next_shard.fetch_add(1, std::memory_order_relaxed) %
+                    FARM::Instrumentation::shard_count];
+        }
+
+        return *thread_shard;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The value of the counter, which is zeroed if reset is true.
+    //
+    CORE::UInt64 read_counter(Counter &counter, bool reset)
+    {
+        return reset ?
+            counter.exchange(0, std::memory_order_relaxed) :
+            counter.load(std::memory_order_relaxed);
+    }
+
+    // ------------------------------------------------------------------------
+    // Sums the shards into the snapshot, zeroing them if reset is true.
+    //
+    void sum_shards(
+        std::vector<FARM::FunctionStatistics> &snapshot,
+        bool reset)
+    {
+        snapshot.assign(
+            FARM::instrumented_function_count, FARM::FunctionStatistics());
+
+        for (int function = 0; function < FARM::instrumented_function_count;
+             ++function)
+        {
+            FARM::FunctionStatistics
+                &statistics = snapshot[function];
+
+            statistics.name = function_names[function];
+            statistics.calls = 0;
+            statistics.cache_hits = 0;
+            statistics.cache_misses = 0;
+            statistics.samples = 0;
+            statistics.sampled_ns = 0;
+
+            for (int bucket = 0;
+                 bucket < FARM::FunctionStatistics::latency_bucket_count;
+                 ++bucket)
+            {
+                statistics.latency_buckets[bucket] = 0;
+            }
+
+            for (int i = 0; i < FARM::Instrumentation::shard_count; ++i)
+            {
+                Shard
+                    &shard = shards[i];
+
+                statistics.calls += read_counter(shard.calls[function], reset);
+                statistics.cache_hits +=
+                    read_counter(shard.cache_hits[function], reset);
+                statistics.cache_misses +=
+                    read_counter(shard.cache_misses[function], reset);
+                statistics.samples +=
+                    read_counter(shard.samples[function], reset);
+                statistics.sampled_ns +=
+                    read_counter(shard.sampled_ns[function], reset);
+
+                for (int bucket = 0;
+                     bucket < FARM::FunctionStatistics::latency_bucket_count;
+                     ++bucket)
+                {
+                    statistics.latency_buckets[bucket] += read_counter(
+                        shard.latency_buckets[function][bucket], reset);
+                }
+            }
+        }
+    }
+}
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    bool Instrumentation::compiled(void)
+    {
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    void Instrumentation::set_sample_interval(CORE::UInt32 interval)
+    {
+        sample_interval.store(interval, std::memory_order_relaxed);
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::UInt32 Instrumentation::get_sample_interval(void)
+    {
+        return sample_interval.load(std::memory_order_relaxed);
+    }
+
+    // ------------------------------------------------------------------------
+    void Instrumentation::get_snapshot(
+        std::vector<FunctionStatistics> &snapshot)
+    {
+        sum_shards(snapshot, false);
+    }
+
+    // ------------------------------------------------------------------------
+    void Instrumentation::get_snapshot_and_reset(
+        std::vector<FunctionStatistics> &snapshot)
+    {
+        sum_shards(snapshot, true);
+    }
+
+    // ------------------------------------------------------------------------
+    void Instrumentation::reset(void)
+    {
+        std::vector<FunctionStatistics>
+            snapshot;
+
+        sum_shards(snapshot, true);
+    }
+
+    // ------------------------------------------------------------------------
+    bool Instrumentation::record_call(InstrumentedFunction function)
+    {
+        Shard
+            &shard = get_shard();
+
+        shard.calls[function].fetch_add(1, std::memory_order_relaxed);
+
+        // The first call of a thread is sampled, then one in the interval.
+        //
+        bool
+            sampled = false;
+
+        if (calls_until_sample == 0)
+        {
+            CORE::UInt32
+                interval = sample_interval.load(std::memory_order_relaxed);
+
+            if (interval > 0)
+            {
+                sampled = true;
+                calls_until_sample = interval - 1;
+            }
+        }
+        else
+        {
+            --calls_until_sample;
+        }
+
+        return sampled;
+    }
+
+    // ------------------------------------------------------------------------
+    void Instrumentation::record_latency(
+        InstrumentedFunction function,
+        CORE::UInt64 nanoseconds)
+    {
+        Shard
+            &shard = get_shard();
+        int
+            bucket = 0;
+
+        while (bucket + 1 < FunctionStatistics::latency_bucket_count and
+               (nanoseconds >> (bucket + 1)) != 0)
+        {
+            ++bucket;
+        }
+
+        shard.samples[function].fetch_add(1, std::memory_order_relaxed);
+        shard.sampled_ns[function].fetch_add(
+            nanoseconds, std::memory_order_relaxed);
+        shard.latency_buckets[function][bucket].fetch_add(
+            1, std::memory_order_relaxed);
+    }
+
+    // ------------------------------------------------------------------------
+    void Instrumentation::record_cache(InstrumentedFunction function, bool hit)
+    {
+        Shard
+            &shard = get_shard();
+
+        if (hit)
+        {
+            shard.cache_hits[function].fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            shard.cache_misses[function].fetch_add(
+                1, std::memory_order_relaxed);
+        }
+    }
+}
+
+#else
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    // Without FARM_INSTRUMENTATION nothing is counted.
+    //
+    bool Instrumentation::compiled(void)
+    {
+        return false;
+    }
+
+    // ------------------------------------------------------------------------
+    void Instrumentation::set_sample_interval(CORE::UInt32)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::UInt32 Instrumentation::get_sample_interval(void)
+    {
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------
+    void Instrumentation::get_snapshot(
+        std::vector<FunctionStatistics> &snapshot)
+    {
+        snapshot.clear();
+    }
+
+    // ------------------------------------------------------------------------
+    void Instrumentation::get_snapshot_and_reset(
+        std::vector<FunctionStatistics> &snapshot)
+    {
+        snapshot.clear();
+    }
+
+    // ------------------------------------------------------------------------
+    void Instrumentation::reset(void)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    bool Instrumentation::record_call(InstrumentedFunction)
+    {
+        return false;
+    }
+
+    // ------------------------------------------------------------------------
+    void Instrumentation::record_latency(InstrumentedFunction, CORE::UInt64)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    void Instrumentation::record_cache(InstrumentedFunction, bool)
+    {
+    }
+}
+
+#endif
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    CORE::UInt64 FunctionStatistics::get_latency_percentile(
+        double fraction) const
+    {
+        return get_bucket_percentile(latency_buckets, samples, fraction);
+    }
+
+    // ------------------------------------------------------------------------
+    const char *Instrumentation::get_name(InstrumentedFunction function)
+    {
+        return function >= 0 and function < instrumented_function_count ?
+            function_names[function] : "unknown";
+    }
+
+    // ------------------------------------------------------------------------
+    void Instrumentation::display(std::ostream &stream)
+    {
+        std::vector<FunctionStatistics>
+            snapshot;
+
+        get_snapshot(snapshot);
+
+        if (snapshot.empty())
+        {
+            stream << "The FARM was built without FARM_INSTRUMENTATION." <<
+                std::endl;
+            return;
+        }
+
+        std::ios::fmtflags
+            flags = stream.flags();
+
+        stream << std::left << std::setw(24) << "function" << std::right <<
+            std::setw(14) << "calls" << std::setw(12) << "hits" <<
+            std::setw(12) << "misses" << std::setw(10) << "mean ns" <<
+            std::setw(10) << "p50 ns" << std::setw(10) << "p99 ns" <<
+            std::endl;
+
+        for (std::vector<FunctionStatistics>::size_type i = 0;
+             i < snapshot.size(); ++i)
+        {
+            const FunctionStatistics
+                &statistics = snapshot[i];
+
+            stream << std::left << std::setw(24) << statistics.name <<
+                std::right << std::setw(14) << statistics.calls <<
+                std::setw(12) << statistics.cache_hits <<
+                std::setw(12) << statistics.cache_misses <<
+                std::setw(10) <<
+                (statistics.samples ?
+                    statistics.sampled_ns / statistics.samples : 0) <<
+                std::setw(10) << statistics.get_latency_percentile(0.5) <<
+                std::setw(10) << statistics.get_latency_percentile(0.99) <<
+                std::endl;
+        }
+
+        stream.flags(flags);
+    }
+}
@@ -0,0 +1,209 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef FARM_INSTRUMENTATION_H
+#define FARM_INSTRUMENTATION_H
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "core/sys_types.h"
+
+namespace FARM
+{
+    // The instrumented FARM and EDCS converter functions.  Overloads share
+    // an entry.
+    //
+    enum InstrumentedFunction
+    {
+        instrumented_get_attribute,
+        instrumented_get_attribute_category,
+        instrumented_get_feature_category,
+        instrumented_valid_attribute,
+        instrumented_get_enumeration_value,
+        instrumented_convert_feature,
+        instrumented_convert_value,
+        instrumented_convert_values,
+        instrumented_down_convert_values,
+        instrumented_function_count
+    };
+
+    // The counters of an instrumented function, summed over the threads.
+    // Bucket i of the latency histogram counts the sampled calls that took
+    // from 2^i to 2^(i+1) nanoseconds; bucket 0 also counts faster calls.
+    //
+    struct FunctionStatistics
+    {
+        enum
+        {
+            latency_bucket_count = 32
+        };
+
+        std::string
+            name;
+        CORE::UInt64
+            calls,
+            cache_hits,
+            cache_misses,
+            samples,            // Calls that were timed
+            sampled_ns,         // Total time of the sampled calls
+            latency_buckets[latency_bucket_count];
+
+        // Return:  The upper bound in nanoseconds of the latency below which
+        //          the fraction of the sampled calls fall, or 0 if no call
+        //          was sampled.
+        //
+        CORE::UInt64 get_latency_percentile(double fraction) const;
+    };
+
+    // ------------------------------------------------------------------------
+    // Counts the calls of the FARM lookups and the EDCS conversions, the hits
+    // and misses of the attribute label cache, and the latency of one call
+    // in sample_interval.  The counters are only compiled in when
+    // FARM_INSTRUMENTATION is defined ('make FARM_INSTRUMENTATION=1');
+    // otherwise the macros below are empty and get_snapshot() returns no
+    // functions, so a metrics exporter builds either way.
+    //
+    // The counters are sharded: each thread updates the shard it was given
+    // on its first call with relaxed atomics, so threads do not share cache
+    // lines unless there are more threads than shards.  A snapshot sums the
+    // shards; it is not atomic across functions, but each counter is exact.
+    // ------------------------------------------------------------------------
+    class Instrumentation
+    {
+      public:
+
+        enum
+        {
+            shard_count = 64,
+            default_sample_interval = 16
+        };
+
+        // Return:  Was the library built with FARM_INSTRUMENTATION?
+        //
+        static bool compiled(void);
+
+        // Times one call of every interval calls on each thread.  An
+        // interval of 1 times every call; 0 turns the timing off.
+        //
+        static void set_sample_interval(CORE::UInt32 interval);
+
+        static CORE::UInt32 get_sample_interval(void);
+
+        // Return:  The name of the function, such as "get_attribute".
+        //
+        static const char *get_name(InstrumentedFunction function);
+
+        // Returns the counters of every function.
+        //
+        static void get_snapshot(std::vector<FunctionStatistics> &snapshot);
+
+        // Returns the counters of every function and zeroes them, so that
+        // a poller gets the counts since its last poll.  Calls that run
+        // during the reset may be counted in either period.
+        //
+        static void get_snapshot_and_reset(
+            std::vector<FunctionStatistics> &snapshot);
+
+        static void reset(void);
+
+        // Writes a table of the counters.
+        //
+        static void display(std::ostream &stream);
+
+        // Used by the macros below.
+        //
+        // Return:  Should the call that was counted be timed?
+        //
+        static bool record_call(InstrumentedFunction function);
+
+        static void record_latency(
+            InstrumentedFunction function,
+            CORE::UInt64 nanoseconds);
+
+        static void record_cache(InstrumentedFunction function, bool hit);
+    };
+
+    // ------------------------------------------------------------------------
+    // Counts a call for the lifetime of the object and times it when the
+    // call is sampled.
+    // ------------------------------------------------------------------------
+    class InstrumentedCall
+    {
+      public:
+
+        explicit InstrumentedCall(InstrumentedFunction function);
+
+        ~InstrumentedCall(void);
+
+      private:
+
+        InstrumentedCall(const InstrumentedCall &);
+        InstrumentedCall &operator=(const InstrumentedCall &);
+
+        InstrumentedFunction
+            function;
+        bool
+            sampled;
+        std::chrono::steady_clock::time_point
+            start;
+    };
+
+    // ------------------------------------------------------------------------
+    inline InstrumentedCall::InstrumentedCall(InstrumentedFunction function) :
+        function(function),
+        sampled(Instrumentation::record_call(function))
+    {
+        if (sampled)
+        {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    inline InstrumentedCall::~InstrumentedCall(void)
+    {
+        if (sampled)
+        {
+            Instrumentation::record_latency(
+                function,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count());
+        }
+    }
+}
+
+#if defined(FARM_INSTRUMENTATION)
+
+#define FARM_INSTRUMENT_CALL(function) \
+    FARM::InstrumentedCall \
+        farm_instrumented_call(FARM::instrumented_##function)
+
+#define FARM_INSTRUMENT_CACHE(function, hit) \
+    FARM::Instrumentation::record_cache(FARM::instrumented_##function, hit)
+
+#else
+
+#define FARM_INSTRUMENT_CALL(function)
+
+#define FARM_INSTRUMENT_CACHE(function, hit)
+
+#endif
+
+#endif
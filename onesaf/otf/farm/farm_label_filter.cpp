@@ -0,0 +1,268 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#include <cmath>
+
+#include "farm_label_filter.h"
+
+namespace
+{
+    const CORE::UInt64
+        fnv_offset_basis = 14695981039346656037ULL,
+        fnv_prime = 1099511628211ULL;
+
+    const int
+        bits_per_label = 10,
+        default_hash_count = 7;     // Optimal for ten bits per label
+
+    // Double hashing can only choose on the order of (bits * bits) sets of
+    // bits, which raises the false positive rate of very small filters.  So
+    // a filter is at least a cache line.
+    //
+    const CORE::UInt64
+        minimum_bit_count = 512;
+
+    // ------------------------------------------------------------------------
+    // Return:  The hash updated with the bytes of the string.
+    //
+    CORE::UInt64 fnv1a(const std::string &string, CORE::UInt64 hash)
+    {
+        for (std::string::size_type i = 0; i < string.size(); ++i)
+        {
+            hash ^= static_cast<unsigned char>(string[i]);
+            hash *= fnv_prime;
+        }
+
+        return hash;
+    }
+
+    // ------------------------------------------------------------------------
+    // FNV-1a leaves labels that only differ at the end, such as numbered
+    // labels, close together in the low bits.  The 64 bit finalizer from
+    // MurmurHash3 spreads them out before the bits are chosen.
+    //
+    // Return:  The mixed hash.
+    //
+    CORE::UInt64 mix(CORE::UInt64 hash)
+    {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 33;
+
+        return hash;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The hash of a pair of labels.  A separator that cannot be in
+    //          a label keeps ("AB", "C") apart from ("A", "BC").
+    //
+    CORE::UInt64 fnv1a(const std::string &first, const std::string &second)
+    {
+        CORE::UInt64
+            hash = fnv1a(first, fnv_offset_basis);
+
+        hash ^= 0x1f;
+        hash *= fnv_prime;
+
+        return fnv1a(second, hash);
+    }
+}
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    LabelFilter::LabelFilter(const std::string &name) :
+        name(name),
+        bit_mask(0),
+        labels(0),
+        hash_count(default_hash_count),
+        queries(0),
+        rejected(0),
+        false_positives(0)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    void LabelFilter::reset(std::size_t label_count)
+    {
+        CORE::UInt64
+            bit_count = minimum_bit_count;
+
+        while (bit_count < label_count * bits_per_label)
+        {
+            bit_count <<= 1;
+        }
+
+        words.assign(bit_count / 64, 0);
+        bit_mask = bit_count - 1;
+        labels = 0;
+
+        reset_statistics();
+    }
+
+    // ------------------------------------------------------------------------
+    void LabelFilter::clear(void)
+    {
+        std::vector<CORE::UInt64>().swap(words);
+        bit_mask = 0;
+        labels = 0;
+
+        reset_statistics();
+    }
+
+    // ------------------------------------------------------------------------
+    void LabelFilter::add(const std::string &label)
+    {
+        add_hash(fnv1a(label, fnv_offset_basis));
+    }
+
+    // ------------------------------------------------------------------------
+    void LabelFilter::add(const std::string &first, const std::string &second)
+    {
+        add_hash(fnv1a(first, second));
+    }
+
+    // ------------------------------------------------------------------------
+    bool LabelFilter::may_contain(const std::string &label) const
+    {
+        return may_contain_hash(fnv1a(label, fnv_offset_basis));
+    }
+
+    // ------------------------------------------------------------------------
+    bool LabelFilter::may_contain(
+        const std::string &first,
+        const std::string &second
+    ) const
+    {
+        return may_contain_hash(fnv1a(first, second));
+    }
+
+    // ------------------------------------------------------------------------
+    void LabelFilter::record_false_positive(void) const
+    {
+#if defined(FARM_INSTRUMENTATION)
+        false_positives.fetch_add(1, std::memory_order_relaxed);
+#endif
+    }
+
+    // ------------------------------------------------------------------------
+    LabelFilterStatistics LabelFilter::get_statistics(void) const
+    {
+        LabelFilterStatistics
+            statistics;
+
+        statistics.name = name;
+        statistics.labels = labels;
+        statistics.bits = words.size() * 64;
+        statistics.hash_count = hash_count;
+        statistics.queries = queries.load(std::memory_order_relaxed);
+        statistics.rejected = rejected.load(std::memory_order_relaxed);
+        statistics.false_positives =
+            false_positives.load(std::memory_order_relaxed);
+
+        const CORE::Int64
+            misses = statistics.rejected + statistics.false_positives;
+
+        statistics.false_positive_rate =
+            misses ?
+                static_cast<double>(statistics.false_positives) / misses :
+                0.0;
+
+        // (1 - e^(-kn/m))^k
+        //
+        statistics.expected_false_positive_rate =
+            statistics.bits ?
+                std::pow(
+                    1.0 - std::exp(
+                        -static_cast<double>(hash_count * labels) /
+                            statistics.bits),
+                    hash_count) :
+                0.0;
+
+        return statistics;
+    }
+
+    // ------------------------------------------------------------------------
+    void LabelFilter::reset_statistics(void)
+    {
+        queries = 0;
+        rejected = 0;
+        false_positives = 0;
+    }
+
+    // ------------------------------------------------------------------------
+    void LabelFilter::add_hash(const CORE::UInt64 &hash)
+    {
+        if (words.empty())
+        {
+            // The filter was not sized, so size it for a small table.
+            //
+            reset(0);
+        }
+
+        const CORE::UInt64
+            mixed = mix(hash),
+            h1 = mixed,
+            h2 = (mixed >> 32) | 1;
+
+        for (int i = 0; i < hash_count; ++i)
+        {
+            const CORE::UInt64
+                bit = (h1 + i * h2 + (i * i * i - i) / 6) & bit_mask;
+
+            words[bit >> 6] |= CORE::UInt64(1) << (bit & 63);
+        }
+
+        ++labels;
+    }
+
+    // ------------------------------------------------------------------------
+    bool LabelFilter::may_contain_hash(const CORE::UInt64 &hash) const
+    {
+        bool
+            found = not words.empty();
+
+#if defined(FARM_INSTRUMENTATION)
+        queries.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+        const CORE::UInt64
+            mixed = mix(hash),
+            h1 = mixed,
+            h2 = (mixed >> 32) | 1;
+
+        for (int i = 0; found and i < hash_count; ++i)
+        {
+            const CORE::UInt64
+                bit = (h1 + i * h2 + (i * i * i - i) / 6) & bit_mask;
+
+            found = words[bit >> 6] & (CORE::UInt64(1) << (bit & 63));
+        }
+
+#if defined(FARM_INSTRUMENTATION)
+        if (not found)
+        {
+            rejected.fetch_add(1, std::memory_order_relaxed);
+        }
+#endif
+
+        return found;
+    }
+}
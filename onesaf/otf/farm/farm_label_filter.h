@@ -0,0 +1,184 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef FARM_LABEL_FILTER_H
+#define FARM_LABEL_FILTER_H
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/sys_types.h"
+
+namespace FARM
+{
+    // The counters of a LabelFilter.  A false positive is a label that passed
+    // the filter but was not in the table.
+    //
+    struct LabelFilterStatistics
+    {
+        std::string
+            name;
+        CORE::Int64
+            labels,
+            bits,
+            hash_count,
+            queries,
+            rejected,           // Lookups answered by the filter alone
+            false_positives;
+        double
+            false_positive_rate,            // Measured over the misses
+            expected_false_positive_rate;   // For the size of the filter
+    };
+
+    // ------------------------------------------------------------------------
+    // A Bloom filter that is built next to a label table so that a lookup of
+    // an unknown label can be rejected without searching the table.  A label
+    // that is in the table always passes.  Labels are hashed with 64 bit
+    // FNV-1a, and the bits are chosen by enhanced double hashing.  About ten
+    // bits are used per label, which rejects about 99% of unknown labels.
+    //
+    // The filter must be built before it is shared between threads; lookups
+    // may then run concurrently.  The query counters are shared by every
+    // thread, so they are only updated when FARM_INSTRUMENTATION is defined
+    // and are zero otherwise.
+    // ------------------------------------------------------------------------
+    class LabelFilter
+    {
+      public:
+
+        LabelFilter(const std::string &name);
+
+        // Empties the filter and sizes it for the number of labels.
+        //
+        void reset(std::size_t label_count);
+
+        // Empties the filter and releases its memory.
+        //
+        void clear(void);
+
+        void add(const std::string &label);
+
+        // Adds a pair of labels, such as an attribute and enumerant label.
+        //
+        void add(const std::string &first, const std::string &second);
+
+        // Return:  Could the label be in the table?  False is always right.
+        //
+        bool may_contain(const std::string &label) const;
+
+        bool may_contain(
+            const std::string &first,
+            const std::string &second) const;
+
+        // Counts a label that passed the filter but was not in the table.
+        //
+        void record_false_positive(void) const;
+
+        // Return:  The counters and false positive rates of the filter.
+        //
+        LabelFilterStatistics get_statistics(void) const;
+
+        // Zeroes the counters.
+        //
+        void reset_statistics(void);
+
+      private:
+
+        LabelFilter(const LabelFilter &);
+        LabelFilter &operator=(const LabelFilter &);
+
+        void add_hash(const CORE::UInt64 &hash);
+
+        bool may_contain_hash(const CORE::UInt64 &hash) const;
+
+        std::string
+            name;
+        std::vector<CORE::UInt64>
+            words;
+        CORE::UInt64
+            bit_mask;           // The number of bits is a power of two
+        CORE::Int64
+            labels;
+        int
+            hash_count;
+        mutable std::atomic<CORE::Int64>
+            queries,
+            rejected,
+            false_positives;
+    };
+
+    // ------------------------------------------------------------------------
+    // Finds a label in a table that has a filter.  Most unknown labels are
+    // rejected by the filter without searching the table.
+    //
+    // Return:  The entry for the label, or the end of the table.
+    //
+    template <class LabelTable>
+    typename LabelTable::const_iterator find_label(
+        const LabelFilter &filter,
+        const LabelTable &table,
+        const std::string &label
+    )
+    {
+        typename LabelTable::const_iterator
+            table_itr = table.end();
+
+        if (filter.may_contain(label))
+        {
+            table_itr = table.find(label);
+
+            if (table_itr == table.end())
+            {
+                filter.record_false_positive();
+            }
+        }
+
+        return table_itr;
+    }
+
+    // ------------------------------------------------------------------------
+    // Finds a pair of labels in a table that has a filter.
+    //
+    // Return:  The entry for the labels, or the end of the table.
+    //
+    template <class LabelTable>
+    typename LabelTable::const_iterator find_label(
+        const LabelFilter &filter,
+        const LabelTable &table,
+        const std::pair<std::string, std::string> &labels
+    )
+    {
+        typename LabelTable::const_iterator
+            table_itr = table.end();
+
+        if (filter.may_contain(labels.first, labels.second))
+        {
+            table_itr = table.find(labels);
+
+            if (table_itr == table.end())
+            {
+                filter.record_false_positive();
+            }
+        }
+
+        return table_itr;
+    }
+}
+
+#endif
@@ -0,0 +1,399 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#include <algorithm>
+#include <cstring>
+
+#include "core/logger.h"
+#include "farm_label_index.h"
+
+namespace
+{
+    const CORE::UInt64
+        fnv_offset_basis = 14695981039346656037ULL,
+        fnv_prime = 1099511628211ULL;
+
+    // The labels looked up together.  Enough to hide the latency of a cache
+    // miss behind the others, few enough that the prefetched lines are
+    // still in the cache when they are probed.
+    //
+    const std::size_t
+        group_size = 16;
+
+    // Separates the labels of a pair in its hash.  It cannot be in a label.
+    //
+    const unsigned char
+        pair_separator = 0x1f;
+
+    // ------------------------------------------------------------------------
+    // Return:  The hash updated with the bytes.
+    //
+    CORE::UInt64 fnv1a(const char *data, std::size_t size, CORE::UInt64 hash)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= fnv_prime;
+        }
+
+        return hash;
+    }
+
+    // ------------------------------------------------------------------------
+    // Spreads the FNV-1a hash of labels that only differ at the end into the
+    // low bits, which choose the slot.
+    //
+    // Return:  The mixed hash.
+    //
+    CORE::UInt64 mix(CORE::UInt64 hash)
+    {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 33;
+
+        return hash;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The hash of a label, or of a pair of labels if second is not
+    //          null.
+    //
+    CORE::UInt64 hash_labels(
+        const char *first,
+        std::size_t first_size,
+        const char *second,
+        std::size_t second_size
+    )
+    {
+        CORE::UInt64
+            hash = fnv1a(first, first_size, fnv_offset_basis);
+
+        if (second)
+        {
+            hash ^= pair_separator;
+            hash *= fnv_prime;
+            hash = fnv1a(second, second_size, hash);
+        }
+
+        return mix(hash);
+    }
+}
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    LabelIndex::LabelIndex(void) :
+        slot_mask(0),
+        label_count(0)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    void LabelIndex::reset(std::size_t new_label_count)
+    {
+        std::size_t
+            slot_count = 16;
+
+        while (slot_count < 2 * new_label_count)
+        {
+            slot_count *= 2;
+        }
+
+        slots.assign(slot_count, Slot());
+        keys.assign(1, '\0');
+        slot_mask = slot_count - 1;
+        label_count = 0;
+    }
+
+    // ------------------------------------------------------------------------
+    void LabelIndex::clear(void)
+    {
+        std::vector<Slot>().swap(slots);
+        std::vector<char>().swap(keys);
+        slot_mask = 0;
+        label_count = 0;
+    }
+
+    // ------------------------------------------------------------------------
+    void LabelIndex::add(const std::string &label, CORE::Int32 code)
+    {
+        insert(
+            hash_labels(label.data(), label.size(), 0, 0), label, 0, code);
+    }
+
+    // ------------------------------------------------------------------------
+    void LabelIndex::add(
+        const std::string &first,
+        const std::string &second,
+        CORE::Int32 code
+    )
+    {
+        insert(
+            hash_labels(
+                first.data(), first.size(), second.data(), second.size()),
+            first,
+            &second,
+            code);
+    }
+
+    // ------------------------------------------------------------------------
+    void LabelIndex::insert(
+        CORE::UInt64 hash,
+        const std::string &first,
+        const std::string *second,
+        CORE::Int32 code
+    )
+    {
+        const std::size_t
+            key_size = first.size() + (second ? second->size() : 0);
+
+        ASSERT(
+            2 * (label_count + 1) <= slots.size(),
+            fatal,
+            "A label index was not sized for its labels.");
+
+        for (CORE::UInt64 slot = hash & slot_mask; ;
+             slot = (slot + 1) & slot_mask)
+        {
+            Slot
+                &entry = slots[slot];
+
+            if (entry.key == 0)
+            {
+                entry.hash = hash;
+                entry.key = keys.size();
+                entry.first_size = first.size();
+                entry.key_size = key_size;
+                entry.code = code;
+
+                keys.insert(keys.end(), first.begin(), first.end());
+
+                if (second)
+                {
+                    keys.insert(keys.end(), second->begin(), second->end());
+                }
+
+                ++label_count;
+
+                return;
+            }
+
+            if (entry.hash == hash and
+                entry.key_size == key_size and
+                entry.first_size == first.size() and
+                std::memcmp(&keys[entry.key], first.data(), first.size())
+                    == 0 and
+                (not second or
+                    std::memcmp(
+                        &keys[entry.key + first.size()],
+                        second->data(),
+                        second->size()) == 0))
+            {
+                return;
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    std::size_t LabelIndex::find(
+        const LabelView *labels,
+        std::size_t count,
+        CORE::Int32 missing_code,
+        CORE::Int32 *codes,
+        CORE::UInt8 *misses
+    ) const
+    {
+        std::size_t
+            miss_count = 0;
+
+        for (std::size_t first = 0; first < count; first += group_size)
+        {
+            miss_count += find_group(
+                labels + first,
+                0,
+                std::min(group_size, count - first),
+                missing_code,
+                codes + first,
+                misses + first);
+        }
+
+        return miss_count;
+    }
+
+    // ------------------------------------------------------------------------
+    std::size_t LabelIndex::find(
+        const LabelView *first_labels,
+        const LabelView *second_labels,
+        std::size_t count,
+        CORE::Int32 missing_code,
+        CORE::Int32 *codes,
+        CORE::UInt8 *misses
+    ) const
+    {
+        std::size_t
+            miss_count = 0;
+
+        for (std::size_t first = 0; first < count; first += group_size)
+        {
+            miss_count += find_group(
+                first_labels + first,
+                second_labels + first,
+                std::min(group_size, count - first),
+                missing_code,
+                codes + first,
+                misses + first);
+        }
+
+        return miss_count;
+    }
+
+    // ------------------------------------------------------------------------
+    std::size_t LabelIndex::find_group(
+        const LabelView *first_labels,
+        const LabelView *second_labels,
+        std::size_t count,
+        CORE::Int32 missing_code,
+        CORE::Int32 *codes,
+        CORE::UInt8 *misses
+    ) const
+    {
+        CORE::UInt64
+            hashes[group_size];
+        const Slot
+            *found[group_size];
+        std::size_t
+            miss_count = 0;
+
+        if (slots.empty())
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                codes[i] = missing_code;
+                misses[i] = 1;
+            }
+
+            return count;
+        }
+
+        // Hash every label and prefetch its first slot.
+        //
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            hashes[i] = hash_labels(
+                first_labels[i].data,
+                first_labels[i].size,
+                second_labels ? second_labels[i].data : 0,
+                second_labels ? second_labels[i].size : 0);
+
+            __builtin_prefetch(&slots[hashes[i] & slot_mask]);
+        }
+
+        // Find the slot whose hash matches, and prefetch its label.
+        //
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            found[i] = find_slot(
+                hashes[i],
+                first_labels[i],
+                second_labels ? &second_labels[i] : 0,
+                hashes[i] & slot_mask);
+
+            if (found[i])
+            {
+                __builtin_prefetch(&keys[found[i]->key]);
+            }
+        }
+
+        // Compare the labels.  Two labels rarely share a 64 bit hash, so
+        // after a mismatch the probe goes on one slot at a time.
+        //
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Slot
+                *slot = found[i];
+
+            while (slot and not same_labels(
+                *slot,
+                first_labels[i],
+                second_labels ? &second_labels[i] : 0))
+            {
+                slot = find_slot(
+                    hashes[i],
+                    first_labels[i],
+                    second_labels ? &second_labels[i] : 0,
+                    slot - &slots[0] + 1);
+            }
+
+            codes[i] = slot ? slot->code : missing_code;
+            misses[i] = slot == 0;
+            miss_count += slot == 0;
+        }
+
+        return miss_count;
+    }
+
+    // ------------------------------------------------------------------------
+    const LabelIndex::Slot *LabelIndex::find_slot(
+        CORE::UInt64 hash,
+        const LabelView &first,
+        const LabelView *second,
+        CORE::UInt64 slot
+    ) const
+    {
+        const std::size_t
+            key_size = first.size + (second ? second->size : 0);
+
+        for (slot &= slot_mask;
+             slots[slot].key != 0;
+             slot = (slot + 1) & slot_mask)
+        {
+            if (slots[slot].hash == hash and
+                slots[slot].key_size == key_size and
+                slots[slot].first_size == first.size)
+            {
+                return &slots[slot];
+            }
+        }
+
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------
+    bool LabelIndex::same_labels(
+        const Slot &slot,
+        const LabelView &first,
+        const LabelView *second
+    ) const
+    {
+        return
+            std::memcmp(&keys[slot.key], first.data, first.size) == 0 and
+            (not second or
+                std::memcmp(
+                    &keys[slot.key + slot.first_size],
+                    second->data,
+                    second->size) == 0);
+    }
+
+    // ------------------------------------------------------------------------
+    std::size_t LabelIndex::get_bytes(void) const
+    {
+        return slots.capacity() * sizeof(Slot) + keys.capacity();
+    }
+}
@@ -0,0 +1,183 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef FARM_LABEL_INDEX_H
+#define FARM_LABEL_INDEX_H
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "core/sys_types.h"
+
+namespace FARM
+{
+    // A label in the caller's memory, such as a field of a record read from
+    // a terrain source file.  The label does not have to end with a null.
+    //
+    struct LabelView
+    {
+        const char
+            *data;
+        std::size_t
+            size;
+    };
+
+    // Return:  A view of the string, valid until the string changes.
+    //
+    inline LabelView make_label_view(const std::string &label)
+    {
+        LabelView
+            view;
+
+        view.data = label.data();
+        view.size = label.size();
+
+        return view;
+    }
+
+    // ------------------------------------------------------------------------
+    // An open addressed hash table from labels, or pairs of labels, to codes,
+    // for looking up many labels at once.  A batch is looked up a group at a
+    // time: the slots of every label of the group are hashed and prefetched
+    // before any is probed, so the cache misses of the group overlap rather
+    // than follow one another.  The labels are 64 bit FNV-1a hashed, and the
+    // table is at most half full.
+    //
+    // The index must be built before it is shared between threads; lookups
+    // may then run concurrently.
+    // ------------------------------------------------------------------------
+    class LabelIndex
+    {
+      public:
+
+        LabelIndex(void);
+
+        // Empties the index and sizes it for the number of labels.
+        //
+        void reset(std::size_t new_label_count);
+
+        // Empties the index and releases its memory.
+        //
+        void clear(void);
+
+        // Adds a label.  Only the first code of a label is kept.
+        //
+        void add(const std::string &label, CORE::Int32 code);
+
+        // Adds a pair of labels, such as an attribute and enumerant label.
+        //
+        void add(
+            const std::string &first,
+            const std::string &second,
+            CORE::Int32 code
+        );
+
+        // Finds the codes of a batch of labels.  A label that is not in the
+        // index gets the code missing_code and a miss of 1; the others get
+        // a miss of 0.
+        //
+        // Return:  The number of labels that were not found.
+        //
+        std::size_t find(
+            const LabelView *labels,
+            std::size_t count,
+            CORE::Int32 missing_code,
+            CORE::Int32 *codes,
+            CORE::UInt8 *misses
+        ) const;
+
+        // Finds the codes of a batch of pairs of labels.
+        //
+        // Return:  The number of pairs that were not found.
+        //
+        std::size_t find(
+            const LabelView *first_labels,
+            const LabelView *second_labels,
+            std::size_t count,
+            CORE::Int32 missing_code,
+            CORE::Int32 *codes,
+            CORE::UInt8 *misses
+        ) const;
+
+        // Return:  The heap bytes of the index.
+        //
+        std::size_t get_bytes(void) const;
+
+      private:
+
+        struct Slot
+        {
+            CORE::UInt64
+                hash;
+            CORE::UInt32
+                key,            // Offset of the label in keys; 0 if empty
+                first_size;     // Size of the first label of a pair
+            CORE::UInt32
+                key_size;
+            CORE::Int32
+                code;
+        };
+
+        void insert(
+            CORE::UInt64 hash,
+            const std::string &first,
+            const std::string *second,
+            CORE::Int32 code
+        );
+
+        // Return:  The first slot from the given one on whose hash and sizes
+        //          match the labels, or null if an empty slot comes first.
+        //
+        const Slot *find_slot(
+            CORE::UInt64 hash,
+            const LabelView &first,
+            const LabelView *second,
+            CORE::UInt64 slot
+        ) const;
+
+        // Return:  Does the slot hold the labels?
+        //
+        bool same_labels(
+            const Slot &slot,
+            const LabelView &first,
+            const LabelView *second
+        ) const;
+
+        // Finds one group of labels.
+        //
+        std::size_t find_group(
+            const LabelView *first_labels,
+            const LabelView *second_labels,
+            std::size_t count,
+            CORE::Int32 missing_code,
+            CORE::Int32 *codes,
+            CORE::UInt8 *misses
+        ) const;
+
+        std::vector<Slot>
+            slots;
+        std::vector<char>
+            keys;               // The labels, after a leading null
+        CORE::UInt64
+            slot_mask;
+        std::size_t
+            label_count;
+    };
+}
+
+#endif
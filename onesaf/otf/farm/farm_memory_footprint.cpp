@@ -0,0 +1,359 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "farm_memory_footprint.h"
+
+namespace
+{
+    // ------------------------------------------------------------------------
+    // Return:  The ratio, or 1 if there is nothing to compare.
+    //
+    double get_ratio(CORE::Int64 total, CORE::Int64 distinct)
+    {
+        return distinct > 0 ? static_cast<double>(total) / distinct : 1.0;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  Does the feature use more memory than the other one?
+    //
+    bool larger_feature(
+        const FARM::FeatureFootprint &feature,
+        const FARM::FeatureFootprint &other)
+    {
+        return feature.bytes > other.bytes;
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes a count with a sign.
+    //
+    void write_change(std::ostream &stream, int width, CORE::Int64 change)
+    {
+        std::ostringstream
+            text;
+
+        text << (change > 0 ? "+" : "") << change;
+        stream << std::setw(width) << text.str();
+    }
+}
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    double StructureFootprint::get_duplication_ratio(void) const
+    {
+        return get_ratio(elements, distinct_elements);
+    }
+
+    // ------------------------------------------------------------------------
+    double StructureFootprint::get_string_duplication_ratio(void) const
+    {
+        return get_ratio(string_bytes, unique_string_bytes);
+    }
+
+    // ------------------------------------------------------------------------
+    MemoryFootprint::MemoryFootprint(void) :
+        bytes(0),
+        allocations(0),
+        string_bytes(0),
+        unique_string_bytes(0)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    void MemoryFootprint::clear(void)
+    {
+        structures.clear();
+        features.clear();
+        bytes = 0;
+        allocations = 0;
+        string_bytes = 0;
+        unique_string_bytes = 0;
+    }
+
+    // ------------------------------------------------------------------------
+    void MemoryFootprint::display(
+        std::ostream &stream,
+        int largest_features
+    ) const
+    {
+        std::ios::fmtflags
+            flags = stream.flags();
+
+        stream << std::left << std::setw(40) << "structure" << std::right <<
+            std::setw(12) << "bytes" << std::setw(10) << "allocs" <<
+            std::setw(10) << "elements" << std::setw(8) << "dup" <<
+            std::setw(12) << "str bytes" << std::setw(8) << "str dup" <<
+            std::endl;
+
+        for (std::vector<StructureFootprint>::size_type i = 0;
+             i < structures.size(); ++i)
+        {
+            const StructureFootprint
+                &structure = structures[i];
+
+            stream << std::left << std::setw(40) << structure.name <<
+                std::right << std::setw(12) << structure.bytes <<
+                std::setw(10) << structure.allocations <<
+                std::setw(10) << structure.elements << std::fixed <<
+                std::setprecision(2) << std::setw(8) <<
+                structure.get_duplication_ratio() << std::setw(12) <<
+                structure.string_bytes << std::setw(8) <<
+                structure.get_string_duplication_ratio() << std::endl;
+        }
+
+        stream << std::left << std::setw(40) << "total" << std::right <<
+            std::setw(12) << bytes << std::setw(10) << allocations <<
+            std::setw(18) << "" << std::setw(12) << string_bytes <<
+            std::setw(8) << get_ratio(string_bytes, unique_string_bytes) <<
+            std::endl;
+
+        std::vector<FeatureFootprint>
+            largest(features);
+        std::vector<FeatureFootprint>::size_type
+            count = std::min<std::vector<FeatureFootprint>::size_type>(
+                largest.size(), std::max(largest_features, 0));
+
+        std::partial_sort(
+            largest.begin(),
+            largest.begin() + count,
+            largest.end(),
+            larger_feature);
+
+        if (count > 0)
+        {
+            stream << std::endl << std::left << std::setw(40) <<
+                "feature category" << std::right << std::setw(12) <<
+                "bytes" << std::setw(10) << "allocs" << std::setw(10) <<
+                "attribs" << std::setw(10) << "enums" << std::endl;
+        }
+
+        for (std::vector<FeatureFootprint>::size_type i = 0; i < count; ++i)
+        {
+            const FeatureFootprint
+                &feature = largest[i];
+            std::ostringstream
+                name;
+
+            name << feature.category << " " << feature.label << " " <<
+                feature.geometry;
+
+            stream << std::left << std::setw(40) << name.str() <<
+                std::right << std::setw(12) << feature.bytes <<
+                std::setw(10) << feature.allocations << std::setw(10) <<
+                feature.attributes << std::setw(10) << feature.enumerants <<
+                std::endl;
+        }
+
+        stream.flags(flags);
+    }
+
+    // ------------------------------------------------------------------------
+    void MemoryFootprint::display_difference(
+        const MemoryFootprint &baseline,
+        std::ostream &stream
+    ) const
+    {
+        std::map<std::string, const StructureFootprint *>
+            baseline_structures;
+        std::ios::fmtflags
+            flags = stream.flags();
+
+        for (std::vector<StructureFootprint>::size_type i = 0;
+             i < baseline.structures.size(); ++i)
+        {
+            baseline_structures[baseline.structures[i].name] =
+                &baseline.structures[i];
+        }
+
+        stream << std::left << std::setw(40) << "structure" << std::right <<
+            std::setw(12) << "baseline" << std::setw(12) << "bytes" <<
+            std::setw(12) << "change" << std::setw(10) << "allocs" <<
+            std::endl;
+
+        for (std::vector<StructureFootprint>::size_type i = 0;
+             i < structures.size(); ++i)
+        {
+            const StructureFootprint
+                &structure = structures[i];
+            std::map<std::string, const StructureFootprint *>::iterator
+                found = baseline_structures.find(structure.name);
+            CORE::Int64
+                baseline_bytes = 0,
+                baseline_allocations = 0;
+
+            if (found != baseline_structures.end())
+            {
+                baseline_bytes = found->second->bytes;
+                baseline_allocations = found->second->allocations;
+                baseline_structures.erase(found);
+            }
+
+            stream << std::left << std::setw(40) << structure.name <<
+                std::right << std::setw(12) << baseline_bytes <<
+                std::setw(12) << structure.bytes;
+            write_change(stream, 12, structure.bytes - baseline_bytes);
+            write_change(
+                stream, 10, structure.allocations - baseline_allocations);
+            stream << std::endl;
+        }
+
+        // Structures that are only in the baseline.
+        //
+        for (std::map<std::string, const StructureFootprint *>::iterator
+                 structure = baseline_structures.begin();
+             structure != baseline_structures.end(); ++structure)
+        {
+            stream << std::left << std::setw(40) << structure->first <<
+                std::right << std::setw(12) << structure->second->bytes <<
+                std::setw(12) << 0;
+            write_change(stream, 12, -structure->second->bytes);
+            write_change(stream, 10, -structure->second->allocations);
+            stream << std::endl;
+        }
+
+        stream << std::left << std::setw(40) << "total" << std::right <<
+            std::setw(12) << baseline.bytes << std::setw(12) << bytes;
+        write_change(stream, 12, bytes - baseline.bytes);
+        write_change(stream, 10, allocations - baseline.allocations);
+        stream << std::endl;
+
+        stream.flags(flags);
+    }
+
+    // ------------------------------------------------------------------------
+    FootprintAccumulator::FootprintAccumulator(MemoryFootprint &footprint) :
+        footprint(footprint),
+        distinct_elements(0),
+        bytes(0),
+        allocations(0)
+    {
+        footprint.clear();
+    }
+
+    // ------------------------------------------------------------------------
+    void FootprintAccumulator::begin_structure(const std::string &name)
+    {
+        structure = StructureFootprint();
+        structure.name = name;
+        structure.elements = 0;
+        structure.distinct_elements = 0;
+        structure.bytes = 0;
+        structure.allocations = 0;
+        structure.strings = 0;
+        structure.string_bytes = 0;
+        structure.unique_string_bytes = 0;
+
+        elements.clear();
+        strings.clear();
+        distinct_elements = 0;
+    }
+
+    // ------------------------------------------------------------------------
+    void FootprintAccumulator::end_structure(void)
+    {
+        structure.distinct_elements = elements.size() + distinct_elements;
+
+        footprint.structures.push_back(structure);
+        footprint.bytes += structure.bytes;
+        footprint.allocations += structure.allocations;
+        footprint.string_bytes += structure.string_bytes;
+
+        elements.clear();
+        strings.clear();
+    }
+
+    // ------------------------------------------------------------------------
+    void FootprintAccumulator::add_bytes(std::size_t object_bytes)
+    {
+        structure.bytes += object_bytes;
+        bytes += object_bytes;
+    }
+
+    // ------------------------------------------------------------------------
+    void FootprintAccumulator::add_allocation(std::size_t requested_bytes)
+    {
+        std::size_t
+            block_bytes = get_block_bytes(requested_bytes);
+
+        structure.bytes += block_bytes;
+        structure.allocations++;
+        bytes += block_bytes;
+        allocations++;
+    }
+
+    // ------------------------------------------------------------------------
+    void FootprintAccumulator::add_string(const std::string &string)
+    {
+        const char
+            *data = string.data(),
+            *object = reinterpret_cast<const char *>(&string);
+
+        // A short string is stored in the string object.
+        //
+        if (data < object or data >= object + sizeof(string))
+        {
+            add_allocation(string.capacity() + 1);
+        }
+
+        structure.strings++;
+        structure.string_bytes += string.size();
+
+        if (strings.insert(string).second)
+        {
+            structure.unique_string_bytes += string.size();
+        }
+
+        if (all_strings.insert(string).second)
+        {
+            footprint.unique_string_bytes += string.size();
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    void FootprintAccumulator::add_element(const std::string &key)
+    {
+        structure.elements++;
+        elements.insert(key);
+    }
+
+    // ------------------------------------------------------------------------
+    void FootprintAccumulator::add_distinct_elements(CORE::Int64 count)
+    {
+        structure.elements += count;
+        distinct_elements += count;
+    }
+
+    // ------------------------------------------------------------------------
+    std::size_t FootprintAccumulator::get_block_bytes(
+        std::size_t requested_bytes)
+    {
+        const std::size_t
+            header_bytes = sizeof(std::size_t),
+            alignment = 2 * sizeof(std::size_t),
+            minimum_bytes = 4 * sizeof(std::size_t);
+
+        return std::max(
+            minimum_bytes,
+            (requested_bytes + header_bytes + alignment - 1) &
+                ~(alignment - 1));
+    }
+}
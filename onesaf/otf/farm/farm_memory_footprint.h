@@ -0,0 +1,229 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef FARM_MEMORY_FOOTPRINT_H
+#define FARM_MEMORY_FOOTPRINT_H
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/sys_types.h"
+#include "farm_feature.h"
+
+namespace FARM
+{
+    // The memory of one FARM structure.  An element is an entry of the
+    // structure, such as a map node or a FARM table cell; elements with the
+    // same contents are not distinct.  Bytes count the structure itself and
+    // every heap block it owns, including the allocator overhead.
+    //
+    struct StructureFootprint
+    {
+        std::string
+            name;
+        CORE::Int64
+            elements,
+            distinct_elements,
+            bytes,
+            allocations,
+            strings,
+            string_bytes,           // Characters of the strings
+            unique_string_bytes;    // Characters of the distinct strings
+
+        // Return:  Elements per distinct element; 1 means no duplication.
+        //
+        double get_duplication_ratio(void) const;
+
+        // Return:  String characters per distinct string character.
+        //
+        double get_string_duplication_ratio(void) const;
+    };
+
+    // The FARM table row and feature of one feature category.
+    //
+    struct FeatureFootprint
+    {
+        FeatureCategory
+            category;
+        FeatureLabel
+            label;
+        FeatureGeometry
+            geometry;
+        CORE::Int64
+            attributes,
+            enumerants,
+            bytes,
+            allocations;
+    };
+
+    // ------------------------------------------------------------------------
+    // The memory used by the FARM, by structure and by feature category, as
+    // returned by FeatureAttributeMapping::get_memory_footprint().  The
+    // bytes are estimated from the sizes of the objects and a model of the
+    // heap allocator (a 16 byte aligned block with an 8 byte header), so
+    // footprints taken on the same platform can be compared.
+    // ------------------------------------------------------------------------
+    struct MemoryFootprint
+    {
+        std::vector<StructureFootprint>
+            structures;
+        std::vector<FeatureFootprint>
+            features;
+        CORE::Int64
+            bytes,
+            allocations,
+            string_bytes,
+            unique_string_bytes;    // Across all the structures
+
+        MemoryFootprint(void);
+
+        void clear(void);
+
+        // Writes the structures, the totals, and the count of feature
+        // categories given as the largest.
+        //
+        void display(std::ostream &stream, int largest_features = 10) const;
+
+        // Writes the change of each structure from a footprint taken from
+        // another deployment or before a change.
+        //
+        void display_difference(
+            const MemoryFootprint &baseline,
+            std::ostream &stream
+        ) const;
+    };
+
+    // ------------------------------------------------------------------------
+    // Adds up the memory of the structures one at a time.  Used by the FARM
+    // to fill in a MemoryFootprint.
+    // ------------------------------------------------------------------------
+    class FootprintAccumulator
+    {
+      public:
+
+        FootprintAccumulator(MemoryFootprint &footprint);
+
+        void begin_structure(const std::string &name);
+
+        void end_structure(void);
+
+        // Adds memory that is not on the heap, such as a global object.
+        //
+        void add_bytes(std::size_t bytes);
+
+        // Adds a heap block of the requested size.
+        //
+        void add_allocation(std::size_t requested_bytes);
+
+        // Adds the heap block of a string if it has one.  The string object
+        // itself is counted by its owner.
+        //
+        void add_string(const std::string &string);
+
+        // Adds an element whose contents are described by the key.
+        //
+        void add_element(const std::string &key);
+
+        // Adds elements that are known to be distinct, such as map entries.
+        //
+        void add_distinct_elements(CORE::Int64 count);
+
+        // Adds the nodes of a std::map or std::set, but not the heap blocks
+        // owned by the values.
+        //
+        template<class Tree>
+        void add_tree(const Tree &tree);
+
+        // Adds the array of a std::vector, but not the heap blocks owned by
+        // the values.
+        //
+        template<class Type>
+        void add_vector(const std::vector<Type> &vector);
+
+        // Return:  The bytes and allocations added so far.
+        //
+        CORE::Int64 get_bytes(void) const;
+
+        CORE::Int64 get_allocations(void) const;
+
+        // Return:  The size of the heap block the allocator uses for a
+        //          request of the size.
+        //
+        static std::size_t get_block_bytes(std::size_t requested_bytes);
+
+      private:
+
+        MemoryFootprint
+            &footprint;
+        StructureFootprint
+            structure;
+        std::set<std::string>
+            elements,
+            strings,
+            all_strings;
+        CORE::Int64
+            distinct_elements,
+            bytes,
+            allocations;
+    };
+
+    // ------------------------------------------------------------------------
+    template<class Tree>
+    inline void FootprintAccumulator::add_tree(const Tree &tree)
+    {
+        // A red-black tree node in libstdc++ and libc++ holds the color and
+        // three links before the value.
+        //
+        const std::size_t
+            node_bytes =
+                4 * sizeof(void *) + sizeof(typename Tree::value_type);
+
+        for (std::size_t i = 0; i < tree.size(); ++i)
+        {
+            add_allocation(node_bytes);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    template<class Type>
+    inline void FootprintAccumulator::add_vector(
+        const std::vector<Type> &vector)
+    {
+        if (vector.capacity() > 0)
+        {
+            add_allocation(vector.capacity() * sizeof(Type));
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    inline CORE::Int64 FootprintAccumulator::get_bytes(void) const
+    {
+        return bytes;
+    }
+
+    // ------------------------------------------------------------------------
+    inline CORE::Int64 FootprintAccumulator::get_allocations(void) const
+    {
+        return allocations;
+    }
+}
+
+#endif
@@ -0,0 +1,1287 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+
+#include "core/logger.h"
+#include "farm_binary_codec.h"
+#include "farm_overlay_migration.h"
+
+namespace
+{
+    const char
+        layout_magic[8] = {'F', 'A', 'R', 'M', 'O', 'V', 'L', 'Y'};
+    const CORE::UInt16
+        layout_format = 1;
+
+    // The largest count of categories, attributes, or enumerants that a
+    // layout file is trusted to hold.
+    //
+    const CORE::UInt32
+        maximum_layout_count = 1 << 20;
+
+    typedef std::map<FARM::AttributeLabel, std::size_t>
+        AttributeIndices;
+
+    // ------------------------------------------------------------------------
+    // Return:  The bytes a value of the data type takes in an overlay, or 0
+    // if the data type has no value.
+    //
+    CORE::Int32 get_value_size(FARM::AttributeDataType data_type)
+    {
+        CORE::Int32
+            size = 0;
+
+        switch (data_type)
+        {
+            case FARM::int32:
+            case FARM::boolean:
+            {
+                size = 4;
+                break;
+            }
+
+            case FARM::float64:
+            case FARM::string:
+            case FARM::enumeration:
+            {
+                size = 8;
+                break;
+            }
+
+            case FARM::uuid:
+            {
+                size = 16;
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+
+        return size;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  Is a value of the data type a number that can be converted?
+    //
+    bool is_number(FARM::AttributeDataType data_type)
+    {
+        return
+            data_type == FARM::int32 or
+            data_type == FARM::float64 or
+            data_type == FARM::boolean;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The number at the address in an overlay.
+    //
+    inline CORE::Float64 get_number(
+        const char *address,
+        FARM::AttributeDataType data_type)
+    {
+        CORE::Float64
+            value;
+        CORE::Int32
+            int_value;
+
+        if (data_type == FARM::float64)
+        {
+            std::memcpy(&value, address, sizeof(value));
+        }
+        else
+        {
+            std::memcpy(&int_value, address, sizeof(int_value));
+            value = int_value;
+        }
+
+        return value;
+    }
+
+    // ------------------------------------------------------------------------
+    template<class Type>
+    inline void put_value(char *address, const Type &value)
+    {
+        std::memcpy(address, &value, sizeof(value));
+    }
+
+    // ------------------------------------------------------------------------
+    // Checks that every value of the category lies inside of its overlay and
+    // that the enumerants of each attribute are sorted by code and span no
+    // more codes than a layout file is trusted to hold, so that the programs
+    // built from the category stay inside of the overlays and enumerant
+    // maps.
+    //
+    // Return:  Is the layout of the category usable?
+    //
+    bool check_category(const FARM::OverlayCategoryLayout &category)
+    {
+        bool
+            usable = category.overlay_size >= 0;
+
+        ASSERT_WITH_STREAM(
+            usable,
+            high,
+            "The overlay size " << category.overlay_size << " of '" <<
+                category.label << "' is negative.");
+
+        for (std::vector<FARM::OverlayAttributeLayout>::const_iterator
+                 attribute = category.attributes.begin();
+             usable and attribute != category.attributes.end(); ++attribute)
+        {
+            const CORE::Int32
+                size = get_value_size(attribute->data_type);
+
+            usable =
+                size > 0 and
+                attribute->offset >= 0 and
+                attribute->offset <= category.overlay_size - size;
+
+            ASSERT_WITH_STREAM(
+                usable,
+                high,
+                "The " << size << " byte value of '" << attribute->label <<
+                    "' at offset " << attribute->offset <<
+                    " is not inside of the " << category.overlay_size <<
+                    " byte overlay of '" << category.label << "'.");
+
+            for (std::vector<FARM::OverlayAttributeLayout>::size_type i = 1;
+                 usable and i < attribute->enumerants.size(); ++i)
+            {
+                usable =
+                    attribute->enumerants[i - 1].first <
+                        attribute->enumerants[i].first and
+                    static_cast<CORE::Int64>(attribute->enumerants[i].first) -
+                        attribute->enumerants.front().first <
+                        maximum_layout_count;
+
+                ASSERT_WITH_STREAM(
+                    usable,
+                    high,
+                    "The enumerant codes of '" << attribute->label <<
+                        "' in '" << category.label <<
+                        "' are not sorted or span too many codes.");
+            }
+        }
+
+        return usable;
+    }
+
+    // ------------------------------------------------------------------------
+    // Builds the overlay that holds the default of every attribute of the
+    // category, as EDCSMigration does.
+    //
+    void build_default_overlay(
+        const FARM::OverlayCategoryLayout &category,
+        std::vector<char> &overlay)
+    {
+        overlay.assign(std::max<CORE::Int32>(category.overlay_size, 0), 0);
+
+        for (std::vector<FARM::OverlayAttributeLayout>::const_iterator
+                 attribute = category.attributes.begin();
+             attribute != category.attributes.end(); ++attribute)
+        {
+            if (attribute->offset < 0 or
+                attribute->offset + get_value_size(attribute->data_type) >
+                    category.overlay_size)
+            {
+                continue;
+            }
+
+            char
+                *address = &overlay[attribute->offset];
+
+            switch (attribute->data_type)
+            {
+                case FARM::int32:
+                case FARM::boolean:
+                {
+                    put_value(
+                        address,
+                        static_cast<CORE::Int32>(attribute->default_value));
+                    break;
+                }
+
+                case FARM::float64:
+                {
+                    put_value(address, attribute->default_value);
+                    break;
+                }
+
+                case FARM::enumeration:
+                {
+                    put_value(
+                        address, static_cast<CORE::Int32>(attribute->code));
+                    put_value(
+                        address + sizeof(CORE::Int32),
+                        static_cast<CORE::Int32>(
+                            attribute->default_enumerant));
+                    break;
+                }
+
+                case FARM::string:
+                {
+                    put_value(address, static_cast<CORE::Int32>(-1));
+                    break;
+                }
+
+                default:
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Builds the map of the source enumerant codes to the target codes of
+    // the enumerants with the same labels.
+    //
+    // Return:  Does every source enumerant keep its code?
+    //
+    bool build_enumerant_map(
+        const FARM::OverlayAttributeLayout &source,
+        const FARM::OverlayAttributeLayout &target,
+        FARM::MigrationStep &step)
+    {
+        std::map<FARM::EnumerantLabel, FARM::EnumerantCode>
+            target_codes;
+        bool
+            unchanged = true;
+
+        step.first_enumerant = 0;
+        step.enumerant_map.clear();
+
+        for (std::vector<std::pair<FARM::EnumerantCode, FARM::EnumerantLabel> >
+                 ::const_iterator enumerant = target.enumerants.begin();
+             enumerant != target.enumerants.end(); ++enumerant)
+        {
+            target_codes[enumerant->second] = enumerant->first;
+        }
+
+        if (not source.enumerants.empty())
+        {
+            // The enumerants are sorted by code, as check_category() made
+            // sure.
+            //
+            step.first_enumerant = source.enumerants.front().first;
+            step.enumerant_map.assign(
+                source.enumerants.back().first - step.first_enumerant + 1,
+                -1);
+        }
+
+        for (std::vector<std::pair<FARM::EnumerantCode, FARM::EnumerantLabel> >
+                 ::const_iterator enumerant = source.enumerants.begin();
+             enumerant != source.enumerants.end(); ++enumerant)
+        {
+            std::map<FARM::EnumerantLabel, FARM::EnumerantCode>::const_iterator
+                target_code = target_codes.find(enumerant->second);
+            FARM::EnumerantCode
+                code =
+                    target_code == target_codes.end() ?
+                        -1 : target_code->second;
+
+            step.enumerant_map[enumerant->first - step.first_enumerant] = code;
+            unchanged = unchanged and code == enumerant->first;
+        }
+
+        return unchanged;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The step that migrates a source attribute to the target
+    // attribute with the same label.
+    //
+    FARM::MigrationStep build_step(
+        const FARM::OverlayAttributeLayout &source,
+        const FARM::OverlayAttributeLayout &target)
+    {
+        FARM::MigrationStep
+            step;
+
+        step.operation = FARM::migrate_fill_default;
+        step.label = source.label;
+        step.source_type = source.data_type;
+        step.target_type = target.data_type;
+        step.source_offset = source.offset;
+        step.target_offset = target.offset;
+        step.size = get_value_size(target.data_type);
+        step.target_code = target.code;
+        step.minimum = target.minimum;
+        step.maximum = target.maximum;
+        step.first_enumerant = 0;
+
+        if (source.data_type == target.data_type)
+        {
+            switch (source.data_type)
+            {
+                case FARM::int32:
+                case FARM::float64:
+                {
+                    // Values outside of a narrower range are replaced.
+                    //
+                    step.operation =
+                        target.minimum <= source.minimum and
+                        source.maximum <= target.maximum ?
+                            FARM::migrate_copy_bytes :
+                            FARM::migrate_convert_value;
+                    break;
+                }
+
+                case FARM::boolean:
+                case FARM::string:
+                case FARM::uuid:
+                {
+                    step.operation = FARM::migrate_copy_bytes;
+                    break;
+                }
+
+                case FARM::enumeration:
+                {
+                    step.operation =
+                        build_enumerant_map(source, target, step) and
+                        source.code == target.code ?
+                            FARM::migrate_copy_bytes :
+                            FARM::migrate_remap_enumerant;
+                    break;
+                }
+
+                default:
+                {
+                    break;
+                }
+            }
+        }
+        else if (is_number(source.data_type) and is_number(target.data_type))
+        {
+            step.operation = FARM::migrate_convert_value;
+        }
+
+        if (step.operation == FARM::migrate_copy_bytes)
+        {
+            step.enumerant_map.clear();
+        }
+
+        return step;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  Does the copy come before the other one in the source?
+    //
+    bool earlier_copy(
+        const FARM::MigrationStep &copy,
+        const FARM::MigrationStep &other)
+    {
+        return copy.source_offset < other.source_offset;
+    }
+
+    // ------------------------------------------------------------------------
+    // Merges the copies of neighboring values into spans.
+    //
+    void merge_copies(std::vector<FARM::MigrationStep> &copies)
+    {
+        std::vector<FARM::MigrationStep>::size_type
+            merged = 0;
+
+        std::sort(copies.begin(), copies.end(), earlier_copy);
+
+        for (std::vector<FARM::MigrationStep>::size_type i = 0;
+             i < copies.size(); ++i)
+        {
+            if (merged > 0 and
+                copies[merged - 1].source_offset + copies[merged - 1].size ==
+                    copies[i].source_offset and
+                copies[merged - 1].target_offset + copies[merged - 1].size ==
+                    copies[i].target_offset)
+            {
+                copies[merged - 1].size += copies[i].size;
+                copies[merged - 1].label.clear();
+                copies[merged - 1].source_type = FARM::no_data_type;
+                copies[merged - 1].target_type = FARM::no_data_type;
+            }
+            else
+            {
+                copies[merged++] = copies[i];
+            }
+        }
+
+        copies.resize(merged);
+    }
+
+    // ------------------------------------------------------------------------
+    // Builds the program of a source category.  The target is 0 if the
+    // feature is not in the target FARM.
+    //
+    void build_category(
+        const FARM::OverlayCategoryLayout &source,
+        const FARM::OverlayCategoryLayout *target,
+        FARM::CategoryMigration &migration)
+    {
+        std::vector<FARM::MigrationStep>
+            copies,
+            others;
+        AttributeIndices
+            target_indices;
+        std::vector<bool>
+            matched;
+
+        migration.source_category = source.category;
+        migration.target_category = target ? target->category : -1;
+        migration.label = source.label;
+        migration.geometry = source.geometry;
+        migration.source_size = source.overlay_size;
+        migration.target_size = target ? target->overlay_size : 0;
+        migration.unchanged = false;
+        migration.default_overlay.clear();
+        migration.steps.clear();
+
+        if (not target)
+        {
+            return;
+        }
+
+        build_default_overlay(*target, migration.default_overlay);
+
+        for (std::vector<FARM::OverlayAttributeLayout>::size_type i = 0;
+             i < target->attributes.size(); ++i)
+        {
+            target_indices[target->attributes[i].label] = i;
+        }
+
+        matched.assign(target->attributes.size(), false);
+
+        for (std::vector<FARM::OverlayAttributeLayout>::const_iterator
+                 attribute = source.attributes.begin();
+             attribute != source.attributes.end(); ++attribute)
+        {
+            AttributeIndices::const_iterator
+                index = target_indices.find(attribute->label);
+
+            if (index == target_indices.end())
+            {
+                FARM::MigrationStep
+                    step =
+                        build_step(*attribute, *attribute);
+
+                step.operation = FARM::migrate_drop_value;
+                step.target_type = FARM::no_data_type;
+                step.target_offset = -1;
+                step.enumerant_map.clear();
+                others.push_back(step);
+            }
+            else
+            {
+                FARM::MigrationStep
+                    step =
+                        build_step(
+                            *attribute, target->attributes[index->second]);
+
+                matched[index->second] = true;
+
+                if (step.operation == FARM::migrate_copy_bytes)
+                {
+                    copies.push_back(step);
+                }
+                else
+                {
+                    others.push_back(step);
+                }
+            }
+        }
+
+        // The new attributes keep the defaults.
+        //
+        for (std::vector<FARM::OverlayAttributeLayout>::size_type i = 0;
+             i < target->attributes.size(); ++i)
+        {
+            if (not matched[i])
+            {
+                FARM::MigrationStep
+                    step =
+                        build_step(
+                            target->attributes[i], target->attributes[i]);
+
+                step.operation = FARM::migrate_fill_default;
+                step.source_type = FARM::no_data_type;
+                step.source_offset = -1;
+                step.enumerant_map.clear();
+                others.push_back(step);
+            }
+        }
+
+        merge_copies(copies);
+
+        migration.unchanged =
+            others.empty() and
+            source.overlay_size == target->overlay_size and
+            (copies.empty() ?
+                source.overlay_size == 0 :
+                copies.size() == 1 and
+                copies[0].source_offset == 0 and
+                copies[0].target_offset == 0 and
+                copies[0].size == source.overlay_size);
+
+        migration.steps = copies;
+        migration.steps.insert(
+            migration.steps.end(), others.begin(), others.end());
+    }
+
+    // ------------------------------------------------------------------------
+    void write_string(FARM::BinaryWriter &writer, const std::string &string)
+    {
+        writer.write(static_cast<CORE::UInt16>(string.size()));
+        writer.write_bytes(string.data(), string.size());
+    }
+
+    // ------------------------------------------------------------------------
+    bool read_string(FARM::BinaryReader &reader, std::string &string)
+    {
+        CORE::UInt16
+            size = 0;
+        bool
+            successful = reader.read(size);
+
+        string.assign(size, '\0');
+
+        if (successful and size > 0)
+        {
+            successful = reader.read_bytes(&string[0], size);
+        }
+
+        return successful;
+    }
+
+    // ------------------------------------------------------------------------
+    // Reads a count and checks that it is believable.
+    //
+    bool read_count(FARM::BinaryReader &reader, CORE::UInt32 &count)
+    {
+        return reader.read(count) and count <= maximum_layout_count;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The name of an operation for display.
+    //
+    const char *get_operation_name(FARM::MigrationOperation operation)
+    {
+        const char
+            *name = "";
+
+        switch (operation)
+        {
+            case FARM::migrate_copy_bytes:
+            {
+                name = "copy";
+                break;
+            }
+
+            case FARM::migrate_convert_value:
+            {
+                name = "convert";
+                break;
+            }
+
+            case FARM::migrate_remap_enumerant:
+            {
+                name = "remap";
+                break;
+            }
+
+            case FARM::migrate_fill_default:
+            {
+                name = "default";
+                break;
+            }
+
+            case FARM::migrate_drop_value:
+            {
+                name = "drop";
+                break;
+            }
+        };
+
+        return name;
+    }
+}
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    bool OverlayLayout::write(const std::string &file_name) const
+    {
+        std::ofstream
+            file(file_name.c_str(), std::ios::out | std::ios::binary);
+        BinaryWriter
+            writer(file);
+
+        writer.write_bytes(layout_magic, sizeof(layout_magic));
+        writer.write(static_cast<CORE::UInt16>(1));   // Byte order mark
+        writer.write(layout_format);
+        writer.write(static_cast<CORE::UInt32>(categories.size()));
+
+        for (std::vector<OverlayCategoryLayout>::const_iterator
+                 category = categories.begin();
+             category != categories.end(); ++category)
+        {
+            writer.write(static_cast<CORE::Int32>(category->category));
+            write_string(writer, category->label);
+            writer.write(static_cast<CORE::Int32>(category->geometry));
+            writer.write(category->overlay_size);
+            writer.write(
+                static_cast<CORE::UInt32>(category->attributes.size()));
+
+            for (std::vector<OverlayAttributeLayout>::const_iterator
+                     attribute = category->attributes.begin();
+                 attribute != category->attributes.end(); ++attribute)
+            {
+                writer.write(static_cast<CORE::Int32>(attribute->code));
+                write_string(writer, attribute->label);
+                writer.write(static_cast<CORE::Int32>(attribute->data_type));
+                writer.write(attribute->offset);
+                writer.write(attribute->default_value);
+                writer.write(attribute->minimum);
+                writer.write(attribute->maximum);
+                writer.write(attribute->default_enumerant);
+                writer.write(
+                    static_cast<CORE::UInt32>(attribute->enumerants.size()));
+
+                for (std::vector<std::pair<EnumerantCode, EnumerantLabel> >
+                         ::const_iterator enumerant =
+                             attribute->enumerants.begin();
+                     enumerant != attribute->enumerants.end(); ++enumerant)
+                {
+                    writer.write(enumerant->first);
+                    write_string(writer, enumerant->second);
+                }
+            }
+        }
+
+        return writer.flush() and file.good();
+    }
+
+    // ------------------------------------------------------------------------
+    bool OverlayLayout::read(const std::string &file_name)
+    {
+        std::ifstream
+            file(file_name.c_str(), std::ios::in | std::ios::binary);
+        BinaryReader
+            reader(file);
+        char
+            magic[sizeof(layout_magic)];
+        CORE::UInt16
+            format = 0,
+            byte_order = 0;
+        CORE::UInt32
+            category_count = 0;
+        bool
+            successful =
+                file.is_open() and
+                reader.read_bytes(magic, sizeof(magic)) and
+                std::memcmp(magic, layout_magic, sizeof(magic)) == 0 and
+                reader.read_bytes(&byte_order, sizeof(byte_order));
+
+        categories.clear();
+
+        // The byte order mark is 1 in the order of the writer.
+        //
+        if (successful and byte_order != 1)
+        {
+            reader.set_swap_bytes(true);
+            successful = ByteSwap::swap(byte_order) == 1;
+        }
+
+        successful =
+            successful and
+            reader.read(format) and
+            format == layout_format and
+            read_count(reader, category_count);
+
+        for (CORE::UInt32 i = 0; successful and i < category_count; ++i)
+        {
+            OverlayCategoryLayout
+                category;
+            CORE::Int32
+                feature_category = 0,
+                geometry = 0;
+            CORE::UInt32
+                attribute_count = 0;
+
+            successful =
+                reader.read(feature_category) and
+                read_string(reader, category.label) and
+                reader.read(geometry) and
+                reader.read(category.overlay_size) and
+                read_count(reader, attribute_count);
+
+            category.category = feature_category;
+            category.geometry = static_cast<FeatureGeometry>(geometry);
+
+            for (CORE::UInt32 j = 0; successful and j < attribute_count; ++j)
+            {
+                OverlayAttributeLayout
+                    attribute;
+                CORE::Int32
+                    code = 0,
+                    data_type = 0;
+                CORE::UInt32
+                    enumerant_count = 0;
+
+                successful =
+                    reader.read(code) and
+                    read_string(reader, attribute.label) and
+                    reader.read(data_type) and
+                    reader.read(attribute.offset) and
+                    reader.read(attribute.default_value) and
+                    reader.read(attribute.minimum) and
+                    reader.read(attribute.maximum) and
+                    reader.read(attribute.default_enumerant) and
+                    read_count(reader, enumerant_count);
+
+                attribute.code = code;
+                attribute.data_type =
+                    static_cast<AttributeDataType>(data_type);
+
+                for (CORE::UInt32 k = 0;
+                     successful and k < enumerant_count; ++k)
+                {
+                    std::pair<EnumerantCode, EnumerantLabel>
+                        enumerant;
+
+                    successful =
+                        reader.read(enumerant.first) and
+                        read_string(reader, enumerant.second);
+
+                    attribute.enumerants.push_back(enumerant);
+                }
+
+                category.attributes.push_back(attribute);
+            }
+
+            successful = successful and check_category(category);
+
+            categories.push_back(category);
+        }
+
+        if (not successful)
+        {
+            LOG(high, "Could not read the overlay layout '" + file_name +
+                "'.");
+            categories.clear();
+        }
+
+        return successful;
+    }
+
+    // ------------------------------------------------------------------------
+    OverlayMigrationCounts::OverlayMigrationCounts(void) :
+        overlays(0),
+        dropped_overlays(0),
+        unchanged_overlays(0),
+        copied_values(0),
+        converted_values(0),
+        remapped_values(0),
+        defaulted_values(0)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    void OverlayMigrationCounts::display(std::ostream &stream) const
+    {
+        stream << overlays << " overlays, " << unchanged_overlays <<
+            " unchanged, " << dropped_overlays << " dropped" << std::endl <<
+            copied_values << " spans copied, " << converted_values <<
+            " values converted, " << remapped_values << " remapped, " <<
+            defaulted_values << " defaulted" << std::endl;
+    }
+
+    // ------------------------------------------------------------------------
+    bool OverlayMigration::build(
+        const OverlayLayout &source,
+        const OverlayLayout &target
+    )
+    {
+        std::map<FeatureLabelAndGeometry, const OverlayCategoryLayout *>
+            targets;
+        bool
+            successful = true;
+
+        categories.clear();
+
+        // Layouts that did not come from read() are checked here.
+        //
+        for (std::vector<OverlayCategoryLayout>::const_iterator
+                 category = target.categories.begin();
+             successful and category != target.categories.end(); ++category)
+        {
+            successful = check_category(*category);
+
+            targets[FeatureLabelAndGeometry(
+                category->label, category->geometry)] = &*category;
+        }
+
+        for (std::vector<OverlayCategoryLayout>::const_iterator
+                 category = source.categories.begin();
+             successful and category != source.categories.end(); ++category)
+        {
+            successful = check_category(*category);
+        }
+
+        for (std::vector<OverlayCategoryLayout>::const_iterator
+                 category = source.categories.begin();
+             successful and category != source.categories.end(); ++category)
+        {
+            std::map<FeatureLabelAndGeometry, const OverlayCategoryLayout *>
+                ::const_iterator match =
+                    targets.find(FeatureLabelAndGeometry(
+                        category->label, category->geometry));
+
+            successful = category->category >= 0;
+
+            ASSERT_WITH_STREAM(
+                successful,
+                high,
+                "The overlay layout of '" << category->label <<
+                    "' has a negative feature category.");
+
+            if (successful)
+            {
+                if (static_cast<std::size_t>(category->category) >=
+                    categories.size())
+                {
+                    CategoryMigration
+                        missing;
+
+                    missing.source_category = -1;
+                    categories.resize(category->category + 1, missing);
+                }
+
+                build_category(
+                    *category,
+                    match == targets.end() ? 0 : match->second,
+                    categories[category->category]);
+            }
+        }
+
+        if (not successful)
+        {
+            categories.clear();
+        }
+
+        return successful;
+    }
+
+    // ------------------------------------------------------------------------
+    const CategoryMigration *OverlayMigration::get_category(
+        const FeatureCategory &source_category
+    ) const
+    {
+        const CategoryMigration
+            *category = 0;
+
+        if (0 <= source_category and
+            static_cast<std::size_t>(source_category) < categories.size() and
+            categories[source_category].source_category == source_category)
+        {
+            category = &categories[source_category];
+        }
+
+        return category;
+    }
+
+    // ------------------------------------------------------------------------
+    void OverlayMigration::migrate(
+        const CategoryMigration &category,
+        const char *source,
+        std::size_t count,
+        char *target,
+        OverlayMigrationCounts &counts
+    ) const
+    {
+        const std::size_t
+            source_size = category.source_size,
+            target_size = category.target_size;
+
+        counts.overlays += count;
+
+        if (category.target_category < 0)
+        {
+            counts.dropped_overlays += count;
+        }
+        else if (category.unchanged)
+        {
+            // The whole array is copied at once.
+            //
+            if (count * source_size > 0)
+            {
+                std::memcpy(target, source, count * source_size);
+            }
+
+            counts.unchanged_overlays += count;
+        }
+        else
+        {
+            // Start from the defaults, then apply each step to every overlay
+            // in turn.
+            //
+            if (target_size > 0)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    std::memcpy(
+                        target + i * target_size,
+                        &category.default_overlay[0],
+                        target_size);
+                }
+            }
+
+            for (std::vector<MigrationStep>::const_iterator
+                     step = category.steps.begin();
+                 step != category.steps.end(); ++step)
+            {
+                switch (step->operation)
+                {
+                    case migrate_copy_bytes:
+                    {
+                        const char
+                            *from = source + step->source_offset;
+                        char
+                            *to = target + step->target_offset;
+
+                        for (std::size_t i = 0; i < count; ++i)
+                        {
+                            std::memcpy(
+                                to + i * target_size,
+                                from + i * source_size,
+                                step->size);
+                        }
+
+                        counts.copied_values += count;
+                        break;
+                    }
+
+                    case migrate_convert_value:
+                    {
+                        const char
+                            *from = source + step->source_offset;
+                        char
+                            *to = target + step->target_offset;
+
+                        for (std::size_t i = 0; i < count; ++i)
+                        {
+                            CORE::Float64
+                                value =
+                                    get_number(
+                                        from + i * source_size,
+                                        step->source_type);
+
+                            if (step->target_type == int32)
+                            {
+                                value = std::floor(value + 0.5);
+                            }
+
+                            if (step->target_type == boolean)
+                            {
+                                put_value(
+                                    to + i * target_size,
+                                    static_cast<CORE::Int32>(value != 0.0));
+                                counts.converted_values++;
+                            }
+                            else if (value < step->minimum or
+                                     value > step->maximum)
+                            {
+                                counts.defaulted_values++;
+                            }
+                            else if (step->target_type == int32)
+                            {
+                                put_value(
+                                    to + i * target_size,
+                                    static_cast<CORE::Int32>(value));
+                                counts.converted_values++;
+                            }
+                            else
+                            {
+                                put_value(to + i * target_size, value);
+                                counts.converted_values++;
+                            }
+                        }
+                        break;
+                    }
+
+                    case migrate_remap_enumerant:
+                    {
+                        const char
+                            *from = source + step->source_offset;
+                        char
+                            *to = target + step->target_offset;
+
+                        for (std::size_t i = 0; i < count; ++i)
+                        {
+                            CORE::Int32
+                                code;
+                            std::size_t
+                                index;
+
+                            std::memcpy(
+                                &code,
+                                from + i * source_size + sizeof(CORE::Int32),
+                                sizeof(code));
+
+                            index = code - step->first_enumerant;
+
+                            if (index < step->enumerant_map.size() and
+                                step->enumerant_map[index] >= 0)
+                            {
+                                put_value(
+                                    to + i * target_size,
+                                    static_cast<CORE::Int32>(
+                                        step->target_code));
+                                put_value(
+                                    to + i * target_size +
+                                        sizeof(CORE::Int32),
+                                    static_cast<CORE::Int32>(
+                                        step->enumerant_map[index]));
+                                counts.remapped_values++;
+                            }
+                            else
+                            {
+                                counts.defaulted_values++;
+                            }
+                        }
+                        break;
+                    }
+
+                    case migrate_fill_default:
+                    case migrate_drop_value:
+                    {
+                        break;
+                    }
+                };
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    bool OverlayMigration::migrate_file(
+        const std::string &input_file,
+        const std::string &output_file,
+        OverlayMigrationCounts &counts
+    ) const
+    {
+        std::ifstream
+            input(input_file.c_str(), std::ios::in | std::ios::binary);
+        std::ofstream
+            output(output_file.c_str(), std::ios::out | std::ios::binary);
+        std::vector<char>
+            source_overlay,
+            target_overlay;
+        std::vector<std::pair<CORE::Int32, std::string> >
+            strings,
+            kept_strings;
+        bool
+            successful = input.is_open() and output.is_open();
+
+        if (not successful)
+        {
+            LOG(high, "Could not open the overlay file '" + input_file +
+                "' or '" + output_file + "'.");
+            return false;
+        }
+
+        BinaryReader
+            reader(input);
+        BinaryWriter
+            writer(output);
+
+        while (successful and not reader.at_end())
+        {
+            CORE::Int32
+                feature_category = 0,
+                overlay_size = 0,
+                string_count = 0;
+            const CategoryMigration
+                *category;
+
+            successful =
+                reader.read(feature_category) and
+                reader.read(overlay_size) and
+                overlay_size >= 0;
+
+            if (successful)
+            {
+                source_overlay.resize(overlay_size);
+
+                successful =
+                    (overlay_size == 0 or
+                     reader.read_bytes(&source_overlay[0], overlay_size)) and
+                    reader.read(string_count) and
+                    string_count >= 0;
+            }
+
+            strings.resize(successful ? string_count : 0);
+
+            for (CORE::Int32 i = 0; successful and i < string_count; ++i)
+            {
+                successful =
+                    reader.read(strings[i].first) and
+                    reader.read_core_string(strings[i].second);
+            }
+
+            category = get_category(feature_category);
+
+            if (successful and
+                (not category or category->source_size != overlay_size))
+            {
+                LOG_WITH_STREAM(
+                    high,
+                    "The overlay of feature category " << feature_category <<
+                        " in '" << input_file << "' does not match the "
+                        "source layout.");
+                successful = false;
+            }
+
+            if (not successful)
+            {
+                break;
+            }
+
+            target_overlay.resize(category->target_size);
+            migrate(
+                *category,
+                source_overlay.empty() ? 0 : &source_overlay[0],
+                1,
+                target_overlay.empty() ? 0 : &target_overlay[0],
+                counts);
+
+            if (category->target_category < 0)
+            {
+                continue;
+            }
+
+            // Move the strings to the new offsets of their attributes and
+            // index them again, dropping the strings of dropped attributes.
+            //
+            kept_strings.clear();
+
+            for (std::vector<std::pair<CORE::Int32, std::string> >::size_type
+                     i = 0; i < strings.size(); ++i)
+            {
+                for (std::vector<MigrationStep>::const_iterator
+                         step = category->steps.begin();
+                     step != category->steps.end(); ++step)
+                {
+                    if (step->operation == migrate_copy_bytes and
+                        step->source_offset <= strings[i].first and
+                        strings[i].first < step->source_offset + step->size)
+                    {
+                        CORE::Int32
+                            offset =
+                                step->target_offset +
+                                    strings[i].first - step->source_offset;
+
+                        put_value(
+                            &target_overlay[offset],
+                            static_cast<CORE::Int32>(kept_strings.size()));
+                        kept_strings.push_back(
+                            std::make_pair(offset, strings[i].second));
+                        break;
+                    }
+                }
+            }
+
+            writer.write(static_cast<CORE::Int32>(category->target_category));
+            writer.write(category->target_size);
+
+            if (not target_overlay.empty())
+            {
+                writer.write_bytes(&target_overlay[0], target_overlay.size());
+            }
+
+            writer.write(static_cast<CORE::Int32>(kept_strings.size()));
+
+            for (std::vector<std::pair<CORE::Int32, std::string> >::size_type
+                     i = 0; i < kept_strings.size(); ++i)
+            {
+                writer.write(kept_strings[i].first);
+                writer.write_core_string(kept_strings[i].second);
+            }
+        }
+
+        if (not successful)
+        {
+            LOG(high, "Could not migrate the overlay file '" + input_file +
+                "'.");
+        }
+
+        return writer.flush() and output.good() and successful;
+    }
+
+    // ------------------------------------------------------------------------
+    void OverlayMigration::display(std::ostream &stream) const
+    {
+        for (std::vector<CategoryMigration>::const_iterator
+                 category = categories.begin();
+             category != categories.end(); ++category)
+        {
+            if (category->source_category < 0 or category->unchanged)
+            {
+                continue;
+            }
+
+            stream << category->source_category << " " << category->label <<
+                " " << category->geometry << " -> ";
+
+            if (category->target_category < 0)
+            {
+                stream << "dropped" << std::endl;
+                continue;
+            }
+
+            stream << category->target_category << " (" <<
+                category->source_size << " -> " << category->target_size <<
+                " bytes)" << std::endl;
+
+            for (std::vector<MigrationStep>::const_iterator
+                     step = category->steps.begin();
+                 step != category->steps.end(); ++step)
+            {
+                stream << "    " << std::left << std::setw(8) <<
+                    get_operation_name(step->operation) << std::right;
+
+                if (step->operation == migrate_copy_bytes)
+                {
+                    stream << step->size << " bytes " <<
+                        step->source_offset << " -> " << step->target_offset;
+                }
+                else
+                {
+                    stream << step->label << " " << step->source_type <<
+                        " -> " << step->target_type;
+                }
+
+                stream << std::endl;
+            }
+        }
+    }
+}
@@ -0,0 +1,254 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef FARM_OVERLAY_MIGRATION_H
+#define FARM_OVERLAY_MIGRATION_H
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/sys_types.h"
+#include "farm_attribute.h"
+#include "farm_data_types.h"
+#include "farm_enumerant.h"
+#include "farm_feature.h"
+
+namespace FARM
+{
+    // An attribute in the overlay of a feature category.  The default and
+    // the range of an integer, real, or boolean attribute are held as
+    // doubles.
+    //
+    struct OverlayAttributeLayout
+    {
+        AttributeCode
+            code;
+        AttributeLabel
+            label;
+        AttributeDataType
+            data_type;
+        AttributeOffset
+            offset;
+        CORE::Float64
+            default_value,
+            minimum,
+            maximum;
+        EnumerantCode
+            default_enumerant;
+        std::vector<std::pair<EnumerantCode, EnumerantLabel> >
+            enumerants;         // The valid enumerants, by code
+    };
+
+    // The overlay of one feature category.
+    //
+    struct OverlayCategoryLayout
+    {
+        FeatureCategory
+            category;
+        FeatureLabel
+            label;
+        FeatureGeometry
+            geometry;
+        CORE::Int32
+            overlay_size;
+        std::vector<OverlayAttributeLayout>
+            attributes;
+    };
+
+    // ------------------------------------------------------------------------
+    // The overlays of every feature category of a FARM revision, as returned
+    // by FeatureAttributeMapping::get_overlay_layout().  Only one FARM can be
+    // loaded at a time, so the layout of a revision is saved with the
+    // overlays that were written with it and read back when the overlays
+    // are migrated to a later revision.
+    // ------------------------------------------------------------------------
+    struct OverlayLayout
+    {
+        std::vector<OverlayCategoryLayout>
+            categories;
+
+        // Return:  Was the layout written to the file?
+        //
+        bool write(const std::string &file_name) const;
+
+        // Reads a layout written on a machine of either byte order.  The
+        // layout is rejected if a value is not inside of its overlay or the
+        // enumerants of an attribute are not sorted by code.
+        //
+        // Return:  Was the layout read from the file?
+        //
+        bool read(const std::string &file_name);
+    };
+
+    // What a step of a category migration does with one attribute.
+    //
+    enum MigrationOperation
+    {
+        migrate_copy_bytes,         // Copies unchanged values in spans
+        migrate_convert_value,      // Converts the type or checks the range
+        migrate_remap_enumerant,    // Maps the enumerant code by its label
+        migrate_fill_default,       // The new or changed attribute's default
+        migrate_drop_value          // Not an attribute of the new revision
+    };
+
+    // ------------------------------------------------------------------------
+    // One step of the program that migrates the overlays of a feature
+    // category.  A value that can not be converted or remapped, or is out of
+    // the new range, keeps the default of the new revision.
+    // ------------------------------------------------------------------------
+    struct MigrationStep
+    {
+        MigrationOperation
+            operation;
+        AttributeLabel
+            label;              // Empty for a span of several attributes
+        AttributeDataType
+            source_type,
+            target_type;
+        AttributeOffset
+            source_offset,
+            target_offset;
+        CORE::Int32
+            size,               // Bytes copied by migrate_copy_bytes
+            target_code;        // Attribute code written with an enumerant
+        CORE::Float64
+            minimum,            // Range of a converted value
+            maximum;
+        EnumerantCode
+            first_enumerant;    // Source code of enumerant_map[0]
+        std::vector<EnumerantCode>
+            enumerant_map;      // Target code by source code, or -1
+    };
+
+    // The program that migrates the overlays of one feature category.
+    //
+    struct CategoryMigration
+    {
+        FeatureCategory
+            source_category,
+            target_category;    // -1 if the feature is not in the new FARM
+        FeatureLabel
+            label;
+        FeatureGeometry
+            geometry;
+        CORE::Int32
+            source_size,
+            target_size;
+        bool
+            unchanged;          // The overlays are copied as they are
+        std::vector<char>
+            default_overlay;    // The defaults of the new revision
+        std::vector<MigrationStep>
+            steps;
+    };
+
+    // The counts of a migration.
+    //
+    struct OverlayMigrationCounts
+    {
+        OverlayMigrationCounts(void);
+
+        void display(std::ostream &stream) const;
+
+        CORE::Int64
+            overlays,
+            dropped_overlays,   // Of features not in the new FARM
+            unchanged_overlays,
+            copied_values,      // Counted a span at a time
+            converted_values,
+            remapped_values,
+            defaulted_values;   // Could not be converted or remapped
+    };
+
+    // ------------------------------------------------------------------------
+    // Migrates attribute overlays from one FARM revision to another.  The
+    // feature categories of the two revisions are matched by feature label
+    // and geometry and their attributes by attribute label, since the
+    // categories, the attribute codes, and the overlay offsets can all
+    // change between revisions.
+    //
+    // build() compiles a program for each feature category.  Values whose
+    // attribute is unchanged are copied, and neighboring copies are merged
+    // into spans, so the overlays of a category whose layout is unchanged
+    // are copied with one memcpy() for the whole array.
+    //
+    // Overlays are in the format of EDCSMigration: integer and boolean
+    // values are a native Int32, real values a native Float64, enumerated
+    // values the Int32 attribute and enumerant codes, and string values the
+    // Int32 index of the text in the record.
+    // ------------------------------------------------------------------------
+    class OverlayMigration
+    {
+      public:
+
+        // Compiles the programs that migrate overlays from the source layout
+        // to the target layout.  Both layouts are checked as read() checks
+        // them.
+        //
+        // Return:  Were the programs built?
+        //
+        bool build(
+            const OverlayLayout &source,
+            const OverlayLayout &target
+        );
+
+        // Return:  The program for a source feature category, or 0 if the
+        // category was not in the source layout.
+        //
+        const CategoryMigration *get_category(
+            const FeatureCategory &source_category
+        ) const;
+
+        // Migrates an array of overlays of the category.  The source array
+        // holds count overlays of source_size bytes and the target array
+        // count overlays of target_size bytes.
+        //
+        void migrate(
+            const CategoryMigration &category,
+            const char *source,
+            std::size_t count,
+            char *target,
+            OverlayMigrationCounts &counts
+        ) const;
+
+        // Migrates an overlay file written by EDCSMigration.  Records of
+        // features that are not in the new FARM are dropped, and the strings
+        // of dropped string attributes with them.
+        //
+        // Return:  Was the file read and written?
+        //
+        bool migrate_file(
+            const std::string &input_file,
+            const std::string &output_file,
+            OverlayMigrationCounts &counts
+        ) const;
+
+        // Writes the program of each feature category that changed.
+        //
+        void display(std::ostream &stream) const;
+
+      private:
+
+        std::vector<CategoryMigration>
+            categories;         // By source feature category
+    };
+}
+
+#endif
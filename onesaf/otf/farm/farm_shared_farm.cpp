@@ -0,0 +1,512 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "core/logger.h"
+#include "farm.h"
+#include "farm_shared_farm.h"
+
+namespace
+{
+    const char
+        segment_magic[8] = {'F', 'A', 'R', 'M', 'S', 'H', 'M', '1'};
+
+    const CORE::UInt32
+        segment_publishing = 0,
+        segment_ready = 1;
+
+    // The header at the start of a segment.  The image follows it, on a
+    // cache line boundary.
+    //
+    struct SegmentHeader
+    {
+        char
+            magic[8];
+        CORE::UInt32
+            state;              // Set to ready after the image is copied
+        CORE::UInt32
+            reserved;
+        CORE::UInt64
+            image_bytes;
+        char
+            padding[40];
+    };
+
+    // A segment that its publisher left before writing the header is only
+    // taken to be stale once it is this old, since it may have just been
+    // created and not locked yet.
+    //
+    const std::time_t
+        stale_seconds = 10;
+
+    // ------------------------------------------------------------------------
+    // Creates a new segment and locks it.  The lock is held until the
+    // descriptor is closed, or the process dies.
+    //
+    // Return:  The descriptor of the segment, or -1 with errno set.
+    //
+    int create_segment(const std::string &segment_name)
+    {
+        int
+            descriptor =
+                shm_open(
+                    segment_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+
+        if (descriptor >= 0 and flock(descriptor, LOCK_EX) != 0)
+        {
+            const int
+                error = errno;
+
+            close(descriptor);
+            shm_unlink(segment_name.c_str());
+
+            descriptor = -1;
+            errno = error;
+        }
+
+        return descriptor;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  Does the segment name still refer to the segment that is open
+    // on the descriptor?
+    //
+    bool same_segment(
+        const std::string &segment_name,
+        const struct stat &status
+    )
+    {
+        const int
+            descriptor = shm_open(segment_name.c_str(), O_RDONLY, 0);
+        struct stat
+            current;
+        bool
+            same = false;
+
+        if (descriptor >= 0)
+        {
+            same =
+                fstat(descriptor, &current) == 0 and
+                current.st_dev == status.st_dev and
+                current.st_ino == status.st_ino;
+
+            close(descriptor);
+        }
+
+        return same;
+    }
+
+    // ------------------------------------------------------------------------
+    // Removes the segment if no process should attach it any more: either
+    // its publisher died before it was ready, or it is ready with an image
+    // that is not valid or has another schema fingerprint than the image
+    // that is being published, such as one left by the previous FARM
+    // version.  The publisher holds the lock of the segment until it is
+    // ready, so an unfinished segment whose lock is free was left behind.
+    // The segment is only removed while it is locked and still has the
+    // name, so a publisher never removes the new segment of another.
+    //
+    // Return:  Was the segment removed?
+    //
+    bool remove_replaced_segment(
+        const std::string &segment_name,
+        const FARM::FlatFarm &new_farm
+    )
+    {
+        const int
+            descriptor = shm_open(segment_name.c_str(), O_RDONLY, 0);
+        struct stat
+            status;
+        SegmentHeader
+            header;
+        FARM::Fingerprint
+            old_fingerprint;
+        bool
+            stale = false,
+            replaced = false;
+
+        std::memset(&header, 0, sizeof(header));
+
+        if (descriptor >= 0 and
+            flock(descriptor, LOCK_EX | LOCK_NB) == 0 and
+            fstat(descriptor, &status) == 0)
+        {
+            void
+                *segment = MAP_FAILED;
+
+            if (static_cast<std::size_t>(status.st_size) >= sizeof(header))
+            {
+                segment = mmap(
+                    0,
+                    status.st_size,
+                    PROT_READ,
+                    MAP_SHARED,
+                    descriptor,
+                    0);
+            }
+
+            if (segment != MAP_FAILED)
+            {
+                std::memcpy(&header, segment, sizeof(header));
+            }
+
+            if (std::memcmp(
+                header.magic, segment_magic, sizeof(segment_magic)) != 0)
+            {
+                stale = std::time(0) - status.st_mtime > stale_seconds;
+            }
+            else if (header.state != segment_ready)
+            {
+                stale = true;
+            }
+            else if (new_farm.is_open())
+            {
+                FARM::FlatFarm
+                    old_farm;
+
+                replaced =
+                    header.image_bytes >
+                        status.st_size - sizeof(SegmentHeader) or
+                    not old_farm.open(
+                        static_cast<const SegmentHeader *>(segment) + 1,
+                        header.image_bytes);
+
+                if (not replaced)
+                {
+                    old_fingerprint = old_farm.get_fingerprint();
+                    replaced =
+                        old_fingerprint != new_farm.get_fingerprint();
+                }
+            }
+
+            if (segment != MAP_FAILED)
+            {
+                munmap(segment, status.st_size);
+            }
+        }
+
+        if ((stale or replaced) and not same_segment(segment_name, status))
+        {
+            // Another publisher has already replaced it.
+            //
+            stale = false;
+            replaced = false;
+        }
+
+        if (stale)
+        {
+            LOG_WITH_STREAM(
+                info,
+                "Removing the shared FARM segment '" << segment_name <<
+                    "' that its publisher did not finish.");
+        }
+        else if (replaced)
+        {
+            LOG_WITH_STREAM(
+                info,
+                "Replacing the shared FARM segment '" << segment_name <<
+                    "' that has the schema fingerprint " <<
+                    old_fingerprint.to_string() << " instead of " <<
+                    new_farm.get_fingerprint().to_string() << ".");
+        }
+
+        const bool
+            removed =
+                (stale or replaced) and
+                shm_unlink(segment_name.c_str()) == 0;
+
+        if (descriptor >= 0)
+        {
+            close(descriptor);
+        }
+
+        return removed;
+    }
+}
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    SharedFarm::SharedFarm(void) :
+        address(0),
+        size(0)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    SharedFarm::~SharedFarm(void)
+    {
+        detach();
+    }
+
+    // ------------------------------------------------------------------------
+    bool SharedFarm::publish(const std::string &segment_name)
+    {
+        std::vector<char>
+            image;
+
+        FeatureAttributeMapping::build_flat_image(image);
+
+        return publish(segment_name, image);
+    }
+
+    // ------------------------------------------------------------------------
+    bool SharedFarm::publish(
+        const std::string &segment_name,
+        const std::vector<char> &image
+    )
+    {
+        std::size_t
+            segment_size = sizeof(SegmentHeader) + image.size();
+        int
+            descriptor = create_segment(segment_name),
+            error = errno;
+        void
+            *segment = MAP_FAILED;
+        FlatFarm
+            new_farm;
+
+        if (descriptor < 0 and error == EEXIST)
+        {
+            if (not image.empty())
+            {
+                new_farm.open(&image[0], image.size());
+            }
+
+            if (remove_replaced_segment(segment_name, new_farm))
+            {
+                descriptor = create_segment(segment_name);
+                error = errno;
+            }
+        }
+
+        if (descriptor < 0)
+        {
+            LOG_WITH_STREAM(
+                error == EEXIST ? info : high,
+                "Could not create the shared FARM segment '" <<
+                    segment_name << "': " << std::strerror(error));
+
+            return false;
+        }
+
+        if (ftruncate(descriptor, segment_size) == 0)
+        {
+            segment = mmap(
+                0,
+                segment_size,
+                PROT_READ | PROT_WRITE,
+                MAP_SHARED,
+                descriptor,
+                0);
+        }
+
+        if (segment == MAP_FAILED)
+        {
+            LOG_WITH_STREAM(
+                high,
+                "Could not map the shared FARM segment '" << segment_name <<
+                    "': " << std::strerror(errno));
+
+            shm_unlink(segment_name.c_str());
+            close(descriptor);
+
+            return false;
+        }
+
+        SegmentHeader
+            *header = static_cast<SegmentHeader *>(segment);
+
+        std::memset(header, 0, sizeof(SegmentHeader));
+        std::memcpy(header->magic, segment_magic, sizeof(segment_magic));
+        header->state = segment_publishing;
+        header->image_bytes = image.size();
+
+        if (not image.empty())
+        {
+            std::memcpy(header + 1, &image[0], image.size());
+        }
+
+        // Readers check the state with acquire, so they see the whole image
+        // once they see it ready.
+        //
+        __atomic_store_n(&header->state, segment_ready, __ATOMIC_RELEASE);
+
+        munmap(segment, segment_size);
+
+        // Closing the descriptor releases the lock.
+        //
+        close(descriptor);
+
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    bool SharedFarm::remove(const std::string &segment_name)
+    {
+        return shm_unlink(segment_name.c_str()) == 0;
+    }
+
+    // ------------------------------------------------------------------------
+    bool SharedFarm::attach(
+        const std::string &segment_name,
+        const Fingerprint &expected_fingerprint,
+        int wait_milliseconds
+    )
+    {
+        bool
+            successful = false,
+            publishing = true;
+
+        detach();
+
+        for (int waited = 0; not successful and publishing; ++waited)
+        {
+            successful =
+                map_segment(segment_name, expected_fingerprint, publishing);
+
+            publishing = publishing and waited < wait_milliseconds;
+
+            if (publishing)
+            {
+                usleep(1000);
+            }
+        }
+
+        return successful;
+    }
+
+    // ------------------------------------------------------------------------
+    bool SharedFarm::map_segment(
+        const std::string &segment_name,
+        const Fingerprint &expected_fingerprint,
+        bool &publishing
+    )
+    {
+        int
+            descriptor;
+        struct stat
+            status;
+        void
+            *segment = MAP_FAILED;
+
+        publishing = false;
+
+        descriptor = shm_open(segment_name.c_str(), O_RDONLY, 0);
+
+        if (descriptor < 0)
+        {
+            return false;
+        }
+
+        if (fstat(descriptor, &status) == 0 and
+            static_cast<std::size_t>(status.st_size) >=
+                sizeof(SegmentHeader))
+        {
+            segment = mmap(
+                0,
+                status.st_size,
+                PROT_READ,
+                MAP_SHARED,
+                descriptor,
+                0);
+        }
+        else
+        {
+            // The publisher has not sized the segment yet.
+            //
+            publishing = true;
+        }
+
+        close(descriptor);
+
+        if (segment == MAP_FAILED)
+        {
+            return false;
+        }
+
+        const SegmentHeader
+            *header = static_cast<const SegmentHeader *>(segment);
+        const bool
+            valid_magic =
+                std::memcmp(
+                    header->magic, segment_magic, sizeof(segment_magic)) == 0;
+        bool
+            successful =
+                valid_magic and
+                __atomic_load_n(&header->state, __ATOMIC_ACQUIRE) ==
+                    segment_ready;
+
+        // The header is written after the segment is sized.
+        //
+        publishing =
+            not successful and (valid_magic or header->magic[0] == '\0');
+
+        successful =
+            successful and
+            header->image_bytes <=
+                status.st_size - sizeof(SegmentHeader) and
+            farm.open(header + 1, header->image_bytes);
+
+        if (successful and farm.get_fingerprint() != expected_fingerprint)
+        {
+            LOG_WITH_STREAM(
+                high,
+                "The shared FARM segment '" << segment_name <<
+                    "' has the schema fingerprint " <<
+                    farm.get_fingerprint().to_string() << " instead of " <<
+                    expected_fingerprint.to_string() << ".");
+
+            farm.close();
+            successful = false;
+        }
+
+        if (successful)
+        {
+            address = segment;
+            size = status.st_size;
+        }
+        else
+        {
+            munmap(segment, status.st_size);
+        }
+
+        return successful;
+    }
+
+    // ------------------------------------------------------------------------
+    void SharedFarm::detach(void)
+    {
+        if (address)
+        {
+            farm.close();
+            munmap(address, size);
+
+            address = 0;
+            size = 0;
+        }
+    }
+}
@@ -0,0 +1,158 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef FARM_SHARED_FARM_H
+#define FARM_SHARED_FARM_H
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "farm_flat_image.h"
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    // Shares one copy of a FARM between the processes of a machine.  The
+    // first process loads the FARM and publishes its flat image in a POSIX
+    // shared memory segment; later processes attach the segment read-only
+    // and query it in place through get_farm(), without parsing or loading
+    // the FARM, so every process uses the same physical pages.  A process
+    // only attaches a FARM with the schema fingerprint it expects.
+    //
+    //     FARM::SharedFarm
+    //         shared;
+    //
+    //     if (not shared.attach("/onesaf_farm", fingerprint))
+    //     {
+    //         FARM::FeatureAttributeMapping::initialize(...);
+    //
+    //         // Another process may have won the race to publish, so wait
+    //         // for its segment to be ready.  If it still cannot be
+    //         // attached, the process uses the FARM that it loaded.
+    //         //
+    //         FARM::SharedFarm::publish("/onesaf_farm");
+    //         shared.attach("/onesaf_farm", fingerprint, 10000);
+    //     }
+    //
+    // The segment is marked ready only after the image is copied into it, so
+    // a process never attaches a partial image.  The publisher locks the
+    // segment until it is ready, so a segment that was left unfinished by a
+    // publisher that died is found and replaced by the next publish().  So
+    // is a ready segment of another schema fingerprint, such as one left by
+    // the previous FARM version, which no process would attach.  The
+    // segment lasts until it is removed, and removing or replacing it does
+    // not affect processes attached to it.
+    // ------------------------------------------------------------------------
+    class SharedFarm
+    {
+      public:
+
+        SharedFarm(void);
+
+        // Detaches the segment.
+        //
+        ~SharedFarm(void);
+
+        // Publishes the flat image of the loaded FARM in a new segment.
+        //
+        // Return:  Was the segment created?  An existing segment is only
+        // replaced if its publisher died before it was ready, or if its
+        // image has another schema fingerprint.
+        //
+        static bool publish(const std::string &segment_name);
+
+        // Publishes a flat image in a new segment.
+        //
+        // Return:  Was the segment created?  An existing segment is only
+        // replaced if its publisher died before it was ready, or if its
+        // image has another schema fingerprint.
+        //
+        static bool publish(
+            const std::string &segment_name,
+            const std::vector<char> &image
+        );
+
+        // Removes the segment name, so that the segment is freed when the
+        // last process detaches it.
+        //
+        // Return:  Was the segment removed?
+        //
+        static bool remove(const std::string &segment_name);
+
+        // Maps the segment read-only.  Only the header of the image is
+        // checked, so attaching takes microseconds.  A segment that is
+        // still being published is waited for up to wait_milliseconds.
+        //
+        // Return:  Was a ready segment with a valid image of the expected
+        // schema fingerprint attached?
+        //
+        bool attach(
+            const std::string &segment_name,
+            const Fingerprint &expected_fingerprint,
+            int wait_milliseconds = 0
+        );
+
+        void detach(void);
+
+        bool is_attached(void) const;
+
+        // Return:  The FARM of the attached segment.
+        //
+        const FlatFarm &get_farm(void) const;
+
+      private:
+
+        // Not copyable, since it owns the mapping.
+        //
+        SharedFarm(const SharedFarm &rhs);
+
+        SharedFarm &operator=(const SharedFarm &rhs);
+
+        // Maps the segment if it is ready.
+        //
+        // Return:  Was the segment attached?  publishing is set if the
+        // segment exists but is not ready yet.
+        //
+        bool map_segment(
+            const std::string &segment_name,
+            const Fingerprint &expected_fingerprint,
+            bool &publishing
+        );
+
+        void
+            *address;
+        std::size_t
+            size;
+        FlatFarm
+            farm;
+    };
+
+    // ------------------------------------------------------------------------
+    inline bool SharedFarm::is_attached(void) const
+    {
+        return address != 0;
+    }
+
+    // ------------------------------------------------------------------------
+    inline const FlatFarm &SharedFarm::get_farm(void) const
+    {
+        return farm;
+    }
+}
+
+#endif
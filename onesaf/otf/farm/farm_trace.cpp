@@ -0,0 +1,545 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "core/logger.h"
+#include "farm_trace.h"
+
+// mallinfo2() is the first glibc interface that reports the heap in use
+// without overflowing at 2 GB.
+//
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+#define FARM_TRACE_HEAP_IN_USE
+#endif
+
+namespace
+{
+    typedef std::chrono::steady_clock
+        Clock;
+
+    // A phase that has started but not ended, with the counters at its start.
+    //
+    struct OpenPhase
+    {
+        std::vector<FARM::TracePhase>::size_type
+            index;
+        Clock::time_point
+            start;
+        CORE::Int64
+            allocations,
+            heap_in_use;
+    };
+
+    typedef std::vector<OpenPhase>
+        OpenPhaseStack;
+
+    typedef std::map<std::thread::id, OpenPhaseStack>
+        OpenPhaseMap;
+
+    typedef std::map<std::thread::id, int>
+        ThreadIdMap;
+
+    std::mutex
+        trace_mutex;
+
+    bool
+        trace_enabled = true;
+
+    FARM::AllocationCounter
+        allocation_counter = 0;
+
+    std::vector<FARM::TracePhase>
+        phases;
+
+    OpenPhaseMap
+        open_phases;
+
+    ThreadIdMap
+        thread_ids;
+
+    Clock::time_point
+        trace_origin;
+
+    CORE::Int64
+        dropped_phases = 0;
+
+    // ------------------------------------------------------------------------
+    // Return:  The bytes of heap in use, or -1 if it cannot be found.
+    //
+    CORE::Int64 get_heap_in_use(void)
+    {
+#if defined(FARM_TRACE_HEAP_IN_USE)
+        struct mallinfo2
+            info = mallinfo2();
+
+        return static_cast<CORE::Int64>(info.uordblks + info.hblkhd);
+#else
+        return -1;
+#endif
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The allocations made so far, or -1 if there is no counter.
+    //
+    CORE::Int64 get_allocations(void)
+    {
+        return allocation_counter ? allocation_counter() : -1;
+    }
+
+    // ------------------------------------------------------------------------
+    // Must be called with the trace mutex locked.
+    //
+    // Return:  The small id of the calling thread.
+    //
+    int get_thread(void)
+    {
+        std::thread::id
+            id = std::this_thread::get_id();
+        ThreadIdMap::iterator
+            found = thread_ids.find(id);
+
+        if (found == thread_ids.end())
+        {
+            int
+                thread = static_cast<int>(thread_ids.size()) + 1;
+
+            found = thread_ids.insert(std::make_pair(id, thread)).first;
+        }
+
+        return found->second;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The nanoseconds between the two times.
+    //
+    CORE::Int64 get_nanoseconds(
+        const Clock::time_point &from,
+        const Clock::time_point &to)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            to - from).count();
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes the string as a JSON string, with the quotes.
+    //
+    void write_json_string(std::ostream &stream, const std::string &string)
+    {
+        stream << '"';
+
+        for (std::string::size_type i = 0; i < string.size(); ++i)
+        {
+            unsigned char
+                character = static_cast<unsigned char>(string[i]);
+
+            if (character == '"' or character == '\\')
+            {
+                stream << '\\' << string[i];
+            }
+            else if (character < 0x20)
+            {
+                stream << "\\u" << std::hex << std::setw(4) <<
+                    std::setfill('0') << static_cast<int>(character) <<
+                    std::dec << std::setfill(' ');
+            }
+            else
+            {
+                stream << string[i];
+            }
+        }
+
+        stream << '"';
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes the trace to the file named by FARM_TRACE_FILE, if it is set,
+    // and logs the summary.  Must be called with the trace mutex unlocked.
+    //
+    void write_environment_trace(void)
+    {
+        const char
+            *file_name = std::getenv("FARM_TRACE_FILE");
+
+        if (file_name and *file_name)
+        {
+            std::ostringstream
+                summary;
+
+            FARM::StartupTrace::write_chrome_trace(std::string(file_name));
+            FARM::StartupTrace::display(summary);
+
+            LOG(info, "FARM startup trace:\n" + summary.str());
+        }
+    }
+}
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    void StartupTrace::enable(bool enabled)
+    {
+        std::lock_guard<std::mutex>
+            lock(trace_mutex);
+
+        trace_enabled = enabled;
+    }
+
+    // ------------------------------------------------------------------------
+    bool StartupTrace::enabled(void)
+    {
+        std::lock_guard<std::mutex>
+            lock(trace_mutex);
+
+        return trace_enabled;
+    }
+
+    // ------------------------------------------------------------------------
+    void StartupTrace::set_allocation_counter(AllocationCounter counter)
+    {
+        std::lock_guard<std::mutex>
+            lock(trace_mutex);
+
+        allocation_counter = counter;
+    }
+
+    // ------------------------------------------------------------------------
+    void StartupTrace::begin_phase(const char *name)
+    {
+        // The counters are read before the lock, and the clock last, so the
+        // bookkeeping of the trace is not charged to the phase.
+        //
+        CORE::Int64
+            allocations = get_allocations(),
+            heap_in_use = get_heap_in_use();
+        std::lock_guard<std::mutex>
+            lock(trace_mutex);
+        OpenPhaseStack
+            &stack = open_phases[std::this_thread::get_id()];
+
+        if (phases.size() >= static_cast<std::size_t>(max_phases))
+        {
+            ++dropped_phases;
+
+            // A placeholder keeps the begin and end calls matched.
+            //
+            OpenPhase
+                dropped = {phases.size(), Clock::time_point(), 0, 0};
+
+            stack.push_back(dropped);
+
+            return;
+        }
+
+        if (phases.empty())
+        {
+            trace_origin = Clock::now();
+        }
+
+        TracePhase
+            phase;
+
+        phase.name = name;
+        phase.depth = static_cast<int>(stack.size());
+        phase.thread = get_thread();
+        phase.start_ns = 0;
+        phase.duration_ns = 0;
+        phase.allocations = -1;
+        phase.heap_bytes = -1;
+
+        OpenPhase
+            open = {phases.size(), Clock::time_point(), allocations,
+                heap_in_use};
+
+        phases.push_back(phase);
+
+        open.start = Clock::now();
+        phases.back().start_ns = get_nanoseconds(trace_origin, open.start);
+
+        stack.push_back(open);
+    }
+
+    // ------------------------------------------------------------------------
+    void StartupTrace::end_phase(void)
+    {
+        Clock::time_point
+            end = Clock::now();
+        CORE::Int64
+            allocations = get_allocations(),
+            heap_in_use = get_heap_in_use();
+        bool
+            outermost = false;
+
+        {
+            std::lock_guard<std::mutex>
+                lock(trace_mutex);
+            OpenPhaseMap::iterator
+                found = open_phases.find(std::this_thread::get_id());
+
+            if (found == open_phases.end() or found->second.empty())
+            {
+                LOG(medium, "A FARM startup phase ended without starting.");
+
+                return;
+            }
+
+            OpenPhase
+                open = found->second.back();
+
+            found->second.pop_back();
+            outermost = found->second.empty();
+
+            // A dropped phase has no start time.
+            //
+            if (open.start != Clock::time_point() and
+                open.index < phases.size())
+            {
+                TracePhase
+                    &phase = phases[open.index];
+
+                phase.duration_ns = get_nanoseconds(open.start, end);
+
+                if (allocations >= 0 and open.allocations >= 0)
+                {
+                    phase.allocations = allocations - open.allocations;
+                }
+
+                if (heap_in_use >= 0 and open.heap_in_use >= 0)
+                {
+                    phase.heap_bytes = heap_in_use - open.heap_in_use;
+                }
+            }
+
+            if (outermost)
+            {
+                open_phases.erase(found);
+            }
+        }
+
+        if (outermost)
+        {
+            write_environment_trace();
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    void StartupTrace::clear(void)
+    {
+        std::lock_guard<std::mutex>
+            lock(trace_mutex);
+
+        // Phases that are still open are ended as dropped phases.
+        //
+        for (OpenPhaseMap::iterator open = open_phases.begin();
+             open != open_phases.end(); ++open)
+        {
+            for (OpenPhaseStack::iterator phase = open->second.begin();
+                 phase != open->second.end(); ++phase)
+            {
+                phase->start = Clock::time_point();
+            }
+        }
+
+        phases.clear();
+        thread_ids.clear();
+        dropped_phases = 0;
+    }
+
+    // ------------------------------------------------------------------------
+    void StartupTrace::get_phases(std::vector<TracePhase> &phases_out)
+    {
+        std::lock_guard<std::mutex>
+            lock(trace_mutex);
+
+        phases_out = phases;
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 StartupTrace::get_dropped_phases(void)
+    {
+        std::lock_guard<std::mutex>
+            lock(trace_mutex);
+
+        return dropped_phases;
+    }
+
+    // ------------------------------------------------------------------------
+    bool StartupTrace::write_chrome_trace(std::ostream &stream)
+    {
+        std::vector<TracePhase>
+            trace;
+
+        get_phases(trace);
+
+        // Chrome wants microseconds; the fraction keeps the nanoseconds.
+        //
+        stream << "{\"traceEvents\":[";
+
+        for (std::vector<TracePhase>::size_type i = 0; i < trace.size(); ++i)
+        {
+            const TracePhase
+                &phase = trace[i];
+
+            stream << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+            write_json_string(stream, phase.name);
+            stream << std::fixed << std::setprecision(3) <<
+                ",\"cat\":\"farm\",\"ph\":\"X\",\"ts\":" <<
+                phase.start_ns / 1000.0 << ",\"dur\":" <<
+                phase.duration_ns / 1000.0 << ",\"pid\":1,\"tid\":" <<
+                phase.thread << ",\"args\":{\"depth\":" << phase.depth;
+
+            if (phase.allocations >= 0)
+            {
+                stream << ",\"allocations\":" << phase.allocations;
+            }
+
+            if (phase.heap_bytes != -1)
+            {
+                stream << ",\"heap_bytes\":" << phase.heap_bytes;
+            }
+
+            stream << "}}";
+        }
+
+        stream << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":" <<
+            "{\"dropped_phases\":" << get_dropped_phases() << "}}\n";
+
+        return not stream.fail();
+    }
+
+    // ------------------------------------------------------------------------
+    bool StartupTrace::write_chrome_trace(const std::string &file_name)
+    {
+        std::ofstream
+            stream(file_name.c_str());
+        bool
+            successful = stream.is_open() and write_chrome_trace(stream);
+
+        if (not successful)
+        {
+            LOG(medium,
+                "Could not write the FARM startup trace '" + file_name +
+                    "'.");
+        }
+
+        return successful;
+    }
+
+    // ------------------------------------------------------------------------
+    void StartupTrace::display(std::ostream &stream)
+    {
+        std::vector<TracePhase>
+            trace;
+        CORE::Int64
+            root_ns = 0;
+        std::string::size_type
+            name_width = 5;
+
+        get_phases(trace);
+
+        for (std::vector<TracePhase>::size_type i = 0; i < trace.size(); ++i)
+        {
+            name_width = std::max(
+                name_width, 2 * trace[i].depth + trace[i].name.size());
+        }
+
+        name_width += 2;
+
+        std::ios::fmtflags
+            flags = stream.flags();
+
+        stream << std::left << std::setw(name_width) << "Phase" <<
+            std::right << std::setw(12) << "ms" << std::setw(8) << "%" <<
+            std::setw(12) << "allocs" << std::setw(14) << "heap bytes" <<
+            std::endl;
+
+        for (std::vector<TracePhase>::size_type i = 0; i < trace.size(); ++i)
+        {
+            const TracePhase
+                &phase = trace[i];
+
+            if (phase.depth == 0)
+            {
+                root_ns = phase.duration_ns;
+            }
+
+            std::string
+                name = std::string(2 * phase.depth, ' ') + phase.name;
+
+            stream << std::left << std::setw(name_width) << name <<
+                std::right << std::fixed << std::setprecision(3) << std::setw(12) <<
+                phase.duration_ns / 1.0e6 << std::setprecision(1) <<
+                std::setw(8);
+
+            if (root_ns > 0)
+            {
+                stream << 100.0 * phase.duration_ns / root_ns;
+            }
+            else
+            {
+                stream << "-";
+            }
+
+            stream << std::setw(12);
+
+            if (phase.allocations >= 0)
+            {
+                stream << phase.allocations;
+            }
+            else
+            {
+                stream << "-";
+            }
+
+            stream << std::setw(14);
+
+            if (phase.heap_bytes != -1)
+            {
+                stream << phase.heap_bytes;
+            }
+            else
+            {
+                stream << "-";
+            }
+
+            stream << std::endl;
+        }
+
+        CORE::Int64
+            dropped = get_dropped_phases();
+
+        if (dropped > 0)
+        {
+            stream << dropped << " phases were dropped." << std::endl;
+        }
+
+        stream.flags(flags);
+    }
+}
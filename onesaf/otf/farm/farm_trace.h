@@ -0,0 +1,162 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef FARM_TRACE_H
+#define FARM_TRACE_H
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "core/sys_types.h"
+
+namespace FARM
+{
+    // A timed phase of the FARM startup.  Phases nest; the depth of an
+    // outermost phase, such as FeatureAttributeMapping::initialize, is 0.
+    // The allocation and heap counters are -1 when they are not available.
+    //
+    struct TracePhase
+    {
+        std::string
+            name;
+        int
+            depth,
+            thread;             // Small id of the thread, starting at 1
+        CORE::Int64
+            start_ns,           // From the first phase that was recorded
+            duration_ns,
+            allocations,        // Made during the phase
+            heap_bytes;         // Change of the heap in use
+    };
+
+    // Returns the number of heap allocations made so far by the process.
+    //
+    typedef CORE::Int64 (*AllocationCounter)(void);
+
+    // ------------------------------------------------------------------------
+    // Records the phases of the FARM startup: the EDCS initialization, the
+    // FDF, ADF, and FAA readers or the binary loaders, and the feature,
+    // attribute, and enumeration category initialization.  Each phase records
+    // its wall time and, where the platform allows it, the allocations and
+    // the heap growth.
+    //
+    // The trace can be written as Chrome trace-event JSON, which
+    // chrome://tracing and Perfetto display, or as a summary table.  When
+    // the environment variable FARM_TRACE_FILE is set, the trace is written
+    // to that file every time an outermost phase ends, so a slow terrain
+    // load can be diagnosed in the field without a profiler.
+    //
+    // Recording is on by default and costs about a microsecond per phase.
+    // At most max_phases phases are kept; later phases are counted as
+    // dropped until clear() is called.
+    // ------------------------------------------------------------------------
+    class StartupTrace
+    {
+      public:
+
+        static const int
+            max_phases = 10000;
+
+        // Turns the recording of phases on or off.
+        //
+        static void enable(bool enabled);
+
+        // Return:  Are phases being recorded?
+        //
+        static bool enabled(void);
+
+        // Sets the function that counts the allocations of the process.  An
+        // application that replaces the global operator new can provide one;
+        // otherwise only the heap growth is recorded.
+        //
+        static void set_allocation_counter(AllocationCounter counter);
+
+        // Starts a phase, which ends at the matching end_phase().  Use
+        // StartupTracePhase to keep the calls matched.
+        //
+        static void begin_phase(const char *name);
+
+        static void end_phase(void);
+
+        // Discards the recorded phases.
+        //
+        static void clear(void);
+
+        // Returns the recorded phases in the order in which they started.
+        //
+        static void get_phases(std::vector<TracePhase> &phases);
+
+        // Return:  The number of phases that were not kept.
+        //
+        static CORE::Int64 get_dropped_phases(void);
+
+        // Writes the phases as Chrome trace-event JSON.
+        //
+        // Return:  Was the trace written?
+        //
+        static bool write_chrome_trace(std::ostream &stream);
+
+        static bool write_chrome_trace(const std::string &file_name);
+
+        // Writes a table of the phases with their times, their share of the
+        // outermost phase, and their allocations.
+        //
+        static void display(std::ostream &stream);
+    };
+
+    // ------------------------------------------------------------------------
+    // Records a startup phase for the lifetime of the object.
+    // ------------------------------------------------------------------------
+    class StartupTracePhase
+    {
+      public:
+
+        explicit StartupTracePhase(const char *name);
+
+        ~StartupTracePhase(void);
+
+      private:
+
+        StartupTracePhase(const StartupTracePhase &);
+        StartupTracePhase &operator=(const StartupTracePhase &);
+
+        bool
+            recording;
+    };
+
+    // ------------------------------------------------------------------------
+    inline StartupTracePhase::StartupTracePhase(const char *name) :
+        recording(StartupTrace::enabled())
+    {
+        if (recording)
+        {
+            StartupTrace::begin_phase(name);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    inline StartupTracePhase::~StartupTracePhase(void)
+    {
+        if (recording)
+        {
+            StartupTrace::end_phase();
+        }
+    }
+}
+
+#endif
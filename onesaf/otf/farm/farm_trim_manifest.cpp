@@ -0,0 +1,359 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#include <fstream>
+#include <sstream>
+
+#include "core/logger.h"
+#include "farm.h"
+#include "farm_binary_codec.h"
+#include "farm_trim_manifest.h"
+
+namespace
+{
+    // Return:  The label of a geometry in a manifest, as in the FDF file.
+    //
+    const char *geometry_label(FARM::FeatureGeometry geometry)
+    {
+        switch (geometry)
+        {
+            case FARM::point:
+                return "POINT";
+            case FARM::linear:
+                return "LINE";
+            case FARM::areal:
+                return "AREA";
+            default:
+                return "NULL";
+        }
+    }
+
+    // Return:  Was the label a geometry?
+    //
+    bool parse_geometry(
+        const std::string &label,
+        FARM::FeatureGeometry &geometry
+    )
+    {
+        if (label == "POINT")
+        {
+            geometry = FARM::point;
+        }
+        else if (label == "LINE")
+        {
+            geometry = FARM::linear;
+        }
+        else if (label == "AREA")
+        {
+            geometry = FARM::areal;
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    }
+}
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    void TrimManifest::clear(void)
+    {
+        features.clear();
+        attributes.clear();
+        feature_entries.clear();
+        attribute_entries.clear();
+    }
+
+    // ------------------------------------------------------------------------
+    void TrimManifest::add_feature(
+        const FeatureLabel &label,
+        const FeatureGeometry &geometry,
+        CORE::UInt64 count
+    )
+    {
+        std::pair<FeatureEntries::iterator, bool>
+            entry = feature_entries.insert(
+                FeatureEntries::value_type(
+                    std::make_pair(label, geometry), features.size()));
+
+        if (entry.second)
+        {
+            TrimFeatureUse
+                use;
+
+            use.label = label;
+            use.geometry = geometry;
+            use.count = 0;
+
+            features.push_back(use);
+        }
+
+        features[entry.first->second].count += count;
+    }
+
+    // ------------------------------------------------------------------------
+    void TrimManifest::add_attribute(
+        const AttributeLabel &label,
+        CORE::UInt64 count
+    )
+    {
+        std::pair<AttributeEntries::iterator, bool>
+            entry = attribute_entries.insert(
+                AttributeEntries::value_type(label, attributes.size()));
+
+        if (entry.second)
+        {
+            TrimAttributeUse
+                use;
+
+            use.label = label;
+            use.count = 0;
+
+            attributes.push_back(use);
+        }
+
+        attributes[entry.first->second].count += count;
+    }
+
+    // ------------------------------------------------------------------------
+    bool TrimManifest::add_overlay_file(const std::string &file_name)
+    {
+        std::ifstream
+            file(file_name.c_str(), std::ios::in | std::ios::binary);
+        std::map<FeatureCategory, CORE::UInt64>
+            counts;
+        std::vector<char>
+            overlay;
+        std::string
+            value;
+        bool
+            successful = file.is_open();
+
+        if (not successful)
+        {
+            LOG(high, "Could not open the overlay file '" + file_name + "'.");
+            return false;
+        }
+
+        BinaryReader
+            reader(file);
+
+        // Each record is a feature category, its overlay, and the strings
+        // that the overlay refers to.
+        //
+        while (successful and not reader.at_end())
+        {
+            CORE::Int32
+                feature_category = 0,
+                overlay_size = 0,
+                string_count = 0,
+                offset = 0;
+
+            successful =
+                reader.read(feature_category) and
+                reader.read(overlay_size) and
+                overlay_size >= 0;
+
+            if (successful)
+            {
+                overlay.resize(overlay_size);
+
+                successful =
+                    (overlay_size == 0 or
+                     reader.read_bytes(&overlay[0], overlay_size)) and
+                    reader.read(string_count) and
+                    string_count >= 0;
+            }
+
+            for (CORE::Int32 i = 0; successful and i < string_count; ++i)
+            {
+                successful =
+                    reader.read(offset) and
+                    reader.read_core_string(value);
+            }
+
+            if (successful)
+            {
+                ++counts[feature_category];
+            }
+        }
+
+        ASSERT(
+            successful,
+            high,
+            "The overlay file '" + file_name + "' is damaged.");
+
+        for (std::map<FeatureCategory, CORE::UInt64>::const_iterator
+                 count = counts.begin();
+             count != counts.end();
+             ++count)
+        {
+            FeatureLabel
+                label;
+            FeatureGeometry
+                geometry;
+
+            if (FeatureAttributeMapping::get_feature_label(
+                    count->first, label) and
+                FeatureAttributeMapping::get_feature_geometry(
+                    count->first, geometry))
+            {
+                add_feature(label, geometry, count->second);
+            }
+            else
+            {
+                LOG_WITH_STREAM(
+                    high,
+                    "The overlay file '" << file_name << "' has feature "
+                        "category " << count->first << ", which the FARM "
+                        "does not have.");
+                successful = false;
+            }
+        }
+
+        return successful;
+    }
+
+    // ------------------------------------------------------------------------
+    bool TrimManifest::read(const std::string &file_name)
+    {
+        std::ifstream
+            file(file_name.c_str());
+        std::string
+            line;
+        int
+            line_number = 0;
+        bool
+            successful = file.is_open();
+
+        ASSERT(
+            successful,
+            high,
+            "Could not open the manifest '" + file_name + "'.");
+
+        while (successful and std::getline(file, line))
+        {
+            std::istringstream
+                fields(line.substr(0, line.find('#')));
+            std::string
+                kind,
+                label,
+                geometry_text;
+            FeatureGeometry
+                geometry;
+            CORE::UInt64
+                count = 0;
+            std::string
+                rest;
+
+            ++line_number;
+
+            if (not (fields >> kind))
+            {
+                continue;
+            }
+
+            if (kind == "feature")
+            {
+                successful =
+                    fields >> label >> geometry_text >> count and
+                    parse_geometry(geometry_text, geometry) and
+                    not (fields >> rest);
+
+                if (successful)
+                {
+                    add_feature(label, geometry, count);
+                }
+            }
+            else if (kind == "attribute")
+            {
+                successful =
+                    fields >> label >> count and
+                    not (fields >> rest);
+
+                if (successful)
+                {
+                    add_attribute(label, count);
+                }
+            }
+            else
+            {
+                successful = false;
+            }
+
+            ASSERT_WITH_STREAM(
+                successful,
+                high,
+                "Line " << line_number << " of the manifest '" <<
+                    file_name << "' is not a feature or attribute entry.");
+        }
+
+        return successful;
+    }
+
+    // ------------------------------------------------------------------------
+    bool TrimManifest::write(const std::string &file_name) const
+    {
+        std::ofstream
+            file(file_name.c_str());
+
+        ASSERT(
+            file.is_open(),
+            high,
+            "Could not create the manifest '" + file_name + "'.");
+
+        file << "# FARM trim manifest: feature <label> <geometry> <uses>, "
+            "attribute <label> <uses>\n";
+
+        for (std::size_t index = 0; index < features.size(); ++index)
+        {
+            file <<
+                "feature " << features[index].label << ' ' <<
+                geometry_label(features[index].geometry) << ' ' <<
+                features[index].count << '\n';
+        }
+
+        for (std::size_t index = 0; index < attributes.size(); ++index)
+        {
+            file <<
+                "attribute " << attributes[index].label << ' ' <<
+                attributes[index].count << '\n';
+        }
+
+        file.close();
+
+        return not file.fail();
+    }
+
+    // ------------------------------------------------------------------------
+    const std::vector<TrimFeatureUse> &TrimManifest::get_features(void) const
+    {
+        return features;
+    }
+
+    // ------------------------------------------------------------------------
+    const std::vector<TrimAttributeUse> &TrimManifest::get_attributes(
+        void
+    ) const
+    {
+        return attributes;
+    }
+}
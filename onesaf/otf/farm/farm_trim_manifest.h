@@ -0,0 +1,132 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef FARM_TRIM_MANIFEST_H
+#define FARM_TRIM_MANIFEST_H
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/sys_types.h"
+#include "farm_attribute.h"
+#include "farm_feature.h"
+
+namespace FARM
+{
+    // A feature category that a simulation uses, and how often.
+    //
+    struct TrimFeatureUse
+    {
+        FeatureLabel
+            label;
+        FeatureGeometry
+            geometry;
+        CORE::UInt64
+            count;
+    };
+
+    // An attribute that a simulation uses, and how often.
+    //
+    struct TrimAttributeUse
+    {
+        AttributeLabel
+            label;
+        CORE::UInt64
+            count;
+    };
+
+    // ------------------------------------------------------------------------
+    // The feature categories and attributes that a simulation uses, from
+    // which FeatureAttributeMapping::build_trimmed_flat_image() builds a
+    // trimmed FARM.  The counts order the trimmed codes, so that the most
+    // used categories and attributes share cache lines.  With no attributes
+    // listed, the trimmed FARM has every attribute of its features.
+    //
+    // A manifest is written by hand or derived from the migrated overlay
+    // files of a terrain database, and is saved as text with one entry per
+    // line, after an optional '#' comment:
+    //
+    //     # The features of the Fort Irwin database
+    //     feature RIVER LINE 1200
+    //     feature BUILDING AREA 85000
+    //     attribute HEIGHT_ABOVE_SURFACE_LEVEL 85000
+    //
+    // Entries name labels rather than codes, so a manifest outlives a FARM
+    // revision.
+    // ------------------------------------------------------------------------
+    class TrimManifest
+    {
+      public:
+
+        void clear(void);
+
+        // Adds uses of a feature category.  Uses of the same category are
+        // summed.
+        //
+        void add_feature(
+            const FeatureLabel &label,
+            const FeatureGeometry &geometry,
+            CORE::UInt64 count
+        );
+
+        // Adds uses of an attribute.  Uses of the same attribute are summed.
+        //
+        void add_attribute(const AttributeLabel &label, CORE::UInt64 count);
+
+        // Counts the feature categories of the overlays in an overlay file,
+        // as written by OverlayMigration::migrate_file() or EDCSMigration,
+        // under the loaded FARM.
+        //
+        // Return:  Was the whole file read?
+        //
+        bool add_overlay_file(const std::string &file_name);
+
+        // Adds the entries of a manifest file.
+        //
+        // Return:  Was the file read without errors?
+        //
+        bool read(const std::string &file_name);
+
+        // Return:  Was the manifest written?
+        //
+        bool write(const std::string &file_name) const;
+
+        const std::vector<TrimFeatureUse> &get_features(void) const;
+
+        const std::vector<TrimAttributeUse> &get_attributes(void) const;
+
+      private:
+
+        typedef std::map<std::pair<FeatureLabel, FeatureGeometry>, std::size_t>
+            FeatureEntries;
+        typedef std::map<AttributeLabel, std::size_t>
+            AttributeEntries;
+
+        std::vector<TrimFeatureUse>
+            features;
+        std::vector<TrimAttributeUse>
+            attributes;
+        FeatureEntries
+            feature_entries;    // The index of each feature in features
+        AttributeEntries
+            attribute_entries;
+    };
+}
+
+#endif
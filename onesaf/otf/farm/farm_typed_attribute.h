@@ -0,0 +1,229 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef FARM_TYPED_ATTRIBUTE_H
+#define FARM_TYPED_ATTRIBUTE_H
+#include <atomic>
+#include <cstring>
+
+#include "core/compare.h"
+#include "core/sys_types.h"
+#include "farm_attribute.h"
+#include "farm_data_types.h"
+#include "farm_enumerant.h"
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    // How a value of a data type is held in the FARM table and in an
+    // attributes overlay.  Cell is the DataType of the FARM table entry and
+    // Type the C++ type of the value.  ordered tells whether the values have
+    // a minimum and maximum.
+    //
+    // Only the data types whose overlay cells hold the value itself are
+    // typed.  String and UUID cells hold handles that only the owner of the
+    // overlay can resolve.
+    // ------------------------------------------------------------------------
+    template<AttributeDataType value_data_type>
+    struct AttributeValue;
+
+    // ------------------------------------------------------------------------
+    template<>
+    struct AttributeValue<int32>
+    {
+        typedef CORE::Int32
+            Type;
+        typedef InstantiatedDataType<CORE::Int32>
+            Cell;
+
+        static const bool
+            ordered = true;
+
+        // Return:  The value at the address of the attribute in an overlay.
+        //
+        static Type load(const char *address)
+        {
+            Type
+                value;
+
+            std::memcpy(&value, address, sizeof(value));
+
+            return value;
+        }
+
+        // Return:  Is the value within the range of the cell?
+        //
+        static bool valid(const Cell &cell, const Type &value)
+        {
+            return
+                CORE::ordered(cell.get_minimum(), value, cell.get_maximum());
+        }
+    };
+
+    // ------------------------------------------------------------------------
+    template<>
+    struct AttributeValue<float64>
+    {
+        typedef CORE::Float64
+            Type;
+        typedef InstantiatedDataType<CORE::Float64>
+            Cell;
+
+        static const bool
+            ordered = true;
+
+        static Type load(const char *address)
+        {
+            Type
+                value;
+
+            std::memcpy(&value, address, sizeof(value));
+
+            return value;
+        }
+
+        static bool valid(const Cell &cell, const Type &value)
+        {
+            return
+                CORE::ordered(cell.get_minimum(), value, cell.get_maximum());
+        }
+    };
+
+    // ------------------------------------------------------------------------
+    // Booleans are held in an overlay as an Int32.
+    //
+    template<>
+    struct AttributeValue<boolean>
+    {
+        typedef bool
+            Type;
+        typedef BooleanDataType
+            Cell;
+
+        static const bool
+            ordered = false;
+
+        static Type load(const char *address)
+        {
+            CORE::Int32
+                value;
+
+            std::memcpy(&value, address, sizeof(value));
+
+            return value != 0;
+        }
+
+        static bool valid(const Cell &, const Type &)
+        {
+            return true;
+        }
+    };
+
+    // ------------------------------------------------------------------------
+    // Enumerations are held in an overlay as the Int32 attribute code
+    // followed by the Int32 enumerant code.  The value is the enumerant code.
+    //
+    template<>
+    struct AttributeValue<enumeration>
+    {
+        typedef EnumerantCode
+            Type;
+        typedef EnumerantDataType
+            Cell;
+
+        static const bool
+            ordered = false;
+
+        static Type load(const char *address)
+        {
+            Type
+                value;
+
+            std::memcpy(&value, address + sizeof(CORE::Int32), sizeof(value));
+
+            return value;
+        }
+
+        // Return:  Is the enumerant code one of the valid enumerants of the
+        // cell?
+        //
+        static bool valid(const Cell &cell, const Type &value)
+        {
+            bool
+                found = false;
+
+            for (Enumerants::const_iterator
+                enum_itr = cell.enumerants().begin();
+                not found and enum_itr != cell.enumerants().end();
+                ++enum_itr)
+            {
+                found = enum_itr->get_ee_code() == value;
+            }
+
+            return found;
+        }
+    };
+
+    // ------------------------------------------------------------------------
+    // The base of an attribute tag, which names an attribute of the FARM and
+    // carries the C++ type of its values, so that the typed accessors of
+    // FeatureAttributeMapping check the type at compile time:
+    //
+    //     struct Width : FARM::AttributeTag<FARM::float64>
+    //     {
+    //         static const char *label(void) { return "WIDTH"; }
+    //     };
+    //
+    //     CORE::Float64 width;
+    //     FARM::FeatureAttributeMapping::get<Width>(category, overlay, width);
+    //
+    // Tags are generated from a FARM by the farm_attribute_tags tool.
+    // ------------------------------------------------------------------------
+    template<AttributeDataType tag_data_type>
+    struct AttributeTag
+    {
+        typedef typename AttributeValue<tag_data_type>::Type
+            Value;
+
+        static const AttributeDataType
+            data_type = tag_data_type;
+    };
+
+    template<AttributeDataType tag_data_type>
+    const AttributeDataType
+        AttributeTag<tag_data_type>::data_type;
+
+    // ------------------------------------------------------------------------
+    // The attribute category of a tag's label, looked up once for each FARM
+    // that is loaded.  The upper 32 bits are the FARM generation that the
+    // category was looked up in and the lower 32 bits the category, which is
+    // -1 if the FARM has no such attribute of the tag's data type.
+    // ------------------------------------------------------------------------
+    template<class Tag>
+    struct AttributeTagCategory
+    {
+        static std::atomic<CORE::UInt64>
+            resolved;
+    };
+
+    template<class Tag>
+    std::atomic<CORE::UInt64>
+        AttributeTagCategory<Tag>::resolved(0);
+}
+
+#endif
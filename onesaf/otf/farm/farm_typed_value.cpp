@@ -0,0 +1,117 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#include "core/logger.h"
+#include "farm_typed_value.h"
+
+namespace
+{
+    static_assert(
+        sizeof(FARM::TypedValue) == 16,
+        "A TypedValue must stay 16 bytes.");
+}
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    StringPool::StringPool(void)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    const std::string *StringPool::intern(const std::string &string)
+    {
+        std::lock_guard<std::mutex>
+            lock(mutex);
+
+        // The nodes of a set are never moved, so the pointer stays valid as
+        // strings are added.
+        //
+        return &*strings.insert(string).first;
+    }
+
+    // ------------------------------------------------------------------------
+    std::size_t StringPool::size(void) const
+    {
+        std::lock_guard<std::mutex>
+            lock(mutex);
+
+        return strings.size();
+    }
+
+    // ------------------------------------------------------------------------
+    void StringPool::clear(void)
+    {
+        std::lock_guard<std::mutex>
+            lock(mutex);
+
+        strings.clear();
+    }
+
+    // ------------------------------------------------------------------------
+    bool TypedValue::operator==(const TypedValue &rhs) const
+    {
+        bool
+            equal = data_type == rhs.data_type;
+
+        if (equal)
+        {
+            switch (data_type)
+            {
+                case int32:
+                {
+                    equal = value.int32 == rhs.value.int32;
+                    break;
+                }
+
+                case float64:
+                {
+                    equal = value.float64 == rhs.value.float64;
+                    break;
+                }
+
+                case boolean:
+                {
+                    equal = value.boolean == rhs.value.boolean;
+                    break;
+                }
+
+                case enumeration:
+                {
+                    equal = value.enumeration == rhs.value.enumeration;
+                    break;
+                }
+
+                case FARM::string:
+                {
+                    equal =
+                        value.string == rhs.value.string or
+                        *value.string == *rhs.value.string;
+                    break;
+                }
+
+                default:
+                {
+                    break;
+                }
+            }
+        }
+
+        return equal;
+    }
+}
@@ -0,0 +1,263 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef FARM_TYPED_VALUE_H
+#define FARM_TYPED_VALUE_H
+#include <mutex>
+#include <set>
+#include <string>
+
+#include "core/sys_types.h"
+#include "farm_attribute.h"
+#include "farm_enumerant.h"
+
+namespace FARM
+{
+    // ------------------------------------------------------------------------
+    // Interns the strings that are referenced by TypedValues so that a value
+    // only carries a pointer.  Equal strings share a pointer.  The strings
+    // are never moved, so a pointer that is returned by intern() stays valid
+    // until the pool is cleared or destroyed.  Each pool belongs to whoever
+    // creates the values that use it: the EDCSConverter keeps the strings of
+    // its mapping files, and callers pass a pool of their own for the values
+    // that carry over.  Interning is guarded by a mutex.
+    // ------------------------------------------------------------------------
+    class StringPool
+    {
+      public:
+
+        StringPool(void);
+
+        // Return:  The pooled copy of the string, adding it if needed.
+        //
+        const std::string *intern(const std::string &string);
+
+        // Return:  The number of strings in the pool.
+        //
+        std::size_t size(void) const;
+
+        // Removes all of the strings from the pool.  Values that reference
+        // them must not be read afterwards.
+        //
+        void clear(void);
+
+      private:
+
+        // Pools are not copied, since values point into them.
+        //
+        StringPool(const StringPool &);
+        StringPool &operator=(const StringPool &);
+
+        std::set<std::string>
+            strings;
+        mutable std::mutex
+            mutex;
+    };
+
+    // ------------------------------------------------------------------------
+    // A 16 byte attribute value that is tagged with its data type.  Enumerated
+    // values are carried as the enumerant code and strings as a pointer into
+    // a StringPool, so a value can be copied without copying any text.
+    // ------------------------------------------------------------------------
+    class TypedValue
+    {
+      public:
+
+        // Constructs a value without a data type.
+        //
+        TypedValue(void);
+
+        // Return:  The data type of the value.
+        //
+        AttributeDataType get_data_type(void) const;
+
+        // Sets the data type without a value.  Used for no_data_type and
+        // deleted.
+        //
+        void set_data_type(const AttributeDataType &new_data_type);
+
+        void set_int32(const CORE::Int32 &new_value);
+
+        void set_float64(const CORE::Float64 &new_value);
+
+        void set_boolean(const bool &new_value);
+
+        void set_enumerant(const EnumerantCode &new_value);
+
+        // The string must come from StringPool::intern(), and the pool must
+        // outlive the value.
+        //
+        void set_string(const std::string *new_value);
+
+        // Return:  The value.  The data type must match.
+        //
+        CORE::Int32 get_int32(void) const;
+        CORE::Float64 get_float64(void) const;
+        bool get_boolean(void) const;
+        EnumerantCode get_enumerant(void) const;
+        const std::string &get_string(void) const;
+
+        // Are the two values of the same data type and equal?  Strings from
+        // different pools are compared by their text.
+        //
+        bool operator==(const TypedValue &rhs) const;
+
+        bool operator!=(const TypedValue &rhs) const;
+
+      private:
+
+        void verify_data_type(const AttributeDataType &expected) const;
+
+        union
+        {
+            CORE::Int32
+                int32;
+            CORE::Float64
+                float64;
+            bool
+                boolean;
+            EnumerantCode
+                enumeration;
+            const std::string
+                *string;
+        } value;
+        AttributeDataType
+            data_type;
+    };
+
+    // ------------------------------------------------------------------------
+    inline TypedValue::TypedValue(void) :
+        data_type(no_data_type)
+    {
+        value.float64 = 0.0;
+    }
+
+    // ------------------------------------------------------------------------
+    inline AttributeDataType TypedValue::get_data_type(void) const
+    {
+        return data_type;
+    }
+
+    // ------------------------------------------------------------------------
+    inline void TypedValue::set_data_type(
+        const AttributeDataType &new_data_type
+    )
+    {
+        value.float64 = 0.0;
+        data_type = new_data_type;
+    }
+
+    // ------------------------------------------------------------------------
+    inline void TypedValue::set_int32(const CORE::Int32 &new_value)
+    {
+        value.float64 = 0.0;
+        value.int32 = new_value;
+        data_type = int32;
+    }
+
+    // ------------------------------------------------------------------------
+    inline void TypedValue::set_float64(const CORE::Float64 &new_value)
+    {
+        value.float64 = new_value;
+        data_type = float64;
+    }
+
+    // ------------------------------------------------------------------------
+    inline void TypedValue::set_boolean(const bool &new_value)
+    {
+        value.float64 = 0.0;
+        value.boolean = new_value;
+        data_type = boolean;
+    }
+
+    // ------------------------------------------------------------------------
+    inline void TypedValue::set_enumerant(const EnumerantCode &new_value)
+    {
+        value.float64 = 0.0;
+        value.enumeration = new_value;
+        data_type = enumeration;
+    }
+
+    // ------------------------------------------------------------------------
+    inline void TypedValue::set_string(const std::string *new_value)
+    {
+        value.float64 = 0.0;
+        value.string = new_value;
+        data_type = FARM::string;
+    }
+
+    // ------------------------------------------------------------------------
+    inline CORE::Int32 TypedValue::get_int32(void) const
+    {
+        verify_data_type(int32);
+
+        return value.int32;
+    }
+
+    // ------------------------------------------------------------------------
+    inline CORE::Float64 TypedValue::get_float64(void) const
+    {
+        verify_data_type(float64);
+
+        return value.float64;
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool TypedValue::get_boolean(void) const
+    {
+        verify_data_type(boolean);
+
+        return value.boolean;
+    }
+
+    // ------------------------------------------------------------------------
+    inline EnumerantCode TypedValue::get_enumerant(void) const
+    {
+        verify_data_type(enumeration);
+
+        return value.enumeration;
+    }
+
+    // ------------------------------------------------------------------------
+    inline const std::string &TypedValue::get_string(void) const
+    {
+        verify_data_type(FARM::string);
+
+        return *value.string;
+    }
+
+    // ------------------------------------------------------------------------
+    inline bool TypedValue::operator!=(const TypedValue &rhs) const
+    {
+        return not (*this == rhs);
+    }
+
+    // ------------------------------------------------------------------------
+    inline void TypedValue::verify_data_type(
+        const AttributeDataType &expected
+    ) const
+    {
+        ASSERT_WITH_STREAM(
+            data_type == expected,
+            fatal,
+            "A typed value of data type " << data_type <<
+                " was read as data type " << expected << ".");
+    }
+}
+
+#endif
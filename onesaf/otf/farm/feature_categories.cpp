@@ -48,6 +48,7 @@
 **
 *****************************************************************************/
 
+#include "farm_trace.h"
 #include "feature_categories.h"
 
 namespace
@@ -140,6 +141,9 @@ namespace FARM
     // ------------------------------------------------------------------------
     bool FeatureCategories::initialize()
     {
+        StartupTracePhase
+            phase("FeatureCategories::initialize");
+
         if (FeatureAttributeMapping::initialized())
         {
             initialized = true;
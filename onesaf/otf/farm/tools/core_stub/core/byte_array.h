@@ -0,0 +1,55 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef CORE_BYTE_ARRAY_H
+#define CORE_BYTE_ARRAY_H
+
+#include "core/sys_types.h"
+
+namespace CORE
+{
+    // Big-endian (network order) integer packing that advances the pointer.
+    //
+    inline void put_int32(char *&byte_array, Int32 value)
+    {
+        const UInt32
+            bits = static_cast<UInt32>(value);
+
+        byte_array[0] = static_cast<char>(bits >> 24);
+        byte_array[1] = static_cast<char>(bits >> 16);
+        byte_array[2] = static_cast<char>(bits >> 8);
+        byte_array[3] = static_cast<char>(bits);
+        byte_array += 4;
+    }
+
+    inline Int32 get_int32(char *&byte_array)
+    {
+        const UInt32
+            bits =
+                (static_cast<UInt32>(static_cast<unsigned char>(byte_array[0])) << 24) |
+                (static_cast<UInt32>(static_cast<unsigned char>(byte_array[1])) << 16) |
+                (static_cast<UInt32>(static_cast<unsigned char>(byte_array[2])) << 8) |
+                static_cast<UInt32>(static_cast<unsigned char>(byte_array[3]));
+
+        byte_array += 4;
+
+        return static_cast<Int32>(bits);
+    }
+}
+
+#endif
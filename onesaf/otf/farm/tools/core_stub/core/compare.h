@@ -0,0 +1,31 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef CORE_COMPARE_H
+#define CORE_COMPARE_H
+
+namespace CORE
+{
+    template <class T>
+    inline bool ordered(const T &low, const T &value, const T &high)
+    {
+        return not (value < low) and not (high < value);
+    }
+}
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef CORE_CONFIG_OPTIONS_H
+#define CORE_CONFIG_OPTIONS_H
+
+#include <map>
+#include <string>
+
+#include "core/sys_types.h"
+#include "core/vec.h"
+
+namespace CORE
+{
+    // Parses the subset of the configuration syntax used by the EDCS mapping
+    // files:
+    //
+    //     TableName = ( ( "A", 1, 2.5 ) ( "B", 2, 3.5 ) );
+    //
+    // Cells are separated by white space and/or commas; '#' and ';' start
+    // comments that run to the end of the line outside of quoted strings.
+    //
+    class ConfigurationOptions
+    {
+      public:
+        explicit ConfigurationOptions(const std::string &filename);
+
+        bool is_ready() const;
+
+        bool value(const std::string &name, VecofCells &cells) const;
+
+        bool value(const VecofCells &cells, int index, VecofCells &entry) const;
+        bool value(const VecofCells &cells, int index, std::string &entry) const;
+        bool value(const VecofCells &cells, int index, Int32 &entry) const;
+        bool value(const VecofCells &cells, int index, Float64 &entry) const;
+
+      private:
+        bool
+            ready;
+        std::map<std::string, Cell>
+            tables;
+    };
+}
+
+#endif
@@ -0,0 +1,86 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef CORE_CORE_STRING_H
+#define CORE_CORE_STRING_H
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "core/sys_types.h"
+
+namespace CORE
+{
+    template <class T>
+    inline std::string to_string(const T &value)
+    {
+        std::ostringstream
+            stream;
+
+        stream << value;
+
+        return stream.str();
+    }
+
+    template <class T>
+    inline bool from_string(const std::string &string, T &value)
+    {
+        std::istringstream
+            stream(string);
+
+        stream >> value;
+
+        return not stream.fail();
+    }
+
+    // Strings are stored as a native Int32 length followed by the characters.
+    //
+    inline void dump_string(std::ostream &stream, const std::string &string)
+    {
+        const Int32
+            size = static_cast<Int32>(string.size());
+
+        stream.write(reinterpret_cast<const char *>(&size), sizeof(size));
+        stream.write(string.data(), size);
+    }
+
+    inline void load_string(std::istream &stream, std::string &string)
+    {
+        Int32
+            size = 0;
+
+        stream.read(reinterpret_cast<char *>(&size), sizeof(size));
+
+        if (stream and size >= 0)
+        {
+            string.resize(size);
+
+            if (size)
+            {
+                stream.read(&string[0], size);
+            }
+        }
+        else
+        {
+            string.clear();
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,87 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef CORE_LOGGER_H
+#define CORE_LOGGER_H
+
+#include <sstream>
+#include <string>
+
+// Severity levels used by the FARM diagnostics.
+//
+enum LogLevel
+{
+    info,
+    low,
+    medium,
+    high,
+    fatal
+};
+
+namespace CORE
+{
+    // Writes the message to standard error; fatal messages abort unless
+    // CORE::Logger::set_abort_on_fatal(false) was called.
+    //
+    void log_message(
+        LogLevel level,
+        const std::string &message,
+        const char *file,
+        int line);
+
+    class Logger
+    {
+      public:
+        static void set_abort_on_fatal(bool abort_on_fatal);
+        static void set_minimum_level(LogLevel level);
+        static bool abort_on_fatal();
+        static LogLevel minimum_level();
+    };
+}
+
+#define LOG(level, message) \
+    CORE::log_message((level), (message), __FILE__, __LINE__)
+
+#define LOG_WITH_STREAM(level, message) \
+    do \
+    { \
+        std::ostringstream \
+            core_log_stream; \
+        core_log_stream << message; \
+        CORE::log_message((level), core_log_stream.str(), __FILE__, __LINE__); \
+    } while (0)
+
+#define ASSERT(condition, level, message) \
+    do \
+    { \
+        if (not (condition)) \
+        { \
+            LOG(level, message); \
+        } \
+    } while (0)
+
+#define ASSERT_WITH_STREAM(condition, level, message) \
+    do \
+    { \
+        if (not (condition)) \
+        { \
+            LOG_WITH_STREAM(level, message); \
+        } \
+    } while (0)
+
+#endif
@@ -0,0 +1,48 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef CORE_SYS_TYPES_H
+#define CORE_SYS_TYPES_H
+
+// The real core headers make the logging macros visible everywhere.
+//
+#include "core/logger.h"
+
+namespace CORE
+{
+    typedef signed char    Int8;
+    typedef unsigned char  UInt8;
+    typedef short          Int16;
+    typedef unsigned short UInt16;
+    typedef int            Int32;
+    typedef unsigned int   UInt32;
+    typedef long long      Int64;
+    typedef unsigned long long UInt64;
+    typedef float          Float32;
+    typedef double         Float64;
+
+    inline bool little_endian()
+    {
+        const UInt16
+            probe = 1;
+
+        return *reinterpret_cast<const UInt8 *>(&probe) == 1;
+    }
+}
+
+#endif
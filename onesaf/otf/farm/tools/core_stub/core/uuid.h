@@ -0,0 +1,48 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef CORE_UUID_H
+#define CORE_UUID_H
+
+#include <cstring>
+
+#include "core/sys_types.h"
+
+namespace CORE
+{
+    class UUID
+    {
+      public:
+        UUID() { std::memset(bytes, 0, sizeof(bytes)); }
+
+        bool operator<(const UUID &rhs) const
+        {
+            return std::memcmp(bytes, rhs.bytes, sizeof(bytes)) < 0;
+        }
+
+        bool operator==(const UUID &rhs) const
+        {
+            return std::memcmp(bytes, rhs.bytes, sizeof(bytes)) == 0;
+        }
+
+        UInt8
+            bytes[16];
+    };
+}
+
+#endif
@@ -0,0 +1,48 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef CORE_VEC_H
+#define CORE_VEC_H
+
+#include <string>
+#include <vector>
+
+namespace CORE
+{
+    // A configuration cell is either an atom (quoted string or bare token)
+    // or a list of cells.
+    //
+    class Cell
+    {
+      public:
+        Cell() : is_list(false) {}
+
+        bool
+            is_list;
+        std::string
+            atom;
+        std::vector<Cell>
+            cells;
+    };
+
+    class VecofCells : public std::vector<Cell>
+    {
+    };
+}
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+#ifndef CORE_VERSION_H
+#define CORE_VERSION_H
+
+#include <iostream>
+
+#include "core/sys_types.h"
+
+namespace CORE
+{
+    class Version
+    {
+      public:
+        enum Product
+        {
+            land_version
+        };
+
+        explicit Version(Product product);
+
+        bool read(std::istream &stream);
+        bool write(std::ostream &stream) const;
+        void display(std::ostream &stream) const;
+
+        Int32 get_version() const { return version; }
+        Int32 get_format() const { return format; }
+        Int32 get_update() const { return update; }
+
+        bool operator==(const Version &rhs) const
+        {
+            return version == rhs.version and format == rhs.format and
+                update == rhs.update;
+        }
+
+        bool operator!=(const Version &rhs) const
+        {
+            return not (*this == rhs);
+        }
+
+      private:
+        Int32
+            version,
+            format,
+            update;
+    };
+}
+
+#endif
@@ -0,0 +1,420 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+// A minimal stand-in for the parts of the core library that the FARM uses,
+// so that the FARM tools can be built and run without the rest of OneSAF.
+// Only the configuration syntax used by the EDCS mapping files is parsed.
+//
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "core/config_options.h"
+#include "core/core_string.h"
+#include "core/directory_parser.h"
+#include "core/logger.h"
+#include "core/version.h"
+
+namespace
+{
+    bool
+        abort_on_fatal_flag = true;
+    LogLevel
+        minimum_log_level = medium;
+
+    const char *level_name(LogLevel level)
+    {
+        switch (level)
+        {
+            case info:   return "info";
+            case low:    return "low";
+            case medium: return "medium";
+            case high:   return "high";
+            case fatal:  return "fatal";
+        }
+
+        return "unknown";
+    }
+
+    // Tokenizer for the configuration subset.
+    //
+    class Parser
+    {
+      public:
+        explicit Parser(const std::string &text) : text(text), position(0) {}
+
+        void skip()
+        {
+            while (position < text.size())
+            {
+                const char
+                    c = text[position];
+
+                if (c == '#' or c == ';')
+                {
+                    while (position < text.size() and text[position] != '\n')
+                    {
+                        ++position;
+                    }
+                }
+                else if (c == ' ' or c == '\t' or c == '\r' or c == '\n' or
+                    c == ',')
+                {
+                    ++position;
+                }
+                else
+                {
+                    break;
+                }
+            }
+        }
+
+        bool at_end()
+        {
+            skip();
+
+            return position >= text.size();
+        }
+
+        bool identifier(std::string &name)
+        {
+            skip();
+
+            const std::string::size_type
+                start = position;
+
+            while (position < text.size() and
+                (std::isalnum(static_cast<unsigned char>(text[position])) or
+                 text[position] == '_' or text[position] == '.'))
+            {
+                ++position;
+            }
+
+            name = text.substr(start, position - start);
+
+            return not name.empty();
+        }
+
+        bool expect(char c)
+        {
+            skip();
+
+            if (position < text.size() and text[position] == c)
+            {
+                ++position;
+                return true;
+            }
+
+            return false;
+        }
+
+        bool cell(CORE::Cell &result)
+        {
+            skip();
+
+            if (position >= text.size())
+            {
+                return false;
+            }
+
+            if (text[position] == '(')
+            {
+                ++position;
+                result.is_list = true;
+
+                while (true)
+                {
+                    skip();
+
+                    if (position >= text.size())
+                    {
+                        return false;
+                    }
+
+                    if (text[position] == ')')
+                    {
+                        ++position;
+                        return true;
+                    }
+
+                    CORE::Cell
+                        child;
+
+                    if (not cell(child))
+                    {
+                        return false;
+                    }
+
+                    result.cells.push_back(child);
+                }
+            }
+
+            if (text[position] == '"')
+            {
+                ++position;
+
+                while (position < text.size() and text[position] != '"')
+                {
+                    result.atom += text[position++];
+                }
+
+                return expect('"');
+            }
+
+            while (position < text.size() and
+                text[position] != ' ' and text[position] != '\t' and
+                text[position] != '\r' and text[position] != '\n' and
+                text[position] != ',' and text[position] != ')' and
+                text[position] != '(' and text[position] != ';')
+            {
+                result.atom += text[position++];
+            }
+
+            return not result.atom.empty();
+        }
+
+      private:
+        const std::string
+            &text;
+        std::string::size_type
+            position;
+    };
+
+    const CORE::Cell *entry(const CORE::VecofCells &cells, int index)
+    {
+        if (index < 0 or index >= static_cast<int>(cells.size()))
+        {
+            return 0;
+        }
+
+        return &cells[index];
+    }
+}
+
+namespace CORE
+{
+    // ------------------------------------------------------------------------
+    void log_message(
+        LogLevel level,
+        const std::string &message,
+        const char *file,
+        int line)
+    {
+        if (level >= minimum_log_level)
+        {
+            std::cerr << "[" << level_name(level) << "] " << file << ":" << line
+                << ": " << message << std::endl;
+        }
+
+        if (level == fatal and abort_on_fatal_flag)
+        {
+            std::abort();
+        }
+    }
+
+    void Logger::set_abort_on_fatal(bool abort_on_fatal)
+    {
+        abort_on_fatal_flag = abort_on_fatal;
+    }
+
+    void Logger::set_minimum_level(LogLevel level)
+    {
+        minimum_log_level = level;
+    }
+
+    bool Logger::abort_on_fatal()
+    {
+        return abort_on_fatal_flag;
+    }
+
+    LogLevel Logger::minimum_level()
+    {
+        return minimum_log_level;
+    }
+
+    // ------------------------------------------------------------------------
+    ConfigurationOptions::ConfigurationOptions(const std::string &filename) :
+        ready(false)
+    {
+        std::ifstream
+            file(filename.c_str());
+
+        if (not file)
+        {
+            return;
+        }
+
+        std::stringstream
+            contents;
+
+        contents << file.rdbuf();
+
+        const std::string
+            text = contents.str();
+
+        Parser
+            parser(text);
+
+        ready = true;
+
+        while (ready and not parser.at_end())
+        {
+            std::string
+                name;
+            Cell
+                table;
+
+            ready =
+                parser.identifier(name) and
+                parser.expect('=') and
+                parser.cell(table);
+
+            if (ready)
+            {
+                tables[name] = table;
+            }
+        }
+    }
+
+    bool ConfigurationOptions::is_ready() const
+    {
+        return ready;
+    }
+
+    bool ConfigurationOptions::value(
+        const std::string &name,
+        VecofCells &cells) const
+    {
+        std::map<std::string, Cell>::const_iterator
+            itr = tables.find(name);
+
+        if (itr == tables.end() or not itr->second.is_list)
+        {
+            return false;
+        }
+
+        cells.assign(itr->second.cells.begin(), itr->second.cells.end());
+
+        return true;
+    }
+
+    bool ConfigurationOptions::value(
+        const VecofCells &cells,
+        int index,
+        VecofCells &result) const
+    {
+        const Cell
+            *cell = entry(cells, index);
+
+        if (not cell or not cell->is_list)
+        {
+            return false;
+        }
+
+        result.assign(cell->cells.begin(), cell->cells.end());
+
+        return true;
+    }
+
+    bool ConfigurationOptions::value(
+        const VecofCells &cells,
+        int index,
+        std::string &result) const
+    {
+        const Cell
+            *cell = entry(cells, index);
+
+        if (not cell or cell->is_list)
+        {
+            return false;
+        }
+
+        result = cell->atom;
+
+        return true;
+    }
+
+    bool ConfigurationOptions::value(
+        const VecofCells &cells,
+        int index,
+        Int32 &result) const
+    {
+        const Cell
+            *cell = entry(cells, index);
+
+        return cell and not cell->is_list and from_string(cell->atom, result);
+    }
+
+    bool ConfigurationOptions::value(
+        const VecofCells &cells,
+        int index,
+        Float64 &result) const
+    {
+        const Cell
+            *cell = entry(cells, index);
+
+        return cell and not cell->is_list and from_string(cell->atom, result);
+    }
+
+    // ------------------------------------------------------------------------
+    Version::Version(Product) : version(1), format(0), update(0)
+    {
+    }
+
+    bool Version::read(std::istream &stream)
+    {
+        stream.read(reinterpret_cast<char *>(&version), sizeof(version));
+        stream.read(reinterpret_cast<char *>(&format), sizeof(format));
+        stream.read(reinterpret_cast<char *>(&update), sizeof(update));
+
+        return not stream.fail();
+    }
+
+    bool Version::write(std::ostream &stream) const
+    {
+        stream.write(reinterpret_cast<const char *>(&version), sizeof(version));
+        stream.write(reinterpret_cast<const char *>(&format), sizeof(format));
+        stream.write(reinterpret_cast<const char *>(&update), sizeof(update));
+
+        return not stream.fail();
+    }
+
+    void Version::display(std::ostream &stream) const
+    {
+        stream << version << "." << format << "." << update << std::endl;
+    }
+
+    // ------------------------------------------------------------------------
+    bool DirectoryParser::verify_dir(const std::string &directory)
+    {
+        struct stat
+            info_buffer;
+
+        if (stat(directory.c_str(), &info_buffer) == 0)
+        {
+            return S_ISDIR(info_buffer.st_mode);
+        }
+
+        return mkdir(directory.c_str(), 0755) == 0 or errno == EEXIST;
+    }
+}
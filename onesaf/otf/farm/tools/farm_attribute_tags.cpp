@@ -0,0 +1,395 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+// Generates the attribute tags of a FARM, for the typed attribute accessors
+// of FARM::FeatureAttributeMapping (see farm_typed_attribute.h).  Each tag
+// is a struct named for its attribute, HEIGHT_ABOVE_SURFACE_LEVEL becoming
+// HeightAboveSurfaceLevel, that carries the attribute's data type.
+//
+//     farm_attribute_tags [-m <manifest>] [-n <namespace>]
+//         <data directory> <header file>
+//
+// The data directory holds the FARM configuration files, as for
+// farm_benchmark.  By default every integer, real, logical, and enumerated
+// attribute gets a tag; -m limits the tags to the attributes of a trim
+// manifest.  The tags are put in the namespace FARM_ATTRIBUTES unless -n
+// names another.
+//
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+
+#include "core/logger.h"
+#include "farm.h"
+#include "farm_trim_manifest.h"
+
+namespace
+{
+    typedef std::map<FARM::AttributeLabel, FARM::AttributeDataType>
+        TaggedAttributes;
+
+    // ------------------------------------------------------------------------
+    // Return:  The file in the data directory.
+    //
+    std::string data_file(const std::string &data_dir, const char *name)
+    {
+        return data_dir + "/" + name;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The name of the data type in a generated header, or an empty
+    // string if attributes of the data type do not get tags.
+    //
+    std::string data_type_name(const FARM::AttributeDataType &data_type)
+    {
+        std::string
+            name;
+
+        switch (data_type)
+        {
+            case FARM::int32:
+            {
+                name = "FARM::int32";
+                break;
+            }
+
+            case FARM::float64:
+            {
+                name = "FARM::float64";
+                break;
+            }
+
+            case FARM::boolean:
+            {
+                name = "FARM::boolean";
+                break;
+            }
+
+            case FARM::enumeration:
+            {
+                name = "FARM::enumeration";
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+
+        return name;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The tag name of an attribute label, with each word of the
+    // label capitalized and the underscores removed.
+    //
+    std::string tag_name(const FARM::AttributeLabel &label)
+    {
+        std::string
+            name;
+        bool
+            word_start = true;
+
+        for (std::size_t i = 0; i < label.size(); ++i)
+        {
+            const unsigned char
+                character = label[i];
+
+            if (not std::isalnum(character))
+            {
+                word_start = true;
+            }
+            else if (word_start)
+            {
+                name += static_cast<char>(std::toupper(character));
+                word_start = false;
+            }
+            else
+            {
+                name += static_cast<char>(std::tolower(character));
+            }
+        }
+
+        if (name.empty() or std::isdigit(static_cast<unsigned char>(name[0])))
+        {
+            name = "Attribute" + name;
+        }
+
+        return name;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The include guard of the header file, from its file name.
+    //
+    std::string include_guard(const std::string &header_file)
+    {
+        std::string
+            guard;
+        std::string::size_type
+            slash = header_file.find_last_of('/');
+
+        for (std::size_t i = slash == std::string::npos ? 0 : slash + 1;
+             i < header_file.size();
+             ++i)
+        {
+            const unsigned char
+                character = header_file[i];
+
+            guard += std::isalnum(character) ?
+                static_cast<char>(std::toupper(character)) : '_';
+        }
+
+        return guard;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The label as a C++ string literal.
+    //
+    std::string quote(const FARM::AttributeLabel &label)
+    {
+        std::string
+            literal = "\"";
+
+        for (std::size_t i = 0; i < label.size(); ++i)
+        {
+            if (label[i] == '"' or label[i] == '\\')
+            {
+                literal += '\\';
+            }
+
+            literal += label[i];
+        }
+
+        return literal + "\"";
+    }
+
+    // ------------------------------------------------------------------------
+    // Finds the attributes of the FARM that get tags, and their data types.
+    // With a manifest, only its attributes get tags.
+    //
+    // Return:  Were the attributes found?
+    //
+    bool find_attributes(
+        const FARM::TrimManifest *manifest,
+        TaggedAttributes &attributes
+    )
+    {
+        std::list<FARM::AttributeCategory>
+            categories;
+        std::set<FARM::AttributeLabel>
+            wanted;
+        FARM::AttributeLabel
+            label;
+        FARM::AttributeDataType
+            data_type;
+        bool
+            successful =
+                FARM::FeatureAttributeMapping::get_all_attribute_categories(
+                    categories);
+
+        if (manifest)
+        {
+            for (std::size_t i = 0; i < manifest->get_attributes().size(); ++i)
+            {
+                wanted.insert(manifest->get_attributes()[i].label);
+            }
+        }
+
+        for (std::list<FARM::AttributeCategory>::const_iterator
+                 category = categories.begin();
+             successful and category != categories.end();
+             ++category)
+        {
+            successful =
+                FARM::FeatureAttributeMapping::get_attribute_label(
+                    *category, label) and
+                FARM::FeatureAttributeMapping::get_data_type(
+                    *category, data_type);
+
+            if (successful and
+                not data_type_name(data_type).empty() and
+                (not manifest or wanted.count(label)))
+            {
+                attributes[label] = data_type;
+            }
+        }
+
+        return successful;
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes the header of tags.  Attributes whose labels give the same tag
+    // name are told apart by a numeric suffix.
+    //
+    // Return:  Was the header written?
+    //
+    bool write_header(
+        const std::string &header_file,
+        const std::string &name_space,
+        const std::string &data_dir,
+        const TaggedAttributes &attributes
+    )
+    {
+        std::ofstream
+            header(header_file.c_str());
+        const std::string
+            guard = include_guard(header_file);
+        std::set<std::string>
+            names;
+
+        header <<
+            "// The attribute tags of the FARM in " << data_dir << ",\n"
+            "// generated by farm_attribute_tags.  Regenerate them whenever\n"
+            "// the attributes of the FARM change.\n"
+            "//\n"
+            "#ifndef " << guard << "\n"
+            "#define " << guard << "\n"
+            "#include \"farm_typed_attribute.h\"\n"
+            "\n"
+            "namespace " << name_space << "\n"
+            "{";
+
+        for (TaggedAttributes::const_iterator
+                 attribute = attributes.begin();
+             attribute != attributes.end();
+             ++attribute)
+        {
+            std::string
+                name = tag_name(attribute->first);
+
+            for (int suffix = 2; names.count(name); ++suffix)
+            {
+                name = tag_name(attribute->first) + std::to_string(suffix);
+            }
+
+            names.insert(name);
+
+            header <<
+                "\n"
+                "    struct " << name << " :\n"
+                "        FARM::AttributeTag<" <<
+                    data_type_name(attribute->second) << ">\n"
+                "    {\n"
+                "        static const char *label(void)\n"
+                "        {\n"
+                "            return " << quote(attribute->first) << ";\n"
+                "        }\n"
+                "    };\n";
+        }
+
+        header <<
+            "}\n"
+            "\n"
+            "#endif\n";
+
+        return static_cast<bool>(header);
+    }
+
+    // ------------------------------------------------------------------------
+    void usage(const char *program)
+    {
+        std::cerr << "Usage:  " << program <<
+            " [-m <manifest>] [-n <namespace>]"
+            " <data directory> <header file>" << std::endl;
+    }
+}
+
+// ----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    std::string
+        manifest_file,
+        name_space = "FARM_ATTRIBUTES",
+        data_dir,
+        header_file;
+    FARM::TrimManifest
+        manifest;
+    TaggedAttributes
+        attributes;
+    bool
+        successful;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string
+            argument = argv[i];
+
+        if (argument == "-m" and i + 1 < argc)
+        {
+            manifest_file = argv[++i];
+        }
+        else if (argument == "-n" and i + 1 < argc)
+        {
+            name_space = argv[++i];
+        }
+        else if (data_dir.empty() and argument[0] != '-')
+        {
+            data_dir = argument;
+        }
+        else if (header_file.empty() and argument[0] != '-')
+        {
+            header_file = argument;
+        }
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (header_file.empty())
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    CORE::Logger::set_minimum_level(high);
+
+    successful =
+        FARM::FeatureAttributeMapping::initialize(
+            data_dir,
+            data_file(data_dir, "farm.fdf"),
+            data_file(data_dir, "farm.adf"),
+            data_file(data_dir, "farm.faa"),
+            data_file(data_dir, "feat.cfg"),
+            data_file(data_dir, "attr.cfg"),
+            data_file(data_dir, "enum.cfg")) and
+        (manifest_file.empty() or manifest.read(manifest_file)) and
+        find_attributes(
+            manifest_file.empty() ? 0 : &manifest, attributes) and
+        write_header(header_file, name_space, data_dir, attributes);
+
+    if (not successful)
+    {
+        std::cerr << "Could not write the attribute tags." << std::endl;
+        return 1;
+    }
+
+    std::cout <<
+        "Wrote " << attributes.size() << " attribute tags to " <<
+        header_file << "." << std::endl;
+
+    FARM::FeatureAttributeMapping::destroy();
+
+    return 0;
+}
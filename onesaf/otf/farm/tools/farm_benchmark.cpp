@@ -0,0 +1,1424 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+// Microbenchmarks for the FARM lookups, the EDCS conversion, and the FARM
+// initialization.  For every operation the time, the heap allocations, and
+// the last level cache misses per operation are reported.
+//
+//     farm_benchmark [-t <seconds>] [-o <FARM.bin directory>]
+//         [-T <trace file>] [-m] [-f] <data directory>
+//
+// The data directory holds the FARM configuration files farm.fdf, farm.adf,
+// and farm.faa and the EDCS mapping files feat.cfg, attr.cfg, and enum.cfg.
+// The FARM is dumped to FARM.bin in the output directory (the data directory
+// by default) so that the binary initialization can be measured as well.
+// farm_generator writes data directories of any size.
+//
+// Before the benchmarks, the phases of one initialization from the
+// configuration files and one from FARM.bin are traced and summarized.  The
+// trace is written as Chrome trace-event JSON to the -T file.  -m reports
+// the memory used by each FARM structure and the largest feature categories.
+// -f writes the schema fingerprint and the fingerprint of each feature
+// category.
+//
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "core/config_options.h"
+#include "core/logger.h"
+#include "core/uuid.h"
+#include "edcs_converter.h"
+#include "farm.h"
+#include "farm_instrumentation.h"
+#include "farm_trace.h"
+
+namespace
+{
+    typedef std::chrono::steady_clock
+        Clock;
+
+    // Counts every heap allocation made by the process.
+    //
+    std::atomic<CORE::Int64>
+        allocation_count(0);
+
+    // ------------------------------------------------------------------------
+    // Return:  The number of heap allocations made so far.
+    //
+    CORE::Int64 get_allocation_count(void)
+    {
+        return allocation_count.load(std::memory_order_relaxed);
+    }
+
+    // ------------------------------------------------------------------------
+    // Counts the last level cache misses of the calling thread using the
+    // Linux performance counters.  The counter is unavailable if the kernel
+    // or the container does not allow it.
+    // ------------------------------------------------------------------------
+    class CacheMissCounter
+    {
+      public:
+
+        CacheMissCounter(void);
+        ~CacheMissCounter(void);
+
+        // Return:  Can cache misses be counted?
+        //
+        bool available(void) const;
+
+        void start(void);
+
+        // Return:  The cache misses since start() was called.
+        //
+        CORE::Int64 stop(void);
+
+      private:
+
+        int
+            descriptor;
+    };
+
+    // ------------------------------------------------------------------------
+    CacheMissCounter::CacheMissCounter(void) :
+        descriptor(-1)
+    {
+        perf_event_attr
+            attributes;
+
+        std::memset(&attributes, 0, sizeof(attributes));
+
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.size = sizeof(attributes);
+        attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+
+        descriptor = static_cast<int>(
+            syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+    }
+
+    // ------------------------------------------------------------------------
+    CacheMissCounter::~CacheMissCounter(void)
+    {
+        if (available())
+        {
+            close(descriptor);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    bool CacheMissCounter::available(void) const
+    {
+        return descriptor >= 0;
+    }
+
+    // ------------------------------------------------------------------------
+    void CacheMissCounter::start(void)
+    {
+        if (available())
+        {
+            ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+            ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 CacheMissCounter::stop(void)
+    {
+        CORE::Int64
+            misses = 0;
+
+        if (available())
+        {
+            ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+
+            if (read(descriptor, &misses, sizeof(misses)) != sizeof(misses))
+            {
+                misses = 0;
+            }
+        }
+
+        return misses;
+    }
+
+    // A feature and one of its attributes.
+    //
+    struct FeatureAttribute
+    {
+        FARM::FeatureCategory
+            feature_category;
+        FARM::AttributeCategory
+            attribute_category;
+    };
+
+    // An enumerant of an attribute of a feature.
+    //
+    struct FeatureEnumerant
+    {
+        FARM::FeatureCategory
+            feature_category;
+        FARM::AttributeCategory
+            attribute_category;
+        FARM::EnumerantLabel
+            label;
+        FARM::EnumerantCode
+            code;
+    };
+
+    // An EDCS 3.x attribute value to convert.
+    //
+    struct OldValue
+    {
+        FARM::AttributeLabel
+            attribute_label;
+        FARM::EnumerantLabel
+            enumerant_label;
+    };
+
+    // The inputs of the benchmarks, gathered from the initialized FARM so
+    // that every benchmark walks all of the features and attributes.
+    //
+    struct Workload
+    {
+        std::string
+            data_dir,
+            binary_dir;
+        std::vector<FARM::FeatureLabel>
+            feature_labels;
+        std::vector<FARM::FeatureGeometry>
+            feature_geometries;
+        std::vector<FARM::FeatureCategory>
+            feature_categories;
+        std::vector<FARM::FeatureCode>
+            feature_codes;
+        std::vector<FeatureAttribute>
+            all_pairs,          // Every feature with every attribute
+            contained_pairs,    // Only the attributes the features contain
+            int32_pairs,
+            float64_pairs,
+            string_pairs,
+            boolean_pairs,
+            uuid_pairs;
+        std::vector<CORE::Int32>
+            int32_values;
+        std::vector<CORE::Float64>
+            float64_values;
+        std::vector<bool>
+            boolean_values;
+        std::vector<FeatureEnumerant>
+            enumerants;
+        std::vector<FARM::Enumerant>
+            enumerant_values;
+        std::vector<OldValue>
+            old_values;
+        std::vector<FARM::OldAttributeValue>
+            old_codes;          // The codes of the old values
+    };
+
+    // Runs one pass over the workload.
+    //
+    // Return:  The number of operations in the pass.
+    //
+    typedef CORE::Int64 (*BenchmarkPass)(
+        const Workload &workload,
+        CORE::Int64 &checksum);
+
+    // Prepares for a pass; the time it takes is not measured.
+    //
+    typedef void (*BenchmarkSetup)(const Workload &workload);
+
+    struct Benchmark
+    {
+        const char
+            *name;
+        BenchmarkPass
+            pass;
+        BenchmarkSetup
+            setup;
+    };
+
+    // ------------------------------------------------------------------------
+    std::string data_file(const Workload &workload, const char *name)
+    {
+        return workload.data_dir + "/" + name;
+    }
+
+    // ------------------------------------------------------------------------
+    // Releases the FARM and the EDCS converter so that they can be
+    // initialized again.
+    //
+    void destroy_farm(const Workload &)
+    {
+        FARM::FeatureAttributeMapping::destroy();
+        FARM::EDCSConverter::destroy();
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  Was the FARM initialized from the configuration files?
+    //
+    bool initialize_from_text(const Workload &workload)
+    {
+        return FARM::FeatureAttributeMapping::initialize(
+            workload.data_dir,
+            data_file(workload, "farm.fdf"),
+            data_file(workload, "farm.adf"),
+            data_file(workload, "farm.faa"),
+            data_file(workload, "feat.cfg"),
+            data_file(workload, "attr.cfg"),
+            data_file(workload, "enum.cfg"));
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  Was the FARM initialized from FARM.bin?
+    //
+    bool initialize_from_binary(const Workload &workload)
+    {
+        return FARM::FeatureAttributeMapping::initialize(
+            workload.binary_dir,
+            "",
+            "",
+            "",
+            data_file(workload, "feat.cfg"),
+            data_file(workload, "attr.cfg"),
+            data_file(workload, "enum.cfg"));
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 get_feature_category_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        FARM::FeatureCategory
+            feature_category;
+
+        for (int i = 0; i < workload.feature_labels.size(); ++i)
+        {
+            if (FARM::FeatureAttributeMapping::get_feature_category(
+                workload.feature_labels[i],
+                workload.feature_geometries[i],
+                feature_category))
+            {
+                checksum += feature_category;
+            }
+        }
+
+        return workload.feature_labels.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 feature_by_category_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        for (int i = 0; i < workload.feature_categories.size(); ++i)
+        {
+            FARM::Feature
+                feature(workload.feature_categories[i]);
+
+            checksum += feature.get_code();
+        }
+
+        return workload.feature_categories.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 feature_by_code_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        for (int i = 0; i < workload.feature_codes.size(); ++i)
+        {
+            FARM::Feature
+                feature(
+                    workload.feature_codes[i],
+                    workload.feature_geometries[i]);
+
+            checksum += feature.get_category();
+        }
+
+        return workload.feature_codes.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 feature_handle_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        for (int i = 0; i < workload.feature_codes.size(); ++i)
+        {
+            const FARM::FeatureHandle
+                handle = FARM::FeatureAttributeMapping::get_feature_handle(
+                    workload.feature_codes[i],
+                    workload.feature_geometries[i]);
+
+            checksum += handle.get_category() + handle.get_label().size();
+        }
+
+        return workload.feature_codes.size();
+    }
+
+
+    // ------------------------------------------------------------------------
+    // Reads the fields of each feature that are read every tick through the
+    // feature itself.
+    //
+    CORE::Int64 feature_fields_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        for (int i = 0; i < workload.feature_categories.size(); ++i)
+        {
+            const FARM::Feature
+                *feature = FARM::FeatureAttributeMapping::get_feature(
+                    workload.feature_categories[i]);
+
+            if (feature)
+            {
+                checksum +=
+                    feature->get_geometry() +
+                    feature->get_usage_bitmask() +
+                    feature->get_precedence() +
+                    feature->get_attributes_overlay_size();
+            }
+        }
+
+        return workload.feature_categories.size();
+    }
+
+    // ------------------------------------------------------------------------
+    // Reads the same fields from the packed feature traits.
+    //
+    CORE::Int64 feature_traits_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        for (int i = 0; i < workload.feature_categories.size(); ++i)
+        {
+            const FARM::FeatureTraits
+                &traits = FARM::FeatureAttributeMapping::get_feature_traits(
+                    workload.feature_categories[i]);
+
+            if (traits.valid())
+            {
+                checksum +=
+                    traits.get_geometry() +
+                    traits.get_usage_bitmask() +
+                    traits.get_precedence() +
+                    traits.get_attributes_overlay_size();
+            }
+        }
+
+        return workload.feature_categories.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 contains_attribute_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        for (int i = 0; i < workload.all_pairs.size(); ++i)
+        {
+            checksum += FARM::FeatureAttributeMapping::contains_attribute(
+                workload.all_pairs[i].feature_category,
+                workload.all_pairs[i].attribute_category);
+        }
+
+        return workload.all_pairs.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 get_attribute_offset_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        FARM::AttributeOffset
+            offset;
+
+        for (int i = 0; i < workload.contained_pairs.size(); ++i)
+        {
+            if (FARM::FeatureAttributeMapping::get_attribute_offset(
+                workload.contained_pairs[i].feature_category,
+                workload.contained_pairs[i].attribute_category,
+                offset))
+            {
+                checksum += offset;
+            }
+        }
+
+        return workload.contained_pairs.size();
+    }
+
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 get_attribute_offset_unchecked_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        for (int i = 0; i < workload.contained_pairs.size(); ++i)
+        {
+            checksum +=
+                FARM::FeatureAttributeMapping::get_attribute_offset_unchecked(
+                    workload.contained_pairs[i].feature_category,
+                    workload.contained_pairs[i].attribute_category);
+        }
+
+        return workload.contained_pairs.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 valid_int32_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        for (int i = 0; i < workload.int32_pairs.size(); ++i)
+        {
+            checksum += FARM::FeatureAttributeMapping::valid_attribute(
+                workload.int32_pairs[i].feature_category,
+                workload.int32_pairs[i].attribute_category,
+                static_cast<int>(workload.int32_values[i]));
+        }
+
+        return workload.int32_pairs.size();
+    }
+
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 valid_int32_unchecked_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        for (int i = 0; i < workload.int32_pairs.size(); ++i)
+        {
+            checksum +=
+                FARM::FeatureAttributeMapping::valid_attribute_unchecked(
+                    workload.int32_pairs[i].feature_category,
+                    workload.int32_pairs[i].attribute_category,
+                    static_cast<int>(workload.int32_values[i]));
+        }
+
+        return workload.int32_pairs.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 valid_float64_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        for (int i = 0; i < workload.float64_pairs.size(); ++i)
+        {
+            checksum += FARM::FeatureAttributeMapping::valid_attribute(
+                workload.float64_pairs[i].feature_category,
+                workload.float64_pairs[i].attribute_category,
+                static_cast<double>(workload.float64_values[i]));
+        }
+
+        return workload.float64_pairs.size();
+    }
+
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 valid_float64_unchecked_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        for (int i = 0; i < workload.float64_pairs.size(); ++i)
+        {
+            checksum +=
+                FARM::FeatureAttributeMapping::valid_attribute_unchecked(
+                    workload.float64_pairs[i].feature_category,
+                    workload.float64_pairs[i].attribute_category,
+                    static_cast<double>(workload.float64_values[i]));
+        }
+
+        return workload.float64_pairs.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 valid_string_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        static const std::string
+            value = "benchmark";
+
+        for (int i = 0; i < workload.string_pairs.size(); ++i)
+        {
+            checksum += FARM::FeatureAttributeMapping::valid_attribute(
+                workload.string_pairs[i].feature_category,
+                workload.string_pairs[i].attribute_category,
+                value);
+        }
+
+        return workload.string_pairs.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 valid_boolean_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        for (int i = 0; i < workload.boolean_pairs.size(); ++i)
+        {
+            checksum += FARM::FeatureAttributeMapping::valid_attribute(
+                workload.boolean_pairs[i].feature_category,
+                workload.boolean_pairs[i].attribute_category,
+                static_cast<bool>(workload.boolean_values[i]));
+        }
+
+        return workload.boolean_pairs.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 valid_enumerant_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        for (int i = 0; i < workload.enumerants.size(); ++i)
+        {
+            checksum += FARM::FeatureAttributeMapping::valid_attribute(
+                workload.enumerants[i].feature_category,
+                workload.enumerants[i].attribute_category,
+                workload.enumerant_values[i]);
+        }
+
+        return workload.enumerants.size();
+    }
+
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 valid_enumerant_code_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        for (int i = 0; i < workload.enumerants.size(); ++i)
+        {
+            checksum += FARM::FeatureAttributeMapping::valid_enumerant(
+                workload.enumerants[i].feature_category,
+                workload.enumerants[i].attribute_category,
+                workload.enumerants[i].code);
+        }
+
+        return workload.enumerants.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 valid_enumerant_unchecked_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        for (int i = 0; i < workload.enumerants.size(); ++i)
+        {
+            checksum +=
+                FARM::FeatureAttributeMapping::valid_enumerant_unchecked(
+                    workload.enumerants[i].feature_category,
+                    workload.enumerants[i].attribute_category,
+                    workload.enumerants[i].code);
+        }
+
+        return workload.enumerants.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 valid_uuid_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        static const CORE::UUID
+            value;
+
+        for (int i = 0; i < workload.uuid_pairs.size(); ++i)
+        {
+            checksum += FARM::FeatureAttributeMapping::valid_attribute(
+                workload.uuid_pairs[i].feature_category,
+                workload.uuid_pairs[i].attribute_category,
+                value);
+        }
+
+        return workload.uuid_pairs.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 enumeration_by_label_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        FARM::Enumerant
+            value;
+
+        for (int i = 0; i < workload.enumerants.size(); ++i)
+        {
+            if (FARM::FeatureAttributeMapping::get_enumeration_value(
+                workload.enumerants[i].feature_category,
+                workload.enumerants[i].attribute_category,
+                workload.enumerants[i].label,
+                value))
+            {
+                checksum += value.get_ee_code();
+            }
+        }
+
+        return workload.enumerants.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 enumeration_by_code_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        FARM::Enumerant
+            value;
+
+        for (int i = 0; i < workload.enumerants.size(); ++i)
+        {
+            if (FARM::FeatureAttributeMapping::get_enumeration_value(
+                workload.enumerants[i].feature_category,
+                workload.enumerants[i].attribute_category,
+                workload.enumerants[i].code,
+                value))
+            {
+                checksum += value.get_ee_code();
+            }
+        }
+
+        return workload.enumerants.size();
+    }
+
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 enumerant_label_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        FARM::EnumerantLabel
+            label;
+
+        for (int i = 0; i < workload.enumerants.size(); ++i)
+        {
+            if (FARM::FeatureAttributeMapping::get_enumerant_label(
+                workload.enumerant_values[i].get_ea_label(),
+                workload.enumerants[i].code,
+                label))
+            {
+                checksum += label.size();
+            }
+        }
+
+        return workload.enumerants.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 enumerant_label_unchecked_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        for (int i = 0; i < workload.enumerants.size(); ++i)
+        {
+            checksum +=
+                FARM::FeatureAttributeMapping::get_enumerant_label_unchecked(
+                    workload.enumerants[i].attribute_category,
+                    workload.enumerants[i].code).size();
+        }
+
+        return workload.enumerants.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 enumerant_by_code_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        for (int i = 0; i < workload.enumerants.size(); ++i)
+        {
+            FARM::Enumerant
+                enumerant(
+                    workload.enumerants[i].attribute_category,
+                    workload.enumerants[i].code);
+
+            checksum += enumerant.get_ee_label().size();
+        }
+
+        return workload.enumerants.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 enumerant_handle_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        for (int i = 0; i < workload.enumerants.size(); ++i)
+        {
+            const FARM::EnumerantHandle
+                handle = FARM::FeatureAttributeMapping::get_enumerant_handle(
+                    workload.enumerants[i].attribute_category,
+                    workload.enumerants[i].code);
+
+            checksum += handle.get_ee_label().size();
+        }
+
+        return workload.enumerants.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 convert_value_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        FARM::MappingType
+            mapping_flag;
+        FARM::AttributeLabel
+            new_label;
+        FARM::AttributeDataType
+            new_data_type;
+        FARM::AttributeDataValue
+            new_value;
+
+        for (int i = 0; i < workload.old_values.size(); ++i)
+        {
+            if (FARM::EDCSConverter::convert_value(
+                workload.old_values[i].attribute_label,
+                workload.old_values[i].enumerant_label,
+                mapping_flag,
+                new_label,
+                new_data_type,
+                new_value))
+            {
+                checksum += new_label.size() + new_data_type;
+            }
+        }
+
+        return workload.old_values.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 convert_typed_value_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        FARM::MappingType
+            mapping_flag;
+        FARM::AttributeLabel
+            new_label;
+        FARM::TypedValue
+            new_value;
+        FARM::StringPool
+            strings;
+
+        for (int i = 0; i < workload.old_values.size(); ++i)
+        {
+            if (FARM::EDCSConverter::convert_value(
+                workload.old_values[i].attribute_label,
+                workload.old_values[i].enumerant_label,
+                mapping_flag,
+                new_label,
+                new_value,
+                strings))
+            {
+                checksum += new_label.size() + new_value.get_data_type();
+            }
+        }
+
+        return workload.old_values.size();
+    }
+
+    // ------------------------------------------------------------------------
+    // Converts the same values as the convert_value passes through the
+    // compiled plans, a block at a time.
+    //
+    CORE::Int64 convert_values_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        const int
+            block_size = 64;
+
+        FARM::ConvertedValue
+            new_values[block_size];
+
+        for (int i = 0; i < workload.old_codes.size(); i += block_size)
+        {
+            const int
+                count = std::min<int>(
+                    block_size, workload.old_codes.size() - i);
+
+            FARM::EDCSConverter::convert_values(
+                &workload.old_codes[i], count, new_values);
+
+            for (int j = 0; j < count; ++j)
+            {
+                checksum +=
+                    new_values[j].attribute_code +
+                    new_values[j].value.get_data_type();
+            }
+        }
+
+        return workload.old_codes.size();
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 initialize_text_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        checksum += initialize_from_text(workload);
+
+        return 1;
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::Int64 initialize_binary_pass(
+        const Workload &workload,
+        CORE::Int64 &checksum)
+    {
+        checksum += initialize_from_binary(workload);
+
+        return 1;
+    }
+
+    const Benchmark
+        benchmarks[] =
+        {
+            { "get_feature_category",         get_feature_category_pass,  0 },
+            { "Feature (category)",           feature_by_category_pass,   0 },
+            { "Feature (code)",               feature_by_code_pass,       0 },
+            { "get_feature_handle",           feature_handle_pass,        0 },
+            { "Feature fields (get_feature)", feature_fields_pass,        0 },
+            { "get_feature_traits",           feature_traits_pass,        0 },
+            { "contains_attribute",           contains_attribute_pass,    0 },
+            { "get_attribute_offset",         get_attribute_offset_pass,  0 },
+            { "get_attribute_offset_unchecked",
+                get_attribute_offset_unchecked_pass, 0 },
+            { "valid_attribute (int32)",      valid_int32_pass,           0 },
+            { "valid_unchecked (int32)",      valid_int32_unchecked_pass, 0 },
+            { "valid_attribute (float64)",    valid_float64_pass,         0 },
+            { "valid_unchecked (float64)",
+                valid_float64_unchecked_pass, 0 },
+            { "valid_attribute (string)",     valid_string_pass,          0 },
+            { "valid_attribute (boolean)",    valid_boolean_pass,         0 },
+            { "valid_attribute (enumerant)",  valid_enumerant_pass,       0 },
+            { "valid_enumerant",              valid_enumerant_code_pass,  0 },
+            { "valid_enumerant_unchecked",
+                valid_enumerant_unchecked_pass, 0 },
+            { "valid_attribute (uuid)",       valid_uuid_pass,            0 },
+            { "get_enumeration_value (label)", enumeration_by_label_pass, 0 },
+            { "get_enumeration_value (code)", enumeration_by_code_pass,   0 },
+            { "get_enumerant_label",          enumerant_label_pass,       0 },
+            { "get_enumerant_label_unchecked",
+                enumerant_label_unchecked_pass, 0 },
+            { "Enumerant (code)",             enumerant_by_code_pass,     0 },
+            { "get_enumerant_handle",         enumerant_handle_pass,      0 },
+            { "convert_value",                convert_value_pass,         0 },
+            { "convert_value (typed)",        convert_typed_value_pass,   0 },
+            { "convert_values",               convert_values_pass,        0 },
+            { "initialize (text)",   initialize_text_pass,   destroy_farm },
+            { "initialize (FARM.bin)", initialize_binary_pass, destroy_farm }
+        };
+
+    // ------------------------------------------------------------------------
+    // Gathers the features, attributes, and enumerants of the initialized
+    // FARM and the mapped EDCS 3.x enumerants of the enumerant mapping file.
+    //
+    // Return:  Was the workload gathered?
+    //
+    bool gather_workload(Workload &workload)
+    {
+        std::list<FARM::Feature>
+            features;
+        std::list<FARM::AttributeCategory>
+            all_attributes;
+
+        if (not FARM::FeatureAttributeMapping::get_features(features) or
+            not FARM::FeatureAttributeMapping::get_all_attribute_categories(
+                all_attributes))
+        {
+            return false;
+        }
+
+        for (std::list<FARM::Feature>::const_iterator
+                feature = features.begin();
+            feature != features.end();
+            ++feature)
+        {
+            const FARM::FeatureCategory
+                feature_category = feature->get_category();
+
+            workload.feature_labels.push_back(feature->get_label());
+            workload.feature_geometries.push_back(feature->get_geometry());
+            workload.feature_categories.push_back(feature_category);
+            workload.feature_codes.push_back(feature->get_code());
+
+            for (std::list<FARM::AttributeCategory>::const_iterator
+                    attribute = all_attributes.begin();
+                attribute != all_attributes.end();
+                ++attribute)
+            {
+                FeatureAttribute
+                    pair;
+                FARM::AttributeDataType
+                    data_type;
+
+                pair.feature_category = feature_category;
+                pair.attribute_category = *attribute;
+
+                workload.all_pairs.push_back(pair);
+
+                if (not FARM::FeatureAttributeMapping::contains_attribute(
+                        feature_category, *attribute) or
+                    not FARM::FeatureAttributeMapping::get_data_type(
+                        *attribute, data_type))
+                {
+                    continue;
+                }
+
+                workload.contained_pairs.push_back(pair);
+
+                switch (data_type)
+                {
+                    case FARM::int32:
+                    {
+                        int
+                            value = 0;
+
+                        FARM::FeatureAttributeMapping::get_default(
+                            feature_category, *attribute, value);
+
+                        workload.int32_pairs.push_back(pair);
+                        workload.int32_values.push_back(value);
+                        break;
+                    }
+
+                    case FARM::float64:
+                    {
+                        double
+                            value = 0.0;
+
+                        FARM::FeatureAttributeMapping::get_default(
+                            feature_category, *attribute, value);
+
+                        workload.float64_pairs.push_back(pair);
+                        workload.float64_values.push_back(value);
+                        break;
+                    }
+
+                    case FARM::string:
+                    {
+                        workload.string_pairs.push_back(pair);
+                        break;
+                    }
+
+                    case FARM::boolean:
+                    {
+                        bool
+                            value = false;
+
+                        FARM::FeatureAttributeMapping::get_default(
+                            feature_category, *attribute, value);
+
+                        workload.boolean_pairs.push_back(pair);
+                        workload.boolean_values.push_back(value);
+                        break;
+                    }
+
+                    case FARM::enumeration:
+                    {
+                        std::list<FARM::Enumerant>
+                            enumerants;
+
+                        FARM::FeatureAttributeMapping::get_valid_enumerants(
+                            feature_category, *attribute, enumerants);
+
+                        for (std::list<FARM::Enumerant>::const_iterator
+                                enumerant = enumerants.begin();
+                            enumerant != enumerants.end();
+                            ++enumerant)
+                        {
+                            FeatureEnumerant
+                                entry;
+
+                            entry.feature_category = feature_category;
+                            entry.attribute_category = *attribute;
+                            entry.label = enumerant->get_ee_label();
+                            entry.code = enumerant->get_ee_code();
+
+                            workload.enumerants.push_back(entry);
+                            workload.enumerant_values.push_back(*enumerant);
+                        }
+                        break;
+                    }
+
+                    case FARM::uuid:
+                    {
+                        workload.uuid_pairs.push_back(pair);
+                        break;
+                    }
+
+                    default:
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+
+        // The EDCS 3.x values are the mapped enumerants of the enumerant
+        // mapping file (columns 0 through 4).
+        //
+        CORE::ConfigurationOptions
+            options(data_file(workload, "enum.cfg"));
+        CORE::VecofCells
+            table,
+            entry;
+
+        if (options.is_ready() and options.value("EnumerantMapping", table))
+        {
+            for (int i = 0; i < table.size(); ++i)
+            {
+                OldValue
+                    old_value;
+                FARM::OldAttributeValue
+                    old_code;
+                std::string
+                    mapping_type;
+
+                if (options.value(table, i, entry) and
+                    options.value(entry, 0, old_code.attribute_code) and
+                    options.value(entry, 1, old_code.enumerant_code) and
+                    options.value(entry, 2, old_value.attribute_label) and
+                    options.value(entry, 3, old_value.enumerant_label) and
+                    options.value(entry, 4, mapping_type) and
+                    mapping_type != "DELETED" and
+                    mapping_type != "REMOVED" and
+                    FARM::EDCSConverter::valid_old_enum(
+                        old_value.attribute_label, old_value.enumerant_label))
+                {
+                    workload.old_values.push_back(old_value);
+                    workload.old_codes.push_back(old_code);
+                }
+            }
+        }
+
+        return not workload.feature_labels.empty();
+    }
+
+    // ------------------------------------------------------------------------
+    // Runs the benchmark for at least the minimum time and writes a row of
+    // the results.
+    //
+    void run_benchmark(
+        const Benchmark &benchmark,
+        const Workload &workload,
+        double minimum_seconds,
+        CacheMissCounter &cache_misses,
+        CORE::Int64 &checksum)
+    {
+        CORE::Int64
+            operations = 0,
+            allocations = 0,
+            misses = 0;
+        double
+            seconds = 0.0;
+
+        // Warm up the caches and any lazily built tables first.
+        //
+        if (benchmark.setup)
+        {
+            benchmark.setup(workload);
+        }
+
+        if (benchmark.pass(workload, checksum) == 0)
+        {
+            std::cout << std::left << std::setw(32) << benchmark.name <<
+                "  (no operations in the workload)" << std::endl;
+            return;
+        }
+
+        while (seconds < minimum_seconds)
+        {
+            if (benchmark.setup)
+            {
+                benchmark.setup(workload);
+            }
+
+            const CORE::Int64
+                first_allocation = allocation_count.load();
+
+            cache_misses.start();
+
+            const Clock::time_point
+                start = Clock::now();
+
+            operations += benchmark.pass(workload, checksum);
+
+            const Clock::time_point
+                stop = Clock::now();
+
+            misses += cache_misses.stop();
+            allocations += allocation_count.load() - first_allocation;
+            seconds += std::chrono::duration<double>(stop - start).count();
+        }
+
+        std::cout << std::left << std::setw(32) << benchmark.name <<
+            std::right << std::fixed <<
+            std::setw(12) << operations <<
+            std::setw(14) << std::setprecision(1) <<
+                seconds * 1.0e9 / operations <<
+            std::setw(14) << std::setprecision(2) <<
+                static_cast<double>(allocations) / operations;
+
+        if (cache_misses.available())
+        {
+            std::cout << std::setw(14) << std::setprecision(2) <<
+                static_cast<double>(misses) / operations;
+        }
+        else
+        {
+            std::cout << std::setw(14) << "n/a";
+        }
+
+        std::cout << std::endl;
+    }
+
+    // ------------------------------------------------------------------------
+    void usage(const char *program)
+    {
+        std::cerr << "Usage:  " << program <<
+            " [-t <seconds>] [-o <FARM.bin directory>] [-T <trace file>]"
+            " [-m] [-f] <data directory>" << std::endl;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// The allocation counting replacements of the global allocation functions.
+//
+void *operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    void
+        *memory = std::malloc(size ? size : 1);
+
+    if (not memory)
+    {
+        throw std::bad_alloc();
+    }
+
+    return memory;
+}
+
+// ----------------------------------------------------------------------------
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+// ----------------------------------------------------------------------------
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+// ----------------------------------------------------------------------------
+void operator delete[](void *memory) noexcept
+{
+    std::free(memory);
+}
+
+// ----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    Workload
+        workload;
+    double
+        minimum_seconds = 0.5;
+    std::string
+        trace_file;
+    bool
+        report_memory = false,
+        report_fingerprint = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string
+            argument = argv[i];
+
+        if (argument == "-t" and i + 1 < argc)
+        {
+            minimum_seconds = std::atof(argv[++i]);
+        }
+        else if (argument == "-o" and i + 1 < argc)
+        {
+            workload.binary_dir = argv[++i];
+        }
+        else if (argument == "-T" and i + 1 < argc)
+        {
+            trace_file = argv[++i];
+        }
+        else if (argument == "-m")
+        {
+            report_memory = true;
+        }
+        else if (argument == "-f")
+        {
+            report_fingerprint = true;
+        }
+        else if (workload.data_dir.empty() and argument[0] != '-')
+        {
+            workload.data_dir = argument;
+        }
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (workload.data_dir.empty())
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (workload.binary_dir.empty())
+    {
+        workload.binary_dir = workload.data_dir;
+    }
+
+    CORE::Logger::set_minimum_level(high);
+
+    FARM::StartupTrace::set_allocation_counter(get_allocation_count);
+    FARM::StartupTrace::clear();
+
+    // Initialize from the configuration files and dump FARM.bin for the
+    // binary initialization benchmark.  An initialization from FARM.bin is
+    // traced as well; it does not initialize the EDCS converter, so the
+    // FARM is initialized from the configuration files again afterwards.
+    //
+    bool
+        initialized = initialize_from_text(workload) and
+            FARM::FeatureAttributeMapping::dump(workload.binary_dir) and
+            gather_workload(workload);
+
+    if (initialized)
+    {
+        destroy_farm(workload);
+        initialized = initialize_from_binary(workload);
+
+        FARM::StartupTrace::enable(false);
+        destroy_farm(workload);
+        initialized = initialized and initialize_from_text(workload);
+    }
+
+    if (not initialized)
+    {
+        std::cerr << "Could not initialize the FARM from '" <<
+            workload.data_dir << "'." << std::endl;
+        return 1;
+    }
+
+    std::cout << std::endl;
+    FARM::StartupTrace::display(std::cout);
+
+    if (not trace_file.empty() and
+        not FARM::StartupTrace::write_chrome_trace(trace_file))
+    {
+        return 1;
+    }
+
+    if (report_memory)
+    {
+        FARM::MemoryFootprint
+            footprint;
+
+        FARM::FeatureAttributeMapping::get_memory_footprint(footprint);
+
+        std::cout << std::endl;
+        footprint.display(std::cout);
+    }
+
+    if (report_fingerprint)
+    {
+        FARM::SchemaFingerprint
+            fingerprint;
+
+        FARM::FeatureAttributeMapping::get_fingerprint(fingerprint);
+
+        std::cout << std::endl;
+        fingerprint.display(std::cout);
+    }
+
+    CacheMissCounter
+        cache_misses;
+    CORE::Int64
+        checksum = 0;
+
+    std::cout << std::endl <<
+        workload.feature_labels.size() << " features, " <<
+        workload.contained_pairs.size() << " feature attributes, " <<
+        workload.enumerants.size() << " feature enumerants, " <<
+        workload.old_values.size() << " EDCS 3.x enumerants" << std::endl;
+
+    if (not cache_misses.available())
+    {
+        std::cout <<
+            "Cache misses are not counted; the performance counters are "
+            "not available." << std::endl;
+    }
+
+    std::cout << std::endl << std::left <<
+        std::setw(32) << "operation" << std::right <<
+        std::setw(12) << "ops" <<
+        std::setw(14) << "ns/op" <<
+        std::setw(14) << "allocs/op" <<
+        std::setw(14) << "misses/op" << std::endl;
+
+    for (int i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); ++i)
+    {
+        run_benchmark(
+            benchmarks[i], workload, minimum_seconds, cache_misses, checksum);
+    }
+
+    // Print the checksum so that the compiler cannot drop the lookups.
+    //
+    std::cout << std::endl << "checksum " << checksum << std::endl;
+
+    if (FARM::Instrumentation::compiled())
+    {
+        std::cout << std::endl;
+        FARM::Instrumentation::display(std::cout);
+    }
+
+    FARM::FeatureAttributeMapping::destroy();
+    FARM::EDCSConverter::destroy();
+
+    return 0;
+}
@@ -0,0 +1,1162 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+// Generates a synthetic FARM for scale and stress testing.  The FDF, ADF,
+// and FAA configuration files and the matching EDCS 3.x to EDCS 4.x mapping
+// files are written to the output directory:
+//
+//     farm.fdf  farm.adf  farm.faa  feat.cfg  attr.cfg  enum.cfg
+//
+// and optionally an EDCS 3.x terrain feature dump for EDCSMigration:
+//
+//     terrain.dump
+//
+// The features, attributes, and enumerants that FeatureCategories,
+// AttributeCategories, and EnumValues look up when the FARM is initialized
+// are always generated, so any generated FARM can be initialized.  The rest
+// is synthetic.  The same options and seed always generate the same files.
+//
+//     farm_generator [options] <output directory>
+//
+//     -f <count>      Feature categories (384)
+//     -a <count>      Attributes (300)
+//     -e <count>      Most enumerants of an enumerated attribute (12)
+//     -p <count>      Mean attributes per feature category (12)
+//     -d <fraction>   Fraction of EDCS 3.x attributes and enumerants that
+//                     were deleted from EDCS 4.x (0.05)
+//     -r <count>      Records in terrain.dump (0 for no dump)
+//     -s <seed>       Seed of the random numbers (1)
+//
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/directory_parser.h"
+#include "core/sys_types.h"
+
+namespace
+{
+    // ------------------------------------------------------------------------
+    // A small random number generator (SplitMix64).  It is used instead of
+    // the standard distributions, whose results differ between standard
+    // libraries, so that a seed generates the same FARM everywhere.
+    // ------------------------------------------------------------------------
+    class Random
+    {
+      public:
+
+        explicit Random(CORE::UInt64 seed);
+
+        // Return:  The next 64 random bits.
+        //
+        CORE::UInt64 next(void);
+
+        // Return:  A random integer from low to high, inclusive.
+        //
+        int uniform(int low, int high);
+
+        // Return:  True with the given probability.
+        //
+        bool chance(double probability);
+
+      private:
+
+        CORE::UInt64
+            state;
+    };
+
+    // ------------------------------------------------------------------------
+    Random::Random(CORE::UInt64 seed) :
+        state(seed)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    CORE::UInt64 Random::next(void)
+    {
+        CORE::UInt64
+            bits = (state += 0x9e3779b97f4a7c15ULL);
+
+        bits = (bits ^ (bits >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        bits = (bits ^ (bits >> 27)) * 0x94d049bb133111ebULL;
+
+        return bits ^ (bits >> 31);
+    }
+
+    // ------------------------------------------------------------------------
+    int Random::uniform(int low, int high)
+    {
+        return low + static_cast<int>(
+            next() % static_cast<CORE::UInt64>(high - low + 1));
+    }
+
+    // ------------------------------------------------------------------------
+    bool Random::chance(double probability)
+    {
+        return (next() >> 11) * (1.0 / 9007199254740992.0) < probability;
+    }
+
+    // A feature type that the FARM initialization requires.
+    //
+    struct RequiredFeature
+    {
+        const char
+            *label,
+            *geometry;
+    };
+
+    // An attribute that the FARM initialization requires.
+    //
+    struct RequiredAttribute
+    {
+        const char
+            *label,
+            *edm_data_type,
+            *units;
+    };
+
+    const RequiredFeature
+        required_features[] =
+        {
+            { "BREACH", "LINE" },
+            { "BREACH", "POINT" },
+            { "BRIDGE", "LINE" },
+            { "BRIDGE_PIER", "POINT" },
+            { "BRIDGE_SPAN", "POINT" },
+            { "BUILDING", "AREA" },
+            { "BUILDING", "POINT" },
+            { "BUILT_UP_REGION", "AREA" },
+            { "CART_TRACK", "LINE" },
+            { "CAUSEWAY", "LINE" },
+            { "COMMUNICATION_TOWER", "POINT" },
+            { "CROSS_COUNTRY_BARRIER", "LINE" },
+            { "DISPLAY_SIGN", "POINT" },
+            { "DISTURBED_SOIL", "POINT" },
+            { "DRAGON_TEETH", "LINE" },
+            { "DRAGON_TEETH", "POINT" },
+            { "ENGINEER_BRIDGE", "LINE" },
+            { "ENGINEER_TRENCH", "LINE" },
+            { "GROUND_SURFACE_ELEMENT", "AREA" },
+            { "HAZARD_MARKER", "LINE" },
+            { "HAZARD_MARKER", "POINT" },
+            { "INDIVIDUAL_FIGHTING_POSITION", "POINT" },
+            { "INFANTRY_TRENCH", "LINE" },
+            { "LAND_FLOODING_PERIODICALLY", "AREA" },
+            { "LOG_OBSTACLE", "POINT" },
+            { "MINEFIELD", "AREA" },
+            { "OVERPASS", "LINE" },
+            { "PUMP", "POINT" },
+            { "RAILWAY", "LINE" },
+            { "RAILWAY_SIDETRACK", "LINE" },
+            { "RIVER", "AREA" },
+            { "RIVER", "LINE" },
+            { "ROAD", "LINE" },
+            { "ROCK_DROP", "POINT" },
+            { "RUBBLE", "POINT" },
+            { "SHRUB", "POINT" },
+            { "SPEED_HUMP", "LINE" },
+            { "STREET_LAMP", "POINT" },
+            { "TENT", "POINT" },
+            { "TERRAIN_CRATER", "POINT" },
+            { "TERRAIN_OBSTACLE", "POINT" },
+            { "TRAIL", "LINE" },
+            { "TREE", "POINT" },
+            { "TREED_TRACT", "AREA" },
+            { "TUNNEL", "LINE" },
+            { "TUNNEL_SHELTER", "AREA" },
+            { "UNDERGROUND_RAILWAY", "LINE" },
+            { "VEHICLE_LOT", "AREA" },
+            { "WADI", "LINE" },
+            { "WALL", "LINE" },
+            { "WATER_TOWER", "POINT" },
+            { "WEAPON_FIGHTING_POSITION", "POINT" },
+            { "WIRE", "LINE" },
+            { "WIRE_OBSTACLE", "LINE" }
+        };
+
+    const RequiredAttribute
+        required_attributes[] =
+        {
+            { "APERTURE_OPEN", "LOGICAL", "" },
+            { "AREA", "REAL", "SQUARE_METRE" },
+            { "ASSOCIATED_TEXT", "STRING", "" },
+            { "BRIDGE_DESIGN", "ENUMERATION", "" },
+            { "BRIDGE_SPAN_COUNT", "COUNT", "UNITLESS" },
+            { "BRUSH_DENSITY", "ENUMERATION", "" },
+            { "BUILDING_CONSTRUCTION_TYPE", "ENUMERATION", "" },
+            { "BUILDING_FUNCTION", "ENUMERATION", "" },
+            { "CLASSIFICATION_NAME", "STRING", "" },
+            { "COLOURATION", "ENUMERATION", "" },
+            { "COMPLEX_COMPONENT_IDENTIFIER", "STRING", "" },
+            { "CONSTRUCTION_COMPLETION_FRACTION", "REAL", "UNITLESS" },
+            { "CROWN_DIAMETER", "REAL", "METRE" },
+            { "DEFENSIVE_POSITION_COUNT", "COUNT", "UNITLESS" },
+            { "DEFENSIVE_POSITION_TYPE", "ENUMERATION", "" },
+            { "DEPTH_BELOW_SURFACE_LEVEL", "REAL", "METRE" },
+            { "ECOSYSTEM_TYPE", "ENUMERATION", "" },
+            { "EXPLOSIVE_MINE_DENSITY", "REAL", "UNITLESS" },
+            { "EXPLOSIVE_MINE_TYPE", "ENUMERATION", "" },
+            { "FORDABLE", "LOGICAL", "" },
+            { "FRONT_AND_AXIS_REFERENCE", "ENUMERATION", "" },
+            { "FROZEN_SOIL_LAYER_BOTTOM_DEPTH", "REAL", "METRE" },
+            { "FROZEN_SOIL_LAYER_TOP_DEPTH", "REAL", "METRE" },
+            { "FROZEN_SURFACE_COVER_TYPE", "ENUMERATION", "" },
+            { "GENERAL_DAMAGE_FRACTION", "REAL", "UNITLESS" },
+            { "HEIGHT_ABOVE_SURFACE_LEVEL", "REAL", "METRE" },
+            { "HULL_DEFILADE_DEPTH", "REAL", "METRE" },
+            { "HYDROLOGIC_PERMANENCE", "ENUMERATION", "" },
+            { "ILLUMINANCE", "REAL", "LUX" },
+            { "INSIDE_DIAMETER", "REAL", "METRE" },
+            { "LADDER_PRESENT", "LOGICAL", "" },
+            { "LAND_ROUTE_TYPE", "ENUMERATION", "" },
+            { "LENGTH", "REAL", "METRE" },
+            { "MASS", "REAL", "KILOGRAM" },
+            { "MAXIMUM_STANDING_WATER_DEPTH", "REAL", "METRE" },
+            { "MEAN_WATER_DEPTH", "REAL", "METRE" },
+            { "MINEFIELD_TYPE", "ENUMERATION", "" },
+            { "NAME", "STRING", "" },
+            { "NUMERIC_OBJECT_IDENTIFIER", "INTEGER", "UNITLESS" },
+            { "OBJECT_BASE_HEIGHT", "REAL", "METRE" },
+            { "OBJECT_VARIANT", "INTEGER", "UNITLESS" },
+            { "ORIENTATION_ANGLE", "REAL", "DEGREE" },
+            { "OVERALL_BRIDGE_HEIGHT", "REAL", "METRE" },
+            { "OVERHEAD_CLEARANCE", "REAL", "METRE" },
+            { "PASSAGE_BLOCKED", "LOGICAL", "" },
+            { "PATH_COUNT", "COUNT", "UNITLESS" },
+            { "PLATOON_ACCOMMODATION_AVAILABILITY_COUNT", "COUNT", "UNITLESS" },
+            { "POINT_OBJECT_TYPE", "ENUMERATION", "" },
+            { "PRIMARY_MATERIAL_TYPE", "ENUMERATION", "" },
+            { "RAILWAY_GAUGE_CATEGORY", "ENUMERATION", "" },
+            { "RELIGIOUS_DESIGNATION", "ENUMERATION", "" },
+            { "ROAD_ILLUMINATED_WIDTH", "REAL", "METRE" },
+            { "ROAD_MINIMUM_TRAVELLED_WAY_WIDTH", "REAL", "METRE" },
+            { "ROOF_ASSEMBLY_TYPE", "ENUMERATION", "" },
+            { "RUBBLE_STABILITY", "ENUMERATION", "" },
+            { "SEASON", "ENUMERATION", "" },
+            { "SNOW_DENSITY", "REAL", "KILOGRAMS_PER_CUBIC_METRE" },
+            { "SNOW_DEPTH_CATEGORY", "ENUMERATION", "" },
+            { "SNOW_ONLY_DEPTH", "REAL", "METRE" },
+            { "SOIL_DENSITY_DRY", "REAL", "KILOGRAMS_PER_CUBIC_METRE" },
+            { "SOIL_TYPE", "ENUMERATION", "" },
+            { "SOIL_WATER_VOLUME", "REAL", "UNITLESS" },
+            { "SOIL_WETNESS_CATEGORY", "ENUMERATION", "" },
+            { "STEM_DIAMETER", "REAL", "METRE" },
+            { "SURFACE_MATERIAL_TYPE", "ENUMERATION", "" },
+            { "SURFACE_TEMPERATURE", "REAL", "CELSIUS" },
+            { "TERRAIN_ELEVATION", "REAL", "METRE" },
+            { "TERRAIN_OBSTACLE_TYPE", "ENUMERATION", "" },
+            { "TERRAIN_ROUGHNESS_ROOT_MEAN_SQUARE", "REAL", "METRE" },
+            { "TERRAIN_TRAFFICABILITY_FINE", "INTEGER", "UNITLESS" },
+            { "TEXTUAL_OBJECT_IDENTIFIER", "STRING", "" },
+            { "TOTAL_SNOW_ICE_DEPTH", "REAL", "METRE" },
+            { "TREE_CANOPY_BOTTOM_HEIGHT", "REAL", "METRE" },
+            { "TUNNEL_CROSS_SECTION", "ENUMERATION", "" },
+            { "TURRET_DEFILADE_DEPTH", "REAL", "METRE" },
+            { "UNDERBRIDGE_CLEARANCE", "REAL", "METRE" },
+            { "USABLE_LENGTH", "REAL", "METRE" },
+            { "VEGETATION_TYPE", "ENUMERATION", "" },
+            { "VEHICLE_TRAFFIC_FLOW", "ENUMERATION", "" },
+            { "VEHICULAR_SPEED_LIMIT", "REAL", "METRE_PER_SECOND" },
+            { "VERTICAL_LOAD_BEARING_CAPACITY", "REAL", "KILOGRAM" },
+            { "WIDTH", "REAL", "METRE" }
+        };
+
+    // EnumValues looks up this enumerant of the river's hydrologic
+    // permanence.
+    //
+    const char
+        *required_enumerant_attribute = "HYDROLOGIC_PERMANENCE",
+        *required_enumerant = "PERENNIAL_OR_PERMANENT",
+        *required_enumerant_feature = "RIVER",
+        *required_enumerant_geometry = "LINE";
+
+    // The usage tokens of the FAA file.
+    //
+    const char
+        *usages[] =
+        {
+            "avenue", "aperture", "building", "farm", "forest", "furniture",
+            "raisedCombatPos", "dugInCombatPos", "lane", "multiBldg",
+            "LFSmlVehObstacle", "vehObstacle", "airVehObstacle", "urban",
+            "NBC", "blocksLSmlVehLOS", "blocksVehLOS", "blocksLOS",
+            "protectsLSmlVeh"
+        };
+
+    const char
+        *geometries[] = { "POINT", "LINE", "AREA" };
+
+    // The EDM data types and units of the synthetic attributes.
+    //
+    const char
+        *synthetic_data_types[] =
+        {
+            "INTEGER", "REAL", "REAL", "STRING", "LOGICAL",
+            "ENUMERATION", "ENUMERATION", "ENUMERATION"
+        },
+        *synthetic_units[] =
+        {
+            "UNITLESS", "METRE", "DEGREE", "KILOGRAM", "SQUARE_METRE"
+        };
+
+    const int
+        required_feature_count =
+            sizeof(required_features) / sizeof(required_features[0]),
+        required_attribute_count =
+            sizeof(required_attributes) / sizeof(required_attributes[0]),
+        usage_count = sizeof(usages) / sizeof(usages[0]),
+        synthetic_data_type_count =
+            sizeof(synthetic_data_types) / sizeof(synthetic_data_types[0]),
+        synthetic_units_count =
+            sizeof(synthetic_units) / sizeof(synthetic_units[0]),
+        old_code_offset = 10000;  // EDCS 3.x codes are offset from EDCS 4.x
+
+    struct GeneratorOptions
+    {
+        GeneratorOptions(void);
+
+        std::string
+            output_dir;
+        int
+            feature_count,
+            attribute_count,
+            enumerant_count,
+            attributes_per_feature,
+            record_count;
+        double
+            deleted_fraction;
+        CORE::UInt64
+            seed;
+    };
+
+    // ------------------------------------------------------------------------
+    GeneratorOptions::GeneratorOptions(void) :
+        feature_count(384),
+        attribute_count(300),
+        enumerant_count(12),
+        attributes_per_feature(12),
+        record_count(0),
+        deleted_fraction(0.05),
+        seed(1)
+    {
+    }
+
+    struct GeneratedEnumerant
+    {
+        std::string
+            label;
+        int
+            code;
+        bool
+            deleted;            // Only in EDCS 3.x
+    };
+
+    struct GeneratedAttribute
+    {
+        std::string
+            label,
+            edm_data_type,
+            units;
+        int
+            code;
+        bool
+            deleted;            // Only in EDCS 3.x
+        std::vector<GeneratedEnumerant>
+            enumerants;
+    };
+
+    struct GeneratedFeature
+    {
+        std::string
+            label,
+            geometry;
+        int
+            code,
+            precedence;
+        std::vector<int>
+            usages,
+            attributes;         // Indices of the attributes, enumerations
+                                // first
+    };
+
+    struct GeneratedFarm
+    {
+        std::vector<GeneratedAttribute>
+            attributes;
+        std::vector<GeneratedFeature>
+            features;
+        std::vector<std::string>
+            feature_labels;     // Unique labels; the code is the index + 1
+    };
+
+    // ------------------------------------------------------------------------
+    // Return:  The label with the number appended.
+    //
+    std::string numbered(const std::string &prefix, int number)
+    {
+        std::ostringstream
+            label;
+
+        label << prefix << std::setw(5) << std::setfill('0') << number;
+
+        return label.str();
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  Is the attribute an enumeration?
+    //
+    bool enumerated(const GeneratedAttribute &attribute)
+    {
+        return attribute.edm_data_type == "ENUMERATION";
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The data type of the attribute in the EDCS mapping files.
+    //
+    std::string mapping_data_type(const GeneratedAttribute &attribute)
+    {
+        if (attribute.edm_data_type == "COUNT")
+        {
+            return "INTEGER";
+        }
+        else if (attribute.edm_data_type == "LOGICAL")
+        {
+            return "BOOLEAN";
+        }
+
+        return attribute.edm_data_type;
+    }
+
+    // ------------------------------------------------------------------------
+    // Generates the enumerants of an enumerated attribute.  The enumerant
+    // labels start with the attribute label, so they can never be mistaken
+    // for a feature or attribute label in the FAA file.
+    //
+    void generate_enumerants(
+        const GeneratorOptions &options,
+        Random &random,
+        GeneratedAttribute &attribute)
+    {
+        const int
+            count = random.uniform(2, std::max(2, options.enumerant_count));
+
+        for (int i = 0; i < count; ++i)
+        {
+            GeneratedEnumerant
+                enumerant;
+
+            enumerant.label = attribute.label + "_" + numbered("VALUE_", i + 1);
+            enumerant.code = i + 1;
+            enumerant.deleted =
+                i > 0 and random.chance(options.deleted_fraction);
+
+            attribute.enumerants.push_back(enumerant);
+        }
+
+        if (attribute.label == required_enumerant_attribute)
+        {
+            attribute.enumerants[0].label = required_enumerant;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Generates the required and synthetic attributes and the EDCS 3.x
+    // attributes that were deleted from EDCS 4.x.
+    //
+    void generate_attributes(
+        const GeneratorOptions &options,
+        Random &random,
+        GeneratedFarm &farm)
+    {
+        const int
+            count = std::max(options.attribute_count, required_attribute_count);
+
+        for (int i = 0; i < count; ++i)
+        {
+            GeneratedAttribute
+                attribute;
+
+            if (i < required_attribute_count)
+            {
+                attribute.label = required_attributes[i].label;
+                attribute.edm_data_type = required_attributes[i].edm_data_type;
+                attribute.units = required_attributes[i].units;
+            }
+            else
+            {
+                attribute.label = numbered("SYNTHETIC_ATTRIBUTE_", i);
+                attribute.edm_data_type = synthetic_data_types[
+                    random.uniform(0, synthetic_data_type_count - 1)];
+
+                if (attribute.edm_data_type == "INTEGER" or
+                    attribute.edm_data_type == "REAL")
+                {
+                    attribute.units = synthetic_units[
+                        random.uniform(0, synthetic_units_count - 1)];
+                }
+            }
+
+            attribute.code = i + 1;
+            attribute.deleted = false;
+
+            if (enumerated(attribute))
+            {
+                generate_enumerants(options, random, attribute);
+            }
+
+            farm.attributes.push_back(attribute);
+        }
+
+        const int
+            deleted_count =
+                static_cast<int>(count * options.deleted_fraction + 0.5);
+
+        for (int i = 0; i < deleted_count; ++i)
+        {
+            GeneratedAttribute
+                attribute;
+
+            attribute.label = numbered("DELETED_ATTRIBUTE_", i);
+            attribute.edm_data_type = random.chance(0.5) ?
+                "ENUMERATION" : "INTEGER";
+            attribute.units = "UNITLESS";
+            attribute.code = count + i + 1;
+            attribute.deleted = true;
+
+            if (enumerated(attribute))
+            {
+                generate_enumerants(options, random, attribute);
+            }
+
+            farm.attributes.push_back(attribute);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Chooses the usages and attributes of a feature.  The enumerated
+    // attributes are listed first and a feature never ends with one: the FAA
+    // parser reads enumerants until it finds a token that is not one, and it
+    // treats the feature labels TUNDRA and DRAGON_TEETH after an enumerant
+    // specially.
+    //
+    void choose_attributes(
+        const GeneratorOptions &options,
+        Random &random,
+        const GeneratedFarm &farm,
+        GeneratedFeature &feature)
+    {
+        std::set<int>
+            chosen;
+        const int
+            mean = std::max(1, options.attributes_per_feature),
+            count = random.uniform((mean + 1) / 2, mean + mean / 2),
+            usage_total = random.uniform(1, 3);
+
+        for (int i = 0; i < usage_total; ++i)
+        {
+            const int
+                usage = random.uniform(0, usage_count - 1);
+
+            if (std::find(feature.usages.begin(), feature.usages.end(), usage)
+                == feature.usages.end())
+            {
+                feature.usages.push_back(usage);
+            }
+        }
+
+        // The attributes that were deleted from EDCS 4.x come last.
+        //
+        int
+            last_attribute = 0;
+
+        while (last_attribute < farm.attributes.size() and
+            not farm.attributes[last_attribute].deleted)
+        {
+            ++last_attribute;
+        }
+
+        for (int attempt = 0; chosen.size() < count and attempt < 4 * count;
+            ++attempt)
+        {
+            chosen.insert(random.uniform(0, last_attribute - 1));
+        }
+
+        if (feature.label == required_enumerant_feature and
+            feature.geometry == required_enumerant_geometry)
+        {
+            for (int i = 0; i < farm.attributes.size(); ++i)
+            {
+                if (farm.attributes[i].label == required_enumerant_attribute)
+                {
+                    chosen.insert(i);
+                }
+            }
+        }
+
+        int
+            plain_attribute = -1;
+
+        for (std::set<int>::const_iterator itr = chosen.begin();
+            itr != chosen.end();
+            ++itr)
+        {
+            if (enumerated(farm.attributes[*itr]))
+            {
+                feature.attributes.push_back(*itr);
+            }
+            else
+            {
+                plain_attribute = *itr;
+            }
+        }
+
+        for (std::set<int>::const_iterator itr = chosen.begin();
+            itr != chosen.end();
+            ++itr)
+        {
+            if (not enumerated(farm.attributes[*itr]))
+            {
+                feature.attributes.push_back(*itr);
+            }
+        }
+
+        // End with an attribute that is not an enumeration.
+        //
+        while (plain_attribute < 0)
+        {
+            const int
+                candidate = random.uniform(0, last_attribute - 1);
+
+            if (not enumerated(farm.attributes[candidate]))
+            {
+                plain_attribute = candidate;
+                feature.attributes.push_back(candidate);
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Generates the required and synthetic feature types.  A synthetic label
+    // has one to three geometries, each of which is a feature category.
+    //
+    void generate_features(
+        const GeneratorOptions &options,
+        Random &random,
+        GeneratedFarm &farm)
+    {
+        for (int i = 0; i < required_feature_count; ++i)
+        {
+            GeneratedFeature
+                feature;
+
+            feature.label = required_features[i].label;
+            feature.geometry = required_features[i].geometry;
+
+            farm.features.push_back(feature);
+        }
+
+        for (int label = 0; farm.features.size() < options.feature_count;
+            ++label)
+        {
+            const int
+                first = random.uniform(0, 2),
+                count = random.uniform(1, 3);
+
+            for (int i = 0;
+                i < count and farm.features.size() < options.feature_count;
+                ++i)
+            {
+                GeneratedFeature
+                    feature;
+
+                feature.label = numbered("SYNTHETIC_FEATURE_", label);
+                feature.geometry = geometries[(first + i) % 3];
+
+                farm.features.push_back(feature);
+            }
+        }
+
+        for (int i = 0; i < farm.features.size(); ++i)
+        {
+            GeneratedFeature
+                &feature = farm.features[i];
+
+            if (farm.feature_labels.empty() or
+                farm.feature_labels.back() != feature.label)
+            {
+                farm.feature_labels.push_back(feature.label);
+            }
+
+            feature.code = farm.feature_labels.size();
+            feature.precedence = random.uniform(0, 9);
+
+            choose_attributes(options, random, farm, feature);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  Was the FDF file written?
+    //
+    bool write_fdf(const std::string &file_name, const GeneratedFarm &farm)
+    {
+        std::ofstream
+            file(file_name.c_str());
+
+        for (int i = 0; i < farm.features.size(); ++i)
+        {
+            const GeneratedFeature
+                &feature = farm.features[i];
+
+            file << "\"" << feature.label << "\" \"" << feature.geometry <<
+                "\" \"Synthetic " << feature.label << "\" " <<
+                feature.precedence << "\n";
+        }
+
+        return file.good();
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  Was the ADF file written?
+    //
+    bool write_adf(const std::string &file_name, const GeneratedFarm &farm)
+    {
+        std::ofstream
+            file(file_name.c_str());
+
+        for (int i = 0; i < farm.attributes.size(); ++i)
+        {
+            const GeneratedAttribute
+                &attribute = farm.attributes[i];
+
+            if (attribute.deleted)
+            {
+                continue;
+            }
+
+            file << "\"" << attribute.label << "\" \"" <<
+                attribute.edm_data_type << "\"";
+
+            if (not attribute.units.empty())
+            {
+                file << " \"" << attribute.units << "\"";
+            }
+
+            file << " \"Editable\" \"Synthetic " << attribute.label << "\"\n";
+        }
+
+        return file.good();
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes the default and range of an attribute of a feature.  The ranges
+    // always hold 0 to 100, the values that the terrain dump uses.
+    //
+    void write_attribute_ranges(
+        std::ostream &file,
+        Random &random,
+        const GeneratedAttribute &attribute)
+    {
+        const std::string
+            data_type = mapping_data_type(attribute);
+
+        if (data_type == "INTEGER")
+        {
+            const int
+                maximum = random.uniform(100, 1000);
+
+            file << " " << random.uniform(0, maximum) << " 0 " << maximum;
+        }
+        else if (data_type == "REAL")
+        {
+            const int
+                maximum = random.uniform(100, 1000);
+
+            file << " " << random.uniform(0, maximum - 1) << ".5 0.0 " <<
+                maximum << ".5";
+        }
+        else if (data_type == "BOOLEAN")
+        {
+            file << (random.chance(0.5) ? " \"TRUE\"" : " \"FALSE\"");
+        }
+        else if (data_type == "ENUMERATION")
+        {
+            std::vector<const GeneratedEnumerant *>
+                valid;
+
+            for (int i = 0; i < attribute.enumerants.size(); ++i)
+            {
+                if (not attribute.enumerants[i].deleted)
+                {
+                    valid.push_back(&attribute.enumerants[i]);
+                }
+            }
+
+            file << " \"" <<
+                valid[random.uniform(0, valid.size() - 1)]->label << "\"";
+
+            for (int i = 0; i < valid.size(); ++i)
+            {
+                file << " \"" << valid[i]->label << "\"";
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  Was the FAA file written?
+    //
+    bool write_faa(
+        const std::string &file_name,
+        Random &random,
+        const GeneratedFarm &farm)
+    {
+        std::ofstream
+            file(file_name.c_str());
+
+        for (int i = 0; i < farm.features.size(); ++i)
+        {
+            const GeneratedFeature
+                &feature = farm.features[i];
+
+            file << "\"" << feature.label << "\" \"" << feature.geometry <<
+                "\"";
+
+            for (int u = 0; u < feature.usages.size(); ++u)
+            {
+                file << " \"" << usages[feature.usages[u]] << "\"";
+            }
+
+            for (int a = 0; a < feature.attributes.size(); ++a)
+            {
+                const GeneratedAttribute
+                    &attribute = farm.attributes[feature.attributes[a]];
+
+                file << "\n    \"" << attribute.label << "\"";
+
+                write_attribute_ranges(file, random, attribute);
+            }
+
+            file << "\n";
+        }
+
+        return file.good();
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes the EDCS 3.x to EDCS 4.x feature mapping.  The EDCS 3.x labels
+    // are the same as the EDCS 4.x labels.
+    //
+    // Return:  Was the file written?
+    //
+    bool write_feature_mapping(
+        const std::string &file_name,
+        const GeneratedFarm &farm)
+    {
+        std::ofstream
+            file(file_name.c_str());
+
+        file << "FeatureMapping = (\n";
+
+        for (int i = 0; i < farm.feature_labels.size(); ++i)
+        {
+            file << "  (\"" << farm.feature_labels[i] << "\", \"" <<
+                farm.feature_labels[i] << "\", " << i + 1 << ")\n";
+        }
+
+        file << ");\n";
+
+        return file.good();
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes the EDCS 3.x to EDCS 4.x attribute mapping.
+    //
+    // Return:  Was the file written?
+    //
+    bool write_attribute_mapping(
+        const std::string &file_name,
+        const GeneratedFarm &farm)
+    {
+        std::ofstream
+            file(file_name.c_str());
+
+        file << "AttributeMapping = (\n";
+
+        for (int i = 0; i < farm.attributes.size(); ++i)
+        {
+            const GeneratedAttribute
+                &attribute = farm.attributes[i];
+            const std::string
+                data_type = mapping_data_type(attribute);
+
+            file << "  (" << attribute.code + old_code_offset << ", \"" <<
+                data_type << "\", \"" << attribute.label << "\", " <<
+                attribute.code << ", \"" <<
+                (attribute.deleted ? "DELETED" : data_type) << "\", \"" <<
+                attribute.label << "\")\n";
+        }
+
+        file << ");\n";
+
+        return file.good();
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes the EDCS 3.x to EDCS 4.x enumerant mapping.
+    //
+    // Return:  Was the file written?
+    //
+    bool write_enumerant_mapping(
+        const std::string &file_name,
+        const GeneratedFarm &farm)
+    {
+        std::ofstream
+            file(file_name.c_str());
+
+        file << "EnumerantMapping = (\n";
+
+        for (int i = 0; i < farm.attributes.size(); ++i)
+        {
+            const GeneratedAttribute
+                &attribute = farm.attributes[i];
+
+            for (int e = 0; e < attribute.enumerants.size(); ++e)
+            {
+                const GeneratedEnumerant
+                    &enumerant = attribute.enumerants[e];
+                const bool
+                    deleted = attribute.deleted or enumerant.deleted;
+
+                file << "  (" << attribute.code + old_code_offset << ", " <<
+                    enumerant.code << ", \"" << attribute.label << "\", \"" <<
+                    enumerant.label << "\", \"" <<
+                    (deleted ? "DELETED" : "MAPPED") << "\", \"ENUM\", " <<
+                    attribute.code << ", " << (deleted ? 0 : enumerant.code) <<
+                    ", \"" << attribute.label << "\", \"" <<
+                    (deleted ? "" : enumerant.label) << "\")\n";
+            }
+        }
+
+        file << ");\n";
+
+        return file.good();
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes an EDCS 3.x terrain feature dump in the EDCSMigration input
+    // format.  Most values are valid; a few records use deleted attributes
+    // and enumerants so that the reject log is exercised too.
+    //
+    // Return:  Was the file written?
+    //
+    bool write_terrain_dump(
+        const std::string &file_name,
+        const GeneratorOptions &options,
+        Random &random,
+        const GeneratedFarm &farm)
+    {
+        std::ofstream
+            file(file_name.c_str());
+        int
+            first_deleted = 0;
+
+        while (first_deleted < farm.attributes.size() and
+            not farm.attributes[first_deleted].deleted)
+        {
+            ++first_deleted;
+        }
+
+        file << "# Synthetic EDCS 3.x terrain feature dump, seed " <<
+            options.seed << "\n";
+
+        for (int r = 0; r < options.record_count; ++r)
+        {
+            const GeneratedFeature
+                &feature = farm.features[
+                    random.uniform(0, farm.features.size() - 1)];
+
+            file << feature.label << "\t" << feature.geometry;
+
+            for (int a = 0; a < feature.attributes.size(); ++a)
+            {
+                const GeneratedAttribute
+                    *attribute = &farm.attributes[feature.attributes[a]];
+
+                if (random.chance(0.25))
+                {
+                    continue;
+                }
+
+                if (first_deleted < farm.attributes.size() and
+                    random.chance(options.deleted_fraction))
+                {
+                    attribute = &farm.attributes[random.uniform(
+                        first_deleted, farm.attributes.size() - 1)];
+                }
+
+                const std::string
+                    data_type = mapping_data_type(*attribute);
+
+                file << "\t" << attribute->label << "=";
+
+                if (data_type == "INTEGER")
+                {
+                    file << random.uniform(0, 100);
+                }
+                else if (data_type == "REAL")
+                {
+                    file << random.uniform(0, 100) << ".25";
+                }
+                else if (data_type == "BOOLEAN")
+                {
+                    file << (random.chance(0.5) ? "TRUE" : "FALSE");
+                }
+                else if (data_type == "ENUMERATION")
+                {
+                    file << attribute->enumerants[random.uniform(
+                        0, attribute->enumerants.size() - 1)].label;
+                }
+                else
+                {
+                    file << numbered("TEXT_", r);
+                }
+            }
+
+            file << "\n";
+        }
+
+        return file.good();
+    }
+
+    // ------------------------------------------------------------------------
+    void usage(const char *program)
+    {
+        std::cerr << "Usage:  " << program << " [-f <features>] "
+            "[-a <attributes>] [-e <enumerants>] [-p <attributes per "
+            "feature>] [-d <deleted fraction>] [-r <records>] [-s <seed>] "
+            "<output directory>" << std::endl;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  Were the options parsed?
+    //
+    bool parse_options(int argc, char *argv[], GeneratorOptions &options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string
+                argument = argv[i];
+
+            if (argument.size() == 2 and argument[0] == '-' and i + 1 < argc)
+            {
+                const char
+                    *value = argv[++i];
+
+                switch (argument[1])
+                {
+                    case 'f': options.feature_count = std::atoi(value); break;
+                    case 'a': options.attribute_count = std::atoi(value); break;
+                    case 'e': options.enumerant_count = std::atoi(value); break;
+                    case 'p':
+                        options.attributes_per_feature = std::atoi(value);
+                        break;
+                    case 'd': options.deleted_fraction = std::atof(value); break;
+                    case 'r': options.record_count = std::atoi(value); break;
+                    case 's':
+                        options.seed = std::strtoull(value, 0, 10);
+                        break;
+                    default: return false;
+                }
+            }
+            else if (options.output_dir.empty() and argument[0] != '-')
+            {
+                options.output_dir = argument;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        return not options.output_dir.empty() and
+            0.0 <= options.deleted_fraction and
+            options.deleted_fraction < 1.0;
+    }
+}
+
+// ----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    GeneratorOptions
+        options;
+
+    if (not parse_options(argc, argv, options))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (not CORE::DirectoryParser::verify_dir(options.output_dir))
+    {
+        std::cerr << "Could not create the directory '" <<
+            options.output_dir << "'." << std::endl;
+        return 1;
+    }
+
+    Random
+        random(options.seed);
+    GeneratedFarm
+        farm;
+
+    generate_attributes(options, random, farm);
+    generate_features(options, random, farm);
+
+    const std::string
+        &dir = options.output_dir;
+    bool
+        written =
+            write_fdf(dir + "/farm.fdf", farm) and
+            write_adf(dir + "/farm.adf", farm) and
+            write_faa(dir + "/farm.faa", random, farm) and
+            write_feature_mapping(dir + "/feat.cfg", farm) and
+            write_attribute_mapping(dir + "/attr.cfg", farm) and
+            write_enumerant_mapping(dir + "/enum.cfg", farm);
+
+    if (written and options.record_count > 0)
+    {
+        written =
+            write_terrain_dump(dir + "/terrain.dump", options, random, farm);
+    }
+
+    if (not written)
+    {
+        std::cerr << "Could not write the FARM to '" << dir << "'." <<
+            std::endl;
+        return 1;
+    }
+
+    std::cout << "Generated " << farm.features.size() <<
+        " feature categories and " << farm.attributes.size() <<
+        " attributes in '" << dir << "'." << std::endl;
+
+    return 0;
+}
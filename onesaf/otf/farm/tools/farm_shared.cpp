@@ -0,0 +1,714 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+// Publishes the FARM of a data directory in a POSIX shared memory segment,
+// and checks a shared FARM from several processes at once.
+//
+//     farm_shared publish <data directory> <segment name>
+//     farm_shared check [-n <processes>] <data directory> <segment name>
+//     farm_shared remove <segment name>
+//
+// The data directory holds the FARM configuration files, as for
+// farm_benchmark.  publish replaces a segment that its publisher did not
+// finish, or whose image has another schema fingerprint.  check starts the
+// processes together, so that they race to publish when there is no
+// segment.  Each one follows the SharedFarm idiom: it attaches the segment,
+// or publishes the FARM that it loaded and waits for the segment of the
+// winner.  It then compares every feature, attribute, and FARM table cell of
+// the shared FARM with the FARM that it loaded.
+//
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "core/compare.h"
+#include "core/logger.h"
+#include "farm.h"
+#include "farm_shared_farm.h"
+
+namespace
+{
+    typedef FARM::FeatureAttributeMapping
+        Mapping;
+
+    // Only the first mismatches of a process are written.
+    //
+    const int
+        reported_mismatches = 10;
+
+    // How long a process waits for the segment of another publisher.
+    //
+    const int
+        wait_milliseconds = 10000;
+
+    // ------------------------------------------------------------------------
+    // Return:  The file in the data directory.
+    //
+    std::string data_file(const std::string &data_dir, const char *name)
+    {
+        return data_dir + "/" + name;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  Was the FARM loaded from the data directory?
+    //
+    bool load_farm(const std::string &data_dir)
+    {
+        return Mapping::initialize(
+            data_dir,
+            data_file(data_dir, "farm.fdf"),
+            data_file(data_dir, "farm.adf"),
+            data_file(data_dir, "farm.faa"),
+            data_file(data_dir, "feat.cfg"),
+            data_file(data_dir, "attr.cfg"),
+            data_file(data_dir, "enum.cfg"));
+    }
+
+    // ------------------------------------------------------------------------
+    // Counts a mismatch between the shared and the loaded FARM if the
+    // condition does not hold.
+    //
+    void expect(
+        bool condition,
+        const char *what,
+        const FARM::FeatureCategory &feature_category,
+        const FARM::AttributeCategory &attribute_category,
+        int &mismatches
+    )
+    {
+        if (not condition)
+        {
+            if (mismatches < reported_mismatches)
+            {
+                std::cerr <<
+                    "Process " << getpid() << ": the " << what <<
+                    " of feature category " << feature_category <<
+                    " and attribute " << attribute_category <<
+                    " differs." << std::endl;
+            }
+
+            ++mismatches;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Compares a FARM table cell of the shared FARM with the loaded FARM.
+    //
+    void compare_cell(
+        const FARM::FlatFarm &farm,
+        const FARM::FeatureCategory &feature_category,
+        const FARM::AttributeCategory &attribute_category,
+        int &mismatches
+    )
+    {
+        FARM::AttributeOffset
+            offset = -1,
+            flat_offset = -1;
+        FARM::AttributeDataType
+            data_type = FARM::no_data_type;
+
+        Mapping::get_attribute_offset(
+            feature_category, attribute_category, offset);
+        Mapping::get_data_type(attribute_category, data_type);
+
+        expect(
+            farm.get_attribute_offset(
+                feature_category, attribute_category, flat_offset) and
+            flat_offset == offset,
+            "offset",
+            feature_category,
+            attribute_category,
+            mismatches);
+
+        switch (data_type)
+        {
+            case FARM::int32:
+            {
+                int
+                    value = 0,
+                    flat_value = 0,
+                    maximum = 0,
+                    flat_maximum = 0;
+
+                Mapping::get_default(
+                    feature_category, attribute_category, value);
+                expect(
+                    farm.get_default(
+                        feature_category, attribute_category, flat_value) and
+                    flat_value == value,
+                    "default",
+                    feature_category,
+                    attribute_category,
+                    mismatches);
+
+                Mapping::get_min_max(
+                    feature_category, attribute_category, value, maximum);
+                expect(
+                    farm.get_min_max(
+                        feature_category,
+                        attribute_category,
+                        flat_value,
+                        flat_maximum) and
+                    flat_value == value and
+                    flat_maximum == maximum,
+                    "range",
+                    feature_category,
+                    attribute_category,
+                    mismatches);
+
+                // The values around and inside the range, in 64 bits so
+                // that the widest range does not overflow.
+                //
+                const CORE::Int64
+                    step =
+                        (static_cast<CORE::Int64>(maximum) - value) / 8 + 1;
+
+                for (CORE::Int64 test = static_cast<CORE::Int64>(value) - 1;
+                     test <= static_cast<CORE::Int64>(maximum) + 1;
+                     test += step)
+                {
+                    if (CORE::ordered<CORE::Int64>(
+                        std::numeric_limits<int>::min(),
+                        test,
+                        std::numeric_limits<int>::max()))
+                    {
+                        const int
+                            test_value = static_cast<int>(test);
+
+                        expect(
+                            farm.valid_attribute(
+                                feature_category,
+                                attribute_category,
+                                test_value) ==
+                            Mapping::valid_attribute(
+                                feature_category,
+                                attribute_category,
+                                test_value),
+                            "valid value",
+                            feature_category,
+                            attribute_category,
+                            mismatches);
+                    }
+                }
+                break;
+            }
+
+            case FARM::float64:
+            {
+                double
+                    value = 0.0,
+                    flat_value = 0.0,
+                    maximum = 0.0,
+                    flat_maximum = 0.0;
+
+                Mapping::get_default(
+                    feature_category, attribute_category, value);
+                expect(
+                    farm.get_default(
+                        feature_category, attribute_category, flat_value) and
+                    flat_value == value,
+                    "default",
+                    feature_category,
+                    attribute_category,
+                    mismatches);
+
+                Mapping::get_min_max(
+                    feature_category, attribute_category, value, maximum);
+                expect(
+                    farm.get_min_max(
+                        feature_category,
+                        attribute_category,
+                        flat_value,
+                        flat_maximum) and
+                    flat_value == value and
+                    flat_maximum == maximum,
+                    "range",
+                    feature_category,
+                    attribute_category,
+                    mismatches);
+
+                for (int step = -1; step <= 9; ++step)
+                {
+                    const double
+                        test = value + (maximum - value) * step / 8.0;
+
+                    expect(
+                        farm.valid_attribute(
+                            feature_category, attribute_category, test) ==
+                        Mapping::valid_attribute(
+                            feature_category, attribute_category, test),
+                        "valid value",
+                        feature_category,
+                        attribute_category,
+                        mismatches);
+                }
+                break;
+            }
+
+            case FARM::boolean:
+            {
+                bool
+                    value = false,
+                    flat_value = false;
+
+                Mapping::get_default(
+                    feature_category, attribute_category, value);
+                expect(
+                    farm.get_default(
+                        feature_category, attribute_category, flat_value) and
+                    flat_value == value,
+                    "default",
+                    feature_category,
+                    attribute_category,
+                    mismatches);
+                break;
+            }
+
+            case FARM::enumeration:
+            {
+                FARM::Enumerant
+                    value;
+                FARM::EnumerantCode
+                    flat_value = -1,
+                    flat_code = -1,
+                    maximum_code = 0;
+                std::list<FARM::Enumerant>
+                    enumerants;
+
+                Mapping::get_default(
+                    feature_category, attribute_category, value);
+                expect(
+                    farm.get_default_enumerant(
+                        feature_category, attribute_category, flat_value) and
+                    flat_value == value.get_ee_code(),
+                    "default",
+                    feature_category,
+                    attribute_category,
+                    mismatches);
+
+                Mapping::get_valid_enumerants(
+                    feature_category, attribute_category, enumerants);
+
+                for (std::list<FARM::Enumerant>::const_iterator
+                        enumerant = enumerants.begin();
+                    enumerant != enumerants.end();
+                    ++enumerant)
+                {
+                    const char
+                        *flat_label = farm.get_enumerant_label(
+                            attribute_category, enumerant->get_ee_code());
+
+                    expect(
+                        flat_label and enumerant->get_ee_label() == flat_label,
+                        "enumerant label",
+                        feature_category,
+                        attribute_category,
+                        mismatches);
+                    expect(
+                        farm.get_enumerant_code(
+                            attribute_category,
+                            enumerant->get_ee_label(),
+                            flat_code) and
+                        flat_code == enumerant->get_ee_code(),
+                        "enumerant code",
+                        feature_category,
+                        attribute_category,
+                        mismatches);
+
+                    if (maximum_code < enumerant->get_ee_code())
+                    {
+                        maximum_code = enumerant->get_ee_code();
+                    }
+                }
+
+                for (FARM::EnumerantCode code = -1;
+                     code <= maximum_code + 1;
+                     ++code)
+                {
+                    expect(
+                        farm.valid_enumerant(
+                            feature_category, attribute_category, code) ==
+                        Mapping::valid_enumerant(
+                            feature_category, attribute_category, code),
+                        "valid enumerant",
+                        feature_category,
+                        attribute_category,
+                        mismatches);
+                }
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Compares every feature, attribute, and FARM table cell of the shared
+    // FARM with the loaded FARM.
+    //
+    // Return:  The number of mismatches.
+    //
+    int compare_farm(const FARM::FlatFarm &farm, int &cell_count)
+    {
+        int
+            mismatches = 0;
+
+        cell_count = 0;
+
+        for (int attribute = 0;
+             attribute < farm.get_attribute_category_count();
+             ++attribute)
+        {
+            const char
+                *flat_label = farm.get_attribute_label(attribute);
+            FARM::AttributeLabel
+                label;
+            FARM::AttributeCategory
+                flat_attribute = -1;
+            FARM::AttributeDataType
+                data_type = FARM::no_data_type,
+                flat_data_type = FARM::no_data_type;
+
+            if (not Mapping::valid_attribute_category(attribute))
+            {
+                expect(not flat_label, "label", -1, attribute, mismatches);
+                continue;
+            }
+
+            Mapping::get_attribute_label(attribute, label);
+            Mapping::get_data_type(attribute, data_type);
+
+            expect(
+                flat_label and label == flat_label and
+                farm.get_attribute_category(label, flat_attribute) and
+                flat_attribute == attribute,
+                "label",
+                -1,
+                attribute,
+                mismatches);
+            expect(
+                farm.get_data_type(attribute, flat_data_type) and
+                flat_data_type == data_type,
+                "data type",
+                -1,
+                attribute,
+                mismatches);
+        }
+
+        for (int feature = 0;
+             feature < farm.get_feature_category_count();
+             ++feature)
+        {
+            const char
+                *flat_label = farm.get_feature_label(feature);
+            FARM::FeatureLabel
+                label;
+            FARM::FeatureGeometry
+                geometry;
+            FARM::FeatureCategory
+                flat_feature = -1;
+            int
+                overlay_size = 0;
+
+            if (not Mapping::valid_not_all_feature_category(feature))
+            {
+                continue;
+            }
+
+            Mapping::get_feature_label(feature, label);
+            Mapping::get_feature_geometry(feature, geometry);
+            Mapping::get_attributes_overlay_size(feature, overlay_size);
+
+            expect(
+                flat_label and label == flat_label and
+                farm.get_feature_category(label, geometry, flat_feature) and
+                flat_feature == feature,
+                "label",
+                feature,
+                -1,
+                mismatches);
+            expect(
+                farm.get_feature(feature) and
+                farm.get_feature(feature)->overlay_size == overlay_size,
+                "overlay size",
+                feature,
+                -1,
+                mismatches);
+
+            for (int attribute = 0;
+                 attribute < farm.get_attribute_category_count();
+                 ++attribute)
+            {
+                if (not Mapping::valid_attribute_category(attribute))
+                {
+                    continue;
+                }
+
+                const bool
+                    contained =
+                        Mapping::contains_attribute(feature, attribute);
+
+                expect(
+                    farm.contains_attribute(feature, attribute) == contained,
+                    "presence",
+                    feature,
+                    attribute,
+                    mismatches);
+
+                if (contained)
+                {
+                    compare_cell(farm, feature, attribute, mismatches);
+                    ++cell_count;
+                }
+            }
+        }
+
+        return mismatches;
+    }
+
+    // ------------------------------------------------------------------------
+    // Attaches the shared FARM as a SharedFarm user does and compares it
+    // with the FARM of the data directory.
+    //
+    // Return:  The exit status of the process.
+    //
+    int check_process(
+        const std::string &data_dir,
+        const std::string &segment_name
+    )
+    {
+        FARM::SharedFarm
+            shared;
+        FARM::SchemaFingerprint
+            fingerprint;
+        bool
+            published = false;
+        int
+            cell_count = 0,
+            mismatches = 0;
+
+        if (not load_farm(data_dir))
+        {
+            std::cerr <<
+                "Process " << getpid() << " could not load the FARM." <<
+                std::endl;
+            return 1;
+        }
+
+        Mapping::get_fingerprint(fingerprint);
+
+        const std::chrono::steady_clock::time_point
+            start = std::chrono::steady_clock::now();
+
+        if (not shared.attach(segment_name, fingerprint.fingerprint))
+        {
+            published = FARM::SharedFarm::publish(segment_name);
+            shared.attach(
+                segment_name, fingerprint.fingerprint, wait_milliseconds);
+        }
+
+        const double
+            attach_microseconds =
+                std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - start).count();
+
+        if (not shared.is_attached())
+        {
+            std::cerr <<
+                "Process " << getpid() << " could not attach the segment '" <<
+                segment_name << "'." << std::endl;
+            return 1;
+        }
+
+        mismatches = compare_farm(shared.get_farm(), cell_count);
+
+        std::cout <<
+            "Process " << getpid() << ": " <<
+            (published ? "published" : "attached") << " in " <<
+            static_cast<long>(attach_microseconds) << " us, " <<
+            cell_count << " cells, " << mismatches << " mismatches" <<
+            std::endl;
+
+        Mapping::destroy();
+
+        return mismatches == 0 ? 0 : 1;
+    }
+
+    // ------------------------------------------------------------------------
+    void usage(const char *program)
+    {
+        std::cerr <<
+            "Usage:  " << program <<
+            " publish <data directory> <segment name>" << std::endl <<
+            "        " << program <<
+            " check [-n <processes>] <data directory> <segment name>" <<
+            std::endl <<
+            "        " << program << " remove <segment name>" << std::endl;
+    }
+}
+
+// ----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    std::string
+        command,
+        data_dir,
+        segment_name;
+    int
+        process_count = 4,
+        failures = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string
+            argument = argv[i];
+
+        if (argument == "-n" and i + 1 < argc)
+        {
+            process_count = std::atoi(argv[++i]);
+        }
+        else if (command.empty() and argument[0] != '-')
+        {
+            command = argument;
+        }
+        else if (data_dir.empty() and argument[0] != '-')
+        {
+            data_dir = argument;
+        }
+        else if (segment_name.empty() and argument[0] != '-')
+        {
+            segment_name = argument;
+        }
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // remove only takes the segment name.
+    //
+    if (command == "remove" and segment_name.empty())
+    {
+        segment_name = data_dir;
+        data_dir.clear();
+    }
+
+    if (segment_name.empty() or
+        (command != "remove" and data_dir.empty()) or
+        (command != "publish" and command != "check" and
+            command != "remove") or
+        process_count < 1)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    CORE::Logger::set_minimum_level(high);
+
+    if (command == "remove")
+    {
+        if (not FARM::SharedFarm::remove(segment_name))
+        {
+            std::cerr <<
+                "Could not remove the segment '" << segment_name << "'." <<
+                std::endl;
+            return 1;
+        }
+    }
+    else if (command == "publish")
+    {
+        FARM::SharedFarm
+            shared;
+        FARM::SchemaFingerprint
+            fingerprint;
+
+        if (not load_farm(data_dir))
+        {
+            std::cerr << "Could not load the FARM." << std::endl;
+            return 1;
+        }
+
+        Mapping::get_fingerprint(fingerprint);
+
+        if (FARM::SharedFarm::publish(segment_name))
+        {
+            std::cout <<
+                "Published the FARM in the segment '" << segment_name <<
+                "'." << std::endl;
+        }
+        else if (shared.attach(segment_name, fingerprint.fingerprint))
+        {
+            std::cout <<
+                "The segment '" << segment_name <<
+                "' already holds the FARM." << std::endl;
+        }
+        else
+        {
+            std::cerr <<
+                "Could not publish the FARM in the segment '" <<
+                segment_name << "'." << std::endl;
+            return 1;
+        }
+
+        Mapping::destroy();
+    }
+    else
+    {
+        for (int i = 0; i < process_count; ++i)
+        {
+            const pid_t
+                child = fork();
+
+            if (child == 0)
+            {
+                _exit(check_process(data_dir, segment_name));
+            }
+            else if (child < 0)
+            {
+                ++failures;
+            }
+        }
+
+        int
+            status;
+
+        while (wait(&status) > 0)
+        {
+            if (not WIFEXITED(status) or WEXITSTATUS(status) != 0)
+            {
+                ++failures;
+            }
+        }
+
+        std::cout <<
+            process_count - failures << " of " << process_count <<
+            " processes checked the shared FARM." << std::endl;
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,225 @@
+/*
+ * NOTICE: This file is critical to the OneSAF virtual training use case.  
+ * Any changes to this file will be subject to an increased review process
+ * to ensure that changes do not impact OneSAF virtual training.  Please 
+ * coordinate proposed changes with PM OneSAF to avoid delays in integration.
+ */
+/*
+ * Classification:  Unclassified
+ *
+ * Project Name:  OneSAF
+ *
+ * DISTRIBUTION STATEMENT C.
+ *
+ * Distribution is authorized to U.S. Government Agencies and their
+ * contractors. Export Controlled: 23 August 2012. Other requests for
+ * this document shall be referred to U.S. Army PEO STRI.
+ *
+ */
+// Builds a trimmed FARM that holds only the feature categories and
+// attributes a simulation uses, numbered densely with the most used first,
+// so that the tables it queries fit in the L2 cache.  The trimmed FARM is a
+// flat image that FARM::FlatFarm queries in place, and it maps its codes to
+// those of the full FARM both ways.
+//
+//     farm_trim [-m <manifest>] [-d <overlay file>] [-w <manifest>]
+//         <data directory> <image file>
+//
+// The data directory holds the FARM configuration files, as for
+// farm_benchmark.  The categories to keep come from a manifest (-m), from
+// the migrated overlay files of a terrain database (-d), or both; -m and -d
+// may be repeated.  -w writes the combined manifest, so that one derived
+// from overlay files can be edited and reused.
+//
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "core/logger.h"
+#include "farm.h"
+#include "farm_flat_image.h"
+#include "farm_trim_manifest.h"
+
+namespace
+{
+    // ------------------------------------------------------------------------
+    // Return:  The file in the data directory.
+    //
+    std::string data_file(const std::string &data_dir, const char *name)
+    {
+        return data_dir + "/" + name;
+    }
+
+    // ------------------------------------------------------------------------
+    // Writes the size of a flat image and its tables.
+    //
+    void report_image(
+        const char *name,
+        const FARM::FlatFarm &farm,
+        std::size_t cell_count
+    )
+    {
+        std::cout <<
+            name << ": " << farm.get_feature_category_count() <<
+            " feature categories, " << farm.get_attribute_category_count() <<
+            " attributes, " << cell_count << " cells, " <<
+            farm.get_image_bytes() << " bytes" << std::endl;
+    }
+
+    // ------------------------------------------------------------------------
+    // Return:  The number of cells of the features of a flat image.
+    //
+    std::size_t count_cells(const FARM::FlatFarm &farm)
+    {
+        std::size_t
+            cell_count = 0;
+
+        for (int category = 0;
+             category < farm.get_feature_category_count();
+             ++category)
+        {
+            const FARM::FlatFeature
+                *feature = farm.get_feature(category);
+
+            if (feature)
+            {
+                cell_count += feature->cell_count;
+            }
+        }
+
+        return cell_count;
+    }
+
+    // ------------------------------------------------------------------------
+    void usage(const char *program)
+    {
+        std::cerr << "Usage:  " << program <<
+            " [-m <manifest>] [-d <overlay file>] [-w <manifest>]"
+            " <data directory> <image file>" << std::endl;
+    }
+}
+
+// ----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    std::vector<std::string>
+        manifest_files,
+        overlay_files;
+    std::string
+        data_dir,
+        image_file,
+        written_manifest;
+    FARM::TrimManifest
+        manifest;
+    std::vector<char>
+        full_image,
+        trimmed_image;
+    FARM::FlatFarm
+        full_farm,
+        trimmed_farm;
+    long
+        l2_bytes = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    bool
+        successful;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string
+            argument = argv[i];
+
+        if (argument == "-m" and i + 1 < argc)
+        {
+            manifest_files.push_back(argv[++i]);
+        }
+        else if (argument == "-d" and i + 1 < argc)
+        {
+            overlay_files.push_back(argv[++i]);
+        }
+        else if (argument == "-w" and i + 1 < argc)
+        {
+            written_manifest = argv[++i];
+        }
+        else if (data_dir.empty() and argument[0] != '-')
+        {
+            data_dir = argument;
+        }
+        else if (image_file.empty() and argument[0] != '-')
+        {
+            image_file = argument;
+        }
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (image_file.empty() or
+        (manifest_files.empty() and overlay_files.empty()))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    CORE::Logger::set_minimum_level(high);
+
+    successful = FARM::FeatureAttributeMapping::initialize(
+        data_dir,
+        data_file(data_dir, "farm.fdf"),
+        data_file(data_dir, "farm.adf"),
+        data_file(data_dir, "farm.faa"),
+        data_file(data_dir, "feat.cfg"),
+        data_file(data_dir, "attr.cfg"),
+        data_file(data_dir, "enum.cfg"));
+
+    for (std::size_t i = 0; successful and i < manifest_files.size(); ++i)
+    {
+        successful = manifest.read(manifest_files[i]);
+    }
+
+    for (std::size_t i = 0; successful and i < overlay_files.size(); ++i)
+    {
+        successful = manifest.add_overlay_file(overlay_files[i]);
+    }
+
+    if (successful and not written_manifest.empty())
+    {
+        successful = manifest.write(written_manifest);
+    }
+
+    successful =
+        successful and
+        FARM::FeatureAttributeMapping::build_trimmed_flat_image(
+            manifest, trimmed_image) and
+        FARM::FlatFarm::write_image(image_file, trimmed_image) and
+        trimmed_farm.open(&trimmed_image[0], trimmed_image.size());
+
+    if (not successful)
+    {
+        std::cerr << "Could not build the trimmed FARM." << std::endl;
+        return 1;
+    }
+
+    FARM::FeatureAttributeMapping::build_flat_image(full_image);
+    full_farm.open(&full_image[0], full_image.size());
+
+    report_image("Full FARM", full_farm, count_cells(full_farm));
+    report_image("Trimmed FARM", trimmed_farm, count_cells(trimmed_farm));
+
+    if (l2_bytes > 0)
+    {
+        std::cout <<
+            "The trimmed FARM is " <<
+            (trimmed_farm.get_image_bytes() * 100 + l2_bytes / 2) / l2_bytes <<
+            "% of the " << l2_bytes / 1024 << " KB L2 cache" <<
+            (trimmed_farm.get_image_bytes() <= l2_bytes ?
+                "." : ", and does not fit.") << std::endl;
+    }
+
+    FARM::FeatureAttributeMapping::destroy();
+
+    return 0;
+}